@@ -36,6 +36,7 @@ SOFTWARE.
 #include "../char_traits.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #if defined(ETL_COMPILER_GCC)
 #pragma GCC diagnostic push
@@ -440,7 +441,7 @@ namespace etl
   public:
 
     atomic()
-      : value(nullptr)
+      : value(0)
     {
     }
 
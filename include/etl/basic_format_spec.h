@@ -51,6 +51,7 @@ namespace etl
     /// Width = 0
     /// Upper case (for hex) = true
     /// Left Justified = false
+    /// Shortest = false
     //***************************************************************************
     basic_format_spec()
       : base_(10)
@@ -59,6 +60,7 @@ namespace etl
       , upper_case_(true)
       , left_justified_(false)
       , boolalpha_(false)
+      , shortest_(false)
       , fill_(typename TString::value_type(' '))
     {
 
@@ -248,6 +250,26 @@ namespace etl
       return boolalpha_;
     }
 
+    //***************************************************************************
+    /// Sets the shortest flag.
+    /// Floating point values are formatted with the fewest digits that convert
+    /// back to the same value, and the precision is ignored.
+    /// \return A reference to the basic_format_spec.
+    //***************************************************************************
+    basic_format_spec& shortest(bool s)
+    {
+      shortest_ = s;
+      return *this;
+    }
+
+    //***************************************************************************
+    /// Gets the shortest flag.
+    //***************************************************************************
+    bool is_shortest() const
+    {
+      return shortest_;
+    }
+
   private:
 
     uint_least8_t base_;
@@ -256,6 +278,7 @@ namespace etl
     bool upper_case_;
     bool left_justified_;
     bool boolalpha_;
+    bool shortest_;
     typename TString::value_type fill_;
   };
 }
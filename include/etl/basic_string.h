@@ -52,6 +52,8 @@ SOFTWARE.
 #include "exception.h"
 #include "memory.h"
 
+#include "private/string_search.h"
+
 #undef ETL_FILE
 #define ETL_FILE "27"
 
@@ -1124,21 +1126,7 @@ namespace etl
     //*********************************************************************
     size_t find(const ibasic_string<T>& str, size_t pos = 0) const
     {
-      if ((pos + str.size()) > size())
-      {
-        return npos;
-      }
-
-      const_iterator iposition = std::search(begin() + pos, end(), str.begin(), str.end());
-
-      if (iposition == end())
-      {
-        return npos;
-      }
-      else
-      {
-        return std::distance(begin(), iposition);
-      }
+      return find(str.data(), pos, str.size());
     }
 
     //*********************************************************************
@@ -1148,23 +1136,7 @@ namespace etl
     //*********************************************************************
     size_t find(const_pointer s, size_t pos = 0) const
     {
-#if defined(ETL_DEBUG)
-      if ((pos + etl::strlen(s)) > size())
-      {
-        return npos;
-      }
-#endif
-
-      const_iterator iposition = std::search(begin() + pos, end(), s, s + etl::strlen(s));
-
-      if (iposition == end())
-      {
-        return npos;
-      }
-      else
-      {
-        return std::distance(begin(), iposition);
-      }
+      return find(s, pos, etl::strlen(s));
     }
 
     //*********************************************************************
@@ -1175,23 +1147,20 @@ namespace etl
     //*********************************************************************
     size_t find(const_pointer s, size_t pos, size_t n) const
     {
-#if defined(ETL_DEBUG)
-      if ((pos + etl::strlen(s) - n) > size())
+      if (pos > size())
       {
         return npos;
       }
-#endif
-
-      const_iterator iposition = std::search(begin() + pos, end(), s, s + n);
 
-      if (iposition == end())
-      {
-        return npos;
-      }
-      else
+      // An empty sequence is found at the start position, even at the end of the string.
+      if (n == 0)
       {
-        return std::distance(begin(), iposition);
+        return pos;
       }
+
+      const_pointer iposition = etl::private_string_search::find_sequence(p_buffer + pos, p_buffer + size(), s, n);
+
+      return to_position(iposition);
     }
 
     //*********************************************************************
@@ -1201,16 +1170,14 @@ namespace etl
     //*********************************************************************
     size_t find(T c, size_t position = 0) const
     {
-      const_iterator i = std::find(begin() + position, end(), c);
-
-      if (i != end())
-      {
-        return std::distance(begin(), i);
-      }
-      else
+      if (position >= size())
       {
         return npos;
       }
+
+      const_pointer iposition = etl::private_string_search::find_character(p_buffer + position, p_buffer + size(), c);
+
+      return to_position(iposition);
     }
 
     //*********************************************************************
@@ -1650,21 +1617,14 @@ namespace etl
     //*********************************************************************
     size_t find_first_of(const_pointer s, size_t position, size_t n) const
     {
-      if (position < size())
+      if (position >= size())
       {
-        for (size_t i = position; i < size(); ++i)
-        {
-          for (size_t j = 0; j < n; ++j)
-          {
-            if (p_buffer[i] == s[j])
-            {
-              return i;
-            }
-          }
-        }
+        return npos;
       }
 
-      return npos;
+      const_pointer iposition = etl::private_string_search::find_first_of(p_buffer + position, p_buffer + size(), s, n);
+
+      return to_position(iposition);
     }
 
     //*********************************************************************
@@ -1674,18 +1634,7 @@ namespace etl
     //*********************************************************************
     size_t find_first_of(value_type c, size_t position = 0) const
     {
-      if (position < size())
-      {
-        for (size_t i = position; i < size(); ++i)
-        {
-          if (p_buffer[i] == c)
-          {
-            return i;
-          }
-        }
-      }
-
-      return npos;
+      return find(c, position);
     }
 
     //*********************************************************************
@@ -1723,23 +1672,10 @@ namespace etl
 
       position = std::min(position, size() - 1);
 
-      const_reverse_iterator it = rbegin() + size() - position - 1;
-
-      while (it != rend())
-      {
-        for (size_t j = 0; j < n; ++j)
-        {
-          if (p_buffer[position] == s[j])
-          {
-            return position;
-          }
-        }
+      const_pointer iend      = p_buffer + position + 1;
+      const_pointer iposition = etl::private_string_search::find_last_of(p_buffer, iend, s, n);
 
-        ++it;
-        --position;
-      }
-
-      return npos;
+      return (iposition == iend) ? npos : size_t(iposition - p_buffer);
     }
 
     //*********************************************************************
@@ -2066,6 +2002,15 @@ namespace etl
       }
     }
 
+    //*************************************************************************
+    /// Converts the result of a search to a position.
+    ///\return The position, or npos if the search reached the end of the string.
+    //*************************************************************************
+    size_t to_position(const_pointer iposition) const
+    {
+      return (iposition == (p_buffer + size())) ? npos : size_t(iposition - p_buffer);
+    }
+
     //*************************************************************************
     /// Clear the unused trailing portion of the string.
     //*************************************************************************
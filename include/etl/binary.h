@@ -810,10 +810,15 @@ namespace etl
 
   //***************************************************************************
   /// Count set bits. 32 bits.
+  /// Uses the compiler builtin for GCC, which is a single instruction
+  /// on targets with a population count.
   ///\ingroup binary
   //***************************************************************************
   inline uint_least8_t count_bits(uint32_t value)
   {
+#if defined(ETL_COMPILER_GCC)
+    return uint_least8_t(__builtin_popcount(value));
+#else
     uint32_t count;
 
     value = value - ((value >> 1) & 0x55555555);
@@ -821,6 +826,7 @@ namespace etl
     count = (((value + (value >> 4)) & 0xF0F0F0F) * 0x1010101) >> 24;
 
     return uint_least8_t(count);
+#endif
   }
 
   inline uint_least8_t count_bits(int32_t value)
@@ -830,10 +836,15 @@ namespace etl
 
   //***************************************************************************
   /// Count set bits. 64 bits.
+  /// Uses the compiler builtin for GCC, which is a single instruction
+  /// on targets with a population count.
   ///\ingroup binary
   //***************************************************************************
   inline uint_least8_t count_bits(uint64_t value)
   {
+#if defined(ETL_COMPILER_GCC)
+    return uint_least8_t(__builtin_popcountll(value));
+#else
     uint64_t count;
     static const int S[] = { 1, 2, 4, 8, 16, 32 };
     static const uint64_t B[] = { 0x5555555555555555, 0x3333333333333333, 0x0F0F0F0F0F0F0F0F, 0x00FF00FF00FF00FF, 0x0000FFFF0000FFFF, 0x00000000FFFFFFFF };
@@ -846,6 +857,7 @@ namespace etl
     count = ((count >> S[5]) + count) & B[5];
 
     return uint_least8_t(count);
+#endif
   }
 
   inline uint_least8_t count_bits(int64_t value)
@@ -1015,11 +1027,19 @@ namespace etl
 
   //***************************************************************************
   /// Count trailing zeros. 32bit.
-  /// Uses a binary search.
+  /// Uses the compiler builtin for GCC, otherwise a binary search.
   ///\ingroup binary
   //***************************************************************************
   inline uint_least8_t count_trailing_zeros(uint32_t value)
   {
+#if defined(ETL_COMPILER_GCC)
+    // The builtin is undefined for zero.
+    if (value != 0)
+    {
+      return uint_least8_t(__builtin_ctz(value));
+    }
+#endif
+
     uint_least8_t count;
 
     if (value & 0x1)
@@ -1067,11 +1087,19 @@ namespace etl
 
   //***************************************************************************
   /// Count trailing zeros. 64bit.
-  /// Uses a binary search.
+  /// Uses the compiler builtin for GCC, otherwise a binary search.
   ///\ingroup binary
   //***************************************************************************
   inline uint_least8_t count_trailing_zeros(uint64_t value)
   {
+#if defined(ETL_COMPILER_GCC)
+      // The builtin is undefined for zero.
+      if (value != 0)
+      {
+        return uint_least8_t(__builtin_ctzll(value));
+      }
+#endif
+
       uint_least8_t count;
 
       if (value & 0x1)
@@ -101,10 +101,14 @@ namespace etl
   protected:
 
     // The type used for each element in the array.
-#if !defined(ETL_BITSET_ELEMENT_TYPE)
-    typedef uint_least8_t element_t;
-#else
+    // Defaults to the native word on 64 bit platforms, so that scans and
+    // counts work on 64 bits at a time.
+#if defined(ETL_BITSET_ELEMENT_TYPE)
     typedef ETL_BITSET_ELEMENT_TYPE element_t;
+#elif ETL_PLATFORM_64BIT
+    typedef uint64_t element_t;
+#else
+    typedef uint_least8_t element_t;
 #endif
 
   public:
@@ -448,60 +452,58 @@ namespace etl
     //*************************************************************************
     size_t find_next(bool state, size_t position) const
     {
-      // Where to start.
-      size_t index;
-      size_t bit;
-
-      if (SIZE == 1)
+      if (position >= NBITS)
       {
-        index = 0;
-        bit = position;
+        return ibitset::npos;
       }
-      else
+
+      size_t index = position >> etl::log2<BITS_PER_ELEMENT>::value;
+      size_t bit   = position & (BITS_PER_ELEMENT - 1);
+
+      // Search for set bits, inverting the elements if searching for clear bits.
+      // Mask off the bits before the start position.
+      element_t value = element_t(get_element(index, state) & element_t(ALL_SET << bit));
+
+      // Skip whole elements that have no bits in the required state.
+      while (value == 0)
       {
-        index = position >> log2<BITS_PER_ELEMENT>::value;
-        bit = position & (BITS_PER_ELEMENT - 1);
+        if (++index == SIZE)
+        {
+          return ibitset::npos;
+        }
+
+        value = get_element(index, state);
       }
 
-      element_t mask = 1 << bit;
+      position = (index << etl::log2<BITS_PER_ELEMENT>::value) + etl::count_trailing_zeros(value);
+
+      // Inverted elements have set bits past the end of the bitset.
+      return (position < NBITS) ? position : size_t(ibitset::npos);
+    }
 
-      // For each element in the bitset...
-      while (index < SIZE)
+    //*************************************************************************
+    /// Calls the functor with the position of each set bit, in ascending order.
+    ///\param functor The functor to call. Takes the position as a size_t.
+    ///\returns The functor.
+    //*************************************************************************
+    template <typename TFunctor>
+    TFunctor for_each_set_bit(TFunctor functor) const
+    {
+      for (size_t index = 0; index < SIZE; ++index)
       {
         element_t value = pdata[index];
+        const size_t base = index << etl::log2<BITS_PER_ELEMENT>::value;
 
-        // Needs checking?
-        if ((state && (value != ALL_CLEAR)) ||
-          (!state && (value != ALL_SET)))
+        while (value != 0)
         {
-          // For each bit in the element...
-          while ((bit < BITS_PER_ELEMENT) && (position < NBITS))
-          {
-            // Equal to the required state?
-            if (((value & mask) != 0) == state)
-            {
-              return position;
-            }
-
-            // Move on to the next bit.
-            mask <<= 1;
-            ++position;
-            ++bit;
-          }
-        }
-        else
-        {
-          position += BITS_PER_ELEMENT;
-        }
+          functor(base + etl::count_trailing_zeros(value));
 
-        // Start at the beginning for all other elements.
-        bit = 0;
-        mask = 1;
-
-        ++index;
+          // Clear the lowest set bit.
+          value &= element_t(value - 1);
+        }
       }
 
-      return ibitset::npos;
+      return functor;
     }
 
     //*************************************************************************
@@ -567,6 +569,7 @@ namespace etl
       if (SIZE == 1)
       {
         pdata[0] <<= shift;
+        pdata[0] &= TOP_MASK;
       }
       else
       {
@@ -638,6 +641,14 @@ namespace etl
 
   protected:
 
+    //*************************************************************************
+    /// Gets the element at the index, inverted if searching for clear bits.
+    //*************************************************************************
+    element_t get_element(size_t index, bool state) const
+    {
+      return state ? pdata[index] : element_t(~pdata[index]);
+    }
+
     //*************************************************************************
     /// Initialise from an unsigned long long.
     //*************************************************************************
@@ -0,0 +1,357 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BTREE_MULTISET_INCLUDED
+#define ETL_BTREE_MULTISET_INCLUDED
+
+#define ETL_IN_BTREE_H
+
+#include <stddef.h>
+
+#include "platform.h"
+
+#include "stl/algorithm.h"
+#include "stl/iterator.h"
+#include "stl/functional.h"
+
+#include "private/btree_base.h"
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+  #include <initializer_list>
+#endif
+
+#undef ETL_FILE
+#define ETL_FILE "57"
+
+//*****************************************************************************
+///\defgroup btree_multiset btree_multiset
+/// A multiset with the capacity defined at compile time, stored in a B+ tree.
+/// Each node holds many values, so lookups and iteration touch fewer cache
+/// lines than etl::multiset, at the cost of invalidating iterators on insert and erase.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for specifically sized btree_multisets.
+  /// Can be used as a reference type for all btree_multisets containing a specific type.
+  ///\ingroup btree_multiset
+  //***************************************************************************
+  template <typename TKey, typename TKeyCompare = std::less<TKey> >
+  class ibtree_multiset : public etl::ibtree<TKey, const TKey, etl::private_btree::key_of_key<TKey>, TKeyCompare>
+  {
+  private:
+
+    typedef etl::ibtree<TKey, const TKey, etl::private_btree::key_of_key<TKey>, TKeyCompare> base;
+
+  public:
+
+    typedef TKey              key_type;
+    typedef const TKey        value_type;
+    typedef TKeyCompare       key_compare;
+    typedef TKeyCompare       value_compare;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+    typedef value_type*       pointer;
+    typedef const value_type* const_pointer;
+    typedef size_t            size_type;
+
+    typedef typename base::iterator       iterator;
+    typedef typename base::const_iterator const_iterator;
+
+    //*********************************************************************
+    /// Assigns values to the btree_multiset.
+    /// If asserts or exceptions are enabled, emits btree_full if the btree_multiset does not have enough free space.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign(TIterator first, TIterator last)
+    {
+      this->clear();
+      insert(first, last);
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the btree_multiset.
+    /// If asserts or exceptions are enabled, emits btree_full if the btree_multiset is already full.
+    ///\param value The value to insert.
+    //*********************************************************************
+    iterator insert(const_reference value)
+    {
+      return this->insert_multi(value);
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the btree_multiset.
+    /// If asserts or exceptions are enabled, emits btree_full if the btree_multiset is already full.
+    ///\param position The position hint. Unused.
+    ///\param value    The value to insert.
+    //*********************************************************************
+    iterator insert(const_iterator, const_reference value)
+    {
+      return this->insert_multi(value);
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values to the btree_multiset.
+    /// If asserts or exceptions are enabled, emits btree_full if the btree_multiset does not have enough free space.
+    ///\param first The first element to add.
+    ///\param last  The last + 1 element to add.
+    //*********************************************************************
+    template <class TIterator>
+    void insert(TIterator first, TIterator last)
+    {
+      while (first != last)
+      {
+        this->insert_multi(*first++);
+      }
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    ibtree_multiset& operator = (const ibtree_multiset& rhs)
+    {
+      if (this != &rhs)
+      {
+        assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+    //*************************************************************************
+    /// How to compare two value elements.
+    //*************************************************************************
+    value_compare value_comp() const
+    {
+      return value_compare();
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    ibtree_multiset(etl::ipool& leaf_pool, etl::ipool& internal_pool, size_t max_size_)
+      : base(leaf_pool, internal_pool, max_size_)
+    {
+    }
+
+  private:
+
+    // Disable copy construction.
+    ibtree_multiset(const ibtree_multiset&);
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_BTREE_MULTISET) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~ibtree_multiset()
+    {
+    }
+#else
+  protected:
+    ~ibtree_multiset()
+    {
+    }
+#endif
+  };
+
+  //*************************************************************************
+  /// A templated btree_multiset implementation that uses a fixed size buffer.
+  ///\ingroup btree_multiset
+  //*************************************************************************
+  template <typename TKey, const size_t MAX_SIZE_, typename TCompare = std::less<TKey> >
+  class btree_multiset : public etl::ibtree_multiset<TKey, TCompare>
+  {
+  private:
+
+    typedef etl::ibtree_multiset<TKey, TCompare> base;
+
+  public:
+
+    static const size_t MAX_SIZE = MAX_SIZE_;
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    btree_multiset()
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+      this->initialise();
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    btree_multiset(const btree_multiset& other)
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+      this->assign(other.cbegin(), other.cend());
+    }
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    btree_multiset(TIterator first, TIterator last)
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+      this->assign(first, last);
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Constructor, from an initializer_list.
+    //*************************************************************************
+    btree_multiset(std::initializer_list<typename base::value_type> init)
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+      this->assign(init.begin(), init.end());
+    }
+#endif
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~btree_multiset()
+    {
+      this->initialise();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    btree_multiset& operator = (const btree_multiset& rhs)
+    {
+      if (this != &rhs)
+      {
+        this->assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+  private:
+
+    /// The pools of nodes used for the btree_multiset.
+    etl::pool<typename base::leaf_t,     base::template node_count<MAX_SIZE_>::LEAVES>    leaf_pool;
+    etl::pool<typename base::internal_t, base::template node_count<MAX_SIZE_>::INTERNALS> internal_pool;
+  };
+}
+
+//***************************************************************************
+/// Equal operator.
+///\param lhs Reference to the first btree_multiset.
+///\param rhs Reference to the second btree_multiset.
+///\return <b>true</b> if the btree_multisets are equal, otherwise <b>false</b>
+///\ingroup btree_multiset
+//***************************************************************************
+template <typename TKey, typename TKeyCompare>
+bool operator ==(const etl::ibtree_multiset<TKey, TKeyCompare>& lhs, const etl::ibtree_multiset<TKey, TKeyCompare>& rhs)
+{
+  return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+//***************************************************************************
+/// Not equal operator.
+///\param lhs Reference to the first btree_multiset.
+///\param rhs Reference to the second btree_multiset.
+///\return <b>true</b> if the btree_multisets are not equal, otherwise <b>false</b>
+///\ingroup btree_multiset
+//***************************************************************************
+template <typename TKey, typename TKeyCompare>
+bool operator !=(const etl::ibtree_multiset<TKey, TKeyCompare>& lhs, const etl::ibtree_multiset<TKey, TKeyCompare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+//*************************************************************************
+/// Less than operator.
+///\param lhs Reference to the first btree_multiset.
+///\param rhs Reference to the second btree_multiset.
+///\return <b>true</b> if the first btree_multiset is lexicographically less than the
+/// second, otherwise <b>false</b>.
+//*************************************************************************
+template <typename TKey, typename TKeyCompare>
+bool operator <(const etl::ibtree_multiset<TKey, TKeyCompare>& lhs, const etl::ibtree_multiset<TKey, TKeyCompare>& rhs)
+{
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+//*************************************************************************
+/// Greater than operator.
+///\param lhs Reference to the first btree_multiset.
+///\param rhs Reference to the second btree_multiset.
+///\return <b>true</b> if the first btree_multiset is lexicographically greater than the
+/// second, otherwise <b>false</b>.
+//*************************************************************************
+template <typename TKey, typename TKeyCompare>
+bool operator >(const etl::ibtree_multiset<TKey, TKeyCompare>& lhs, const etl::ibtree_multiset<TKey, TKeyCompare>& rhs)
+{
+  return (rhs < lhs);
+}
+
+//*************************************************************************
+/// Less than or equal operator.
+///\param lhs Reference to the first btree_multiset.
+///\param rhs Reference to the second btree_multiset.
+///\return <b>true</b> if the first btree_multiset is lexicographically less than or equal
+/// to the second, otherwise <b>false</b>.
+//*************************************************************************
+template <typename TKey, typename TKeyCompare>
+bool operator <=(const etl::ibtree_multiset<TKey, TKeyCompare>& lhs, const etl::ibtree_multiset<TKey, TKeyCompare>& rhs)
+{
+  return !(lhs > rhs);
+}
+
+//*************************************************************************
+/// Greater than or equal operator.
+///\param lhs Reference to the first btree_multiset.
+///\param rhs Reference to the second btree_multiset.
+///\return <b>true</b> if the first btree_multiset is lexicographically greater than or
+/// equal to the second, otherwise <b>false</b>.
+//*************************************************************************
+template <typename TKey, typename TKeyCompare>
+bool operator >=(const etl::ibtree_multiset<TKey, TKeyCompare>& lhs, const etl::ibtree_multiset<TKey, TKeyCompare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+#undef ETL_FILE
+
+#endif
@@ -94,6 +94,56 @@ struct ecl_timer_config
   uint_least8_t     previous;
   uint_least8_t     next;
   char              repeating;
+  ecl_timer_time_t  expiry;
+  uint_least8_t     slot;
+};
+
+//*************************************************************************
+/// The dimensions of the timing wheel of a timer context.
+/// Eight levels of sixteen slots cover the full 32 bit time range.
+//*************************************************************************
+#define ECL_TIMER_WHEEL_LEVEL_BITS 4
+#define ECL_TIMER_WHEEL_SLOTS      (1 << ECL_TIMER_WHEEL_LEVEL_BITS)
+#define ECL_TIMER_WHEEL_LEVELS     (32 / ECL_TIMER_WHEEL_LEVEL_BITS)
+
+// Timer wheel slots.
+enum
+{
+  ECL_TIMER_NO_SLOT = 255
+};
+
+//*************************************************************************
+/// Optional locking of a timer context.
+/// Define ECL_TIMER_CONTEXT_LOCK_TYPE in ecl_user.h to give each context a
+/// lock, along with ECL_TIMER_CONTEXT_LOCK_INIT(lock),
+/// ECL_TIMER_CONTEXT_LOCK(lock) and ECL_TIMER_CONTEXT_UNLOCK(lock).
+/// The lock is not held while a callback is called, so callbacks may
+/// start and stop timers.
+//*************************************************************************
+#if defined(ECL_TIMER_CONTEXT_LOCK_TYPE)
+  #if !defined(ECL_TIMER_CONTEXT_LOCK_INIT) || !defined(ECL_TIMER_CONTEXT_LOCK) || !defined(ECL_TIMER_CONTEXT_UNLOCK)
+    #error ECL_TIMER_CONTEXT_LOCK_INIT, ECL_TIMER_CONTEXT_LOCK and/or ECL_TIMER_CONTEXT_UNLOCK not defined
+  #endif
+#endif
+
+//*************************************************************************
+/// A timer context.
+/// Holds an independent set of timers in a hierarchical timing wheel, so
+/// starting, stopping and expiring a timer are O(1).
+//*************************************************************************
+struct ecl_timer_context
+{
+  struct ecl_timer_config*    ptimers;
+  uint_least8_t               max_timers;
+  volatile ecl_timer_enable_t enabled;
+  volatile uint_least8_t      registered_timers;
+  uint_least8_t               active_timers;
+  ecl_timer_time_t            time;
+  ecl_timer_id_t              heads[ECL_TIMER_WHEEL_LEVELS * ECL_TIMER_WHEEL_SLOTS];
+  uint16_t                    occupied[ECL_TIMER_WHEEL_LEVELS];
+#if defined(ECL_TIMER_CONTEXT_LOCK_TYPE)
+  ECL_TIMER_CONTEXT_LOCK_TYPE lock;
+#endif
 };
 
 //*************************************************************************
@@ -115,4 +165,20 @@ ecl_timer_result_t ecl_timer_stop(ecl_timer_id_t id_);
 ecl_timer_result_t ecl_timer_set_period(ecl_timer_id_t id_, ecl_timer_time_t period_);
 ecl_timer_result_t ecl_timer_set_mode(ecl_timer_id_t id_, ecl_timer_mode_t repeating_);
 
+//*************************************************************************
+/// The timer context API.
+//*************************************************************************
+void ecl_timer_context_init(struct ecl_timer_context* pcontext_, struct ecl_timer_config* ptimers_, uint_least8_t max_timers_);
+ecl_timer_id_t ecl_timer_context_register(struct ecl_timer_context* pcontext_, void(*pcallback_)(), ecl_timer_time_t period_, ecl_timer_mode_t repeating_);
+ecl_timer_result_t ecl_timer_context_unregister(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_);
+void ecl_timer_context_enable(struct ecl_timer_context* pcontext_, ecl_timer_enable_t state_);
+ecl_timer_result_t ecl_timer_context_is_running(struct ecl_timer_context* pcontext_);
+void ecl_timer_context_clear(struct ecl_timer_context* pcontext_);
+ecl_timer_result_t ecl_timer_context_tick(struct ecl_timer_context* pcontext_, uint32_t count);
+ecl_timer_time_t ecl_timer_context_time_to_next_expiry(struct ecl_timer_context* pcontext_);
+ecl_timer_result_t ecl_timer_context_start(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_, ecl_timer_start_t immediate_);
+ecl_timer_result_t ecl_timer_context_stop(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_);
+ecl_timer_result_t ecl_timer_context_set_period(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_, ecl_timer_time_t period_);
+ecl_timer_result_t ecl_timer_context_set_mode(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_, ecl_timer_mode_t repeating_);
+
 #endif
@@ -40,6 +40,10 @@ SOFTWARE.
 #include "timer.h"
 #include "atomic.h"
 
+#if ETL_HAS_ATOMIC
+  #include "queue_mpmc_atomic.h"
+#endif
+
 #undef ETL_FILE
 #define ETL_FILE "43"
 
@@ -154,6 +158,41 @@ namespace etl
     callback_timer_data& operator =(const callback_timer_data& other);
   };
 
+  //*************************************************************************
+  /// A command posted to a callback timer from another thread.
+  //*************************************************************************
+  struct callback_timer_command
+  {
+    enum
+    {
+      START,      ///< Start the timer. 'value' is non-zero to start immediately.
+      STOP,       ///< Stop the timer.
+      SET_PERIOD, ///< Stop the timer and set its period to 'value'.
+      SET_MODE,   ///< Stop the timer and set its mode. 'value' is non-zero for repeating.
+      REARM       ///< Set the timer's period to 'value' and restart it.
+    };
+
+    //*******************************************
+    callback_timer_command()
+      : command(STOP),
+        id(etl::timer::id::NO_TIMER),
+        value(0)
+    {
+    }
+
+    //*******************************************
+    callback_timer_command(uint_least8_t command_, etl::timer::id::type id_, uint32_t value_)
+      : command(command_),
+        id(id_),
+        value(value_)
+    {
+    }
+
+    uint_least8_t        command;
+    etl::timer::id::type id;
+    uint32_t             value;
+  };
+
   namespace private_callback_timer
   {
     //*************************************************************************
@@ -287,6 +326,12 @@ namespace etl
         return ptimers[head];
       }
 
+      //*******************************
+      const etl::callback_timer_data& front() const
+      {
+        return ptimers[head];
+      }
+
       //*******************************
       etl::timer::id::type begin()
       {
@@ -462,6 +507,13 @@ namespace etl
       active_list.clear();
       ETL_ENABLE_TIMER_UPDATES;
 
+#if ETL_HAS_ATOMIC
+      if (p_command_queue != nullptr)
+      {
+        p_command_queue->clear();
+      }
+#endif
+
       for (int i = 0; i < MAX_TIMERS; ++i)
       {
         new (&timer_array[i]) callback_timer_data();
@@ -482,6 +534,15 @@ namespace etl
       {
         if (ETL_TIMER_UPDATES_ENABLED)
         {
+#if ETL_HAS_ATOMIC
+          if (p_command_queue != nullptr)
+          {
+            process_commands(count);
+          }
+#endif
+
+          elapsed_time += count;
+
           // We have something to do?
           bool has_active = !active_list.empty();
 
@@ -534,39 +595,46 @@ namespace etl
     }
 
     //*******************************************
-    /// Starts a timer.
+    /// Processes the timers up to the time 'now', in ticks.
+    /// For tickless operation, where 'now' is read from a monotonic clock
+    /// rather than counted by a periodic tick.
+    /// The time is counted from construction, and may wrap.
+    /// Returns true if the time was processed,
+    /// false if not.
     //*******************************************
-    bool start(etl::timer::id::type id_, bool immediate_ = false)
+    bool advance_to(uint32_t now)
     {
-      bool result = false;
-
-      // Valid timer id?
-      if (id_ != etl::timer::id::NO_TIMER)
-      {
-        etl::callback_timer_data& timer = timer_array[id_];
-
-        // Registered timer?
-        if (timer.id != etl::timer::id::NO_TIMER)
-        {         
-          // Has a valid period.
-          if (timer.period != etl::timer::state::INACTIVE)
-          {
-            ETL_DISABLE_TIMER_UPDATES;
-            if (timer.is_active())
-            {
-              active_list.remove(timer.id, false);
-            }
+      return tick(now - elapsed_time);
+    }
 
-            timer.delta = immediate_ ? 0 : timer.period;
-            active_list.insert(timer.id);
-            ETL_ENABLE_TIMER_UPDATES;
+    //*******************************************
+    /// The time of the last processed tick.
+    //*******************************************
+    uint32_t time() const
+    {
+      return elapsed_time;
+    }
 
-            result = true;
-          }                
-        }
+    //*******************************************
+    /// The number of ticks until the next timer expires,
+    /// or etl::timer::state::INACTIVE if there are no active timers.
+    //*******************************************
+    uint32_t time_to_next_expiry() const
+    {
+      if (active_list.empty())
+      {
+        return etl::timer::state::INACTIVE;
       }
 
-      return result;
+      return active_list.front().delta;
+    }
+
+    //*******************************************
+    /// Starts a timer.
+    //*******************************************
+    bool start(etl::timer::id::type id_, bool immediate_ = false)
+    {
+      return start_timer(id_, immediate_, 0);
     }
 
     //*******************************************
@@ -626,12 +694,68 @@ namespace etl
       return false;
     }
 
+#if ETL_HAS_ATOMIC
+    //*******************************************
+    /// Posts a command to start a timer.
+    /// The post functions may be called from any thread. The commands are
+    /// applied, in the order that they were posted, by the next processed tick
+    /// before any timers expire. A started timer counts its period from that tick.
+    /// Returns false if the timer has no command queue or the queue is full.
+    //*******************************************
+    bool post_start(etl::timer::id::type id_, bool immediate_ = false)
+    {
+      return post(etl::callback_timer_command(etl::callback_timer_command::START, id_, immediate_ ? 1U : 0U));
+    }
+
+    //*******************************************
+    /// Posts a command to stop a timer.
+    //*******************************************
+    bool post_stop(etl::timer::id::type id_)
+    {
+      return post(etl::callback_timer_command(etl::callback_timer_command::STOP, id_, 0U));
+    }
+
+    //*******************************************
+    /// Posts a command to set a timer's period.
+    //*******************************************
+    bool post_set_period(etl::timer::id::type id_, uint32_t period_)
+    {
+      return post(etl::callback_timer_command(etl::callback_timer_command::SET_PERIOD, id_, period_));
+    }
+
+    //*******************************************
+    /// Posts a command to set a timer's mode.
+    //*******************************************
+    bool post_set_mode(etl::timer::id::type id_, bool repeating_)
+    {
+      return post(etl::callback_timer_command(etl::callback_timer_command::SET_MODE, id_, repeating_ ? 1U : 0U));
+    }
+
+    //*******************************************
+    /// Posts a command to set a timer's period and restart it.
+    /// For arming a timeout in one command.
+    //*******************************************
+    bool post_rearm(etl::timer::id::type id_, uint32_t period_)
+    {
+      return post(etl::callback_timer_command(etl::callback_timer_command::REARM, id_, period_));
+    }
+#endif
+
   protected:
 
+#if ETL_HAS_ATOMIC
+    typedef etl::iqueue_mpmc_atomic<etl::callback_timer_command> command_queue_t;
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    icallback_timer(callback_timer_data* const timer_array_, const uint_least8_t  MAX_TIMERS_, command_queue_t* p_command_queue_ = nullptr)
+#else
     //*******************************************
     /// Constructor.
     //*******************************************
     icallback_timer(callback_timer_data* const timer_array_, const uint_least8_t  MAX_TIMERS_)
+#endif
       : timer_array(timer_array_),
         active_list(timer_array_),
         enabled(false),
@@ -639,12 +763,132 @@ namespace etl
         process_semaphore(0),
 #endif
         registered_timers(0),
+        elapsed_time(0),
+#if ETL_HAS_ATOMIC
+        p_command_queue(p_command_queue_),
+#endif
         MAX_TIMERS(MAX_TIMERS_)
     {
     }
 
   private:
 
+    //*******************************************
+    /// Starts a timer.
+    /// 'offset' is added to the delta, for a timer started before the
+    /// ticks that are about to be processed.
+    //*******************************************
+    bool start_timer(etl::timer::id::type id_, bool immediate_, uint32_t offset)
+    {
+      bool result = false;
+
+      // Valid timer id?
+      if (id_ != etl::timer::id::NO_TIMER)
+      {
+        etl::callback_timer_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::id::NO_TIMER)
+        {         
+          // Has a valid period.
+          if (timer.period != etl::timer::state::INACTIVE)
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            if (timer.is_active())
+            {
+              active_list.remove(timer.id, false);
+            }
+
+            timer.delta = immediate_ ? 0 : timer.period;
+
+            if (offset > (etl::timer::state::INACTIVE - 1U - timer.delta))
+            {
+              timer.delta = etl::timer::state::INACTIVE - 1U;
+            }
+            else
+            {
+              timer.delta += offset;
+            }
+
+            active_list.insert(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+
+            result = true;
+          }                
+        }
+      }
+
+      return result;
+    }
+
+#if ETL_HAS_ATOMIC
+    //*******************************************
+    /// Pushes a command on to the command queue.
+    //*******************************************
+    bool post(const etl::callback_timer_command& command)
+    {
+      if ((p_command_queue == nullptr) || (command.id >= MAX_TIMERS))
+      {
+        return false;
+      }
+
+      return p_command_queue->push(command);
+    }
+
+    //*******************************************
+    /// Applies the posted commands.
+    /// 'count' is the number of ticks about to be processed.
+    //*******************************************
+    void process_commands(uint32_t count)
+    {
+      etl::callback_timer_command command;
+
+      while (p_command_queue->pop(command))
+      {
+        switch (command.command)
+        {
+          case etl::callback_timer_command::START:
+          {
+            start_timer(command.id, command.value != 0U, count);
+            break;
+          }
+
+          case etl::callback_timer_command::STOP:
+          {
+            stop(command.id);
+            break;
+          }
+
+          case etl::callback_timer_command::SET_PERIOD:
+          {
+            set_period(command.id, command.value);
+            break;
+          }
+
+          case etl::callback_timer_command::SET_MODE:
+          {
+            set_mode(command.id, command.value != 0U);
+            break;
+          }
+
+          case etl::callback_timer_command::REARM:
+          {
+            if (set_period(command.id, command.value))
+            {
+              start_timer(command.id, false, count);
+            }
+            break;
+          }
+
+          default:
+          {
+            break;
+          }
+        }
+      }
+    }
+#endif
+
     // The array of timer data structures.
     callback_timer_data* const timer_array;
 
@@ -656,21 +900,79 @@ namespace etl
     volatile etl::timer_semaphore_t process_semaphore;
 #endif
     volatile uint_least8_t registered_timers;
+    uint32_t elapsed_time;
+
+#if ETL_HAS_ATOMIC
+    // The queue of commands posted from other threads, if any.
+    command_queue_t* const p_command_queue;
+#endif
 
   public:
 
     const uint_least8_t MAX_TIMERS;
   };
 
+#if ETL_HAS_ATOMIC
   //***************************************************************************
   /// The callback timer
+  /// If COMMAND_QUEUE_SIZE_ is not zero then the timer has a lock free queue
+  /// of that size for commands posted from other threads.
+  //***************************************************************************
+  template <const uint_least8_t MAX_TIMERS_, const size_t COMMAND_QUEUE_SIZE_ = 0U>
+  class callback_timer : public etl::icallback_timer
+  {
+  public:
+
+    ETL_STATIC_ASSERT(MAX_TIMERS_ <= 254, "No more than 254 timers are allowed");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    callback_timer()
+      : icallback_timer(timer_array, MAX_TIMERS_, &command_queue)
+    {
+    }
+
+  private:
+
+    callback_timer_data timer_array[MAX_TIMERS_];
+    etl::queue_mpmc_atomic<etl::callback_timer_command, COMMAND_QUEUE_SIZE_> command_queue;
+  };
+
+  //***************************************************************************
+  /// The callback timer without a command queue.
   //***************************************************************************
   template <const uint_least8_t MAX_TIMERS_>
+  class callback_timer<MAX_TIMERS_, 0U> : public etl::icallback_timer
+  {
+  public:
+
+    ETL_STATIC_ASSERT(MAX_TIMERS_ <= 254, "No more than 254 timers are allowed");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    callback_timer()
+      : icallback_timer(timer_array, MAX_TIMERS_)
+    {
+    }
+
+  private:
+
+    callback_timer_data timer_array[MAX_TIMERS_];
+  };
+#else
+  //***************************************************************************
+  /// The callback timer
+  /// A command queue needs etl::atomic, so COMMAND_QUEUE_SIZE_ must be zero.
+  //***************************************************************************
+  template <const uint_least8_t MAX_TIMERS_, const size_t COMMAND_QUEUE_SIZE_ = 0U>
   class callback_timer : public etl::icallback_timer
   {
   public:
 
     ETL_STATIC_ASSERT(MAX_TIMERS_ <= 254, "No more than 254 timers are allowed");
+    ETL_STATIC_ASSERT(COMMAND_QUEUE_SIZE_ == 0U, "A command queue needs etl::atomic");
 
     //*******************************************
     /// Constructor.
@@ -684,6 +986,7 @@ namespace etl
 
     callback_timer_data timer_array[MAX_TIMERS_];
   };
+#endif
 }
 
 #undef ETL_DISABLE_TIMER_UPDATES
@@ -0,0 +1,841 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_CALLBACK_TIMER_WHEEL_INCLUDED
+#define ETL_CALLBACK_TIMER_WHEEL_INCLUDED
+
+#include <stdint.h>
+#include <new>
+
+#include "platform.h"
+#include "nullptr.h"
+#include "function.h"
+#include "static_assert.h"
+#include "binary.h"
+#include "timer.h"
+#include "atomic.h"
+
+#undef ETL_FILE
+#define ETL_FILE "62"
+
+#if !defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK) && !defined(ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK)
+  #error ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK or ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK not defined
+#endif
+
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK) && defined(ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK)
+  #error Only define one of ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK or ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK
+#endif
+
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+  #define ETL_DISABLE_TIMER_UPDATES (++process_semaphore)
+  #define ETL_ENABLE_TIMER_UPDATES  (--process_semaphore)
+  #define ETL_TIMER_UPDATES_ENABLED (process_semaphore.load() == 0)
+#endif
+
+#if defined(ETL_CALLBACK_TIMER_USE_INTERRUPT_LOCK)
+  #if !defined(ETL_CALLBACK_TIMER_DISABLE_INTERRUPTS) || !defined(ETL_CALLBACK_TIMER_ENABLE_INTERRUPTS)
+    #error ETL_CALLBACK_TIMER_DISABLE_INTERRUPTS and/or ETL_CALLBACK_TIMER_ENABLE_INTERRUPTS not defined
+  #endif
+
+  #define ETL_DISABLE_TIMER_UPDATES (ETL_CALLBACK_TIMER_DISABLE_INTERRUPTS)
+  #define ETL_ENABLE_TIMER_UPDATES  (ETL_CALLBACK_TIMER_ENABLE_INTERRUPTS)
+  #define ETL_TIMER_UPDATES_ENABLED true
+#endif
+
+namespace etl
+{
+  //*************************************************************************
+  /// The configuration of a timer in a timing wheel.
+  struct callback_timer_wheel_data
+  {
+    enum
+    {
+      NO_SLOT = 255
+    };
+
+    //*******************************************
+    callback_timer_wheel_data()
+      : p_callback(nullptr),
+        period(0),
+        expiry(0),
+        id(etl::timer::id::NO_TIMER),
+        previous(etl::timer::id::NO_TIMER),
+        next(etl::timer::id::NO_TIMER),
+        slot(NO_SLOT),
+        repeating(true),
+        has_c_callback(true)
+    {
+    }
+
+    //*******************************************
+    /// C function callback
+    //*******************************************
+    callback_timer_wheel_data(etl::timer::id::type id_,
+                              void                 (*p_callback_)(),
+                              uint32_t             period_,
+                              bool                 repeating_)
+      : p_callback(reinterpret_cast<void*>(p_callback_)),
+        period(period_),
+        expiry(0),
+        id(id_),
+        previous(etl::timer::id::NO_TIMER),
+        next(etl::timer::id::NO_TIMER),
+        slot(NO_SLOT),
+        repeating(repeating_),
+        has_c_callback(true)
+    {
+    }
+
+    //*******************************************
+    /// ETL function callback
+    //*******************************************
+    callback_timer_wheel_data(etl::timer::id::type  id_,
+                              etl::ifunction<void>& callback_,
+                              uint32_t              period_,
+                              bool                  repeating_)
+      : p_callback(reinterpret_cast<void*>(&callback_)),
+        period(period_),
+        expiry(0),
+        id(id_),
+        previous(etl::timer::id::NO_TIMER),
+        next(etl::timer::id::NO_TIMER),
+        slot(NO_SLOT),
+        repeating(repeating_),
+        has_c_callback(false)
+    {
+    }
+
+    //*******************************************
+    /// Returns true if the timer is active.
+    //*******************************************
+    bool is_active() const
+    {
+      return slot != NO_SLOT;
+    }
+
+    void*                 p_callback;
+    uint32_t              period;
+    uint32_t              expiry;
+    etl::timer::id::type  id;
+    uint_least8_t         previous;
+    uint_least8_t         next;
+    uint_least8_t         slot;
+    bool                  repeating;
+    bool                  has_c_callback;
+
+  private:
+
+    // Disabled.
+    callback_timer_wheel_data(const callback_timer_wheel_data& other);
+    callback_timer_wheel_data& operator =(const callback_timer_wheel_data& other);
+  };
+
+  namespace private_callback_timer_wheel
+  {
+    //*************************************************************************
+    /// A hierarchical timing wheel of timer data.
+    /// Eight levels of sixteen slots cover the full 32 bit time range.
+    /// A timer is placed at the level of the highest four bits in which its
+    /// expiry time differs from the current time, and moves down a level
+    /// each time the current time enters its slot.
+    /// Each slot is a circular, doubly linked list in insertion order.
+    //*************************************************************************
+    class wheel
+    {
+    public:
+
+      enum
+      {
+        LEVEL_BITS = 4,
+        SLOTS      = 1 << LEVEL_BITS,
+        SLOT_MASK  = SLOTS - 1,
+        LEVELS     = 32 / LEVEL_BITS
+      };
+
+      //*******************************
+      wheel(etl::callback_timer_wheel_data* ptimers_)
+        : current_time(0),
+          n_active(0),
+          ptimers(ptimers_)
+      {
+        clear();
+      }
+
+      //*******************************
+      bool empty() const
+      {
+        return n_active == 0;
+      }
+
+      //*******************************
+      /// The current time of the wheel.
+      //*******************************
+      uint32_t time() const
+      {
+        return current_time;
+      }
+
+      //*******************************
+      /// Inserts the timer at its 'expiry' time.
+      //*******************************
+      void insert(etl::timer::id::type id_)
+      {
+        etl::callback_timer_wheel_data& timer = ptimers[id_];
+
+        uint32_t      difference = timer.expiry ^ current_time;
+        uint_least8_t level      = 0;
+
+        while ((difference >>= LEVEL_BITS) != 0)
+        {
+          ++level;
+        }
+
+        const uint_least8_t index = uint_least8_t((level * SLOTS) + ((timer.expiry >> (level * LEVEL_BITS)) & SLOT_MASK));
+
+        etl::timer::id::type& head = heads[index];
+
+        if (head == etl::timer::id::NO_TIMER)
+        {
+          head           = id_;
+          timer.previous = id_;
+          timer.next     = id_;
+
+          occupied[level] |= uint16_t(1U << (index & SLOT_MASK));
+        }
+        else
+        {
+          // Add at the tail.
+          etl::callback_timer_wheel_data& first = ptimers[head];
+
+          timer.previous = first.previous;
+          timer.next     = head;
+          ptimers[first.previous].next = id_;
+          first.previous               = id_;
+        }
+
+        timer.slot = index;
+        ++n_active;
+      }
+
+      //*******************************
+      void remove(etl::timer::id::type id_)
+      {
+        etl::callback_timer_wheel_data& timer = ptimers[id_];
+
+        const uint_least8_t index = timer.slot;
+
+        etl::timer::id::type& head = heads[index];
+
+        if (timer.next == id_)
+        {
+          // The only timer in the slot.
+          head = etl::timer::id::NO_TIMER;
+
+          occupied[index / SLOTS] &= uint16_t(~(1U << (index & SLOT_MASK)));
+        }
+        else
+        {
+          ptimers[timer.previous].next = timer.next;
+          ptimers[timer.next].previous = timer.previous;
+
+          if (head == id_)
+          {
+            head = timer.next;
+          }
+        }
+
+        timer.previous = etl::timer::id::NO_TIMER;
+        timer.next     = etl::timer::id::NO_TIMER;
+        timer.slot     = etl::callback_timer_wheel_data::NO_SLOT;
+        --n_active;
+      }
+
+      //*******************************
+      /// The first timer in the current slot, or NO_TIMER.
+      /// Its expiry time is normally the current time.
+      //*******************************
+      etl::timer::id::type due() const
+      {
+        return heads[current_time & SLOT_MASK];
+      }
+
+      //*******************************
+      /// The number of ticks until the current time next enters an occupied
+      /// slot at any level, or UINT32_MAX if there are no timers.
+      //*******************************
+      uint32_t ticks_to_next_slot() const
+      {
+        uint64_t ticks = UINT32_MAX;
+
+        for (uint_least8_t level = 0; level < LEVELS; ++level)
+        {
+          if (occupied[level] != 0)
+          {
+            const uint_least8_t shift    = uint_least8_t(level * LEVEL_BITS);
+            const uint32_t      position = (current_time >> shift) & SLOT_MASK;
+
+            // Rotate so that the slot after the current one is bit 0.
+            const uint32_t rotated = ((uint32_t(occupied[level]) >> (position + 1U)) |
+                                      (uint32_t(occupied[level]) << (SLOT_MASK - position))) & 0xFFFFU;
+
+            const uint64_t slots  = uint64_t(etl::count_trailing_zeros(rotated)) + 1U;
+            const uint64_t offset = current_time & ((uint64_t(1U) << shift) - 1U);
+            const uint64_t level_ticks = (slots << shift) - offset;
+
+            if (level_ticks < ticks)
+            {
+              ticks = level_ticks;
+            }
+          }
+        }
+
+        return uint32_t(ticks);
+      }
+
+      //*******************************
+      /// The number of ticks until the earliest expiry time,
+      /// or etl::timer::state::INACTIVE if there are no timers.
+      /// A timer whose expiry has wrapped past zero may sit in a nearer slot,
+      /// or a lower level, than an earlier one, so every occupied slot is
+      /// searched.
+      //*******************************
+      uint32_t ticks_to_next_expiry() const
+      {
+        uint32_t ticks = etl::timer::state::INACTIVE;
+
+        for (uint_least8_t level = 0; level < LEVELS; ++level)
+        {
+          uint32_t slots = occupied[level];
+
+          while (slots != 0)
+          {
+            const uint32_t index = (level * SLOTS) + etl::count_trailing_zeros(slots);
+
+            // Clear the lowest set bit.
+            slots &= (slots - 1U);
+
+            etl::timer::id::type id = heads[index];
+
+            do
+            {
+              const etl::callback_timer_wheel_data& timer = ptimers[id];
+
+              if (uint32_t(timer.expiry - current_time) < ticks)
+              {
+                ticks = timer.expiry - current_time;
+              }
+
+              id = timer.next;
+            } while (id != heads[index]);
+          }
+        }
+
+        return ticks;
+      }
+
+      //*******************************
+      /// Advances the current time.
+      /// 'count' must not be more than ticks_to_next_slot().
+      /// Timers in higher level slots that the current time enters are moved down.
+      //*******************************
+      void advance(uint32_t count)
+      {
+        current_time += count;
+
+        if ((count != 0) && (n_active != 0))
+        {
+          for (uint_least8_t level = 1; level < LEVELS; ++level)
+          {
+            const uint_least8_t shift = uint_least8_t(level * LEVEL_BITS);
+
+            if ((current_time & ((uint32_t(1U) << shift) - 1U)) != 0)
+            {
+              break;
+            }
+
+            cascade(uint_least8_t((level * SLOTS) + ((current_time >> shift) & SLOT_MASK)));
+          }
+        }
+      }
+
+      //*******************************
+      void clear()
+      {
+        for (uint_least8_t i = 0; i < (LEVELS * SLOTS); ++i)
+        {
+          heads[i] = etl::timer::id::NO_TIMER;
+        }
+
+        for (uint_least8_t i = 0; i < LEVELS; ++i)
+        {
+          occupied[i] = 0;
+        }
+
+        n_active = 0;
+      }
+
+    private:
+
+      //*******************************
+      /// Reinserts the timers in a slot relative to the current time.
+      //*******************************
+      void cascade(uint_least8_t index)
+      {
+        etl::timer::id::type id = heads[index];
+
+        while (id != etl::timer::id::NO_TIMER)
+        {
+          remove(id);
+          insert(id);
+          id = heads[index];
+        }
+      }
+
+      uint32_t             current_time;
+      uint_least8_t        n_active;
+      etl::timer::id::type heads[LEVELS * SLOTS];
+      uint16_t             occupied[LEVELS];
+
+      etl::callback_timer_wheel_data* const ptimers;
+    };
+  }
+
+  //***************************************************************************
+  /// Interface for callback timer wheel.
+  /// Has the same interface as icallback_timer, but start, stop and the
+  /// expiry of each timer are O(1), rather than O(N) in active timers.
+  //***************************************************************************
+  class icallback_timer_wheel
+  {
+  public:
+
+    //*******************************************
+    /// Register a timer.
+    //*******************************************
+    etl::timer::id::type register_timer(void     (*p_callback_)(),
+                                        uint32_t period_,
+                                        bool     repeating_)
+    {
+      etl::timer::id::type id = etl::timer::id::NO_TIMER;
+
+      bool is_space = (registered_timers < MAX_TIMERS);
+
+      if (is_space)
+      {
+        // Search for the free space.
+        for (uint_least8_t i = 0; i < MAX_TIMERS; ++i)
+        {
+          etl::callback_timer_wheel_data& timer = timer_array[i];
+
+          if (timer.id == etl::timer::id::NO_TIMER)
+          {
+            // Create in-place.
+            new (&timer) callback_timer_wheel_data(i, p_callback_, period_, repeating_);
+            registered_timers = uint_least8_t(registered_timers + 1U);
+            id = i;
+            break;
+          }
+        }
+      }
+
+      return id;
+    }
+
+    //*******************************************
+    /// Register a timer.
+    //*******************************************
+    etl::timer::id::type register_timer(etl::ifunction<void>& callback_,
+                                        uint32_t              period_,
+                                        bool                  repeating_)
+    {
+      etl::timer::id::type id = etl::timer::id::NO_TIMER;
+
+      bool is_space = (registered_timers < MAX_TIMERS);
+
+      if (is_space)
+      {
+        // Search for the free space.
+        for (uint_least8_t i = 0; i < MAX_TIMERS; ++i)
+        {
+          etl::callback_timer_wheel_data& timer = timer_array[i];
+
+          if (timer.id == etl::timer::id::NO_TIMER)
+          {
+            // Create in-place.
+            new (&timer) callback_timer_wheel_data(i, callback_, period_, repeating_);
+            registered_timers = uint_least8_t(registered_timers + 1U);
+            id = i;
+            break;
+          }
+        }
+      }
+
+      return id;
+    }
+
+    //*******************************************
+    /// Unregister a timer.
+    //*******************************************
+    bool unregister_timer(etl::timer::id::type id_)
+    {
+      bool result = false;
+
+      if (id_ != etl::timer::id::NO_TIMER)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id_];
+
+        if (timer.id != etl::timer::id::NO_TIMER)
+        {
+          if (timer.is_active())
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            active_wheel.remove(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+          }
+
+          // Reset in-place.
+          new (&timer) callback_timer_wheel_data();
+          registered_timers = uint_least8_t(registered_timers - 1U);
+
+          result = true;
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Enable/disable the timer.
+    //*******************************************
+    void enable(bool state_)
+    {
+      enabled = state_;
+    }
+
+    //*******************************************
+    /// Get the enable/disable state.
+    //*******************************************
+    bool is_running() const
+    {
+      return enabled;
+    }
+
+    //*******************************************
+    /// Clears the timer of data.
+    //*******************************************
+    void clear()
+    {
+      ETL_DISABLE_TIMER_UPDATES;
+      active_wheel.clear();
+      ETL_ENABLE_TIMER_UPDATES;
+
+      for (int i = 0; i < MAX_TIMERS; ++i)
+      {
+        new (&timer_array[i]) callback_timer_wheel_data();
+      }
+
+      registered_timers = 0;
+    }
+
+    //*******************************************
+    // Called by the timer service to indicate the
+    // amount of time that has elapsed since the last successful call to 'tick'.
+    // Returns true if the tick was processed,
+    // false if not.
+    //*******************************************
+    bool tick(uint32_t count)
+    {
+      if (enabled)
+      {
+        if (ETL_TIMER_UPDATES_ENABLED)
+        {
+          // Timers started with no delay since the last tick.
+          process_due();
+
+          // Step from one occupied slot to the next.
+          while ((count != 0) && !active_wheel.empty())
+          {
+            uint32_t step = active_wheel.ticks_to_next_slot();
+
+            if (step > count)
+            {
+              step = count;
+            }
+
+            active_wheel.advance(step);
+            count -= step;
+
+            process_due();
+          }
+
+          // Nothing left to expire.
+          active_wheel.advance(count);
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Processes the timers up to the time 'now', in ticks.
+    /// For tickless operation, where 'now' is read from a monotonic clock
+    /// rather than counted by a periodic tick.
+    /// The time is counted from construction, and may wrap.
+    /// Returns true if the time was processed,
+    /// false if not.
+    //*******************************************
+    bool advance_to(uint32_t now)
+    {
+      return tick(now - active_wheel.time());
+    }
+
+    //*******************************************
+    /// The time of the last processed tick.
+    //*******************************************
+    uint32_t time() const
+    {
+      return active_wheel.time();
+    }
+
+    //*******************************************
+    /// The number of ticks until the next timer expires,
+    /// or etl::timer::state::INACTIVE if there are no active timers.
+    //*******************************************
+    uint32_t time_to_next_expiry() const
+    {
+      return active_wheel.ticks_to_next_expiry();
+    }
+
+    //*******************************************
+    /// Starts a timer.
+    //*******************************************
+    bool start(etl::timer::id::type id_, bool immediate_ = false)
+    {
+      bool result = false;
+
+      // Valid timer id?
+      if (id_ != etl::timer::id::NO_TIMER)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::id::NO_TIMER)
+        {
+          // Has a valid period.
+          if (timer.period != etl::timer::state::INACTIVE)
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            if (timer.is_active())
+            {
+              active_wheel.remove(timer.id);
+            }
+
+            timer.expiry = active_wheel.time() + (immediate_ ? 0 : timer.period);
+            active_wheel.insert(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+
+            result = true;
+          }
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Stops a timer.
+    //*******************************************
+    bool stop(etl::timer::id::type id_)
+    {
+      bool result = false;
+
+      // Valid timer id?
+      if (id_ != etl::timer::id::NO_TIMER)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::id::NO_TIMER)
+        {
+          if (timer.is_active())
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            active_wheel.remove(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+          }
+
+          result = true;
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Sets a timer's period.
+    //*******************************************
+    bool set_period(etl::timer::id::type id_, uint32_t period_)
+    {
+      if (stop(id_))
+      {
+        timer_array[id_].period = period_;
+        return true;
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Sets a timer's mode.
+    //*******************************************
+    bool set_mode(etl::timer::id::type id_, bool repeating_)
+    {
+      if (stop(id_))
+      {
+        timer_array[id_].repeating = repeating_;
+        return true;
+      }
+
+      return false;
+    }
+
+  protected:
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    icallback_timer_wheel(callback_timer_wheel_data* const timer_array_, const uint_least8_t  MAX_TIMERS_)
+      : timer_array(timer_array_),
+        active_wheel(timer_array_),
+        enabled(false),
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+        process_semaphore(0),
+#endif
+        registered_timers(0),
+        MAX_TIMERS(MAX_TIMERS_)
+    {
+    }
+
+  private:
+
+    //*******************************************
+    /// Calls the timers that expire at the current time.
+    //*******************************************
+    void process_due()
+    {
+      etl::timer::id::type id;
+
+      while ((id = active_wheel.due()) != etl::timer::id::NO_TIMER)
+      {
+        etl::callback_timer_wheel_data& timer = timer_array[id];
+
+        active_wheel.remove(id);
+
+        if (timer.expiry != active_wheel.time())
+        {
+          // Placed before a wrap of the time. Not due yet.
+          active_wheel.insert(id);
+          continue;
+        }
+
+        if (timer.repeating)
+        {
+          // Reinsert the timer.
+          timer.expiry = active_wheel.time() + timer.period;
+          active_wheel.insert(timer.id);
+        }
+
+        if (timer.p_callback != nullptr)
+        {
+          if (timer.has_c_callback)
+          {
+            // Call the C callback.
+            reinterpret_cast<void(*)()>(timer.p_callback)();
+          }
+          else
+          {
+            // Call the function wrapper callback.
+            (*reinterpret_cast<etl::ifunction<void>*>(timer.p_callback))();
+          }
+        }
+      }
+    }
+
+    // The array of timer data structures.
+    callback_timer_wheel_data* const timer_array;
+
+    // The wheel of active timers.
+    private_callback_timer_wheel::wheel active_wheel;
+
+    volatile bool enabled;
+#if defined(ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK)
+    volatile etl::timer_semaphore_t process_semaphore;
+#endif
+    volatile uint_least8_t registered_timers;
+
+  public:
+
+    const uint_least8_t MAX_TIMERS;
+  };
+
+  //***************************************************************************
+  /// The callback timer wheel
+  //***************************************************************************
+  template <const uint_least8_t MAX_TIMERS_>
+  class callback_timer_wheel : public etl::icallback_timer_wheel
+  {
+  public:
+
+    ETL_STATIC_ASSERT(MAX_TIMERS_ <= 254, "No more than 254 timers are allowed");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    callback_timer_wheel()
+      : icallback_timer_wheel(timer_array, MAX_TIMERS_)
+    {
+    }
+
+  private:
+
+    callback_timer_wheel_data timer_array[MAX_TIMERS_];
+  };
+}
+
+#undef ETL_DISABLE_TIMER_UPDATES
+#undef ETL_ENABLE_TIMER_UPDATES
+#undef ETL_TIMER_UPDATES_ENABLED
+
+#undef ETL_FILE
+
+#endif
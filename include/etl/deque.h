@@ -33,6 +33,7 @@ SOFTWARE.
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -43,6 +44,7 @@ SOFTWARE.
 #include "container.h"
 #include "alignment.h"
 #include "array.h"
+#include "array_view.h"
 #include "memory.h"
 #include "exception.h"
 #include "error_handler.h"
@@ -200,10 +202,75 @@ namespace etl
     deque_base(size_t max_size_, size_t buffer_size_)
       : current_size(0),
         CAPACITY(max_size_),
-        BUFFER_SIZE(buffer_size_)
+        BUFFER_SIZE(buffer_size_),
+        BUFFER_MASK(((buffer_size_ > 1) && ((buffer_size_ & (buffer_size_ - 1)) == 0)) ? buffer_size_ - 1 : 0)
     {
     }
 
+    //*************************************************************************
+    /// Gets the buffer index after 'index'.
+    //*************************************************************************
+    size_type next_index(size_type index) const
+    {
+      if (BUFFER_MASK != 0)
+      {
+        return (index + 1) & BUFFER_MASK;
+      }
+      else
+      {
+        return (index == BUFFER_SIZE - 1) ? 0 : index + 1;
+      }
+    }
+
+    //*************************************************************************
+    /// Gets the buffer index before 'index'.
+    //*************************************************************************
+    size_type previous_index(size_type index) const
+    {
+      if (BUFFER_MASK != 0)
+      {
+        return (index - 1) & BUFFER_MASK;
+      }
+      else
+      {
+        return (index == 0) ? BUFFER_SIZE - 1 : index - 1;
+      }
+    }
+
+    //*************************************************************************
+    /// Gets the buffer index 'n' after 'index'.
+    /// 'n' must be less than the buffer size.
+    //*************************************************************************
+    size_type add_index(size_type index, size_type n) const
+    {
+      index += n;
+
+      if (BUFFER_MASK != 0)
+      {
+        return index & BUFFER_MASK;
+      }
+      else
+      {
+        return (index >= BUFFER_SIZE) ? index - BUFFER_SIZE : index;
+      }
+    }
+
+    //*************************************************************************
+    /// Gets the buffer index 'n' before 'index'.
+    /// 'n' must be less than the buffer size.
+    //*************************************************************************
+    size_type subtract_index(size_type index, size_type n) const
+    {
+      if (BUFFER_MASK != 0)
+      {
+        return (index - n) & BUFFER_MASK;
+      }
+      else
+      {
+        return (index < n) ? index + BUFFER_SIZE - n : index - n;
+      }
+    }
+
     //*************************************************************************
     /// Destructor.
     //*************************************************************************
@@ -214,6 +281,7 @@ namespace etl
     size_type       current_size; ///< The current number of elements in the deque.
     const size_type CAPACITY;     ///< The maximum number of elements in the deque.
     const size_type BUFFER_SIZE;  ///< The number of elements in the buffer.
+    const size_type BUFFER_MASK;  ///< BUFFER_SIZE - 1 if BUFFER_SIZE is a power of two, otherwise 0.
     ETL_DECLARE_DEBUG_COUNT       ///< Internal debugging.
   };
 
@@ -276,7 +344,7 @@ namespace etl
       //***************************************************
       iterator& operator ++()
       {
-        index = (static_cast<size_t>(index) == p_deque->BUFFER_SIZE - 1) ? 0 : index + 1;
+        index = p_deque->next_index(index);
 
         return *this;
       }
@@ -285,7 +353,7 @@ namespace etl
       iterator operator ++(int)
       {
         iterator previous(*this);
-        index = (static_cast<size_t>(index) == p_deque->BUFFER_SIZE - 1) ? 0 : index + 1;
+        index = p_deque->next_index(index);
 
         return previous;
       }
@@ -295,8 +363,7 @@ namespace etl
       {
         if (offset > 0)
         {
-          index += offset;
-          index = (static_cast<size_t>(index) > p_deque->BUFFER_SIZE - 1) ? index - p_deque->BUFFER_SIZE : index;
+          index = p_deque->add_index(index, offset);
         }
         else if (offset < 0)
         {
@@ -311,8 +378,7 @@ namespace etl
       {
         if (offset > 0)
         {
-          index -= offset;
-          index = (index < 0) ? index + p_deque->BUFFER_SIZE : index;
+          index = p_deque->subtract_index(index, offset);
         }
         else if (offset < 0)
         {
@@ -325,7 +391,7 @@ namespace etl
       //***************************************************
       iterator& operator --()
       {
-        index = (index == 0) ? p_deque->BUFFER_SIZE - 1 : index - 1;
+        index = p_deque->previous_index(index);
 
         return *this;
       }
@@ -334,7 +400,7 @@ namespace etl
       iterator operator --(int)
       {
         iterator previous(*this);
-        index = (index == 0) ? p_deque->BUFFER_SIZE - 1 : index - 1;
+        index = p_deque->previous_index(index);
 
         return previous;
       }
@@ -470,7 +536,7 @@ namespace etl
       //***************************************************
       const_iterator& operator ++()
       {
-        index = (static_cast<size_t>(index) == p_deque->BUFFER_SIZE - 1) ? 0 : index + 1;
+        index = p_deque->next_index(index);
 
         return *this;
       }
@@ -479,7 +545,7 @@ namespace etl
       const_iterator operator ++(int)
       {
         const_iterator previous(*this);
-        index = (static_cast<size_t>(index) == p_deque->BUFFER_SIZE - 1) ? 0 : index + 1;
+        index = p_deque->next_index(index);
 
         return previous;
       }
@@ -489,8 +555,7 @@ namespace etl
       {
         if (offset > 0)
         {
-          index += offset;
-          index = (static_cast<size_t>(index) > p_deque->BUFFER_SIZE - 1) ? index - p_deque->BUFFER_SIZE : index;
+          index = p_deque->add_index(index, offset);
         }
         else if (offset < 0)
         {
@@ -505,8 +570,7 @@ namespace etl
       {
         if (offset > 0)
         {
-          index -= offset;
-          index = (index < 0) ? static_cast<size_t>(index) + p_deque->BUFFER_SIZE : index;
+          index = p_deque->subtract_index(index, offset);
         }
         else if (offset < 0)
         {
@@ -519,7 +583,7 @@ namespace etl
       //***************************************************
       const_iterator& operator --()
       {
-        index = (index == 0) ? p_deque->BUFFER_SIZE - 1 : index - 1;
+        index = p_deque->previous_index(index);
 
         return *this;
       }
@@ -528,7 +592,7 @@ namespace etl
       const_iterator operator --(int)
       {
         const_iterator previous(*this);
-        index = (index == 0) ? p_deque->BUFFER_SIZE - 1 : index - 1;
+        index = p_deque->previous_index(index);
 
         return previous;
       }
@@ -1875,6 +1939,80 @@ namespace etl
       destroy_element_front();
     }
 
+    //*************************************************************************
+    /// Adds a range of items to the back of the deque.
+    /// Trivially copyable items from a pointer range are copied with at most
+    /// two memcpy calls.
+    /// If asserts or exceptions are enabled, throws an etl::deque_full if there
+    /// is not enough room for all of the items.
+    ///\param range_begin The first item to push.
+    ///\param range_end   One past the last item to push.
+    //*************************************************************************
+    template <typename TIterator>
+    typename etl::enable_if<is_iterator<TIterator>::value, void>::type
+      push_back(TIterator range_begin, TIterator range_end)
+    {
+      const size_t n = std::distance(range_begin, range_end);
+
+      ETL_ASSERT(n <= available(), ETL_ERROR(deque_full));
+
+      push_back_range(range_begin, n, typename is_memcpy_range<TIterator>::type());
+    }
+
+    //*************************************************************************
+    /// Copies 'n' items from the front of the deque and removes them.
+    /// Trivially copyable items to a pointer are copied with at most two
+    /// memcpy calls.
+    /// If asserts or exceptions are enabled, throws an etl::deque_empty if the
+    /// deque holds fewer than 'n' items.
+    ///\param n      The number of items to pop.
+    ///\param output The destination for the items.
+    ///\return An iterator to one past the last item written to 'output'.
+    //*************************************************************************
+    template <typename TIterator>
+    TIterator pop_front(size_t n, TIterator output)
+    {
+      ETL_ASSERT(n <= size(), ETL_ERROR(deque_empty));
+
+      return pop_front_range(n, output, typename is_memcpy_range<TIterator>::type());
+    }
+
+    //*************************************************************************
+    /// Gets the first contiguous block of items, starting at the front.
+    /// array_one() followed by array_two() contains every item in order.
+    //*************************************************************************
+    etl::array_view<T> array_one()
+    {
+      return etl::array_view<T>(p_buffer + _begin.index, array_one_size());
+    }
+
+    //*************************************************************************
+    /// Gets the first contiguous block of items, starting at the front.
+    /// array_one() followed by array_two() contains every item in order.
+    //*************************************************************************
+    etl::array_view<const T> array_one() const
+    {
+      return etl::array_view<const T>(p_buffer + _begin.index, array_one_size());
+    }
+
+    //*************************************************************************
+    /// Gets the second contiguous block of items, at the start of the buffer.
+    /// Empty unless the items wrap around the end of the buffer.
+    //*************************************************************************
+    etl::array_view<T> array_two()
+    {
+      return etl::array_view<T>(p_buffer, current_size - array_one_size());
+    }
+
+    //*************************************************************************
+    /// Gets the second contiguous block of items, at the start of the buffer.
+    /// Empty unless the items wrap around the end of the buffer.
+    //*************************************************************************
+    etl::array_view<const T> array_two() const
+    {
+      return etl::array_view<const T>(p_buffer, current_size - array_one_size());
+    }
+
     //*************************************************************************
     /// Resizes the deque.
     /// If asserts or exceptions are enabled, throws an etl::deque_full is 'new_size' is too large.
@@ -2153,6 +2291,116 @@ namespace etl
       ETL_DECREMENT_DEBUG_COUNT
     }
 
+    //*************************************************************************
+    /// Ranges that may be copied with memcpy.
+    //*************************************************************************
+    template <typename TIterator>
+    struct is_memcpy_range
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type iterator_value_type;
+
+      typedef etl::integral_constant<bool, etl::is_pointer<TIterator>::value &&
+                                           etl::is_same<typename etl::remove_cv<iterator_value_type>::type, T>::value &&
+                                           etl::is_trivially_copy_constructible<T>::value &&
+                                           etl::is_trivially_destructible<T>::value> type;
+    };
+
+    //*************************************************************************
+    /// The number of items from the front to the end of the buffer, or to the
+    /// back if that is nearer.
+    //*************************************************************************
+    size_t array_one_size() const
+    {
+      const size_t to_buffer_end = BUFFER_SIZE - _begin.index;
+
+      return (current_size < to_buffer_end) ? current_size : to_buffer_end;
+    }
+
+    //*************************************************************************
+    /// Adds 'n' items to the back, with at most two memcpy calls.
+    //*************************************************************************
+    template <typename TIterator>
+    void push_back_range(TIterator from, size_t n, etl::true_type)
+    {
+      // memcpy must not be given a null pointer, even for no items.
+      if (n == 0)
+      {
+        return;
+      }
+
+      const size_t to_buffer_end = BUFFER_SIZE - _end.index;
+      const size_t first         = (n < to_buffer_end) ? n : to_buffer_end;
+
+      memcpy(p_buffer + _end.index, from, first * sizeof(T));
+
+      if (n > first)
+      {
+        memcpy(p_buffer, from + first, (n - first) * sizeof(T));
+      }
+
+      _end.index = add_index(_end.index, n);
+      current_size += n;
+      ETL_ADD_DEBUG_COUNT(n)
+    }
+
+    //*************************************************************************
+    /// Adds 'n' items to the back, one at a time.
+    //*************************************************************************
+    template <typename TIterator>
+    void push_back_range(TIterator from, size_t n, etl::false_type)
+    {
+      while (n-- != 0)
+      {
+        create_element_back(*from);
+        ++from;
+      }
+    }
+
+    //*************************************************************************
+    /// Removes 'n' items from the front, with at most two memcpy calls.
+    //*************************************************************************
+    template <typename TIterator>
+    TIterator pop_front_range(size_t n, TIterator to, etl::true_type)
+    {
+      // memcpy must not be given a null pointer, even for no items.
+      if (n == 0)
+      {
+        return to;
+      }
+
+      const size_t to_buffer_end = BUFFER_SIZE - _begin.index;
+      const size_t first         = (n < to_buffer_end) ? n : to_buffer_end;
+
+      memcpy(to, p_buffer + _begin.index, first * sizeof(T));
+
+      if (n > first)
+      {
+        memcpy(to + first, p_buffer, (n - first) * sizeof(T));
+      }
+
+      _begin.index = add_index(_begin.index, n);
+      current_size -= n;
+      ETL_SUBTRACT_DEBUG_COUNT(n)
+
+      return to + n;
+    }
+
+    //*************************************************************************
+    /// Removes 'n' items from the front, one at a time.
+    //*************************************************************************
+    template <typename TIterator>
+    TIterator pop_front_range(size_t n, TIterator to, etl::false_type)
+    {
+      while (n-- != 0)
+      {
+        *to = *_begin;
+        ++to;
+        destroy_element_front();
+      }
+
+      return to;
+    }
+
     //*************************************************************************
     /// Measures the distance between two iterators.
     //*************************************************************************
@@ -2173,16 +2421,8 @@ namespace etl
     {
       const difference_type index = other.get_index();
       const difference_type reference_index = other.get_deque()._begin.index;
-      const size_t buffer_size = other.get_deque().BUFFER_SIZE;
 
-      if (index < reference_index)
-      {
-        return buffer_size + index - reference_index;
-      }
-      else
-      {
-        return index - reference_index;
-      }
+      return other.get_deque().subtract_index(index, reference_index);
     }
 
     // Disable copy construction.
@@ -2207,6 +2447,8 @@ namespace etl
   //***************************************************************************
   /// A fixed capacity double ended queue.
   ///\note The deque allocates one more element than the specified maximum size.
+  /// If MAX_SIZE_ + 1 is a power of two, such as 255 or 1023, the indexes wrap
+  /// with a mask rather than a comparison.
   ///\tparam T         The type of items this deque holds.
   ///\tparam MAX_SIZE_ The capacity of the deque
   ///\ingroup deque
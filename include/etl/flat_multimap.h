@@ -68,6 +68,7 @@ namespace etl
 
     typedef etl::ireference_flat_multimap<TKey, TMapped, TKeyCompare> refmap_t;
     typedef typename refmap_t::lookup_t lookup_t;
+    typedef typename refmap_t::index_t index_t;
     typedef etl::ipool         storage_t;
 
   public:
@@ -240,11 +241,7 @@ namespace etl
 #endif
 
       clear();
-
-      while (first != last)
-      {
-        insert(*first++);
-      }
+      insert(first, last);
     }
 
     //*********************************************************************
@@ -281,6 +278,7 @@ namespace etl
 
     //*********************************************************************
     /// Inserts a range of values to the flat_multimap.
+    /// The values are appended, sorted and merged with the existing elements in one pass.
     /// If asserts or exceptions are enabled, emits flat_multimap_full if the flat_multimap does not have enough free space.
     ///\param position The position to insert at.
     ///\param first    The first element to add.
@@ -289,10 +287,20 @@ namespace etl
     template <class TIterator>
     void insert(TIterator first, TIterator last)
     {
+      size_type sorted_size = size();
+
       while (first != last)
       {
-        insert(*first++);
+        ETL_ASSERT(!full(), ETL_ERROR(flat_multimap_full));
+
+        value_type* pvalue = storage.allocate<value_type>();
+        ::new (pvalue) value_type(*first);
+        ETL_INCREMENT_DEBUG_COUNT
+        refmap_t::append(*pvalue);
+        ++first;
       }
+
+      refmap_t::merge_appended(sorted_size);
     }
 
     //*************************************************************************
@@ -651,13 +659,33 @@ namespace etl
       return refmap_t::available();
     }
 
+    //*********************************************************************
+    /// Builds the lookup index from the current contents.
+    /// Only containers declared with INDEXED_ = true have an index, otherwise does nothing.
+    /// Any insert or erase discards the index, and lookups fall back to the
+    /// binary search until it is rebuilt.
+    //*********************************************************************
+    void rebuild_index()
+    {
+      refmap_t::rebuild_index();
+    }
+
+    //*********************************************************************
+    /// Checks whether lookups are using the index.
+    ///\return <b>true</b> if the index is up to date with the contents.
+    //*********************************************************************
+    bool is_index_valid() const
+    {
+      return refmap_t::is_index_valid();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
     //*********************************************************************
-    iflat_multimap(lookup_t& lookup_, storage_t& storage_)
-      : refmap_t(lookup_),
+    iflat_multimap(lookup_t& lookup_, storage_t& storage_, index_t* pindex_)
+      : refmap_t(lookup_, pindex_),
         storage(storage_)
     {
     }
@@ -720,9 +748,10 @@ namespace etl
   ///\tparam TValue   The value type.
   ///\tparam TCompare The type to compare keys. Default = std::less<TKey>
   ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam INDEXED_  If true, reserves space for an index that rebuild_index() can build.
   ///\ingroup flat_multimap
   //***************************************************************************
-  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey> >
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey>, const bool INDEXED_ = false>
   class flat_multimap : public etl::iflat_multimap<TKey, TValue, TCompare>
   {
   public:
@@ -733,7 +762,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     flat_multimap()
-      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage, index.get())
     {
     }
 
@@ -741,7 +770,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     flat_multimap(const flat_multimap& other)
-      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage, index.get())
     {
       this->assign(other.cbegin(), other.cend());
     }
@@ -754,7 +783,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     flat_multimap(TIterator first, TIterator last)
-      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage, index.get())
     {
       this->assign(first, last);
     }
@@ -764,7 +793,7 @@ namespace etl
     /// Construct from initializer_list.
     //*************************************************************************
     flat_multimap(std::initializer_list<typename etl::iflat_multimap<TKey, TValue, TCompare>::value_type> init)
-      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_multimap<TKey, TValue, TCompare>(lookup, storage, index.get())
     {
       this->assign(init.begin(), init.end());
     }
@@ -800,6 +829,9 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<node_t*, MAX_SIZE> lookup;
+
+    // The optional lookup index.
+    etl::private_flat::eytzinger_index<TKey, TCompare, (INDEXED_ ? MAX_SIZE_ : 0)> index;
   };
 }
 
@@ -64,6 +64,7 @@ namespace etl
 
     typedef etl::ireference_flat_multiset<T, TKeyCompare> refset_t;
     typedef typename refset_t::lookup_t lookup_t;
+    typedef typename refset_t::index_t index_t;
     typedef etl::ipool storage_t;
 
   public:
@@ -214,11 +215,7 @@ namespace etl
 #endif
 
       clear();
-
-      while (first != last)
-      {
-        insert(*first++);
-      }
+      insert(first, last);
     }
 
     //*********************************************************************
@@ -255,6 +252,7 @@ namespace etl
 
     //*********************************************************************
     /// Inserts a range of values to the flat_multiset.
+    /// The values are appended, sorted and merged with the existing elements in one pass.
     /// If asserts or exceptions are enabled, emits flat_multiset_full if the flat_multiset does not have enough free space.
     ///\param position The position to insert at.
     ///\param first    The first element to add.
@@ -263,10 +261,20 @@ namespace etl
     template <class TIterator>
     void insert(TIterator first, TIterator last)
     {
+      size_type sorted_size = size();
+
       while (first != last)
       {
-        insert(*first++);
+        ETL_ASSERT(!full(), ETL_ERROR(flat_multiset_full));
+
+        value_type* pvalue = storage.allocate<value_type>();
+        ::new (pvalue) value_type(*first);
+        ETL_INCREMENT_DEBUG_COUNT
+        refset_t::append(*pvalue);
+        ++first;
       }
+
+      refset_t::merge_appended(sorted_size);
     }
 
     //*************************************************************************
@@ -607,13 +615,33 @@ namespace etl
       return refset_t::available();
     }
 
+    //*********************************************************************
+    /// Builds the lookup index from the current contents.
+    /// Only containers declared with INDEXED_ = true have an index, otherwise does nothing.
+    /// Any insert or erase discards the index, and lookups fall back to the
+    /// binary search until it is rebuilt.
+    //*********************************************************************
+    void rebuild_index()
+    {
+      refset_t::rebuild_index();
+    }
+
+    //*********************************************************************
+    /// Checks whether lookups are using the index.
+    ///\return <b>true</b> if the index is up to date with the contents.
+    //*********************************************************************
+    bool is_index_valid() const
+    {
+      return refset_t::is_index_valid();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
     //*********************************************************************
-    iflat_multiset(lookup_t& lookup_, storage_t& storage_)
-      : refset_t(lookup_),
+    iflat_multiset(lookup_t& lookup_, storage_t& storage_, index_t* pindex_)
+      : refset_t(lookup_, pindex_),
         storage(storage_)
     {
     }
@@ -677,9 +705,10 @@ namespace etl
   ///\tparam T        The value type.
   ///\tparam TCompare The type to compare keys. Default = std::less<T>
   ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam INDEXED_  If true, reserves space for an index that rebuild_index() can build.
   ///\ingroup flat_multiset
   //***************************************************************************
-  template <typename T, const size_t MAX_SIZE_, typename TCompare = std::less<T> >
+  template <typename T, const size_t MAX_SIZE_, typename TCompare = std::less<T>, const bool INDEXED_ = false>
   class flat_multiset : public etl::iflat_multiset<T, TCompare>
   {
   public:
@@ -690,7 +719,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     flat_multiset()
-      : etl::iflat_multiset<T, TCompare>(lookup, storage)
+      : etl::iflat_multiset<T, TCompare>(lookup, storage, index.get())
     {
     }
 
@@ -698,7 +727,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     flat_multiset(const flat_multiset& other)
-      : iflat_multiset<T, TCompare>(lookup, storage)
+      : iflat_multiset<T, TCompare>(lookup, storage, index.get())
     {
       this->assign(other.cbegin(), other.cend());
     }
@@ -711,7 +740,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     flat_multiset(TIterator first, TIterator last)
-      : iflat_multiset<T, TCompare>(lookup, storage)
+      : iflat_multiset<T, TCompare>(lookup, storage, index.get())
     {
       this->assign(first, last);
     }
@@ -721,7 +750,7 @@ namespace etl
     /// Construct from initializer_list.
     //*************************************************************************
     flat_multiset(std::initializer_list<T> init)
-      : iflat_multiset<T, TCompare>(lookup, storage)
+      : iflat_multiset<T, TCompare>(lookup, storage, index.get())
     {
       this->assign(init.begin(), init.end());
     }
@@ -757,6 +786,9 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<node_t*, MAX_SIZE> lookup;
+
+    // The optional lookup index.
+    etl::private_flat::eytzinger_index<T, TCompare, (INDEXED_ ? MAX_SIZE_ : 0)> index;
   };
 }
 
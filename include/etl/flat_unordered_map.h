@@ -0,0 +1,1427 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_FLAT_UNORDERED_MAP_INCLUDED
+#define ETL_FLAT_UNORDERED_MAP_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+
+#include "platform.h"
+
+#include "stl/algorithm.h"
+#include "stl/iterator.h"
+#include "stl/functional.h"
+#include "stl/utility.h"
+
+#include "container.h"
+#include "alignment.h"
+#include "power.h"
+#include "hash.h"
+#include "type_traits.h"
+#include "parameter_type.h"
+#include "nullptr.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "debug_count.h"
+#include "memory.h"
+
+#undef ETL_FILE
+#define ETL_FILE "51"
+
+//*****************************************************************************
+///\defgroup flat_unordered_map flat_unordered_map
+/// An open addressing unordered_map with the capacity defined at compile time.
+/// The elements are stored inline in a single array of slots using Robin Hood
+/// linear probing with backward shift deletion, so no tombstones are left behind.
+/// Lookups touch one contiguous run of slots rather than a bucket and a node.
+/// Inserting an element may move other elements, so invalidates all iterators.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception for the flat_unordered_map.
+  ///\ingroup flat_unordered_map
+  //***************************************************************************
+  class flat_unordered_map_exception : public etl::exception
+  {
+  public:
+
+    flat_unordered_map_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Full exception for the flat_unordered_map.
+  ///\ingroup flat_unordered_map
+  //***************************************************************************
+  class flat_unordered_map_full : public etl::flat_unordered_map_exception
+  {
+  public:
+
+    flat_unordered_map_full(string_type file_name_, numeric_type line_number_)
+      : etl::flat_unordered_map_exception(ETL_ERROR_TEXT("flat_unordered_map:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Out of range exception for the flat_unordered_map.
+  ///\ingroup flat_unordered_map
+  //***************************************************************************
+  class flat_unordered_map_out_of_range : public etl::flat_unordered_map_exception
+  {
+  public:
+
+    flat_unordered_map_out_of_range(string_type file_name_, numeric_type line_number_)
+      : etl::flat_unordered_map_exception(ETL_ERROR_TEXT("flat_unordered_map:range", ETL_FILE"B"), file_name_, line_number_)
+    {}
+  };
+
+  //***************************************************************************
+  /// Iterator exception for the flat_unordered_map.
+  ///\ingroup flat_unordered_map
+  //***************************************************************************
+  class flat_unordered_map_iterator : public etl::flat_unordered_map_exception
+  {
+  public:
+
+    flat_unordered_map_iterator(string_type file_name_, numeric_type line_number_)
+      : etl::flat_unordered_map_exception(ETL_ERROR_TEXT("flat_unordered_map:iterator", ETL_FILE"C"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The base class for specifically sized flat_unordered_map.
+  /// Can be used as a reference type for all flat_unordered_map containing a specific type.
+  ///\ingroup flat_unordered_map
+  //***************************************************************************
+  template <typename TKey, typename T, typename THash = etl::hash<TKey>, typename TKeyEqual = std::equal_to<TKey> >
+  class iflat_unordered_map
+  {
+  public:
+
+    typedef std::pair<const TKey, T> value_type;
+
+    typedef TKey              key_type;
+    typedef T                 mapped_type;
+    typedef THash             hasher;
+    typedef TKeyEqual         key_equal;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+    typedef value_type*       pointer;
+    typedef const value_type* const_pointer;
+    typedef size_t            size_type;
+
+    typedef typename etl::parameter_type<TKey>::type key_parameter_t;
+
+    //*************************************************************************
+    /// A slot in the table.
+    /// 'distance' is 0 if the slot is empty, otherwise it is the number of
+    /// slots the element lies from its home slot, plus one.
+    //*************************************************************************
+    struct slot_t
+    {
+      value_type& value()
+      {
+        return *reinterpret_cast<value_type*>(storage.data);
+      }
+
+      const value_type& value() const
+      {
+        return *reinterpret_cast<const value_type*>(storage.data);
+      }
+
+      bool empty() const
+      {
+        return distance == 0;
+      }
+
+      uint32_t distance;
+      typename etl::aligned_storage<sizeof(value_type), etl::alignment_of<value_type>::value>::type storage;
+    };
+
+  private:
+
+    //*********************************************************************
+    /// Iteration starts just after an empty 'anchor' slot and wraps around
+    /// to end there. Backward shift deletion never moves an element across
+    /// an empty slot, so erasing while iterating never skips or repeats one.
+    //*********************************************************************
+    static const slot_t* find_anchor(const slot_t* pslot)
+    {
+      while (!pslot->empty())
+      {
+        ++pslot;
+      }
+
+      return pslot;
+    }
+
+    //*********************************************************************
+    static const slot_t* find_next(const slot_t* pbegin, const slot_t* pend, const slot_t* panchor, const slot_t* pslot)
+    {
+      ++pslot;
+
+      if (pslot > panchor)
+      {
+        // Search to the end of the table.
+        while ((pslot != pend) && pslot->empty())
+        {
+          ++pslot;
+        }
+
+        if (pslot != pend)
+        {
+          return pslot;
+        }
+
+        // Wrap around.
+        pslot = pbegin;
+      }
+
+      // Search up to the anchor.
+      while ((pslot != panchor) && pslot->empty())
+      {
+        ++pslot;
+      }
+
+      return (pslot == panchor) ? pend : pslot;
+    }
+
+  public:
+
+    //*********************************************************************
+    class iterator : public std::iterator<std::forward_iterator_tag, T>
+    {
+    public:
+
+      typedef typename iflat_unordered_map::value_type      value_type;
+      typedef typename iflat_unordered_map::key_type        key_type;
+      typedef typename iflat_unordered_map::mapped_type     mapped_type;
+      typedef typename iflat_unordered_map::hasher          hasher;
+      typedef typename iflat_unordered_map::key_equal       key_equal;
+      typedef typename iflat_unordered_map::reference       reference;
+      typedef typename iflat_unordered_map::const_reference const_reference;
+      typedef typename iflat_unordered_map::pointer         pointer;
+      typedef typename iflat_unordered_map::const_pointer   const_pointer;
+      typedef typename iflat_unordered_map::size_type       size_type;
+
+      friend class iflat_unordered_map;
+
+      //*********************************
+      iterator()
+        : pbegin(nullptr),
+          pend(nullptr),
+          panchor(nullptr),
+          pslot(nullptr)
+      {
+      }
+
+      //*********************************
+      iterator(const iterator& other)
+        : pbegin(other.pbegin),
+          pend(other.pend),
+          panchor(other.panchor),
+          pslot(other.pslot)
+      {
+      }
+
+      //*********************************
+      iterator& operator ++()
+      {
+        if (panchor == nullptr)
+        {
+          panchor = const_cast<slot_t*>(find_anchor(pbegin));
+        }
+
+        pslot = const_cast<slot_t*>(find_next(pbegin, pend, panchor, pslot));
+
+        return *this;
+      }
+
+      //*********************************
+      iterator operator ++(int)
+      {
+        iterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      //*********************************
+      iterator operator =(const iterator& other)
+      {
+        pbegin  = other.pbegin;
+        pend    = other.pend;
+        panchor = other.panchor;
+        pslot   = other.pslot;
+        return *this;
+      }
+
+      //*********************************
+      reference operator *()
+      {
+        return pslot->value();
+      }
+
+      //*********************************
+      const_reference operator *() const
+      {
+        return pslot->value();
+      }
+
+      //*********************************
+      pointer operator &()
+      {
+        return &(pslot->value());
+      }
+
+      //*********************************
+      const_pointer operator &() const
+      {
+        return &(pslot->value());
+      }
+
+      //*********************************
+      pointer operator ->()
+      {
+        return &(pslot->value());
+      }
+
+      //*********************************
+      const_pointer operator ->() const
+      {
+        return &(pslot->value());
+      }
+
+      //*********************************
+      friend bool operator == (const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.pslot == rhs.pslot;
+      }
+
+      //*********************************
+      friend bool operator != (const iterator& lhs, const iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      //*********************************
+      iterator(slot_t* pbegin_, slot_t* pend_, slot_t* panchor_, slot_t* pslot_)
+        : pbegin(pbegin_),
+          pend(pend_),
+          panchor(panchor_),
+          pslot(pslot_)
+      {
+      }
+
+      slot_t* pbegin;
+      slot_t* pend;
+      slot_t* panchor; ///< Found on first increment if not yet known.
+      slot_t* pslot;
+    };
+
+    //*********************************************************************
+    class const_iterator : public std::iterator<std::forward_iterator_tag, const T>
+    {
+    public:
+
+      typedef typename iflat_unordered_map::value_type      value_type;
+      typedef typename iflat_unordered_map::key_type        key_type;
+      typedef typename iflat_unordered_map::mapped_type     mapped_type;
+      typedef typename iflat_unordered_map::hasher          hasher;
+      typedef typename iflat_unordered_map::key_equal       key_equal;
+      typedef typename iflat_unordered_map::reference       reference;
+      typedef typename iflat_unordered_map::const_reference const_reference;
+      typedef typename iflat_unordered_map::pointer         pointer;
+      typedef typename iflat_unordered_map::const_pointer   const_pointer;
+      typedef typename iflat_unordered_map::size_type       size_type;
+
+      friend class iflat_unordered_map;
+      friend class iterator;
+
+      //*********************************
+      const_iterator()
+        : pbegin(nullptr),
+          pend(nullptr),
+          panchor(nullptr),
+          pslot(nullptr)
+      {
+      }
+
+      //*********************************
+      const_iterator(const typename iflat_unordered_map::iterator& other)
+        : pbegin(other.pbegin),
+          pend(other.pend),
+          panchor(other.panchor),
+          pslot(other.pslot)
+      {
+      }
+
+      //*********************************
+      const_iterator(const const_iterator& other)
+        : pbegin(other.pbegin),
+          pend(other.pend),
+          panchor(other.panchor),
+          pslot(other.pslot)
+      {
+      }
+
+      //*********************************
+      const_iterator& operator ++()
+      {
+        if (panchor == nullptr)
+        {
+          panchor = find_anchor(pbegin);
+        }
+
+        pslot = find_next(pbegin, pend, panchor, pslot);
+
+        return *this;
+      }
+
+      //*********************************
+      const_iterator operator ++(int)
+      {
+        const_iterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      //*********************************
+      const_iterator operator =(const const_iterator& other)
+      {
+        pbegin  = other.pbegin;
+        pend    = other.pend;
+        panchor = other.panchor;
+        pslot   = other.pslot;
+        return *this;
+      }
+
+      //*********************************
+      const_reference operator *() const
+      {
+        return pslot->value();
+      }
+
+      //*********************************
+      const_pointer operator &() const
+      {
+        return &(pslot->value());
+      }
+
+      //*********************************
+      const_pointer operator ->() const
+      {
+        return &(pslot->value());
+      }
+
+      //*********************************
+      friend bool operator == (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.pslot == rhs.pslot;
+      }
+
+      //*********************************
+      friend bool operator != (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      //*********************************
+      const_iterator(const slot_t* pbegin_, const slot_t* pend_, const slot_t* panchor_, const slot_t* pslot_)
+        : pbegin(pbegin_),
+          pend(pend_),
+          panchor(panchor_),
+          pslot(pslot_)
+      {
+      }
+
+      const slot_t* pbegin;
+      const slot_t* pend;
+      const slot_t* panchor; ///< Found on first increment if not yet known.
+      const slot_t* pslot;
+    };
+
+    typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+
+    //*********************************************************************
+    /// Returns an iterator to the beginning of the flat_unordered_map.
+    ///\return An iterator to the beginning of the flat_unordered_map.
+    //*********************************************************************
+    iterator begin()
+    {
+      slot_t* panchor = const_cast<slot_t*>(find_anchor(pslots));
+
+      return ++iterator(pslots, pslots + number_of_slots, panchor, panchor);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the flat_unordered_map.
+    ///\return A const iterator to the beginning of the flat_unordered_map.
+    //*********************************************************************
+    const_iterator begin() const
+    {
+      const slot_t* panchor = find_anchor(pslots);
+
+      return ++const_iterator(pslots, pslots + number_of_slots, panchor, panchor);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the flat_unordered_map.
+    ///\return A const iterator to the beginning of the flat_unordered_map.
+    //*********************************************************************
+    const_iterator cbegin() const
+    {
+      return begin();
+    }
+
+    //*********************************************************************
+    /// Returns an iterator to the end of the flat_unordered_map.
+    ///\return An iterator to the end of the flat_unordered_map.
+    //*********************************************************************
+    iterator end()
+    {
+      return iterator(pslots, pslots + number_of_slots, nullptr, pslots + number_of_slots);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the flat_unordered_map.
+    ///\return A const iterator to the end of the flat_unordered_map.
+    //*********************************************************************
+    const_iterator end() const
+    {
+      return const_iterator(pslots, pslots + number_of_slots, nullptr, pslots + number_of_slots);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the flat_unordered_map.
+    ///\return A const iterator to the end of the flat_unordered_map.
+    //*********************************************************************
+    const_iterator cend() const
+    {
+      return end();
+    }
+
+    //*********************************************************************
+    /// Returns the home slot index for the key.
+    ///\return The home slot index for the key.
+    //*********************************************************************
+    size_type get_bucket_index(key_parameter_t key) const
+    {
+      return mix_hash(key_hash_function(key)) & (number_of_slots - 1);
+    }
+
+    //*********************************************************************
+    /// Returns the maximum number of slots the container can hold.
+    ///\return The maximum number of slots the container can hold.
+    //*********************************************************************
+    size_type max_bucket_count() const
+    {
+      return number_of_slots;
+    }
+
+    //*********************************************************************
+    /// Returns the number of slots the container holds.
+    ///\return The number of slots the container holds.
+    //*********************************************************************
+    size_type bucket_count() const
+    {
+      return number_of_slots;
+    }
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    ///\param key The key.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_type& operator [](key_parameter_t key)
+    {
+      size_t   index;
+      uint32_t distance;
+
+      if (!locate_insert_position(key, index, distance))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_unordered_map_full));
+
+        // Doesn't exist, so add a new one.
+        make_room(index);
+        ::new (static_cast<void*>(pslots[index].storage.data)) value_type(key, T());
+        pslots[index].distance = distance;
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT
+      }
+
+      return pslots[index].value().second;
+    }
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::flat_unordered_map_out_of_range if the key is not in the range.
+    ///\param key The key.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_type& at(key_parameter_t key)
+    {
+      size_t index = locate(key);
+
+      ETL_ASSERT(index != number_of_slots, ETL_ERROR(flat_unordered_map_out_of_range));
+
+      return pslots[index].value().second;
+    }
+
+    //*********************************************************************
+    /// Returns a const reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::flat_unordered_map_out_of_range if the key is not in the range.
+    ///\param key The key.
+    ///\return A const reference to the value at index 'key'
+    //*********************************************************************
+    const mapped_type& at(key_parameter_t key) const
+    {
+      size_t index = locate(key);
+
+      ETL_ASSERT(index != number_of_slots, ETL_ERROR(flat_unordered_map_out_of_range));
+
+      return pslots[index].value().second;
+    }
+
+    //*********************************************************************
+    /// Assigns values to the flat_unordered_map.
+    /// If asserts or exceptions are enabled, emits flat_unordered_map_full if the flat_unordered_map does not have enough free space.
+    /// If asserts or exceptions are enabled, emits flat_unordered_map_iterator if the iterators are reversed.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign(TIterator first_, TIterator last_)
+    {
+#if defined(ETL_DEBUG)
+      difference_type d = std::distance(first_, last_);
+      ETL_ASSERT(d >= 0, ETL_ERROR(flat_unordered_map_iterator));
+      ETL_ASSERT(size_t(d) <= max_size(), ETL_ERROR(flat_unordered_map_full));
+#endif
+
+      clear();
+
+      while (first_ != last_)
+      {
+        insert(*first_++);
+      }
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the flat_unordered_map.
+    /// If asserts or exceptions are enabled, emits flat_unordered_map_full if the flat_unordered_map is already full.
+    ///\param value The value to insert.
+    //*********************************************************************
+    std::pair<iterator, bool> insert(const value_type& key_value_pair)
+    {
+      size_t   index;
+      uint32_t distance;
+
+      bool exists = locate_insert_position(key_value_pair.first, index, distance);
+
+      if (!exists)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_unordered_map_full));
+
+        make_room(index);
+        ::new (static_cast<void*>(pslots[index].storage.data)) value_type(key_value_pair);
+        pslots[index].distance = distance;
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT
+      }
+
+      return std::pair<iterator, bool>(make_iterator(index), !exists);
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the flat_unordered_map.
+    /// If asserts or exceptions are enabled, emits flat_unordered_map_full if the flat_unordered_map is already full.
+    ///\param position The position to insert at.
+    ///\param value    The value to insert.
+    //*********************************************************************
+    iterator insert(const_iterator, const value_type& key_value_pair)
+    {
+      return insert(key_value_pair).first;
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values to the flat_unordered_map.
+    /// If asserts or exceptions are enabled, emits flat_unordered_map_full if the flat_unordered_map does not have enough free space.
+    ///\param first    The first element to add.
+    ///\param last     The last + 1 element to add.
+    //*********************************************************************
+    template <class TIterator>
+    void insert(TIterator first_, TIterator last_)
+    {
+      while (first_ != last_)
+      {
+        insert(*first_++);
+      }
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the flat_unordered_map.
+    //*************************************************************************
+    std::pair<iterator, bool> emplace(const value_type& value)
+    {
+      return insert(value);
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT)
+    //*************************************************************************
+    /// Emplaces a value to the flat_unordered_map.
+    /// The mapped value is constructed in place from the arguments.
+    //*************************************************************************
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace(const key_type& key, Args && ... args)
+    {
+      size_t   index;
+      uint32_t distance;
+
+      bool exists = locate_insert_position(key, index, distance);
+
+      if (!exists)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_unordered_map_full));
+
+        make_room(index);
+        value_type* pvalue = &pslots[index].value();
+        ::new ((void*)etl::addressof(pvalue->first)) key_type(key);
+        ::new ((void*)etl::addressof(pvalue->second)) mapped_type(std::forward<Args>(args)...);
+        pslots[index].distance = distance;
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT
+      }
+
+      return std::pair<iterator, bool>(make_iterator(index), !exists);
+    }
+#else
+    //*************************************************************************
+    /// Emplaces a value to the flat_unordered_map.
+    /// The mapped value is constructed in place from the arguments.
+    //*************************************************************************
+    template <typename T1>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1)
+    {
+      size_t   index;
+      uint32_t distance;
+
+      bool exists = locate_insert_position(key, index, distance);
+
+      if (!exists)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_unordered_map_full));
+
+        make_room(index);
+        value_type* pvalue = &pslots[index].value();
+        ::new ((void*)etl::addressof(pvalue->first)) key_type(key);
+        ::new ((void*)etl::addressof(pvalue->second)) mapped_type(value1);
+        pslots[index].distance = distance;
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT
+      }
+
+      return std::pair<iterator, bool>(make_iterator(index), !exists);
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the flat_unordered_map.
+    /// The mapped value is constructed in place from the arguments.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1, const T2& value2)
+    {
+      size_t   index;
+      uint32_t distance;
+
+      bool exists = locate_insert_position(key, index, distance);
+
+      if (!exists)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_unordered_map_full));
+
+        make_room(index);
+        value_type* pvalue = &pslots[index].value();
+        ::new ((void*)etl::addressof(pvalue->first)) key_type(key);
+        ::new ((void*)etl::addressof(pvalue->second)) mapped_type(value1, value2);
+        pslots[index].distance = distance;
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT
+      }
+
+      return std::pair<iterator, bool>(make_iterator(index), !exists);
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the flat_unordered_map.
+    /// The mapped value is constructed in place from the arguments.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1, const T2& value2, const T3& value3)
+    {
+      size_t   index;
+      uint32_t distance;
+
+      bool exists = locate_insert_position(key, index, distance);
+
+      if (!exists)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_unordered_map_full));
+
+        make_room(index);
+        value_type* pvalue = &pslots[index].value();
+        ::new ((void*)etl::addressof(pvalue->first)) key_type(key);
+        ::new ((void*)etl::addressof(pvalue->second)) mapped_type(value1, value2, value3);
+        pslots[index].distance = distance;
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT
+      }
+
+      return std::pair<iterator, bool>(make_iterator(index), !exists);
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the flat_unordered_map.
+    /// The mapped value is constructed in place from the arguments.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      size_t   index;
+      uint32_t distance;
+
+      bool exists = locate_insert_position(key, index, distance);
+
+      if (!exists)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_unordered_map_full));
+
+        make_room(index);
+        value_type* pvalue = &pslots[index].value();
+        ::new ((void*)etl::addressof(pvalue->first)) key_type(key);
+        ::new ((void*)etl::addressof(pvalue->second)) mapped_type(value1, value2, value3, value4);
+        pslots[index].distance = distance;
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT
+      }
+
+      return std::pair<iterator, bool>(make_iterator(index), !exists);
+    }
+#endif
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param key The key to erase.
+    ///\return The number of elements erased. 0 or 1.
+    //*********************************************************************
+    size_t erase(key_parameter_t key)
+    {
+      size_t index = locate(key);
+
+      if (index == number_of_slots)
+      {
+        return 0;
+      }
+
+      remove_at(index);
+
+      return 1;
+    }
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param ielement Iterator to the element.
+    ///\return An iterator to the element that followed the erased one.
+    //*********************************************************************
+    iterator erase(const_iterator ielement)
+    {
+      slot_t* panchor = const_cast<slot_t*>(ielement.panchor);
+
+      if (panchor == nullptr)
+      {
+        panchor = const_cast<slot_t*>(find_anchor(pslots));
+      }
+
+      slot_t* pslot = const_cast<slot_t*>(ielement.pslot);
+
+      remove_at(pslot - pslots);
+
+      iterator inext(pslots, pslots + number_of_slots, panchor, pslot);
+
+      // If nothing was shifted into the vacated slot then move on to the next.
+      if (pslot->empty())
+      {
+        ++inext;
+      }
+
+      return inext;
+    }
+
+    //*********************************************************************
+    /// Erases a range of elements.
+    /// The range includes all the elements between first and last, including the
+    /// element pointed by first, but not the one pointed to by last.
+    ///\param first Iterator to the first element.
+    ///\param last  Iterator to the last element.
+    //*********************************************************************
+    iterator erase(const_iterator first_, const_iterator last_)
+    {
+      // Elements may shift as others are erased, so count them first.
+      difference_type n = std::distance(first_, last_);
+
+      iterator result(pslots, pslots + number_of_slots, const_cast<slot_t*>(first_.panchor), const_cast<slot_t*>(first_.pslot));
+
+      while (n-- > 0)
+      {
+        result = erase(result);
+      }
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Clears the flat_unordered_map.
+    //*************************************************************************
+    void clear()
+    {
+      initialise();
+    }
+
+    //*********************************************************************
+    /// Counts an element.
+    ///\param key The key to search for.
+    ///\return 1 if the key exists, otherwise 0.
+    //*********************************************************************
+    size_t count(key_parameter_t key) const
+    {
+      return (locate(key) == number_of_slots) ? 0 : 1;
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    iterator find(key_parameter_t key)
+    {
+      return make_iterator(locate(key));
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    const_iterator find(key_parameter_t key) const
+    {
+      return const_iterator(pslots, pslots + number_of_slots, nullptr, pslots + locate(key));
+    }
+
+    //*********************************************************************
+    /// Returns a range containing all elements with key key in the container.
+    /// The range is defined by two iterators, the first pointing to the first
+    /// element of the wanted range and the second pointing past the last
+    /// element of the range.
+    ///\param key The key to search for.
+    ///\return An iterator pair to the range of elements if the key exists, otherwise end().
+    //*********************************************************************
+    std::pair<iterator, iterator> equal_range(key_parameter_t key)
+    {
+      iterator f = find(key);
+      iterator l = f;
+
+      if (l != end())
+      {
+        ++l;
+      }
+
+      return std::pair<iterator, iterator>(f, l);
+    }
+
+    //*********************************************************************
+    /// Returns a range containing all elements with key key in the container.
+    /// The range is defined by two iterators, the first pointing to the first
+    /// element of the wanted range and the second pointing past the last
+    /// element of the range.
+    ///\param key The key to search for.
+    ///\return A const iterator pair to the range of elements if the key exists, otherwise end().
+    //*********************************************************************
+    std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
+    {
+      const_iterator f = find(key);
+      const_iterator l = f;
+
+      if (l != end())
+      {
+        ++l;
+      }
+
+      return std::pair<const_iterator, const_iterator>(f, l);
+    }
+
+    //*************************************************************************
+    /// Gets the size of the flat_unordered_map.
+    //*************************************************************************
+    size_type size() const
+    {
+      return current_size;
+    }
+
+    //*************************************************************************
+    /// Gets the maximum possible size of the flat_unordered_map.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return maximum_size;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the flat_unordered_map is empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return current_size == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the flat_unordered_map is full.
+    //*************************************************************************
+    bool full() const
+    {
+      return current_size == maximum_size;
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return maximum_size - current_size;
+    }
+
+    //*************************************************************************
+    /// Returns the load factor = size / bucket_count.
+    ///\return The load factor = size / bucket_count.
+    //*************************************************************************
+    float load_factor() const
+    {
+      return static_cast<float>(size()) / static_cast<float>(bucket_count());
+    }
+
+    //*************************************************************************
+    /// Returns the function that hashes the keys.
+    ///\return The function that hashes the keys..
+    //*************************************************************************
+    hasher hash_function() const
+    {
+      return key_hash_function;
+    }
+
+    //*************************************************************************
+    /// Returns the function that compares the keys.
+    ///\return The function that compares the keys..
+    //*************************************************************************
+    key_equal key_eq() const
+    {
+      return key_equal_function;
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    iflat_unordered_map& operator = (const iflat_unordered_map& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+  protected:
+
+    //*********************************************************************
+    /// Constructor.
+    //*********************************************************************
+    iflat_unordered_map(slot_t* pslots_, size_t number_of_slots_, size_t maximum_size_)
+      : pslots(pslots_),
+        number_of_slots(number_of_slots_),
+        maximum_size(maximum_size_),
+        current_size(0)
+    {
+      for (size_t i = 0; i < number_of_slots; ++i)
+      {
+        pslots[i].distance = 0;
+      }
+    }
+
+    //*********************************************************************
+    /// Initialise the flat_unordered_map.
+    //*********************************************************************
+    void initialise()
+    {
+      if (!empty())
+      {
+        for (size_t i = 0; i < number_of_slots; ++i)
+        {
+          if (!pslots[i].empty())
+          {
+            pslots[i].value().~value_type();
+            pslots[i].distance = 0;
+            ETL_DECREMENT_DEBUG_COUNT
+          }
+        }
+
+        current_size = 0;
+      }
+    }
+
+  private:
+
+    //*********************************************************************
+    /// Makes an iterator for the slot index.
+    //*********************************************************************
+    iterator make_iterator(size_t index)
+    {
+      return iterator(pslots, pslots + number_of_slots, nullptr, pslots + index);
+    }
+
+    //*********************************************************************
+    /// Mixes the hash so that every bit of it affects the slot index.
+    /// etl::hash is the identity for integral keys, and keys with a common
+    /// stride would otherwise share their low bits and so their home slots.
+    /// This is the 64 bit finalizer of MurmurHash3.
+    //*********************************************************************
+    static size_t mix_hash(size_t hash)
+    {
+      uint64_t h = uint64_t(hash);
+
+      h ^= h >> 33;
+      h *= 0xFF51AFD7ED558CCDULL;
+      h ^= h >> 33;
+      h *= 0xC4CEB9FE1A85EC53ULL;
+      h ^= h >> 33;
+
+      return size_t(h);
+    }
+
+    //*********************************************************************
+    /// Finds the slot index of the key.
+    ///\return The index or number_of_slots if not found.
+    //*********************************************************************
+    size_t locate(key_parameter_t key) const
+    {
+      const size_t mask = number_of_slots - 1;
+
+      size_t   index    = get_bucket_index(key);
+      uint32_t distance = 1;
+
+      // Elements in a run are ordered by their home slot, so we can stop
+      // as soon as we see one that is closer to home than we would be.
+      while (distance <= pslots[index].distance)
+      {
+        if ((distance == pslots[index].distance) && key_equal_function(key, pslots[index].value().first))
+        {
+          return index;
+        }
+
+        index = (index + 1) & mask;
+        ++distance;
+      }
+
+      return number_of_slots;
+    }
+
+    //*********************************************************************
+    /// Finds the key, or the slot it should be inserted at.
+    ///\return <b>true</b> if the key already exists.
+    //*********************************************************************
+    bool locate_insert_position(key_parameter_t key, size_t& index, uint32_t& distance) const
+    {
+      const size_t mask = number_of_slots - 1;
+
+      index    = get_bucket_index(key);
+      distance = 1;
+
+      while (distance <= pslots[index].distance)
+      {
+        if ((distance == pslots[index].distance) && key_equal_function(key, pslots[index].value().first))
+        {
+          return true;
+        }
+
+        index = (index + 1) & mask;
+        ++distance;
+      }
+
+      return false;
+    }
+
+    //*********************************************************************
+    /// Moves the element in one slot to another, empty, slot.
+    //*********************************************************************
+    static void move_slot(slot_t& from, slot_t& to, uint32_t distance)
+    {
+#if ETL_CPP11_SUPPORTED
+      ::new (static_cast<void*>(to.storage.data)) value_type(std::move(from.value()));
+#else
+      ::new (static_cast<void*>(to.storage.data)) value_type(from.value());
+#endif
+      from.value().~value_type();
+      to.distance   = distance;
+      from.distance = 0;
+    }
+
+    //*********************************************************************
+    /// Shifts the run starting at 'index' along by one to free the slot.
+    //*********************************************************************
+    void make_room(size_t index)
+    {
+      const size_t mask = number_of_slots - 1;
+
+      // Find the end of the run.
+      size_t last = index;
+
+      while (!pslots[last].empty())
+      {
+        last = (last + 1) & mask;
+      }
+
+      // Shift each element one further from home.
+      while (last != index)
+      {
+        size_t previous = (last - 1) & mask;
+        move_slot(pslots[previous], pslots[last], pslots[previous].distance + 1);
+        last = previous;
+      }
+    }
+
+    //*********************************************************************
+    /// Destroys the element at 'index' and shifts the rest of the run back.
+    //*********************************************************************
+    void remove_at(size_t index)
+    {
+      const size_t mask = number_of_slots - 1;
+
+      pslots[index].value().~value_type();
+      pslots[index].distance = 0;
+      --current_size;
+      ETL_DECREMENT_DEBUG_COUNT
+
+      size_t next = (index + 1) & mask;
+
+      // Shift back until we find an empty slot or an element at its home.
+      while (pslots[next].distance > 1)
+      {
+        move_slot(pslots[next], pslots[index], pslots[next].distance - 1);
+        index = next;
+        next  = (next + 1) & mask;
+      }
+    }
+
+    // Disable copy construction.
+    iflat_unordered_map(const iflat_unordered_map&);
+
+    /// The slots that hold the elements.
+    slot_t* pslots;
+
+    /// The number of slots. Always a power of 2.
+    const size_t number_of_slots;
+
+    /// The maximum number of elements.
+    const size_t maximum_size;
+
+    /// The current number of elements.
+    size_t current_size;
+
+    /// The function that creates the hashes.
+    hasher key_hash_function;
+
+    /// The function that compares the keys for equality.
+    key_equal key_equal_function;
+
+    /// For library debugging purposes only.
+    ETL_DECLARE_DEBUG_COUNT
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_FLAT_UNORDERED_MAP) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iflat_unordered_map()
+    {
+    }
+#else
+  protected:
+    ~iflat_unordered_map()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  /// Equal operator.
+  /// The element order depends on the insertion history, so each element is looked up.
+  ///\param lhs Reference to the first flat_unordered_map.
+  ///\param rhs Reference to the second flat_unordered_map.
+  ///\return <b>true</b> if the arrays are equal, otherwise <b>false</b>
+  ///\ingroup flat_unordered_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename THash, typename TKeyEqual>
+  bool operator ==(const etl::iflat_unordered_map<TKey, TMapped, THash, TKeyEqual>& lhs, const etl::iflat_unordered_map<TKey, TMapped, THash, TKeyEqual>& rhs)
+  {
+    if (lhs.size() != rhs.size())
+    {
+      return false;
+    }
+
+    typename etl::iflat_unordered_map<TKey, TMapped, THash, TKeyEqual>::const_iterator itr = lhs.begin();
+
+    while (itr != lhs.end())
+    {
+      typename etl::iflat_unordered_map<TKey, TMapped, THash, TKeyEqual>::const_iterator irhs = rhs.find(itr->first);
+
+      if ((irhs == rhs.end()) || !(irhs->second == itr->second))
+      {
+        return false;
+      }
+
+      ++itr;
+    }
+
+    return true;
+  }
+
+  //***************************************************************************
+  /// Not equal operator.
+  ///\param lhs Reference to the first flat_unordered_map.
+  ///\param rhs Reference to the second flat_unordered_map.
+  ///\return <b>true</b> if the arrays are not equal, otherwise <b>false</b>
+  ///\ingroup flat_unordered_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename THash, typename TKeyEqual>
+  bool operator !=(const etl::iflat_unordered_map<TKey, TMapped, THash, TKeyEqual>& lhs, const etl::iflat_unordered_map<TKey, TMapped, THash, TKeyEqual>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //*************************************************************************
+  /// A templated flat_unordered_map implementation that uses a fixed size buffer.
+  /// The number of slots is the next power of 2 that keeps the load factor at or below 0.8.
+  //*************************************************************************
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename THash = etl::hash<TKey>, typename TKeyEqual = std::equal_to<TKey> >
+  class flat_unordered_map : public etl::iflat_unordered_map<TKey, TValue, THash, TKeyEqual>
+  {
+  private:
+
+    typedef iflat_unordered_map<TKey, TValue, THash, TKeyEqual> base;
+
+  public:
+
+    static const size_t MAX_SIZE  = MAX_SIZE_;
+    static const size_t MAX_SLOTS = etl::power_of_2_round_up<MAX_SIZE_ + (MAX_SIZE_ / 4) + 1>::value;
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    flat_unordered_map()
+      : base(slots, MAX_SLOTS, MAX_SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    flat_unordered_map(const flat_unordered_map& other)
+      : base(slots, MAX_SLOTS, MAX_SIZE)
+    {
+      base::assign(other.cbegin(), other.cend());
+    }
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    flat_unordered_map(TIterator first_, TIterator last_)
+      : base(slots, MAX_SLOTS, MAX_SIZE)
+    {
+      base::assign(first_, last_);
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~flat_unordered_map()
+    {
+      base::initialise();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    flat_unordered_map& operator = (const flat_unordered_map& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        base::assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+  private:
+
+    /// The slots that hold the elements.
+    typename base::slot_t slots[MAX_SLOTS];
+  };
+}
+
+#undef ETL_FILE
+
+#endif
@@ -0,0 +1,796 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_FORMAT_INCLUDED
+#define ETL_FORMAT_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "type_traits.h"
+#include "basic_string.h"
+#include "string_view.h"
+#include "basic_format_spec.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "static_assert.h"
+#include "private/to_string_helper.h"
+
+#undef ETL_FILE
+#define ETL_FILE "59"
+
+//*****************************************************************************
+///\defgroup format format
+/// Formats arguments into a string, using a subset of the std::format syntax.
+/// Each replacement field is {} or {:[[fill]align][sign][#][0][width][.precision][type]}.
+/// align  : '<' left, '>' right, '^' centre. Numbers default to right, other types to left.
+/// sign   : '+' or ' ' for non-negative numbers.
+/// '#'    : Adds a 0x, 0X, 0b, 0B or 0 prefix to integrals.
+/// '0'    : Pads numbers with zeros after the sign and prefix.
+/// type   : Integrals     d, x, X, o, b, B (default d).
+///          Floating point f, F fixed with the precision (default 6), or none
+///          for the shortest form that converts back to the same value.
+///          bool, characters and strings take no type, or 's' and 'c'.
+/// {{ and }} give literal braces. Output is truncated at the string capacity.
+///\code
+/// etl::string<40> text;
+/// etl::format_to(text, ETL_FORMAT_STRING("{} {:08x} {:.3f}"), 42, 255U, 3.14159);
+///\endcode
+/// ETL_FORMAT_STRING checks the format string against the arguments at
+/// compile time for C++14 and above.
+///\ingroup string
+//*****************************************************************************
+
+#if ETL_CPP11_SUPPORTED
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for format exceptions.
+  ///\ingroup format
+  //***************************************************************************
+  class format_exception : public exception
+  {
+  public:
+
+    format_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when the format string does not match the arguments.
+  ///\ingroup format
+  //***************************************************************************
+  class format_invalid : public format_exception
+  {
+  public:
+
+    format_invalid(string_type file_name_, numeric_type line_number_)
+      : format_exception(ETL_ERROR_TEXT("format:invalid", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  namespace private_format
+  {
+    //*************************************************************************
+    /// The kinds of argument.
+    //*************************************************************************
+    enum category
+    {
+      integral_argument,
+      floating_point_argument,
+      bool_argument,
+      char_argument,
+      string_argument,
+      unsupported_argument
+    };
+
+    //*************************************************************************
+    /// Strings of the format's character type.
+    //*************************************************************************
+    template <typename T, typename TChar>
+    struct is_string
+    {
+    private:
+
+      static char check(const etl::ibasic_string<TChar>*);
+      static long check(...);
+
+    public:
+
+      static const bool value = etl::is_same<T, TChar*>::value       ||
+                                etl::is_same<T, const TChar*>::value ||
+                                (sizeof(check(static_cast<const T*>(0))) == sizeof(char));
+    };
+
+    template <typename TChar, size_t SIZE>
+    struct is_string<TChar[SIZE], TChar>
+    {
+      static const bool value = true;
+    };
+
+    template <typename TChar, size_t SIZE>
+    struct is_string<const TChar[SIZE], TChar>
+    {
+      static const bool value = true;
+    };
+
+    template <typename TChar, typename TTraits>
+    struct is_string<etl::basic_string_view<TChar, TTraits>, TChar>
+    {
+      static const bool value = true;
+    };
+
+    //*************************************************************************
+    /// Gets the category of an argument type.
+    //*************************************************************************
+    template <typename T, typename TChar>
+    struct argument_category
+    {
+      typedef typename etl::remove_cv<T>::type type;
+
+      static const category value = etl::is_same<type, bool>::value           ? bool_argument :
+                                    etl::is_same<type, TChar>::value          ? char_argument :
+                                    etl::is_integral<type>::value             ? integral_argument :
+                                    etl::is_floating_point<type>::value       ? floating_point_argument :
+                                    etl::private_format::is_string<type, TChar>::value ? string_argument :
+                                                                                unsupported_argument;
+    };
+
+    //*************************************************************************
+    /// A parsed replacement field.
+    //*************************************************************************
+    template <typename TChar>
+    struct replacement_field
+    {
+      ETL_CONSTEXPR replacement_field()
+        : fill(TChar(' '))
+        , align(0)
+        , sign(0)
+        , alternate(false)
+        , zero(false)
+        , width(0)
+        , precision(-1)
+        , type(0)
+      {
+      }
+
+      TChar    fill;
+      char     align;     ///< '<', '>', '^' or 0 for the default.
+      char     sign;      ///< '+', ' ' or 0.
+      bool     alternate; ///< '#'
+      bool     zero;      ///< '0'
+      uint32_t width;
+      int      precision; ///< -1 if not given.
+      char     type;      ///< The presentation type, or 0.
+    };
+
+    //*************************************************************************
+    /// Checks for an alignment character.
+    //*************************************************************************
+    template <typename TChar>
+    ETL_CONSTEXPR bool is_align(const TChar c)
+    {
+      return (c == TChar('<')) || (c == TChar('>')) || (c == TChar('^'));
+    }
+
+    //*************************************************************************
+    /// Parses a replacement field, from just after the '{'.
+    ///\return The position after the closing '}', or 0 if invalid.
+    //*************************************************************************
+    template <typename TChar>
+    ETL_CONSTEXPR14 const TChar* parse_field(const TChar* p, replacement_field<TChar>& field)
+    {
+      if (*p == TChar('}'))
+      {
+        return p + 1;
+      }
+
+      // Only automatic argument numbering is supported.
+      if (*p != TChar(':'))
+      {
+        return 0;
+      }
+
+      ++p;
+
+      // [[fill]align]
+      if ((p[0] != TChar(0)) && is_align(p[1]) && (p[0] != TChar('{')) && (p[0] != TChar('}')))
+      {
+        field.fill  = p[0];
+        field.align = char(p[1]);
+        p += 2;
+      }
+      else if (is_align(p[0]))
+      {
+        field.align = char(p[0]);
+        ++p;
+      }
+
+      // [sign]
+      if ((*p == TChar('+')) || (*p == TChar(' ')))
+      {
+        field.sign = char(*p);
+        ++p;
+      }
+      else if (*p == TChar('-'))
+      {
+        ++p;
+      }
+
+      // [#]
+      if (*p == TChar('#'))
+      {
+        field.alternate = true;
+        ++p;
+      }
+
+      // [0]
+      if (*p == TChar('0'))
+      {
+        field.zero = true;
+        ++p;
+      }
+
+      // [width]
+      while ((*p >= TChar('0')) && (*p <= TChar('9')))
+      {
+        field.width = (field.width * 10U) + uint32_t(*p - TChar('0'));
+        ++p;
+      }
+
+      // [.precision]
+      if (*p == TChar('.'))
+      {
+        ++p;
+
+        if ((*p < TChar('0')) || (*p > TChar('9')))
+        {
+          return 0;
+        }
+
+        field.precision = 0;
+
+        while ((*p >= TChar('0')) && (*p <= TChar('9')))
+        {
+          field.precision = (field.precision * 10) + int(*p - TChar('0'));
+          ++p;
+        }
+      }
+
+      // [type]
+      if ((*p != TChar('}')) && (*p != TChar(0)))
+      {
+        field.type = char(*p);
+        ++p;
+      }
+
+      return (*p == TChar('}')) ? p + 1 : 0;
+    }
+
+    //*************************************************************************
+    /// Checks that the field is valid for the kind of argument.
+    //*************************************************************************
+    template <typename TChar>
+    ETL_CONSTEXPR14 bool is_valid_field(const replacement_field<TChar>& field, const category kind)
+    {
+      const char type = field.type;
+
+      switch (kind)
+      {
+        case integral_argument:
+        {
+          return (field.precision < 0) &&
+                 ((type == 0) || (type == 'd') || (type == 'x') || (type == 'X') || (type == 'o') || (type == 'b') || (type == 'B'));
+        }
+
+        case floating_point_argument:
+        {
+          return (type == 0) || (type == 'f') || (type == 'F');
+        }
+
+        case bool_argument:
+        case char_argument:
+        case string_argument:
+        {
+          return (field.precision < 0) && (field.sign == 0) && !field.alternate && !field.zero &&
+                 ((type == 0) || (type == ((kind == char_argument) ? 'c' : 's')));
+        }
+
+        default:
+        {
+          return false;
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Checks a format string against the kinds of its arguments.
+    /// There may be more arguments than fields, as for std::format.
+    //*************************************************************************
+    template <typename TChar>
+    ETL_CONSTEXPR14 bool is_valid_format(const TChar* p, const category* kinds, const size_t count)
+    {
+      size_t index = 0U;
+
+      while (*p != TChar(0))
+      {
+        if (*p == TChar('{'))
+        {
+          if (p[1] == TChar('{'))
+          {
+            p += 2;
+          }
+          else
+          {
+            replacement_field<TChar> field;
+            p = parse_field(p + 1, field);
+
+            if ((p == 0) || (index >= count) || !is_valid_field(field, kinds[index]))
+            {
+              return false;
+            }
+
+            ++index;
+          }
+        }
+        else if (*p == TChar('}'))
+        {
+          if (p[1] != TChar('}'))
+          {
+            return false;
+          }
+
+          p += 2;
+        }
+        else
+        {
+          ++p;
+        }
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// The categories of a list of argument types.
+    //*************************************************************************
+    template <typename TChar, typename... TArgs>
+    struct argument_categories
+    {
+      // One extra, so that the array is never empty.
+      static ETL_CONSTEXPR const category values[sizeof...(TArgs) + 1] = { argument_category<TArgs, TChar>::value..., unsupported_argument };
+    };
+
+    template <typename TChar, typename... TArgs>
+    ETL_CONSTEXPR const category argument_categories<TChar, TArgs...>::values[sizeof...(TArgs) + 1];
+
+    //*************************************************************************
+    /// Copies literal text to the string, up to the next replacement field.
+    ///\return The position after the field's '{', or 0 at the end of the format.
+    //*************************************************************************
+    template <typename TIString>
+    const typename TIString::value_type* copy_literal(TIString& str, const typename TIString::value_type* p)
+    {
+      typedef typename TIString::value_type type;
+
+      const type* run = p;
+
+      while (true)
+      {
+        const type c = *p;
+
+        if ((c == type(0)) || (c == type('{')) || (c == type('}')))
+        {
+          str.append(run, p);
+
+          if (c == type(0))
+          {
+            return 0;
+          }
+
+          if (p[1] == c)
+          {
+            // An escaped brace. Keep one of them.
+            run = p + 1;
+            p  += 2;
+          }
+          else if (c == type('{'))
+          {
+            return p + 1;
+          }
+          else
+          {
+            // An unmatched '}'.
+            ETL_ASSERT(false, ETL_ERROR(format_invalid));
+            return 0;
+          }
+        }
+        else
+        {
+          ++p;
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Pads the text added since 'start' to the field's width.
+    ///\param numeric       Numbers are right aligned by default.
+    ///\param prefix_length The sign and prefix, which zeros are inserted after.
+    //*************************************************************************
+    template <typename TIString>
+    void add_padding(TIString& str,
+                     const size_t start,
+                     const replacement_field<typename TIString::value_type>& field,
+                     const bool numeric,
+                     const size_t prefix_length)
+    {
+      typedef typename TIString::value_type type;
+
+      const size_t length = str.size() - start;
+
+      if (field.width <= length)
+      {
+        return;
+      }
+
+      const size_t padding = field.width - length;
+
+      if (numeric && field.zero && (field.align == 0))
+      {
+        str.insert(str.begin() + start + prefix_length, padding, type('0'));
+        return;
+      }
+
+      const char align = (field.align != 0) ? field.align : (numeric ? '>' : '<');
+
+      if (align == '<')
+      {
+        str.append(padding, field.fill);
+      }
+      else if (align == '>')
+      {
+        str.insert(str.begin() + start, padding, field.fill);
+      }
+      else
+      {
+        str.insert(str.begin() + start, padding / 2U, field.fill);
+        str.append(padding - (padding / 2U), field.fill);
+      }
+    }
+
+    //*************************************************************************
+    /// Formats an integral.
+    //*************************************************************************
+    template <typename TIString, typename T>
+    void format_argument(TIString& str, const replacement_field<typename TIString::value_type>& field, const T value, etl::integral_constant<int, integral_argument>)
+    {
+      typedef typename TIString::value_type type;
+
+      // The magnitude is formatted, so that other bases keep the sign too.
+      typedef typename etl::conditional<(sizeof(T) > sizeof(uint32_t)), uint64_t, uint32_t>::type unsigned_type;
+
+      const bool          negative  = etl::is_negative(value);
+      const unsigned_type magnitude = negative ? unsigned_type(unsigned_type(0U) - unsigned_type(value)) : unsigned_type(value);
+
+      etl::basic_format_spec<TIString> format;
+
+      switch (field.type)
+      {
+        case 'x':
+        case 'X':
+        {
+          format.hex();
+          break;
+        }
+
+        case 'o':
+        {
+          format.octal();
+          break;
+        }
+
+        case 'b':
+        case 'B':
+        {
+          format.binary();
+          break;
+        }
+
+        default:
+        {
+          break;
+        }
+      }
+
+      format.upper_case(field.type == 'X');
+
+      const size_t start = str.size();
+
+      if (negative)
+      {
+        str.push_back(type('-'));
+      }
+      else if (field.sign != 0)
+      {
+        str.push_back(type(field.sign));
+      }
+
+      if (field.alternate && (format.get_base() != 10U))
+      {
+        if ((format.get_base() != 8U) || (magnitude != 0U))
+        {
+          str.push_back(type('0'));
+        }
+
+        if (format.get_base() != 8U)
+        {
+          str.push_back(type(field.type));
+        }
+      }
+
+      const size_t prefix_length = str.size() - start;
+
+      if ((prefix_length == 0U) && (field.align != '^'))
+      {
+        // The integral formatter pads in place.
+        const bool zero = field.zero && (field.align == 0);
+
+        format.width(field.width).fill(zero ? type('0') : field.fill);
+
+        if (field.align == '<')
+        {
+          format.left();
+        }
+
+        etl::private_to_string::add_integral(magnitude, str, format, true);
+      }
+      else
+      {
+        etl::private_to_string::add_integral(magnitude, str, format, true);
+
+        add_padding(str, start, field, true, prefix_length);
+      }
+    }
+
+    //*************************************************************************
+    /// Formats a floating point value.
+    //*************************************************************************
+    template <typename TIString, typename T>
+    void format_argument(TIString& str, const replacement_field<typename TIString::value_type>& field, const T value, etl::integral_constant<int, floating_point_argument>)
+    {
+      typedef typename TIString::value_type type;
+
+      etl::basic_format_spec<TIString> format;
+
+      if ((field.type == 0) && (field.precision < 0))
+      {
+        format.shortest(true);
+      }
+      else
+      {
+        format.precision((field.precision < 0) ? 6U : uint32_t(field.precision));
+      }
+
+      const size_t start = str.size();
+
+      if ((field.sign != 0) && !(value < T(0)))
+      {
+        str.push_back(type(field.sign));
+      }
+
+      etl::private_to_string::add_floating_point(value, str, format, true);
+
+      const bool   has_sign      = (str.size() > start) && ((str[start] == type('-')) || (str[start] == type('+')) || (str[start] == type(' ')));
+      const size_t prefix_length = has_sign ? 1U : 0U;
+
+      add_padding(str, start, field, true, prefix_length);
+    }
+
+    //*************************************************************************
+    /// Formats a bool.
+    //*************************************************************************
+    template <typename TIString>
+    void format_argument(TIString& str, const replacement_field<typename TIString::value_type>& field, const bool value, etl::integral_constant<int, bool_argument>)
+    {
+      etl::basic_format_spec<TIString> format;
+      format.boolalpha(true);
+
+      const size_t start = str.size();
+
+      etl::private_to_string::add_boolean(value, str, format, true);
+
+      add_padding(str, start, field, false, 0U);
+    }
+
+    //*************************************************************************
+    /// Formats a character.
+    //*************************************************************************
+    template <typename TIString>
+    void format_argument(TIString& str, const replacement_field<typename TIString::value_type>& field, const typename TIString::value_type value, etl::integral_constant<int, char_argument>)
+    {
+      const size_t start = str.size();
+
+      str.push_back(value);
+
+      add_padding(str, start, field, false, 0U);
+    }
+
+    //*************************************************************************
+    /// Formats a null terminated string.
+    //*************************************************************************
+    template <typename TIString>
+    void format_string(TIString& str, const typename TIString::value_type* value, etl::false_type)
+    {
+      str.append(value);
+    }
+
+    //*************************************************************************
+    /// Formats an etl::basic_string or etl::basic_string_view.
+    //*************************************************************************
+    template <typename TIString, typename TString>
+    void format_string(TIString& str, const TString& value, etl::true_type)
+    {
+      str.append(value.begin(), value.end());
+    }
+
+    //*************************************************************************
+    /// Formats a string.
+    //*************************************************************************
+    template <typename TIString, typename T>
+    void format_argument(TIString& str, const replacement_field<typename TIString::value_type>& field, const T& value, etl::integral_constant<int, string_argument>)
+    {
+      const size_t start = str.size();
+
+      format_string(str, value, etl::integral_constant<bool, !(etl::is_pointer<T>::value || etl::is_array<T>::value)>());
+
+      add_padding(str, start, field, false, 0U);
+    }
+
+    //*************************************************************************
+    /// Copies the rest of the format, when there are no more arguments.
+    //*************************************************************************
+    template <typename TIString>
+    void format_next(TIString& str, const typename TIString::value_type* p)
+    {
+      if (copy_literal(str, p) != 0)
+      {
+        // More fields than arguments.
+        ETL_ASSERT(false, ETL_ERROR(format_invalid));
+      }
+    }
+
+    //*************************************************************************
+    /// Copies the format up to the next field, then formats the next argument.
+    //*************************************************************************
+    template <typename TIString, typename T, typename... TArgs>
+    void format_next(TIString& str, const typename TIString::value_type* p, const T& value, const TArgs&... args)
+    {
+      typedef typename TIString::value_type type;
+
+      const category kind = argument_category<T, type>::value;
+
+      ETL_STATIC_ASSERT(kind != unsupported_argument, "Unsupported argument type");
+
+      p = copy_literal(str, p);
+
+      if (p == 0)
+      {
+        // More arguments than fields.
+        return;
+      }
+
+      replacement_field<type> field;
+      p = parse_field(p, field);
+
+      if ((p == 0) || !is_valid_field(field, kind))
+      {
+        ETL_ASSERT(false, ETL_ERROR(format_invalid));
+        return;
+      }
+
+      format_argument(str, field, value, etl::integral_constant<int, kind>());
+
+      format_next(str, p, args...);
+    }
+
+    //*************************************************************************
+    /// The type made by ETL_FORMAT_STRING.
+    /// TProvider::get() returns the format string as a constant expression.
+    //*************************************************************************
+    template <typename TProvider>
+    struct checked_format_string
+    {
+    };
+  }
+
+  //***************************************************************************
+  /// Formats the arguments and appends them to the string.
+  ///\param str    The string to append to. The output is truncated at its capacity.
+  ///\param format The null terminated format string.
+  ///\param args   The arguments.
+  ///\return A reference to the string.
+  ///\ingroup format
+  //***************************************************************************
+  template <typename TIString, typename... TArgs>
+  TIString& format_to(TIString& str, const typename TIString::value_type* format, const TArgs&... args)
+  {
+    typedef etl::ibasic_string<typename TIString::value_type> istring_type;
+
+    // Formats through the base class, so that one instantiation serves all capacities.
+    etl::private_format::format_next(static_cast<istring_type&>(str), format, args...);
+
+    return str;
+  }
+
+  //***************************************************************************
+  /// Formats the arguments and appends them to the string.
+  /// The format string, made with ETL_FORMAT_STRING, is checked against the
+  /// arguments at compile time for C++14 and above.
+  ///\ingroup format
+  //***************************************************************************
+  template <typename TIString, typename TProvider, typename... TArgs>
+  TIString& format_to(TIString& str, const etl::private_format::checked_format_string<TProvider>&, const TArgs&... args)
+  {
+#if ETL_CPP14_SUPPORTED
+    typedef typename TIString::value_type type;
+    typedef etl::private_format::argument_categories<type, TArgs...> categories;
+
+    static_assert(etl::private_format::is_valid_format<type>(TProvider::get(), categories::values, sizeof...(TArgs)),
+                  "The format string does not match the arguments");
+#endif
+
+    return etl::format_to(str, TProvider::get(), args...);
+  }
+}
+
+//*****************************************************************************
+/// Makes a format string that etl::format_to can check at compile time.
+///\ingroup format
+//*****************************************************************************
+#define ETL_FORMAT_STRING(text) \
+  [] { \
+    struct provider \
+    { \
+      static constexpr decltype(&text[0]) get() { return text; } \
+    }; \
+    return etl::private_format::checked_format_string<provider>(); \
+  }()
+
+#endif
+
+#undef ETL_FILE
+
+#endif
@@ -0,0 +1,584 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_INDEXED_PRIORITY_QUEUE_INCLUDED
+#define ETL_INDEXED_PRIORITY_QUEUE_INCLUDED
+
+#include <stddef.h>
+#include <new>
+
+#include "platform.h"
+
+#include "stl/algorithm.h"
+#include "stl/functional.h"
+
+#include "alignment.h"
+#include "type_traits.h"
+#include "parameter_type.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "static_assert.h"
+
+#undef ETL_FILE
+#define ETL_FILE "58"
+
+//*****************************************************************************
+///\defgroup indexed_priority_queue indexed_priority_queue
+/// A priority queue with the capacity defined at compile time, that returns
+/// a stable handle for each pushed value. The handle may be used to change the
+/// priority of, or erase, the value while it is in the queue.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for indexed_priority_queue exceptions.
+  ///\ingroup indexed_priority_queue
+  //***************************************************************************
+  class indexed_priority_queue_exception : public exception
+  {
+  public:
+
+    indexed_priority_queue_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when the queue is full.
+  ///\ingroup indexed_priority_queue
+  //***************************************************************************
+  class indexed_priority_queue_full : public indexed_priority_queue_exception
+  {
+  public:
+
+    indexed_priority_queue_full(string_type file_name_, numeric_type line_number_)
+      : indexed_priority_queue_exception(ETL_ERROR_TEXT("indexed_priority_queue:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when a handle does not refer to a value in the queue.
+  ///\ingroup indexed_priority_queue
+  //***************************************************************************
+  class indexed_priority_queue_invalid_handle : public indexed_priority_queue_exception
+  {
+  public:
+
+    indexed_priority_queue_invalid_handle(string_type file_name_, numeric_type line_number_)
+      : indexed_priority_queue_exception(ETL_ERROR_TEXT("indexed_priority_queue:invalid handle", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  ///\ingroup indexed_priority_queue
+  ///\brief The base for all indexed priority queues that contain a particular type.
+  ///\details The values are held in fixed slots and the heap is built from the
+  /// slot numbers, so a value never moves once pushed and its slot number is
+  /// used as its handle. A second array maps each slot to its position in the
+  /// heap, which allows update() and erase() to find the value in O(1) and
+  /// restore the heap in O(log N).
+  /// The slots that are not in use are kept in the heap array after the last
+  /// live entry, so no free list is needed.
+  /// \tparam T        The type of value that the queue holds.
+  /// \tparam TCompare The comparison used to order the values.
+  /// \tparam ARITY    The number of children of each node of the heap.
+  //***************************************************************************
+  template <typename T, typename TCompare = std::less<T>, const size_t ARITY = 4>
+  class iindexed_priority_queue
+  {
+    ETL_STATIC_ASSERT(ARITY >= 2, "The heap arity must be at least 2");
+
+  public:
+
+    typedef T        value_type;      ///< The type stored in the queue.
+    typedef TCompare compare_type;    ///< The comparison type.
+    typedef T&       reference;       ///< A reference to the type used in the queue.
+    typedef const T& const_reference; ///< A const reference to the type used in the queue.
+    typedef size_t   size_type;       ///< The type used for determining the size of the queue.
+    typedef size_t   handle_type;     ///< The type used to identify a value in the queue.
+
+  private:
+
+    typedef typename etl::parameter_type<T>::type parameter_t;
+
+  public:
+
+    //*************************************************************************
+    /// Gets a const reference to the highest priority value in the queue.
+    /// \return A const reference to the highest priority value.
+    //*************************************************************************
+    const_reference top() const
+    {
+      return p_values[p_heap[0]];
+    }
+
+    //*************************************************************************
+    /// Gets the handle of the highest priority value in the queue.
+    //*************************************************************************
+    handle_type top_handle() const
+    {
+      return p_heap[0];
+    }
+
+    //*************************************************************************
+    /// Adds a value to the queue.
+    /// If asserts or exceptions are enabled, throws an etl::indexed_priority_queue_full
+    /// if the queue is already full.
+    ///\param value The value to push to the queue.
+    ///\return The handle of the new value.
+    //*************************************************************************
+    handle_type push(parameter_t value)
+    {
+      ETL_ASSERT(!full(), ETL_ERROR(etl::indexed_priority_queue_full));
+
+      // The first unused slot is held just after the live part of the heap.
+      const handle_type handle = p_heap[current_size];
+
+      ::new (&p_values[handle]) T(value);
+      sift_up(current_size++);
+
+      return handle;
+    }
+
+    //*************************************************************************
+    /// Removes the highest priority value from the queue.
+    /// Does nothing if the queue is empty.
+    //*************************************************************************
+    void pop()
+    {
+      if (!empty())
+      {
+        remove_at(0);
+      }
+    }
+
+    //*************************************************************************
+    /// Gets the highest priority value in the queue and assigns it to destination
+    /// and removes it from the queue.
+    //*************************************************************************
+    void pop_into(reference destination)
+    {
+      destination = top();
+      pop();
+    }
+
+    //*************************************************************************
+    /// Gets a const reference to the value with the handle.
+    /// If asserts or exceptions are enabled, throws an etl::indexed_priority_queue_invalid_handle
+    /// if the handle does not refer to a value in the queue.
+    //*************************************************************************
+    const_reference get(handle_type handle) const
+    {
+      ETL_ASSERT(contains(handle), ETL_ERROR(etl::indexed_priority_queue_invalid_handle));
+
+      return p_values[handle];
+    }
+
+    //*************************************************************************
+    /// Replaces the value with the handle and moves it to its new place in the queue.
+    /// If asserts or exceptions are enabled, throws an etl::indexed_priority_queue_invalid_handle
+    /// if the handle does not refer to a value in the queue.
+    ///\param handle The handle returned by push.
+    ///\param value  The new value.
+    //*************************************************************************
+    void update(handle_type handle, parameter_t value)
+    {
+      ETL_ASSERT(contains(handle), ETL_ERROR(etl::indexed_priority_queue_invalid_handle));
+
+      if (contains(handle))
+      {
+        p_values[handle] = value;
+
+        const size_type index = p_position[handle];
+
+        if (!sift_up(index))
+        {
+          sift_down(index);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Removes the value with the handle from the queue.
+    /// If asserts or exceptions are enabled, throws an etl::indexed_priority_queue_invalid_handle
+    /// if the handle does not refer to a value in the queue.
+    ///\param handle The handle returned by push.
+    //*************************************************************************
+    void erase(handle_type handle)
+    {
+      ETL_ASSERT(contains(handle), ETL_ERROR(etl::indexed_priority_queue_invalid_handle));
+
+      if (contains(handle))
+      {
+        remove_at(p_position[handle]);
+      }
+    }
+
+    //*************************************************************************
+    /// Checks whether the handle refers to a value in the queue.
+    /// A handle becomes invalid when its value is popped or erased, and may be
+    /// returned again by a later push.
+    //*************************************************************************
+    bool contains(handle_type handle) const
+    {
+      return (handle < CAPACITY) && (p_position[handle] < current_size);
+    }
+
+    //*************************************************************************
+    /// Returns the current number of items in the queue.
+    //*************************************************************************
+    size_type size() const
+    {
+      return current_size;
+    }
+
+    //*************************************************************************
+    /// Returns the maximum number of items that can be queued.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the queue is empty.
+    /// \return <b>true</b> if the queue is empty, otherwise <b>false</b>
+    //*************************************************************************
+    bool empty() const
+    {
+      return current_size == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the queue is full.
+    /// \return <b>true</b> if the queue is full, otherwise <b>false</b>
+    //*************************************************************************
+    bool full() const
+    {
+      return current_size == CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_type available() const
+    {
+      return max_size() - size();
+    }
+
+    //*************************************************************************
+    /// Clears the queue to the empty state.
+    //*************************************************************************
+    void clear()
+    {
+      for (size_type i = 0; i < current_size; ++i)
+      {
+        p_values[p_heap[i]].~T();
+      }
+
+      current_size = 0;
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    /// The handles of the copied values are preserved.
+    //*************************************************************************
+    iindexed_priority_queue& operator = (const iindexed_priority_queue& rhs)
+    {
+      if (&rhs != this)
+      {
+        clone(rhs);
+      }
+
+      return *this;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Make this a clone of the supplied queue.
+    /// The handles of the copied values are preserved.
+    //*************************************************************************
+    void clone(const iindexed_priority_queue& other)
+    {
+      ETL_ASSERT(other.CAPACITY <= CAPACITY, ETL_ERROR(etl::indexed_priority_queue_full));
+
+      clear();
+
+      if (other.CAPACITY > CAPACITY)
+      {
+        return;
+      }
+
+      // Slots beyond the other queue's capacity stay unused.
+      for (size_type i = 0; i < other.CAPACITY; ++i)
+      {
+        p_heap[i]     = other.p_heap[i];
+        p_position[i] = other.p_position[i];
+      }
+
+      for (size_type i = other.CAPACITY; i < CAPACITY; ++i)
+      {
+        p_heap[i]     = i;
+        p_position[i] = i;
+      }
+
+      for (size_type i = 0; i < other.current_size; ++i)
+      {
+        const handle_type handle = p_heap[i];
+        ::new (&p_values[handle]) T(other.p_values[handle]);
+      }
+
+      current_size = other.current_size;
+    }
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    //*************************************************************************
+    iindexed_priority_queue(T* p_values_, handle_type* p_heap_, size_type* p_position_, size_type max_size_)
+      : p_values(p_values_),
+        p_heap(p_heap_),
+        p_position(p_position_),
+        current_size(0),
+        CAPACITY(max_size_)
+    {
+      for (size_type i = 0; i < CAPACITY; ++i)
+      {
+        p_heap[i]     = i;
+        p_position[i] = i;
+      }
+    }
+
+  private:
+
+    // Disable copy construction.
+    iindexed_priority_queue(const iindexed_priority_queue&);
+
+    //*************************************************************************
+    /// Removes the value at the heap position.
+    //*************************************************************************
+    void remove_at(size_type index)
+    {
+      const handle_type handle = p_heap[index];
+      const size_type   last   = --current_size;
+
+      // Swap the last live entry into the hole. The removed slot ends up at the
+      // start of the unused part of the heap, ready for the next push.
+      place(index, p_heap[last]);
+      place(last, handle);
+
+      p_values[handle].~T();
+
+      if ((index < last) && !sift_up(index))
+      {
+        sift_down(index);
+      }
+    }
+
+    //*************************************************************************
+    /// Puts the slot at the heap position and records where it is.
+    //*************************************************************************
+    void place(size_type index, handle_type handle)
+    {
+      p_heap[index]      = handle;
+      p_position[handle] = index;
+    }
+
+    //*************************************************************************
+    /// Moves the entry at the heap position towards the root.
+    ///\return <b>true</b> if the entry moved.
+    //*************************************************************************
+    bool sift_up(size_type index)
+    {
+      const handle_type handle = p_heap[index];
+      const size_type   start  = index;
+
+      while (index > 0)
+      {
+        const size_type parent = (index - 1) / ARITY;
+
+        if (!compare(p_values[p_heap[parent]], p_values[handle]))
+        {
+          break;
+        }
+
+        place(index, p_heap[parent]);
+        index = parent;
+      }
+
+      place(index, handle);
+
+      return index != start;
+    }
+
+    //*************************************************************************
+    /// Moves the entry at the heap position away from the root.
+    //*************************************************************************
+    void sift_down(size_type index)
+    {
+      const handle_type handle = p_heap[index];
+
+      while (true)
+      {
+        const size_type first_child = (index * ARITY) + 1;
+
+        if (first_child >= current_size)
+        {
+          break;
+        }
+
+        // Find the highest priority child.
+        const size_type last_child = ((current_size - first_child) > ARITY) ? (first_child + ARITY) : current_size;
+        size_type       best_child = first_child;
+
+        for (size_type child = first_child + 1; child < last_child; ++child)
+        {
+          if (compare(p_values[p_heap[best_child]], p_values[p_heap[child]]))
+          {
+            best_child = child;
+          }
+        }
+
+        if (!compare(p_values[handle], p_values[p_heap[best_child]]))
+        {
+          break;
+        }
+
+        place(index, p_heap[best_child]);
+        index = best_child;
+      }
+
+      place(index, handle);
+    }
+
+    T*           p_values;     ///< The value slots.
+    handle_type* p_heap;       ///< The heap of slots, followed by the unused slots.
+    size_type*   p_position;   ///< The position of each slot in p_heap.
+    size_type    current_size; ///< The number of values in the queue.
+    TCompare     compare;      ///< The comparison object.
+
+    const size_type CAPACITY;  ///< The maximum number of values in the queue.
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_INDEXED_PRIORITY_QUEUE) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iindexed_priority_queue()
+    {
+    }
+#else
+  protected:
+    ~iindexed_priority_queue()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  ///\ingroup indexed_priority_queue
+  /// An indexed priority queue with the capacity defined at compile time.
+  /// \tparam T        The type this queue should support.
+  /// \tparam SIZE     The maximum capacity of the queue.
+  /// \tparam TCompare The comparison used to order the values.
+  /// \tparam ARITY    The number of children of each node of the heap.
+  //***************************************************************************
+  template <typename T, const size_t SIZE, typename TCompare = std::less<T>, const size_t ARITY = 4>
+  class indexed_priority_queue : public etl::iindexed_priority_queue<T, TCompare, ARITY>
+  {
+  private:
+
+    typedef etl::iindexed_priority_queue<T, TCompare, ARITY> base_t;
+
+  public:
+
+    typedef typename base_t::size_type   size_type;
+    typedef typename base_t::handle_type handle_type;
+
+    static const size_type MAX_SIZE = size_type(SIZE);
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    indexed_priority_queue()
+      : base_t(reinterpret_cast<T*>(&values[0]), heap, position, SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    /// The handles of the copied values are preserved.
+    //*************************************************************************
+    indexed_priority_queue(const indexed_priority_queue& rhs)
+      : base_t(reinterpret_cast<T*>(&values[0]), heap, position, SIZE)
+    {
+      base_t::clone(rhs);
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~indexed_priority_queue()
+    {
+      base_t::clear();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    indexed_priority_queue& operator = (const indexed_priority_queue& rhs)
+    {
+      if (&rhs != this)
+      {
+        base_t::clone(rhs);
+      }
+
+      return *this;
+    }
+
+  private:
+
+    /// The uninitialised value slots.
+    typename etl::aligned_storage<sizeof(T), etl::alignment_of<T>::value>::type values[SIZE];
+
+    handle_type heap[SIZE];     ///< The heap of slots.
+    size_type   position[SIZE]; ///< The position of each slot in the heap.
+  };
+}
+
+#undef ETL_FILE
+
+#endif
@@ -29,6 +29,7 @@ SOFTWARE.
 #ifndef ETL_MESSAGE_TIMER_INCLUDED
 #define ETL_MESSAGE_TIMER_INCLUDED
 
+#include <stddef.h>
 #include <stdint.h>
 #include "algorithm.h"
 
@@ -85,7 +86,8 @@ namespace etl
         id(etl::timer::id::NO_TIMER),
         previous(etl::timer::id::NO_TIMER),
         next(etl::timer::id::NO_TIMER),
-        repeating(true)
+        repeating(true),
+        slack(0)
     {
     }
 
@@ -103,7 +105,8 @@ namespace etl
         id(id_),
         previous(etl::timer::id::NO_TIMER),
         next(etl::timer::id::NO_TIMER),
-        repeating(repeating_)
+        repeating(repeating_),
+        slack(0)
     {
       if (irouter_.is_bus())
       {
@@ -140,6 +143,7 @@ namespace etl
     uint_least8_t            previous;
     uint_least8_t            next;
     bool                     repeating;
+    uint32_t                 slack;
 
   private:
 
@@ -281,6 +285,12 @@ namespace etl
         return ptimers[head];
       }
 
+      //*******************************
+      const etl::message_timer_data& front() const
+      {
+        return ptimers[head];
+      }
+
       //*******************************
       etl::timer::id::type begin()
       {
@@ -329,6 +339,27 @@ namespace etl
     };
   }
 
+  //***************************************************************************
+  /// Receives the expired messages of a message timer in batches.
+  //***************************************************************************
+  class imessage_timer_batch_handler
+  {
+  public:
+
+    virtual ~imessage_timer_batch_handler()
+    {
+    }
+
+    //*******************************************
+    /// Called for each router and destination that has expired timers.
+    /// 'messages' holds the messages of the timers, in expiry order.
+    //*******************************************
+    virtual void receive(etl::imessage_router&    router,
+                         etl::message_router_id_t destination_router_id,
+                         const etl::imessage* const* messages,
+                         size_t                   count) = 0;
+  };
+
   //***************************************************************************
   /// Interface for message timer
   //***************************************************************************
@@ -450,6 +481,8 @@ namespace etl
       {
         if ETL_IF_CONSTEXPR(ETL_TIMER_UPDATES_ENABLED)
         {
+          elapsed_time += count;
+
           // We have something to do?
           bool has_active = !active_list.empty();
 
@@ -465,22 +498,25 @@ namespace etl
 
               if (timer.repeating)
               {
-                timer.delta = timer.period;
+                timer.delta = coalesce(timer, timer.period, elapsed_time - count);
                 active_list.insert(timer.id);
               }
 
               if (timer.p_router != nullptr)
               {
-                if (timer.p_router->is_bus())
+                if (p_batch_handler != nullptr)
                 {
-                  // Send to a message bus.
-                  etl::imessage_bus& bus = static_cast<etl::imessage_bus&>(*(timer.p_router));
-                  bus.receive(timer.destination_router_id, *(timer.p_message));
+                  // Delivered with the rest of the batch.
+                  if (batch_count == MAX_BATCH)
+                  {
+                    deliver_batch();
+                  }
+
+                  p_batch_ids[batch_count++] = timer.id;
                 }
                 else
                 {
-                  // Send to a router.
-                  timer.p_router->receive(*(timer.p_message));
+                  send(timer);
                 }
               }
 
@@ -492,6 +528,11 @@ namespace etl
               // Subtract any remainder from the next due timeout.
               active_list.front().delta -= count;
             }
+
+            if (batch_count != 0U)
+            {
+              deliver_batch();
+            }
           }
 
           return true;
@@ -501,6 +542,41 @@ namespace etl
       return false;
     }
 
+    //*******************************************
+    /// Processes the timers up to the time 'now', in ticks.
+    /// For tickless operation, where 'now' is read from a monotonic clock
+    /// rather than counted by a periodic tick.
+    /// The time is counted from construction, and may wrap.
+    /// Returns true if the time was processed,
+    /// false if not.
+    //*******************************************
+    bool advance_to(uint32_t now)
+    {
+      return tick(now - elapsed_time);
+    }
+
+    //*******************************************
+    /// The time of the last processed tick.
+    //*******************************************
+    uint32_t time() const
+    {
+      return elapsed_time;
+    }
+
+    //*******************************************
+    /// The number of ticks until the next timer expires,
+    /// or etl::timer::state::INACTIVE if there are no active timers.
+    //*******************************************
+    uint32_t time_to_next_expiry() const
+    {
+      if (active_list.empty())
+      {
+        return etl::timer::state::INACTIVE;
+      }
+
+      return active_list.front().delta;
+    }
+
     //*******************************************
     /// Starts a timer.
     //*******************************************
@@ -525,7 +601,7 @@ namespace etl
               active_list.remove(timer.id, false);
             }
 
-            timer.delta = immediate_ ? 0 : timer.period;
+            timer.delta = immediate_ ? 0 : coalesce(timer, timer.period, elapsed_time);
             active_list.insert(timer.id);
             ETL_ENABLE_TIMER_UPDATES;
 
@@ -594,12 +670,72 @@ namespace etl
       return false;
     }
 
+    //*******************************************
+    /// Sets the number of ticks that a timer may expire late.
+    /// The expiry is delayed to the next multiple of a power of two no
+    /// greater than 'slack_ + 1', so that timers with similar slack expire
+    /// together in the same tick. Takes effect the next time that the
+    /// timer is started or repeats.
+    //*******************************************
+    bool set_slack(etl::timer::id::type id_, uint32_t slack_)
+    {
+      // Valid timer id?
+      if (id_ != etl::timer::id::NO_TIMER)
+      {
+        etl::message_timer_data& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != etl::timer::id::NO_TIMER)
+        {
+          uint32_t mask = 0U;
+
+          while ((mask < slack_) && (((mask << 1U) | 1U) <= slack_))
+          {
+            mask = (mask << 1U) | 1U;
+          }
+
+          timer.slack = mask;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Delivers the expiries of each tick as one call to the handler for
+    /// each router and destination, instead of one message at a time.
+    /// Returns false if the timer was not declared with a batch size.
+    //*******************************************
+    bool set_batch_handler(etl::imessage_timer_batch_handler& handler_)
+    {
+      if (MAX_BATCH == 0U)
+      {
+        return false;
+      }
+
+      p_batch_handler = &handler_;
+      return true;
+    }
+
+    //*******************************************
+    /// Returns to delivering each expiry as it occurs.
+    //*******************************************
+    void clear_batch_handler()
+    {
+      p_batch_handler = nullptr;
+    }
+
   protected:
 
     //*******************************************
     /// Constructor.
     //*******************************************
-    imessage_timer(message_timer_data* const timer_array_, const uint_least8_t  MAX_TIMERS_)
+    imessage_timer(message_timer_data* const   timer_array_,
+                   const uint_least8_t         MAX_TIMERS_,
+                   etl::timer::id::type* const p_batch_ids_      = nullptr,
+                   const etl::imessage** const p_batch_messages_ = nullptr,
+                   size_t                      MAX_BATCH_        = 0U)
       : timer_array(timer_array_),
         active_list(timer_array_),
         enabled(false),
@@ -607,6 +743,12 @@ namespace etl
         process_semaphore(0),
 #endif
         registered_timers(0),
+        elapsed_time(0),
+        p_batch_handler(nullptr),
+        p_batch_ids(p_batch_ids_),
+        p_batch_messages(p_batch_messages_),
+        batch_count(0U),
+        MAX_BATCH(MAX_BATCH_),
         MAX_TIMERS(MAX_TIMERS_)
     {
     }
@@ -620,6 +762,92 @@ namespace etl
 
   private:
 
+    //*******************************************
+    /// Adds the timer's slack to a delta, so that it expires on a multiple
+    /// of the slack's power of two.
+    /// 'now' is the time that the delta is counted from.
+    //*******************************************
+    static uint32_t coalesce(const etl::message_timer_data& timer, uint32_t delta, uint32_t now)
+    {
+      if (timer.slack != 0U)
+      {
+        const uint32_t expiry = now + delta;
+        const uint32_t extra  = ((expiry + timer.slack) & ~timer.slack) - expiry;
+
+        if (delta < (etl::timer::state::INACTIVE - extra))
+        {
+          delta += extra;
+        }
+        else
+        {
+          delta = etl::timer::state::INACTIVE - 1U;
+        }
+      }
+
+      return delta;
+    }
+
+    //*******************************************
+    /// Sends the timer's message to its router.
+    //*******************************************
+    static void send(const etl::message_timer_data& timer)
+    {
+      if (timer.p_router->is_bus())
+      {
+        // Send to a message bus.
+        etl::imessage_bus& bus = static_cast<etl::imessage_bus&>(*(timer.p_router));
+        bus.receive(timer.destination_router_id, *(timer.p_message));
+      }
+      else
+      {
+        // Send to a router.
+        timer.p_router->receive(*(timer.p_message));
+      }
+    }
+
+    //*******************************************
+    /// Passes the batched expiries to the handler, grouped by router and
+    /// destination.
+    //*******************************************
+    void deliver_batch()
+    {
+      etl::imessage_timer_batch_handler& handler = *p_batch_handler;
+
+      for (size_t i = 0U; i < batch_count; ++i)
+      {
+        if (p_batch_ids[i] != etl::timer::id::NO_TIMER)
+        {
+          etl::imessage_router* const    p_router    = timer_array[p_batch_ids[i]].p_router;
+          const etl::message_router_id_t destination = timer_array[p_batch_ids[i]].destination_router_id;
+
+          size_t count = 0U;
+
+          // Gather the rest of the expiries for this router and destination.
+          for (size_t j = i; j < batch_count; ++j)
+          {
+            if (p_batch_ids[j] != etl::timer::id::NO_TIMER)
+            {
+              const etl::message_timer_data& timer = timer_array[p_batch_ids[j]];
+
+              if ((timer.p_router == p_router) && (timer.destination_router_id == destination))
+              {
+                p_batch_messages[count++] = timer.p_message;
+                p_batch_ids[j] = etl::timer::id::NO_TIMER;
+              }
+            }
+          }
+
+          // The router is null if a handler has unregistered the timer.
+          if (p_router != nullptr)
+          {
+            handler.receive(*p_router, destination, p_batch_messages, count);
+          }
+        }
+      }
+
+      batch_count = 0U;
+    }
+
     // The array of timer data structures.
     message_timer_data* const timer_array;
 
@@ -632,6 +860,14 @@ namespace etl
     volatile etl::timer_semaphore_t process_semaphore;
 #endif
     volatile uint_least8_t registered_timers;
+    uint32_t elapsed_time;
+
+    // Batched delivery.
+    etl::imessage_timer_batch_handler* p_batch_handler;
+    etl::timer::id::type* const        p_batch_ids;
+    const etl::imessage** const        p_batch_messages;
+    size_t                             batch_count;
+    const size_t                       MAX_BATCH;
 
   public:
 
@@ -640,14 +876,41 @@ namespace etl
 
   //***************************************************************************
   /// The message timer
+  /// If BATCH_SIZE_ is not zero then the timer can deliver its expiries in
+  /// batches of up to that size to an etl::imessage_timer_batch_handler.
   //***************************************************************************
-  template <uint_least8_t MAX_TIMERS_>
+  template <uint_least8_t MAX_TIMERS_, const size_t BATCH_SIZE_ = 0U>
   class message_timer : public etl::imessage_timer
   {
   public:
 
     ETL_STATIC_ASSERT(MAX_TIMERS_ <= 254, "No more than 254 timers are allowed");
 
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    message_timer()
+      : imessage_timer(timer_array, MAX_TIMERS_, batch_ids, batch_messages, BATCH_SIZE_)
+    {
+    }
+
+  private:
+
+    message_timer_data   timer_array[MAX_TIMERS_];
+    etl::timer::id::type batch_ids[BATCH_SIZE_];
+    const etl::imessage* batch_messages[BATCH_SIZE_];
+  };
+
+  //***************************************************************************
+  /// The message timer without batched delivery.
+  //***************************************************************************
+  template <uint_least8_t MAX_TIMERS_>
+  class message_timer<MAX_TIMERS_, 0U> : public etl::imessage_timer
+  {
+  public:
+
+    ETL_STATIC_ASSERT(MAX_TIMERS_ <= 254, "No more than 254 timers are allowed");
+
     //*******************************************
     /// Constructor.
     //*******************************************
@@ -31,7 +31,34 @@ SOFTWARE.
 
 #include "platform.h"
 
-#if ETL_CPP11_SUPPORTED == 1 && !defined(ETL_NO_STL)
+///\defgroup mutex mutex
+///\ingroup utilities
+
+// The spin, ticket and futex mutexes may be used directly, or selected as
+// etl::mutex by defining ETL_MUTEX_SPIN, ETL_MUTEX_TICKET or ETL_MUTEX_FUTEX.
+#include "mutex/mutex_spin.h"
+#include "mutex/mutex_ticket.h"
+#include "mutex/mutex_futex.h"
+
+#if defined(ETL_MUTEX_SPIN)
+  namespace etl
+  {
+    typedef etl::spin_mutex mutex;
+  }
+  #define ETL_HAS_MUTEX 1
+#elif defined(ETL_MUTEX_TICKET)
+  namespace etl
+  {
+    typedef etl::ticket_mutex mutex;
+  }
+  #define ETL_HAS_MUTEX 1
+#elif defined(ETL_MUTEX_FUTEX)
+  namespace etl
+  {
+    typedef etl::futex_mutex mutex;
+  }
+  #define ETL_HAS_MUTEX 1
+#elif ETL_CPP11_SUPPORTED == 1 && !defined(ETL_NO_STL)
   #include "mutex/mutex_std.h"
   #define ETL_HAS_MUTEX 1
 #elif defined(ETL_COMPILER_ARM)
@@ -0,0 +1,130 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_MUTEX_BACKOFF_INCLUDED
+#define ETL_MUTEX_BACKOFF_INCLUDED
+
+#include "../platform.h"
+
+#include <stdint.h>
+
+// The maximum number of relax instructions in one backoff step.
+#if !defined(ETL_MUTEX_BACKOFF_LIMIT)
+  #define ETL_MUTEX_BACKOFF_LIMIT 1024
+#endif
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup mutex
+  /// Contention counters for the spin, ticket and futex mutexes.
+  /// Maintained when ETL_MUTEX_STATISTICS is defined.
+  /// The counters are updated by the thread holding the lock.
+  //***************************************************************************
+  struct mutex_statistics
+  {
+    mutex_statistics()
+      : acquisitions(0U)
+      , spins(0U)
+      , parks(0U)
+    {
+    }
+
+    void clear()
+    {
+      acquisitions = 0U;
+      spins        = 0U;
+      parks        = 0U;
+    }
+
+    uint32_t acquisitions; ///< The number of times the lock was taken.
+    uint32_t spins;        ///< The number of backoff steps while waiting.
+    uint32_t parks;        ///< The number of times a waiter was put to sleep.
+  };
+
+  //***************************************************************************
+  ///\ingroup mutex
+  /// Exponential backoff for spin waits.
+  /// Each call to pause() executes twice as many relax instructions as the
+  /// last, up to ETL_MUTEX_BACKOFF_LIMIT.
+  //***************************************************************************
+  class spin_backoff
+  {
+  public:
+
+    spin_backoff()
+      : delay(1U)
+      , steps(0U)
+    {
+    }
+
+    //*************************************************************************
+    /// Waits for the current delay, then doubles it.
+    //*************************************************************************
+    void pause()
+    {
+      wait(delay);
+
+      if (delay < ETL_MUTEX_BACKOFF_LIMIT)
+      {
+        delay <<= 1U;
+      }
+
+      ++steps;
+    }
+
+    //*************************************************************************
+    /// Waits for 'count' relax instructions.
+    //*************************************************************************
+    static void wait(uint32_t count)
+    {
+      for (uint32_t i = 0U; i < count; ++i)
+      {
+        ETL_CPU_RELAX();
+      }
+    }
+
+    //*************************************************************************
+    /// The number of times pause() has been called.
+    //*************************************************************************
+    uint32_t count() const
+    {
+      return steps;
+    }
+
+  private:
+
+    uint32_t delay;
+    uint32_t steps;
+  };
+}
+
+#endif
@@ -0,0 +1,210 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_MUTEX_FUTEX_INCLUDED
+#define ETL_MUTEX_FUTEX_INCLUDED
+
+#include "../platform.h"
+
+#if defined(__linux__) && defined(ETL_COMPILER_GCC)
+
+#include "mutex_backoff.h"
+
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// The number of backoff steps before a waiter is parked.
+#if !defined(ETL_MUTEX_FUTEX_SPIN_LIMIT)
+  #define ETL_MUTEX_FUTEX_SPIN_LIMIT 8
+#endif
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup mutex
+  ///\brief A blocking mutex for Linux, built on futex.
+  /// Contended waiters spin with exponential backoff for a bounded number of
+  /// steps, then sleep in the kernel until the holder releases the lock.
+  /// Unlock only makes a system call when there may be a sleeping waiter.
+  /// Use this rather than a spin lock when threads can outnumber cores.
+  //***************************************************************************
+  class futex_mutex
+  {
+  public:
+
+    futex_mutex()
+      : state(UNLOCKED)
+    {
+    }
+
+    //*************************************************************************
+    /// Takes the lock, sleeping if it is not released within the spin limit.
+    //*************************************************************************
+    void lock()
+    {
+      int32_t current = UNLOCKED;
+
+      if (!__atomic_compare_exchange_n(&state, &current, LOCKED, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+      {
+        lock_contended(current);
+      }
+#if defined(ETL_MUTEX_STATISTICS)
+      else
+      {
+        ++statistics.acquisitions;
+      }
+#endif
+    }
+
+    //*************************************************************************
+    /// Takes the lock if it is available.
+    ///\return <b>true</b> if the lock was taken.
+    //*************************************************************************
+    bool try_lock()
+    {
+      int32_t current = UNLOCKED;
+
+      if (__atomic_compare_exchange_n(&state, &current, LOCKED, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+      {
+#if defined(ETL_MUTEX_STATISTICS)
+        ++statistics.acquisitions;
+#endif
+        return true;
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Releases the lock, waking one sleeping waiter if there are any.
+    //*************************************************************************
+    void unlock()
+    {
+      if (__atomic_exchange_n(&state, UNLOCKED, __ATOMIC_RELEASE) == CONTENDED)
+      {
+        syscall(SYS_futex, &state, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+      }
+    }
+
+#if defined(ETL_MUTEX_STATISTICS)
+    //*************************************************************************
+    /// Gets the contention counters.
+    /// Call while holding the lock, or when idle, for a consistent snapshot.
+    //*************************************************************************
+    const etl::mutex_statistics& get_statistics() const
+    {
+      return statistics;
+    }
+
+    //*************************************************************************
+    /// Clears the contention counters.
+    //*************************************************************************
+    void clear_statistics()
+    {
+      statistics.clear();
+    }
+#endif
+
+  private:
+
+    // Disabled.
+    futex_mutex(const futex_mutex&);
+    futex_mutex& operator =(const futex_mutex&);
+
+    enum
+    {
+      UNLOCKED  = 0, ///< Free.
+      LOCKED    = 1, ///< Held, no sleeping waiters.
+      CONTENDED = 2  ///< Held, there may be sleeping waiters.
+    };
+
+    //*************************************************************************
+    /// The slow path of lock().
+    //*************************************************************************
+    void lock_contended(int32_t current)
+    {
+      etl::spin_backoff backoff;
+
+      // Spin while the holder might release soon and nobody is asleep.
+      while ((current != CONTENDED) && (backoff.count() < ETL_MUTEX_FUTEX_SPIN_LIMIT))
+      {
+        backoff.pause();
+
+        current = __atomic_load_n(&state, __ATOMIC_RELAXED);
+
+        if (current == UNLOCKED)
+        {
+          if (__atomic_compare_exchange_n(&state, &current, LOCKED, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+          {
+#if defined(ETL_MUTEX_STATISTICS)
+            ++statistics.acquisitions;
+            statistics.spins += backoff.count();
+#endif
+            return;
+          }
+        }
+      }
+
+#if defined(ETL_MUTEX_STATISTICS)
+      uint32_t parks = 0U;
+#endif
+
+      // Mark the lock as contended and sleep until it is released.
+      // The lock is taken in the contended state, as other threads may still be asleep.
+      while (__atomic_exchange_n(&state, CONTENDED, __ATOMIC_ACQUIRE) != UNLOCKED)
+      {
+        syscall(SYS_futex, &state, FUTEX_WAIT_PRIVATE, CONTENDED, 0, 0, 0);
+
+#if defined(ETL_MUTEX_STATISTICS)
+        ++parks;
+#endif
+      }
+
+#if defined(ETL_MUTEX_STATISTICS)
+      ++statistics.acquisitions;
+      statistics.spins += backoff.count();
+      statistics.parks += parks;
+#endif
+    }
+
+    int32_t state;
+
+#if defined(ETL_MUTEX_STATISTICS)
+    etl::mutex_statistics statistics;
+#endif
+  };
+}
+
+#endif
+
+#endif
@@ -46,7 +46,6 @@ namespace etl
     mutex()
       : flag(0)
     {
-      __sync_lock_release(flag);
     }
 
     void lock()
@@ -55,17 +54,19 @@ namespace etl
       {
         while (flag)
         {
+          ETL_CPU_RELAX();
         }
+      }
     }
 
     bool try_lock()
     {
-      return (__sync_lock_test_and_set(&flag, 1U) == 1U);
+      return (__sync_lock_test_and_set(&flag, 1U) == 0U);
     }
 
     void unlock()
     {
-      __sync_lock_release(flag);
+      __sync_lock_release(&flag);
     }
 
   private:
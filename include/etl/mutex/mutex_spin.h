@@ -0,0 +1,144 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_MUTEX_SPIN_INCLUDED
+#define ETL_MUTEX_SPIN_INCLUDED
+
+#include "../platform.h"
+#include "../atomic.h"
+
+#if ETL_HAS_ATOMIC
+
+#include "mutex_backoff.h"
+
+#include <stdint.h>
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup mutex
+  ///\brief A test and test-and-set spin lock with exponential backoff.
+  /// Waiters spin on a plain load, so the cache line is only written when the
+  /// lock looks free, and back off exponentially after each failed attempt.
+  /// Not fair; suited to short critical sections with few contenders.
+  //***************************************************************************
+  class spin_mutex
+  {
+  public:
+
+    spin_mutex()
+      : flag(0U)
+    {
+    }
+
+    //*************************************************************************
+    /// Takes the lock, spinning until it is available.
+    //*************************************************************************
+    void lock()
+    {
+      etl::spin_backoff backoff;
+
+      while (flag.exchange(1U, etl::memory_order_acquire) != 0U)
+      {
+        do
+        {
+          backoff.pause();
+        } while (flag.load(etl::memory_order_relaxed) != 0U);
+      }
+
+#if defined(ETL_MUTEX_STATISTICS)
+      ++statistics.acquisitions;
+      statistics.spins += backoff.count();
+#endif
+    }
+
+    //*************************************************************************
+    /// Takes the lock if it is available.
+    ///\return <b>true</b> if the lock was taken.
+    //*************************************************************************
+    bool try_lock()
+    {
+      if ((flag.load(etl::memory_order_relaxed) == 0U) &&
+          (flag.exchange(1U, etl::memory_order_acquire) == 0U))
+      {
+#if defined(ETL_MUTEX_STATISTICS)
+        ++statistics.acquisitions;
+#endif
+        return true;
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Releases the lock.
+    //*************************************************************************
+    void unlock()
+    {
+      flag.store(0U, etl::memory_order_release);
+    }
+
+#if defined(ETL_MUTEX_STATISTICS)
+    //*************************************************************************
+    /// Gets the contention counters.
+    /// Call while holding the lock, or when idle, for a consistent snapshot.
+    //*************************************************************************
+    const etl::mutex_statistics& get_statistics() const
+    {
+      return statistics;
+    }
+
+    //*************************************************************************
+    /// Clears the contention counters.
+    //*************************************************************************
+    void clear_statistics()
+    {
+      statistics.clear();
+    }
+#endif
+
+  private:
+
+    // Disabled.
+    spin_mutex(const spin_mutex&);
+    spin_mutex& operator =(const spin_mutex&);
+
+    etl::atomic<uint32_t> flag;
+
+#if defined(ETL_MUTEX_STATISTICS)
+    etl::mutex_statistics statistics;
+#endif
+  };
+}
+
+#endif
+
+#endif
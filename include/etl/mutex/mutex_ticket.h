@@ -0,0 +1,164 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_MUTEX_TICKET_INCLUDED
+#define ETL_MUTEX_TICKET_INCLUDED
+
+#include "../platform.h"
+#include "../atomic.h"
+
+#if ETL_HAS_ATOMIC
+
+#include "mutex_backoff.h"
+
+#include <stdint.h>
+
+// The number of relax instructions per waiter ahead in the queue.
+#if !defined(ETL_MUTEX_TICKET_BACKOFF)
+  #define ETL_MUTEX_TICKET_BACKOFF 32
+#endif
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup mutex
+  ///\brief A FIFO ticket lock.
+  /// Each thread takes a ticket and waits until it is being served, so the
+  /// lock is granted in arrival order. Waiters back off in proportion to their
+  /// distance from the head of the queue.
+  /// The tickets are on separate cache lines, so taking a ticket does not
+  /// disturb the holder's release.
+  /// Not suitable when threads can outnumber cores, as a preempted thread
+  /// holding the next ticket stalls every thread behind it.
+  //***************************************************************************
+  class ticket_mutex
+  {
+  public:
+
+    ticket_mutex()
+      : next_ticket(0U)
+      , now_serving(0U)
+    {
+    }
+
+    //*************************************************************************
+    /// Takes the lock, waiting for all earlier tickets to be served.
+    //*************************************************************************
+    void lock()
+    {
+      const uint32_t ticket = next_ticket.fetch_add(1U, etl::memory_order_relaxed);
+      uint32_t serving      = now_serving.load(etl::memory_order_acquire);
+
+#if defined(ETL_MUTEX_STATISTICS)
+      uint32_t spins = 0U;
+#endif
+
+      while (serving != ticket)
+      {
+        etl::spin_backoff::wait((ticket - serving) * ETL_MUTEX_TICKET_BACKOFF);
+        serving = now_serving.load(etl::memory_order_acquire);
+
+#if defined(ETL_MUTEX_STATISTICS)
+        ++spins;
+#endif
+      }
+
+#if defined(ETL_MUTEX_STATISTICS)
+      ++statistics.acquisitions;
+      statistics.spins += spins;
+#endif
+    }
+
+    //*************************************************************************
+    /// Takes the lock if no other thread holds or is waiting for it.
+    ///\return <b>true</b> if the lock was taken.
+    //*************************************************************************
+    bool try_lock()
+    {
+      uint32_t ticket = now_serving.load(etl::memory_order_acquire);
+
+      if (next_ticket.compare_exchange_strong(ticket, ticket + 1U, etl::memory_order_acquire))
+      {
+#if defined(ETL_MUTEX_STATISTICS)
+        ++statistics.acquisitions;
+#endif
+        return true;
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Releases the lock to the next ticket holder.
+    //*************************************************************************
+    void unlock()
+    {
+      // Only the holder writes now_serving.
+      now_serving.store(now_serving.load(etl::memory_order_relaxed) + 1U, etl::memory_order_release);
+    }
+
+#if defined(ETL_MUTEX_STATISTICS)
+    //*************************************************************************
+    /// Gets the contention counters.
+    /// Call while holding the lock, or when idle, for a consistent snapshot.
+    //*************************************************************************
+    const etl::mutex_statistics& get_statistics() const
+    {
+      return statistics;
+    }
+
+    //*************************************************************************
+    /// Clears the contention counters.
+    //*************************************************************************
+    void clear_statistics()
+    {
+      statistics.clear();
+    }
+#endif
+
+  private:
+
+    // Disabled.
+    ticket_mutex(const ticket_mutex&);
+    ticket_mutex& operator =(const ticket_mutex&);
+
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<uint32_t> next_ticket;
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<uint32_t> now_serving;
+
+#if defined(ETL_MUTEX_STATISTICS)
+    etl::mutex_statistics statistics;
+#endif
+  };
+}
+
+#endif
+
+#endif
@@ -76,12 +76,48 @@ SOFTWARE.
   #define ETL_COMPILER_FULL_VERSION _MSC_FULL_VER
 #endif
 
+// Hint that the memory at the address will be read soon.
+#if defined(ETL_COMPILER_GCC)
+  #define ETL_PREFETCH(address) __builtin_prefetch(address)
+#else
+  #define ETL_PREFETCH(address)
+#endif
+
+// Hint to the processor that the thread is in a spin wait loop.
+#if defined(ETL_COMPILER_GCC) && (defined(__i386__) || defined(__x86_64__))
+  #define ETL_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(ETL_COMPILER_GCC) && (defined(__arm__) || defined(__aarch64__))
+  #define ETL_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+  #define ETL_CPU_RELAX()
+#endif
+
+// The size of a cache line, for blocking and padding data. May be defined in the profile.
+#if !defined(ETL_CACHE_LINE_SIZE)
+  #define ETL_CACHE_LINE_SIZE 64
+#endif
+
+// Aligns a type or variable to the boundary.
+#if ETL_CPP11_SUPPORTED
+  #define ETL_ALIGNAS(alignment) alignas(alignment)
+#elif defined(ETL_COMPILER_GCC)
+  #define ETL_ALIGNAS(alignment) __attribute__((aligned(alignment)))
+#else
+  #define ETL_ALIGNAS(alignment)
+#endif
+
 #if ETL_CPP11_SUPPORTED
   #define ETL_CONSTEXPR constexpr
 #else
   #define ETL_CONSTEXPR
 #endif
 
+#if ETL_CPP14_SUPPORTED
+  #define ETL_CONSTEXPR14 constexpr
+#else
+  #define ETL_CONSTEXPR14
+#endif
+
 #if ETL_CPP17_SUPPORTED
   #define ETL_IF_CONSTEXPR constexpr
 #else
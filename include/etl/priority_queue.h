@@ -37,6 +37,7 @@ SOFTWARE.
 
 #include "stl/algorithm.h"
 #include "stl/functional.h"
+#include "stl/utility.h"
 
 #include "container.h"
 #include "vector.h"
@@ -44,6 +45,7 @@ SOFTWARE.
 #include "parameter_type.h"
 #include "error_handler.h"
 #include "exception.h"
+#include "static_assert.h"
 
 #undef ETL_FILE
 #define ETL_FILE "12"
@@ -99,6 +101,139 @@ namespace etl
     }
   };
 
+  namespace private_priority_queue
+  {
+    //*************************************************************************
+    /// Moves the value at 'index' towards the root of a d-ary heap.
+    //*************************************************************************
+    template <const size_t ARITY, typename TIterator, typename TCompare>
+    void sift_up(TIterator first, size_t index, TCompare compare)
+    {
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT)
+      typename std::iterator_traits<TIterator>::value_type value = std::move(*(first + index));
+#else
+      typename std::iterator_traits<TIterator>::value_type value = *(first + index);
+#endif
+
+      while (index > 0)
+      {
+        const size_t parent = (index - 1) / ARITY;
+
+        if (!compare(*(first + parent), value))
+        {
+          break;
+        }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT)
+        *(first + index) = std::move(*(first + parent));
+#else
+        *(first + index) = *(first + parent);
+#endif
+        index = parent;
+      }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT)
+      *(first + index) = std::move(value);
+#else
+      *(first + index) = value;
+#endif
+    }
+
+    //*************************************************************************
+    /// Moves the value at 'index' away from the root of a d-ary heap of 'length' values.
+    //*************************************************************************
+    template <const size_t ARITY, typename TIterator, typename TCompare>
+    void sift_down(TIterator first, size_t index, size_t length, TCompare compare)
+    {
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT)
+      typename std::iterator_traits<TIterator>::value_type value = std::move(*(first + index));
+#else
+      typename std::iterator_traits<TIterator>::value_type value = *(first + index);
+#endif
+
+      while (true)
+      {
+        const size_t first_child = (index * ARITY) + 1;
+
+        if (first_child >= length)
+        {
+          break;
+        }
+
+        // Find the highest priority child.
+        const size_t last_child = ((length - first_child) > ARITY) ? (first_child + ARITY) : length;
+        size_t       best_child = first_child;
+
+        for (size_t child = first_child + 1; child < last_child; ++child)
+        {
+          if (compare(*(first + best_child), *(first + child)))
+          {
+            best_child = child;
+          }
+        }
+
+        if (!compare(value, *(first + best_child)))
+        {
+          break;
+        }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT)
+        *(first + index) = std::move(*(first + best_child));
+#else
+        *(first + index) = *(first + best_child);
+#endif
+        index = best_child;
+      }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT)
+      *(first + index) = std::move(value);
+#else
+      *(first + index) = value;
+#endif
+    }
+
+    //*************************************************************************
+    /// Adds the last value in the range to the d-ary heap before it.
+    //*************************************************************************
+    template <const size_t ARITY, typename TIterator, typename TCompare>
+    void push_heap(TIterator first, TIterator last, TCompare compare)
+    {
+      etl::private_priority_queue::sift_up<ARITY>(first, size_t(last - first) - 1, compare);
+    }
+
+    //*************************************************************************
+    /// Moves the highest priority value of the d-ary heap to the end of the range.
+    //*************************************************************************
+    template <const size_t ARITY, typename TIterator, typename TCompare>
+    void pop_heap(TIterator first, TIterator last, TCompare compare)
+    {
+      const size_t length = size_t(last - first) - 1;
+
+      std::swap(*first, *(first + length));
+      etl::private_priority_queue::sift_down<ARITY>(first, 0, length, compare);
+    }
+
+    //*************************************************************************
+    /// Arranges the range as a d-ary heap.
+    //*************************************************************************
+    template <const size_t ARITY, typename TIterator, typename TCompare>
+    void make_heap(TIterator first, TIterator last, TCompare compare)
+    {
+      const size_t length = size_t(last - first);
+
+      if (length > 1)
+      {
+        size_t index = ((length - 2) / ARITY) + 1;
+
+        while (index != 0)
+        {
+          --index;
+          etl::private_priority_queue::sift_down<ARITY>(first, index, length, compare);
+        }
+      }
+    }
+  }
+
   //***************************************************************************
   ///\ingroup queue
   ///\brief This is the base for all priority queues that contain a particular type.
@@ -114,10 +249,14 @@ namespace etl
   /// \tparam T The type of value that the queue holds.
   /// \tparam TContainer to hold the T queue values
   /// \tparam TCompare to use in comparing T values
+  /// \tparam ARITY The number of children of each node of the heap. Wider heaps
+  /// are shallower, so push is cheaper and pop touches fewer cache lines.
   //***************************************************************************
-  template <typename T, typename TContainer, typename TCompare = std::less<T> >
+  template <typename T, typename TContainer, typename TCompare = std::less<T>, const size_t ARITY = 2>
   class ipriority_queue
   {
+    ETL_STATIC_ASSERT(ARITY >= 2, "The heap arity must be at least 2");
+
   public:
 
     typedef T                     value_type;         ///< The type stored in the queue.
@@ -165,7 +304,7 @@ namespace etl
       // Put element at end
       container.push_back(value);
       // Make elements in container into heap
-      std::push_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::push_heap<ARITY>(container.begin(), container.end(), compare);
     }
 
 #if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_PRIORITY_QUEUE_FORCE_CPP03)
@@ -183,7 +322,7 @@ namespace etl
       // Put element at end
       container.emplace_back(std::forward<Args>(args)...);
       // Make elements in container into heap
-      std::push_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::push_heap<ARITY>(container.begin(), container.end(), compare);
     }
 #else
     //*************************************************************************
@@ -200,7 +339,7 @@ namespace etl
       // Put element at end
       container.emplace_back(value1);
       // Make elements in container into heap
-      std::push_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::push_heap<ARITY>(container.begin(), container.end(), compare);
     }
 
     //*************************************************************************
@@ -217,7 +356,7 @@ namespace etl
       // Put element at end
       container.emplace_back(value1, value2);
       // Make elements in container into heap
-      std::push_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::push_heap<ARITY>(container.begin(), container.end(), compare);
     }
 
     //*************************************************************************
@@ -234,7 +373,7 @@ namespace etl
       // Put element at end
       container.emplace_back(value1, value2, value3);
       // Make elements in container into heap
-      std::push_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::push_heap<ARITY>(container.begin(), container.end(), compare);
     }
 
     //*************************************************************************
@@ -251,7 +390,7 @@ namespace etl
       // Put element at end
       container.emplace_back(value1, value2, value3, value4);
       // Make elements in container into heap
-      std::push_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::push_heap<ARITY>(container.begin(), container.end(), compare);
     }
 #endif
 
@@ -275,7 +414,7 @@ namespace etl
 
       clear();
       container.assign(first, last);
-      std::make_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::make_heap<ARITY>(container.begin(), container.end(), compare);
     }
 
     //*************************************************************************
@@ -285,7 +424,7 @@ namespace etl
     void pop()
     {
       // Move largest element to end
-      std::pop_heap(container.begin(), container.end(), compare);
+      etl::private_priority_queue::pop_heap<ARITY>(container.begin(), container.end(), compare);
       // Actually remove largest element at end
       container.pop_back();
     }
@@ -385,9 +524,10 @@ namespace etl
   /// This queue does not support concurrent access by different threads.
   /// \tparam T    The type this queue should support.
   /// \tparam SIZE The maximum capacity of the queue.
+  /// \tparam ARITY The number of children of each node of the heap.
   //***************************************************************************
-  template <typename T, const size_t SIZE, typename TContainer = etl::vector<T, SIZE>, typename TCompare = std::less<typename TContainer::value_type> >
-  class priority_queue : public etl::ipriority_queue<T, TContainer, TCompare>
+  template <typename T, const size_t SIZE, typename TContainer = etl::vector<T, SIZE>, typename TCompare = std::less<typename TContainer::value_type>, const size_t ARITY = 2>
+  class priority_queue : public etl::ipriority_queue<T, TContainer, TCompare, ARITY>
   {
   public:
 
@@ -399,7 +539,7 @@ namespace etl
     /// Default constructor.
     //*************************************************************************
     priority_queue()
-      : etl::ipriority_queue<T, TContainer, TCompare>()
+      : etl::ipriority_queue<T, TContainer, TCompare, ARITY>()
     {
     }
 
@@ -407,9 +547,9 @@ namespace etl
     /// Copy constructor
     //*************************************************************************
     priority_queue(const priority_queue& rhs)
-      : etl::ipriority_queue<T, TContainer, TCompare>()
+      : etl::ipriority_queue<T, TContainer, TCompare, ARITY>()
     {
-      etl::ipriority_queue<T, TContainer, TCompare>::clone(rhs);
+      etl::ipriority_queue<T, TContainer, TCompare, ARITY>::clone(rhs);
     }
 
     //*************************************************************************
@@ -420,9 +560,9 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     priority_queue(TIterator first, TIterator last)
-      : etl::ipriority_queue<T, TContainer, TCompare>()
+      : etl::ipriority_queue<T, TContainer, TCompare, ARITY>()
     {
-      etl::ipriority_queue<T, TContainer, TCompare>::assign(first, last);
+      etl::ipriority_queue<T, TContainer, TCompare, ARITY>::assign(first, last);
     }
 
     //*************************************************************************
@@ -430,7 +570,7 @@ namespace etl
     //*************************************************************************
     ~priority_queue()
     {
-      etl::ipriority_queue<T, TContainer, TCompare>::clear();
+      etl::ipriority_queue<T, TContainer, TCompare, ARITY>::clear();
     }
 
     //*************************************************************************
@@ -440,7 +580,7 @@ namespace etl
     {
       if (&rhs != this)
       {
-        etl::ipriority_queue<T, TContainer, TCompare>::clone(rhs);
+        etl::ipriority_queue<T, TContainer, TCompare, ARITY>::clone(rhs);
       }
 
       return *this;
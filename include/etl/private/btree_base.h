@@ -0,0 +1,1601 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#if !defined(ETL_IN_BTREE_H)
+#error This header is a private element of etl::btree_map, etl::btree_multimap, etl::btree_set & etl::btree_multiset
+#endif
+
+#ifndef ETL_BTREE_BASE_INCLUDED
+#define ETL_BTREE_BASE_INCLUDED
+
+#include <stddef.h>
+#include <new>
+
+#include "../platform.h"
+#include "../stl/algorithm.h"
+#include "../stl/iterator.h"
+#include "../stl/utility.h"
+#include "../pool.h"
+#include "../alignment.h"
+#include "../type_traits.h"
+#include "../parameter_type.h"
+#include "../exception.h"
+#include "../error_handler.h"
+#include "../debug_count.h"
+#include "../nullptr.h"
+
+#undef ETL_FILE
+#define ETL_FILE "53"
+
+//*****************************************************************************
+/// The target size, in bytes, of a B-tree node.
+/// Nodes hold as many values or keys as fit, with a minimum of four values
+/// per leaf and eight children per internal node.
+/// Define in the profile to override.
+//*****************************************************************************
+#if !defined(ETL_BTREE_NODE_SIZE)
+  #define ETL_BTREE_NODE_SIZE 256
+#endif
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup btree
+  /// Exception base for the B-trees.
+  //***************************************************************************
+  class btree_exception : public etl::exception
+  {
+  public:
+
+    btree_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  ///\ingroup btree
+  /// B-tree full exception.
+  //***************************************************************************
+  class btree_full : public etl::btree_exception
+  {
+  public:
+
+    btree_full(string_type file_name_, numeric_type line_number_)
+      : etl::btree_exception(ETL_ERROR_TEXT("btree:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  ///\ingroup btree
+  /// B-tree out of bounds exception.
+  //***************************************************************************
+  class btree_out_of_bounds : public etl::btree_exception
+  {
+  public:
+
+    btree_out_of_bounds(string_type file_name_, numeric_type line_number_)
+      : etl::btree_exception(ETL_ERROR_TEXT("btree:bounds", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  namespace private_btree
+  {
+    //*************************************************************************
+    /// Gets the key from a key/value pair.
+    //*************************************************************************
+    template <typename TKey, typename TValue>
+    struct key_of_pair
+    {
+      static const TKey& get(const TValue& value)
+      {
+        return value.first;
+      }
+    };
+
+    //*************************************************************************
+    /// Gets the key from a key.
+    //*************************************************************************
+    template <typename TKey>
+    struct key_of_key
+    {
+      static const TKey& get(const TKey& value)
+      {
+        return value;
+      }
+    };
+  }
+
+  //***************************************************************************
+  ///\ingroup btree
+  /// The base class for all B-trees.
+  //***************************************************************************
+  class btree_base
+  {
+  public:
+
+    typedef size_t size_type;
+
+    //*************************************************************************
+    /// Gets the size of the container.
+    //*************************************************************************
+    size_type size() const
+    {
+      return current_size;
+    }
+
+    //*************************************************************************
+    /// Gets the maximum possible size of the container.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the container is empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return current_size == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the container is full.
+    //*************************************************************************
+    bool full() const
+    {
+      return current_size == CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the capacity of the container.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return max_size() - size();
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    //*************************************************************************
+    btree_base(size_type max_size_)
+      : current_size(0)
+      , CAPACITY(max_size_)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~btree_base()
+    {
+    }
+
+    size_type       current_size; ///< The number of values in the tree.
+    const size_type CAPACITY;     ///< The maximum number of values in the tree.
+    ETL_DECLARE_DEBUG_COUNT       ///< Internal debugging.
+  };
+
+  //***************************************************************************
+  ///\ingroup btree
+  /// A B+ tree with the capacity defined at compile time.
+  /// Values are held only in the leaves, which are linked in order for
+  /// iteration. Internal nodes hold copies of the separating keys.
+  /// Each node holds many values, so a lookup touches far fewer cache lines
+  /// than a binary tree of the same size.
+  ///\tparam TKey        The key type.
+  ///\tparam TValue      The value type stored in the leaves.
+  ///\tparam TKeyOfValue Gets the key from a value.
+  ///\tparam TKeyCompare The key comparison functor.
+  //***************************************************************************
+  template <typename TKey, typename TValue, typename TKeyOfValue, typename TKeyCompare>
+  class ibtree : public etl::btree_base
+  {
+  public:
+
+    typedef TKey              key_type;
+    typedef TValue            value_type;
+    typedef TKeyCompare       key_compare;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+    typedef value_type*       pointer;
+    typedef const value_type* const_pointer;
+    typedef size_t            size_type;
+
+  protected:
+
+    typedef typename etl::parameter_type<TKey>::type key_parameter_t;
+
+    typedef typename etl::remove_const<TValue>::type mutable_value_type;
+
+    static const size_t LEAF_VALUES       = (ETL_BTREE_NODE_SIZE - (5 * sizeof(void*))) / sizeof(TValue);
+    static const size_t INTERNAL_CHILDREN = (ETL_BTREE_NODE_SIZE - (3 * sizeof(void*)) + sizeof(TKey)) / (sizeof(void*) + sizeof(TKey));
+
+  public:
+
+    static const size_t LEAF_CAPACITY     = (LEAF_VALUES > 4) ? LEAF_VALUES : 4;
+    static const size_t INTERNAL_CAPACITY = (INTERNAL_CHILDREN > 8) ? INTERNAL_CHILDREN : 8;
+    static const size_t LEAF_MINIMUM      = LEAF_CAPACITY / 2;
+    static const size_t INTERNAL_MINIMUM  = INTERNAL_CAPACITY / 2;
+
+    //*************************************************************************
+    /// The number of nodes needed for MAX_SIZE values.
+    /// Every leaf but the root is at least half full, as is every internal
+    /// node but the root.
+    //*************************************************************************
+    template <const size_t MAX_SIZE>
+    struct node_count
+    {
+      static const size_t LEAVES    = (MAX_SIZE / LEAF_MINIMUM) + 1;
+      static const size_t INTERNALS = (LEAVES / (INTERNAL_MINIMUM - 1)) + 1;
+    };
+
+    struct internal_t;
+
+    //*************************************************************************
+    /// The common part of the nodes.
+    //*************************************************************************
+    struct node_t
+    {
+      internal_t* parent;
+      size_t      count;   ///< The number of values in a leaf, or children in an internal node.
+      bool        is_leaf;
+    };
+
+    //*************************************************************************
+    /// A leaf node. Holds the values.
+    //*************************************************************************
+    struct leaf_t : public node_t
+    {
+      value_type* values()
+      {
+        return reinterpret_cast<value_type*>(storage.data);
+      }
+
+      const value_type* values() const
+      {
+        return reinterpret_cast<const value_type*>(storage.data);
+      }
+
+      leaf_t* prev;
+      leaf_t* next;
+      typename etl::aligned_storage<sizeof(value_type) * LEAF_CAPACITY, etl::alignment_of<value_type>::value>::type storage;
+    };
+
+    //*************************************************************************
+    /// An internal node. Holds 'count' children and 'count - 1' keys.
+    /// All keys in children[i] are <= keys[i] <= all keys in children[i + 1].
+    //*************************************************************************
+    struct internal_t : public node_t
+    {
+      TKey* keys()
+      {
+        return reinterpret_cast<TKey*>(storage.data);
+      }
+
+      const TKey* keys() const
+      {
+        return reinterpret_cast<const TKey*>(storage.data);
+      }
+
+      node_t* children[INTERNAL_CAPACITY];
+      typename etl::aligned_storage<sizeof(TKey) * (INTERNAL_CAPACITY - 1), etl::alignment_of<TKey>::value>::type storage;
+    };
+
+    class const_iterator;
+
+    //*************************************************************************
+    /// iterator.
+    //*************************************************************************
+    class iterator : public std::iterator<std::bidirectional_iterator_tag, value_type>
+    {
+    public:
+
+      friend class ibtree;
+      friend class const_iterator;
+
+      iterator()
+        : p_btree(nullptr)
+        , p_leaf(nullptr)
+        , index(0)
+      {
+      }
+
+      iterator(const iterator& other)
+        : p_btree(other.p_btree)
+        , p_leaf(other.p_leaf)
+        , index(other.index)
+      {
+      }
+
+      iterator& operator ++()
+      {
+        if (++index == p_leaf->count)
+        {
+          p_leaf = p_leaf->next;
+          index  = 0;
+        }
+
+        return *this;
+      }
+
+      iterator operator ++(int)
+      {
+        iterator temp(*this);
+        ++(*this);
+        return temp;
+      }
+
+      iterator& operator --()
+      {
+        if (p_leaf == nullptr)
+        {
+          p_leaf = p_btree->p_last_leaf;
+          index  = p_leaf->count - 1;
+        }
+        else if (index == 0)
+        {
+          p_leaf = p_leaf->prev;
+          index  = p_leaf->count - 1;
+        }
+        else
+        {
+          --index;
+        }
+
+        return *this;
+      }
+
+      iterator operator --(int)
+      {
+        iterator temp(*this);
+        --(*this);
+        return temp;
+      }
+
+      iterator& operator =(const iterator& other)
+      {
+        p_btree = other.p_btree;
+        p_leaf  = other.p_leaf;
+        index   = other.index;
+        return *this;
+      }
+
+      reference operator *() const
+      {
+        return p_leaf->values()[index];
+      }
+
+      pointer operator &() const
+      {
+        return &p_leaf->values()[index];
+      }
+
+      pointer operator ->() const
+      {
+        return &p_leaf->values()[index];
+      }
+
+      friend bool operator == (const iterator& lhs, const iterator& rhs)
+      {
+        return (lhs.p_leaf == rhs.p_leaf) && (lhs.index == rhs.index);
+      }
+
+      friend bool operator != (const iterator& lhs, const iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      iterator(ibtree& btree, leaf_t* p_leaf_, size_t index_)
+        : p_btree(&btree)
+        , p_leaf(p_leaf_)
+        , index(index_)
+      {
+      }
+
+      ibtree* p_btree;
+      leaf_t* p_leaf;
+      size_t  index;
+    };
+
+    friend class iterator;
+
+    //*************************************************************************
+    /// const_iterator.
+    //*************************************************************************
+    class const_iterator : public std::iterator<std::bidirectional_iterator_tag, const value_type>
+    {
+    public:
+
+      friend class ibtree;
+
+      const_iterator()
+        : p_btree(nullptr)
+        , p_leaf(nullptr)
+        , index(0)
+      {
+      }
+
+      const_iterator(const typename ibtree::iterator& other)
+        : p_btree(other.p_btree)
+        , p_leaf(other.p_leaf)
+        , index(other.index)
+      {
+      }
+
+      const_iterator(const const_iterator& other)
+        : p_btree(other.p_btree)
+        , p_leaf(other.p_leaf)
+        , index(other.index)
+      {
+      }
+
+      const_iterator& operator ++()
+      {
+        if (++index == p_leaf->count)
+        {
+          p_leaf = p_leaf->next;
+          index  = 0;
+        }
+
+        return *this;
+      }
+
+      const_iterator operator ++(int)
+      {
+        const_iterator temp(*this);
+        ++(*this);
+        return temp;
+      }
+
+      const_iterator& operator --()
+      {
+        if (p_leaf == nullptr)
+        {
+          p_leaf = p_btree->p_last_leaf;
+          index  = p_leaf->count - 1;
+        }
+        else if (index == 0)
+        {
+          p_leaf = p_leaf->prev;
+          index  = p_leaf->count - 1;
+        }
+        else
+        {
+          --index;
+        }
+
+        return *this;
+      }
+
+      const_iterator operator --(int)
+      {
+        const_iterator temp(*this);
+        --(*this);
+        return temp;
+      }
+
+      const_iterator& operator =(const const_iterator& other)
+      {
+        p_btree = other.p_btree;
+        p_leaf  = other.p_leaf;
+        index   = other.index;
+        return *this;
+      }
+
+      const_reference operator *() const
+      {
+        return p_leaf->values()[index];
+      }
+
+      const_pointer operator &() const
+      {
+        return &p_leaf->values()[index];
+      }
+
+      const_pointer operator ->() const
+      {
+        return &p_leaf->values()[index];
+      }
+
+      friend bool operator == (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return (lhs.p_leaf == rhs.p_leaf) && (lhs.index == rhs.index);
+      }
+
+      friend bool operator != (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      const_iterator(const ibtree& btree, const leaf_t* p_leaf_, size_t index_)
+        : p_btree(&btree)
+        , p_leaf(p_leaf_)
+        , index(index_)
+      {
+      }
+
+      const ibtree* p_btree;
+      const leaf_t* p_leaf;
+      size_t        index;
+    };
+
+    friend class const_iterator;
+
+    typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    //*************************************************************************
+    /// Gets the beginning of the container.
+    //*************************************************************************
+    iterator begin()
+    {
+      return iterator(*this, p_first_leaf, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the beginning of the container.
+    //*************************************************************************
+    const_iterator begin() const
+    {
+      return const_iterator(*this, p_first_leaf, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the end of the container.
+    //*************************************************************************
+    iterator end()
+    {
+      return iterator(*this, nullptr, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the end of the container.
+    //*************************************************************************
+    const_iterator end() const
+    {
+      return const_iterator(*this, nullptr, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the beginning of the container.
+    //*************************************************************************
+    const_iterator cbegin() const
+    {
+      return const_iterator(*this, p_first_leaf, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the end of the container.
+    //*************************************************************************
+    const_iterator cend() const
+    {
+      return const_iterator(*this, nullptr, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the reverse beginning of the list.
+    //*************************************************************************
+    reverse_iterator rbegin()
+    {
+      return reverse_iterator(end());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse beginning of the list.
+    //*************************************************************************
+    const_reverse_iterator rbegin() const
+    {
+      return const_reverse_iterator(end());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse end of the list.
+    //*************************************************************************
+    reverse_iterator rend()
+    {
+      return reverse_iterator(begin());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse end of the list.
+    //*************************************************************************
+    const_reverse_iterator rend() const
+    {
+      return const_reverse_iterator(begin());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse beginning of the list.
+    //*************************************************************************
+    const_reverse_iterator crbegin() const
+    {
+      return const_reverse_iterator(cend());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse end of the list.
+    //*************************************************************************
+    const_reverse_iterator crend() const
+    {
+      return const_reverse_iterator(cbegin());
+    }
+
+    //*************************************************************************
+    /// Clears the container.
+    //*************************************************************************
+    void clear()
+    {
+      if (p_root != nullptr)
+      {
+        destroy_node(p_root);
+
+        p_leaf_pool->release_all();
+        p_internal_pool->release_all();
+      }
+
+      p_root       = nullptr;
+      p_first_leaf = nullptr;
+      p_last_leaf  = nullptr;
+      current_size = 0;
+      ETL_RESET_DEBUG_COUNT
+    }
+
+    //*************************************************************************
+    /// Counts the number of elements that contain the key specified.
+    ///\param key The key to search for.
+    ///\return The number of elements matching the key.
+    //*************************************************************************
+    size_type count(key_parameter_t key) const
+    {
+      return std::distance(lower_bound(key), upper_bound(key));
+    }
+
+    //*************************************************************************
+    /// Returns two iterators with bounding (lower bound, upper bound) the key.
+    //*************************************************************************
+    std::pair<iterator, iterator> equal_range(key_parameter_t key)
+    {
+      return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    //*************************************************************************
+    /// Returns two iterators with bounding (lower bound, upper bound) the key.
+    //*************************************************************************
+    std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
+    {
+      return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    //*************************************************************************
+    /// Erases the value at the specified position.
+    ///\return An iterator to the value after the erased one.
+    //*************************************************************************
+    iterator erase(iterator position)
+    {
+      return erase_value(position.p_leaf, position.index);
+    }
+
+    //*************************************************************************
+    /// Erases the value at the specified position.
+    ///\return An iterator to the value after the erased one.
+    //*************************************************************************
+    iterator erase(const_iterator position)
+    {
+      return erase_value(const_cast<leaf_t*>(position.p_leaf), position.index);
+    }
+
+    //*************************************************************************
+    /// Erases the values with the specified key.
+    ///\return The number of values erased.
+    //*************************************************************************
+    size_type erase(key_parameter_t key)
+    {
+      iterator first = lower_bound(key);
+      size_type n    = std::distance(first, upper_bound(key));
+
+      for (size_type i = 0; i < n; ++i)
+      {
+        first = erase(first);
+      }
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Erases a range of values.
+    /// Values move between leaves as the tree rebalances, so the range is
+    /// measured before any are erased.
+    ///\return An iterator to the value after the last erased one.
+    //*************************************************************************
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      iterator position(*this, const_cast<leaf_t*>(first.p_leaf), first.index);
+      size_type n = std::distance(first, last);
+
+      for (size_type i = 0; i < n; ++i)
+      {
+        position = erase(position);
+      }
+
+      return position;
+    }
+
+    //*************************************************************************
+    /// Finds a value with the specified key.
+    ///\return An iterator to the value, or end() if not found.
+    //*************************************************************************
+    iterator find(key_parameter_t key)
+    {
+      iterator i = lower_bound(key);
+
+      return ((i == end()) || kcompare(key, TKeyOfValue::get(*i))) ? end() : i;
+    }
+
+    //*************************************************************************
+    /// Finds a value with the specified key.
+    ///\return An iterator to the value, or end() if not found.
+    //*************************************************************************
+    const_iterator find(key_parameter_t key) const
+    {
+      const_iterator i = lower_bound(key);
+
+      return ((i == end()) || kcompare(key, TKeyOfValue::get(*i))) ? end() : i;
+    }
+
+    //*************************************************************************
+    /// Returns an iterator to the first value not less than the key, or end().
+    //*************************************************************************
+    iterator lower_bound(key_parameter_t key)
+    {
+      leaf_t* p_leaf = find_lower_leaf(key);
+      size_t  index  = (p_leaf == nullptr) ? 0 : leaf_lower_bound(p_leaf, key);
+
+      return make_iterator(p_leaf, index);
+    }
+
+    //*************************************************************************
+    /// Returns an iterator to the first value not less than the key, or end().
+    //*************************************************************************
+    const_iterator lower_bound(key_parameter_t key) const
+    {
+      return const_cast<ibtree*>(this)->lower_bound(key);
+    }
+
+    //*************************************************************************
+    /// Returns an iterator to the first value greater than the key, or end().
+    //*************************************************************************
+    iterator upper_bound(key_parameter_t key)
+    {
+      leaf_t* p_leaf = find_upper_leaf(key);
+      size_t  index  = (p_leaf == nullptr) ? 0 : leaf_upper_bound(p_leaf, key);
+
+      return make_iterator(p_leaf, index);
+    }
+
+    //*************************************************************************
+    /// Returns an iterator to the first value greater than the key, or end().
+    //*************************************************************************
+    const_iterator upper_bound(key_parameter_t key) const
+    {
+      return const_cast<ibtree*>(this)->upper_bound(key);
+    }
+
+    //*************************************************************************
+    /// How to compare two keys.
+    //*************************************************************************
+    key_compare key_comp() const
+    {
+      return kcompare;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    ibtree(etl::ipool& leaf_pool, etl::ipool& internal_pool, size_type max_size_)
+      : etl::btree_base(max_size_)
+      , p_leaf_pool(&leaf_pool)
+      , p_internal_pool(&internal_pool)
+      , p_root(nullptr)
+      , p_first_leaf(nullptr)
+      , p_last_leaf(nullptr)
+    {
+    }
+
+    //*************************************************************************
+    /// Initialise the container.
+    //*************************************************************************
+    void initialise()
+    {
+      clear();
+    }
+
+    //*************************************************************************
+    /// Inserts a value if its key is not already present.
+    //*************************************************************************
+    std::pair<iterator, bool> insert_unique(const_reference value)
+    {
+      const TKey& key = TKeyOfValue::get(value);
+
+      leaf_t* p_leaf = find_lower_leaf(key);
+      size_t  index  = (p_leaf == nullptr) ? 0 : leaf_lower_bound(p_leaf, key);
+
+      // The match may be the first value of the next leaf.
+      iterator i = make_iterator(p_leaf, index);
+
+      if ((i != end()) && !kcompare(key, TKeyOfValue::get(*i)))
+      {
+        return std::make_pair(i, false);
+      }
+
+      ETL_ASSERT(!full(), ETL_ERROR(btree_full));
+
+      return std::make_pair(insert_value(p_leaf, index, value), true);
+    }
+
+    //*************************************************************************
+    /// Inserts a value after any others with an equivalent key.
+    //*************************************************************************
+    iterator insert_multi(const_reference value)
+    {
+      const TKey& key = TKeyOfValue::get(value);
+
+      ETL_ASSERT(!full(), ETL_ERROR(btree_full));
+
+      leaf_t* p_leaf = find_upper_leaf(key);
+      size_t  index  = (p_leaf == nullptr) ? 0 : leaf_upper_bound(p_leaf, key);
+
+      return insert_value(p_leaf, index, value);
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Makes an iterator, stepping to the next leaf if index is past the end.
+    //*************************************************************************
+    iterator make_iterator(leaf_t* p_leaf, size_t index)
+    {
+      if ((p_leaf != nullptr) && (index == p_leaf->count))
+      {
+        p_leaf = p_leaf->next;
+        index  = 0;
+      }
+
+      return iterator(*this, p_leaf, index);
+    }
+
+    //*************************************************************************
+    /// Finds the leaf that would hold the lower bound of the key.
+    //*************************************************************************
+    leaf_t* find_lower_leaf(key_parameter_t key) const
+    {
+      node_t* p_node = p_root;
+
+      if (p_node == nullptr)
+      {
+        return nullptr;
+      }
+
+      while (!p_node->is_leaf)
+      {
+        internal_t* p_internal = static_cast<internal_t*>(p_node);
+        const TKey* keys       = p_internal->keys();
+
+        p_node = p_internal->children[std::lower_bound(keys, keys + p_internal->count - 1, key, kcompare) - keys];
+      }
+
+      return static_cast<leaf_t*>(p_node);
+    }
+
+    //*************************************************************************
+    /// Finds the leaf that would hold the upper bound of the key.
+    //*************************************************************************
+    leaf_t* find_upper_leaf(key_parameter_t key) const
+    {
+      node_t* p_node = p_root;
+
+      if (p_node == nullptr)
+      {
+        return nullptr;
+      }
+
+      while (!p_node->is_leaf)
+      {
+        internal_t* p_internal = static_cast<internal_t*>(p_node);
+        const TKey* keys       = p_internal->keys();
+
+        p_node = p_internal->children[std::upper_bound(keys, keys + p_internal->count - 1, key, kcompare) - keys];
+      }
+
+      return static_cast<leaf_t*>(p_node);
+    }
+
+    //*************************************************************************
+    /// The index of the first value in the leaf not less than the key.
+    //*************************************************************************
+    size_t leaf_lower_bound(const leaf_t* p_leaf, key_parameter_t key) const
+    {
+      const value_type* values = p_leaf->values();
+      size_t first = 0;
+      size_t n     = p_leaf->count;
+
+      while (n > 0)
+      {
+        size_t step = n / 2;
+
+        if (kcompare(TKeyOfValue::get(values[first + step]), key))
+        {
+          first += step + 1;
+          n     -= step + 1;
+        }
+        else
+        {
+          n = step;
+        }
+      }
+
+      return first;
+    }
+
+    //*************************************************************************
+    /// The index of the first value in the leaf greater than the key.
+    //*************************************************************************
+    size_t leaf_upper_bound(const leaf_t* p_leaf, key_parameter_t key) const
+    {
+      const value_type* values = p_leaf->values();
+      size_t first = 0;
+      size_t n     = p_leaf->count;
+
+      while (n > 0)
+      {
+        size_t step = n / 2;
+
+        if (!kcompare(key, TKeyOfValue::get(values[first + step])))
+        {
+          first += step + 1;
+          n     -= step + 1;
+        }
+        else
+        {
+          n = step;
+        }
+      }
+
+      return first;
+    }
+
+    //*************************************************************************
+    /// Inserts the value into the leaf at the index, splitting if necessary.
+    /// Creates the root leaf if the tree is empty.
+    //*************************************************************************
+    iterator insert_value(leaf_t* p_leaf, size_t index, const_reference value)
+    {
+      if (p_leaf == nullptr)
+      {
+        p_leaf = allocate_leaf();
+        p_root       = p_leaf;
+        p_first_leaf = p_leaf;
+        p_last_leaf  = p_leaf;
+      }
+      else if (p_leaf->count == LEAF_CAPACITY)
+      {
+        leaf_t* p_right = split_leaf(p_leaf);
+
+        if (index > p_leaf->count)
+        {
+          index -= p_leaf->count;
+          p_leaf = p_right;
+        }
+      }
+
+      value_type* values = p_leaf->values();
+
+      for (size_t i = p_leaf->count; i > index; --i)
+      {
+        move_value(values + i, values + i - 1);
+      }
+
+      ::new (static_cast<void*>(const_cast<mutable_value_type*>(values + index))) value_type(value);
+      ++p_leaf->count;
+      ++current_size;
+      ETL_INCREMENT_DEBUG_COUNT
+
+      return iterator(*this, p_leaf, index);
+    }
+
+    //*************************************************************************
+    /// Moves the upper half of a full leaf to a new leaf on its right.
+    ///\return The new leaf.
+    //*************************************************************************
+    leaf_t* split_leaf(leaf_t* p_left)
+    {
+      leaf_t* p_right = allocate_leaf();
+
+      const size_t left_count = LEAF_CAPACITY - (LEAF_CAPACITY / 2);
+
+      value_type* from = p_left->values();
+      value_type* to   = p_right->values();
+
+      for (size_t i = left_count; i < LEAF_CAPACITY; ++i)
+      {
+        move_value(to + (i - left_count), from + i);
+      }
+
+      p_left->count  = left_count;
+      p_right->count = LEAF_CAPACITY - left_count;
+
+      // Link into the leaf chain.
+      p_right->prev = p_left;
+      p_right->next = p_left->next;
+
+      if (p_left->next == nullptr)
+      {
+        p_last_leaf = p_right;
+      }
+      else
+      {
+        p_left->next->prev = p_right;
+      }
+
+      p_left->next = p_right;
+
+      insert_into_parent(p_left, p_right, TKeyOfValue::get(to[0]));
+
+      return p_right;
+    }
+
+    //*************************************************************************
+    /// Adds a new right sibling and its separating key to the parent of p_left.
+    //*************************************************************************
+    void insert_into_parent(node_t* p_left, node_t* p_right, const TKey& key)
+    {
+      internal_t* p_parent = p_left->parent;
+
+      if (p_parent == nullptr)
+      {
+        // Grow a new root.
+        p_parent = allocate_internal();
+        p_parent->children[0] = p_left;
+        p_parent->count       = 1;
+        p_left->parent        = p_parent;
+        p_root                = p_parent;
+
+        insert_child(p_parent, 0, key, p_right);
+      }
+      else
+      {
+        size_t index = child_index(p_parent, p_left);
+
+        if (p_parent->count < INTERNAL_CAPACITY)
+        {
+          insert_child(p_parent, index, key, p_right);
+        }
+        else
+        {
+          // Split the parent first, then insert into whichever half holds p_left.
+          internal_t* p_sibling  = allocate_internal();
+          const size_t left_count = INTERNAL_CAPACITY / 2;
+
+          TKey* from = p_parent->keys();
+          TKey* to   = p_sibling->keys();
+
+          for (size_t i = left_count; i < INTERNAL_CAPACITY; ++i)
+          {
+            p_sibling->children[i - left_count] = p_parent->children[i];
+            p_parent->children[i]->parent       = p_sibling;
+          }
+
+          for (size_t i = left_count; i < (INTERNAL_CAPACITY - 1); ++i)
+          {
+            move_key(to + (i - left_count), from + i);
+          }
+
+          p_parent->count  = left_count;
+          p_sibling->count = INTERNAL_CAPACITY - left_count;
+
+          // The key between the halves moves up.
+          TKey promoted(from[left_count - 1]);
+          from[left_count - 1].~TKey();
+
+          if (index < left_count)
+          {
+            insert_child(p_parent, index, key, p_right);
+          }
+          else
+          {
+            insert_child(p_sibling, index - left_count, key, p_right);
+          }
+
+          insert_into_parent(p_parent, p_sibling, promoted);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Inserts a key and child after children[index] in a non-full node.
+    //*************************************************************************
+    void insert_child(internal_t* p_node, size_t index, const TKey& key, node_t* p_child)
+    {
+      TKey* keys = p_node->keys();
+
+      for (size_t i = p_node->count - 1; i > index; --i)
+      {
+        move_key(keys + i, keys + i - 1);
+        p_node->children[i + 1] = p_node->children[i];
+      }
+
+      ::new (static_cast<void*>(keys + index)) TKey(key);
+      p_node->children[index + 1] = p_child;
+      p_child->parent = p_node;
+      ++p_node->count;
+    }
+
+    //*************************************************************************
+    /// Removes keys[index] and children[index + 1].
+    //*************************************************************************
+    void remove_child(internal_t* p_node, size_t index)
+    {
+      TKey* keys = p_node->keys();
+
+      keys[index].~TKey();
+
+      for (size_t i = index + 1; i < (p_node->count - 1); ++i)
+      {
+        move_key(keys + i - 1, keys + i);
+        p_node->children[i] = p_node->children[i + 1];
+      }
+
+      --p_node->count;
+    }
+
+    //*************************************************************************
+    /// Erases the value and rebalances the tree.
+    ///\return An iterator to the value that followed it.
+    //*************************************************************************
+    iterator erase_value(leaf_t* p_leaf, size_t index)
+    {
+      value_type* values = p_leaf->values();
+
+      values[index].~value_type();
+
+      for (size_t i = index + 1; i < p_leaf->count; ++i)
+      {
+        move_value(values + i - 1, values + i);
+      }
+
+      --p_leaf->count;
+      --current_size;
+      ETL_DECREMENT_DEBUG_COUNT
+
+      if (p_leaf == p_root)
+      {
+        if (p_leaf->count == 0)
+        {
+          p_leaf_pool->release(p_leaf);
+          p_root       = nullptr;
+          p_first_leaf = nullptr;
+          p_last_leaf  = nullptr;
+
+          return end();
+        }
+      }
+      else if (p_leaf->count < LEAF_MINIMUM)
+      {
+        rebalance_leaf(p_leaf, index);
+      }
+
+      return make_iterator(p_leaf, index);
+    }
+
+    //*************************************************************************
+    /// Refills a leaf that has dropped below the minimum, either by borrowing
+    /// from a sibling or by merging with one.
+    /// p_leaf and index are updated to follow the value at that position.
+    //*************************************************************************
+    void rebalance_leaf(leaf_t*& p_leaf, size_t& index)
+    {
+      internal_t* p_parent = p_leaf->parent;
+      size_t      i        = child_index(p_parent, p_leaf);
+
+      leaf_t* p_left  = (i > 0)                     ? static_cast<leaf_t*>(p_parent->children[i - 1]) : nullptr;
+      leaf_t* p_right = ((i + 1) < p_parent->count) ? static_cast<leaf_t*>(p_parent->children[i + 1]) : nullptr;
+
+      if ((p_left != nullptr) && (p_left->count > LEAF_MINIMUM))
+      {
+        // Borrow the last value of the left sibling.
+        value_type* values = p_leaf->values();
+
+        for (size_t j = p_leaf->count; j > 0; --j)
+        {
+          move_value(values + j, values + j - 1);
+        }
+
+        move_value(values, p_left->values() + p_left->count - 1);
+        --p_left->count;
+        ++p_leaf->count;
+        ++index;
+
+        assign_key(p_parent, i - 1, TKeyOfValue::get(values[0]));
+      }
+      else if ((p_right != nullptr) && (p_right->count > LEAF_MINIMUM))
+      {
+        // Borrow the first value of the right sibling.
+        value_type* values = p_right->values();
+
+        move_value(p_leaf->values() + p_leaf->count, values);
+
+        for (size_t j = 1; j < p_right->count; ++j)
+        {
+          move_value(values + j - 1, values + j);
+        }
+
+        --p_right->count;
+        ++p_leaf->count;
+
+        assign_key(p_parent, i, TKeyOfValue::get(values[0]));
+      }
+      else
+      {
+        if (p_left != nullptr)
+        {
+          index += p_left->count;
+          merge_leaves(p_left, p_leaf);
+          remove_child(p_parent, i - 1);
+          p_leaf = p_left;
+        }
+        else
+        {
+          merge_leaves(p_leaf, p_right);
+          remove_child(p_parent, i);
+        }
+
+        rebalance_internal(p_parent);
+      }
+    }
+
+    //*************************************************************************
+    /// Moves all of the values of p_right to p_left and releases p_right.
+    //*************************************************************************
+    void merge_leaves(leaf_t* p_left, leaf_t* p_right)
+    {
+      value_type* from = p_right->values();
+      value_type* to   = p_left->values() + p_left->count;
+
+      for (size_t i = 0; i < p_right->count; ++i)
+      {
+        move_value(to + i, from + i);
+      }
+
+      p_left->count += p_right->count;
+
+      // Unlink from the leaf chain.
+      p_left->next = p_right->next;
+
+      if (p_right->next == nullptr)
+      {
+        p_last_leaf = p_left;
+      }
+      else
+      {
+        p_right->next->prev = p_left;
+      }
+
+      p_leaf_pool->release(p_right);
+    }
+
+    //*************************************************************************
+    /// Refills an internal node that has dropped below the minimum, either by
+    /// rotating a child through the parent or by merging with a sibling.
+    /// Shrinks the tree if the root is left with a single child.
+    //*************************************************************************
+    void rebalance_internal(internal_t* p_node)
+    {
+      if (p_node == p_root)
+      {
+        if (p_node->count == 1)
+        {
+          p_root = p_node->children[0];
+          p_root->parent = nullptr;
+          p_internal_pool->release(p_node);
+        }
+
+        return;
+      }
+
+      if (p_node->count >= INTERNAL_MINIMUM)
+      {
+        return;
+      }
+
+      internal_t* p_parent = p_node->parent;
+      size_t      i        = child_index(p_parent, p_node);
+
+      internal_t* p_left  = (i > 0)                     ? static_cast<internal_t*>(p_parent->children[i - 1]) : nullptr;
+      internal_t* p_right = ((i + 1) < p_parent->count) ? static_cast<internal_t*>(p_parent->children[i + 1]) : nullptr;
+
+      TKey* keys = p_node->keys();
+
+      if ((p_left != nullptr) && (p_left->count > INTERNAL_MINIMUM))
+      {
+        // Rotate the last child of the left sibling through the parent.
+        for (size_t j = p_node->count - 1; j > 0; --j)
+        {
+          move_key(keys + j, keys + j - 1);
+        }
+
+        for (size_t j = p_node->count; j > 0; --j)
+        {
+          p_node->children[j] = p_node->children[j - 1];
+        }
+
+        TKey* left_keys = p_left->keys();
+
+        ::new (static_cast<void*>(keys)) TKey(p_parent->keys()[i - 1]);
+        p_node->children[0]         = p_left->children[p_left->count - 1];
+        p_node->children[0]->parent = p_node;
+        ++p_node->count;
+
+        assign_key(p_parent, i - 1, left_keys[p_left->count - 2]);
+        left_keys[p_left->count - 2].~TKey();
+        --p_left->count;
+      }
+      else if ((p_right != nullptr) && (p_right->count > INTERNAL_MINIMUM))
+      {
+        // Rotate the first child of the right sibling through the parent.
+        TKey* right_keys = p_right->keys();
+
+        ::new (static_cast<void*>(keys + p_node->count - 1)) TKey(p_parent->keys()[i]);
+        p_node->children[p_node->count]         = p_right->children[0];
+        p_node->children[p_node->count]->parent = p_node;
+        ++p_node->count;
+
+        assign_key(p_parent, i, right_keys[0]);
+        right_keys[0].~TKey();
+
+        for (size_t j = 1; j < (p_right->count - 1); ++j)
+        {
+          move_key(right_keys + j - 1, right_keys + j);
+        }
+
+        for (size_t j = 1; j < p_right->count; ++j)
+        {
+          p_right->children[j - 1] = p_right->children[j];
+        }
+
+        --p_right->count;
+      }
+      else
+      {
+        if (p_left != nullptr)
+        {
+          merge_internals(p_left, p_node, p_parent->keys()[i - 1]);
+          remove_child(p_parent, i - 1);
+        }
+        else
+        {
+          merge_internals(p_node, p_right, p_parent->keys()[i]);
+          remove_child(p_parent, i);
+        }
+
+        rebalance_internal(p_parent);
+      }
+    }
+
+    //*************************************************************************
+    /// Moves the separating key and all of p_right to p_left and releases p_right.
+    //*************************************************************************
+    void merge_internals(internal_t* p_left, internal_t* p_right, const TKey& key)
+    {
+      TKey* to   = p_left->keys();
+      TKey* from = p_right->keys();
+
+      ::new (static_cast<void*>(to + p_left->count - 1)) TKey(key);
+
+      for (size_t i = 0; i < (p_right->count - 1); ++i)
+      {
+        move_key(to + p_left->count + i, from + i);
+      }
+
+      for (size_t i = 0; i < p_right->count; ++i)
+      {
+        p_left->children[p_left->count + i] = p_right->children[i];
+        p_right->children[i]->parent        = p_left;
+      }
+
+      p_left->count += p_right->count;
+
+      p_internal_pool->release(p_right);
+    }
+
+    //*************************************************************************
+    /// The index of the child in its parent.
+    //*************************************************************************
+    static size_t child_index(const internal_t* p_parent, const node_t* p_child)
+    {
+      size_t i = 0;
+
+      while (p_parent->children[i] != p_child)
+      {
+        ++i;
+      }
+
+      return i;
+    }
+
+    //*************************************************************************
+    /// Replaces a key in an internal node.
+    //*************************************************************************
+    static void assign_key(internal_t* p_node, size_t index, const TKey& key)
+    {
+      TKey* keys = p_node->keys();
+
+      keys[index].~TKey();
+      ::new (static_cast<void*>(keys + index)) TKey(key);
+    }
+
+    //*************************************************************************
+    /// Moves a key to uninitialised storage.
+    //*************************************************************************
+    static void move_key(TKey* to, TKey* from)
+    {
+#if ETL_CPP11_SUPPORTED
+      ::new (static_cast<void*>(to)) TKey(std::move(*from));
+#else
+      ::new (static_cast<void*>(to)) TKey(*from);
+#endif
+      from->~TKey();
+    }
+
+    //*************************************************************************
+    /// Moves a value to uninitialised storage.
+    //*************************************************************************
+    static void move_value(value_type* to, value_type* from)
+    {
+#if ETL_CPP11_SUPPORTED
+      ::new (static_cast<void*>(const_cast<mutable_value_type*>(to))) value_type(std::move(*from));
+#else
+      ::new (static_cast<void*>(const_cast<mutable_value_type*>(to))) value_type(*from);
+#endif
+      from->~value_type();
+    }
+
+    //*************************************************************************
+    /// Allocates an empty leaf.
+    //*************************************************************************
+    leaf_t* allocate_leaf()
+    {
+      leaf_t* p_leaf = p_leaf_pool->allocate<leaf_t>();
+
+      p_leaf->parent  = nullptr;
+      p_leaf->count   = 0;
+      p_leaf->is_leaf = true;
+      p_leaf->prev    = nullptr;
+      p_leaf->next    = nullptr;
+
+      return p_leaf;
+    }
+
+    //*************************************************************************
+    /// Allocates an empty internal node.
+    //*************************************************************************
+    internal_t* allocate_internal()
+    {
+      internal_t* p_internal = p_internal_pool->allocate<internal_t>();
+
+      p_internal->parent  = nullptr;
+      p_internal->count   = 0;
+      p_internal->is_leaf = false;
+
+      return p_internal;
+    }
+
+    //*************************************************************************
+    /// Destroys the values and keys below the node.
+    //*************************************************************************
+    void destroy_node(node_t* p_node)
+    {
+      if (p_node->is_leaf)
+      {
+        value_type* values = static_cast<leaf_t*>(p_node)->values();
+
+        for (size_t i = 0; i < p_node->count; ++i)
+        {
+          values[i].~value_type();
+        }
+      }
+      else
+      {
+        internal_t* p_internal = static_cast<internal_t*>(p_node);
+        TKey*       keys       = p_internal->keys();
+
+        for (size_t i = 0; i < p_node->count; ++i)
+        {
+          destroy_node(p_internal->children[i]);
+        }
+
+        for (size_t i = 0; i < (p_node->count - 1); ++i)
+        {
+          keys[i].~TKey();
+        }
+      }
+    }
+
+    // Disable copy construction.
+    ibtree(const ibtree&);
+
+    etl::ipool* p_leaf_pool;     ///< The pool of leaf nodes.
+    etl::ipool* p_internal_pool; ///< The pool of internal nodes.
+    node_t*     p_root;          ///< The root node, or nullptr if empty.
+    leaf_t*     p_first_leaf;    ///< The leftmost leaf.
+    leaf_t*     p_last_leaf;     ///< The rightmost leaf.
+
+    key_compare kcompare;
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_BTREE) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~ibtree()
+    {
+    }
+#else
+  protected:
+    ~ibtree()
+    {
+    }
+#endif
+  };
+}
+
+#undef ETL_FILE
+
+#endif
@@ -0,0 +1,147 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BUCKET_OCCUPANCY_INCLUDED
+#define ETL_BUCKET_OCCUPANCY_INCLUDED
+
+///\ingroup private
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../platform.h"
+#include "../binary.h"
+#include "../integral_limits.h"
+
+namespace etl
+{
+  namespace private_unordered
+  {
+    //*************************************************************************
+    /// A bitmap with one bit per bucket, set when the bucket is not empty.
+    /// Used by the unordered containers to jump straight to the next
+    /// non-empty bucket, so that iteration and clearing scale with the
+    /// number of elements rather than the number of buckets.
+    //*************************************************************************
+    class bucket_occupancy
+    {
+    public:
+
+#if ETL_PLATFORM_64BIT
+      typedef uint64_t word_t;
+#else
+      typedef uint32_t word_t;
+#endif
+
+      static const size_t BITS_PER_WORD = etl::integral_limits<word_t>::bits;
+
+      //***********************************************************************
+      /// The number of words needed for NBUCKETS buckets.
+      //***********************************************************************
+      template <const size_t NBUCKETS>
+      struct words
+      {
+        static const size_t value = (NBUCKETS + BITS_PER_WORD - 1) / BITS_PER_WORD;
+      };
+
+      //***********************************************************************
+      /// Constructor.
+      //***********************************************************************
+      bucket_occupancy(word_t* pwords_, size_t number_of_buckets_)
+        : pwords(pwords_),
+          number_of_words((number_of_buckets_ + BITS_PER_WORD - 1) / BITS_PER_WORD),
+          number_of_buckets(number_of_buckets_)
+      {
+      }
+
+      //***********************************************************************
+      /// Marks the bucket as occupied.
+      //***********************************************************************
+      void set(size_t index)
+      {
+        pwords[index / BITS_PER_WORD] |= word_t(1) << (index % BITS_PER_WORD);
+      }
+
+      //***********************************************************************
+      /// Marks the bucket as empty.
+      //***********************************************************************
+      void reset(size_t index)
+      {
+        pwords[index / BITS_PER_WORD] &= ~(word_t(1) << (index % BITS_PER_WORD));
+      }
+
+      //***********************************************************************
+      /// Marks all of the buckets as empty.
+      //***********************************************************************
+      void reset_all()
+      {
+        for (size_t i = 0; i < number_of_words; ++i)
+        {
+          pwords[i] = 0;
+        }
+      }
+
+      //***********************************************************************
+      /// Finds the first occupied bucket at or after 'index'.
+      ///\return The bucket index, or the number of buckets if there are none.
+      //***********************************************************************
+      size_t find_next(size_t index) const
+      {
+        if (index >= number_of_buckets)
+        {
+          return number_of_buckets;
+        }
+
+        size_t i    = index / BITS_PER_WORD;
+        word_t word = pwords[i] & (~word_t(0) << (index % BITS_PER_WORD));
+
+        while (word == 0)
+        {
+          if (++i == number_of_words)
+          {
+            return number_of_buckets;
+          }
+
+          word = pwords[i];
+        }
+
+        return (i * BITS_PER_WORD) + etl::count_trailing_zeros(word);
+      }
+
+    private:
+
+      word_t*      pwords;
+      const size_t number_of_words;
+      const size_t number_of_buckets;
+    };
+  }
+}
+
+#endif
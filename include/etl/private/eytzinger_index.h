@@ -0,0 +1,284 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_EYTZINGER_INDEX_INCLUDED
+#define ETL_EYTZINGER_INDEX_INCLUDED
+
+///\ingroup private
+
+#include <stddef.h>
+#include <new>
+
+#include "../platform.h"
+#include "../alignment.h"
+#include "../log.h"
+#include "../parameter_type.h"
+
+namespace etl
+{
+  namespace private_flat
+  {
+    //*************************************************************************
+    /// An optional copy of the keys of a flat container, stored inline in
+    /// Eytzinger (breadth first) order.
+    /// The first levels of the search tree share cache lines, the next levels
+    /// can be prefetched, and the search loop has no unpredictable branches.
+    /// The sorted rank of each key is kept alongside, so that a search result
+    /// maps straight back to a position in the container.
+    /// Position 0 is unused, so that the children of position k are 2k and 2k + 1.
+    //*************************************************************************
+    template <typename TKey, typename TKeyCompare>
+    class ieytzinger_index
+    {
+    public:
+
+      typedef typename etl::parameter_type<TKey>::type key_parameter_t;
+
+      //***********************************************************************
+      /// Builds the index from a sorted sequence.
+      ///\param first  The first element of the sorted sequence.
+      ///\param count  The number of elements.
+      ///\param key_of Gets the key of an element.
+      //***********************************************************************
+      template <typename TIterator, typename TKeyOf>
+      void build(TIterator first, size_t count, TKeyOf key_of)
+      {
+        clear();
+
+        if (count != 0)
+        {
+          // Start at the leftmost position and visit the tree in order.
+          size_t k = 1;
+
+          while ((2 * k) <= count)
+          {
+            k *= 2;
+          }
+
+          for (size_t rank = 0; rank < count; ++rank)
+          {
+            ::new (pkeys + k) TKey(key_of(*first));
+            pranks[k] = rank;
+            ++first;
+            ++current_size;
+
+            if (((2 * k) + 1) <= count)
+            {
+              // The leftmost position of the right subtree.
+              k = (2 * k) + 1;
+
+              while ((2 * k) <= count)
+              {
+                k *= 2;
+              }
+            }
+            else
+            {
+              // Up past every ancestor of which we are the right child.
+              while ((k & 1) != 0)
+              {
+                k >>= 1;
+              }
+
+              k >>= 1;
+            }
+          }
+        }
+
+        valid = true;
+      }
+
+      //***********************************************************************
+      /// Destroys the keys and marks the index as invalid.
+      //***********************************************************************
+      void clear()
+      {
+        for (size_t k = 1; k <= current_size; ++k)
+        {
+          pkeys[k].~TKey();
+        }
+
+        current_size = 0;
+        valid        = false;
+      }
+
+      //***********************************************************************
+      /// Returns <b>true</b> if the index matches the container.
+      //***********************************************************************
+      bool is_valid() const
+      {
+        return valid;
+      }
+
+      //***********************************************************************
+      /// Returns the rank of the first key that is not less than the key,
+      /// or the number of keys if there is none.
+      //***********************************************************************
+      size_t lower_bound(key_parameter_t key) const
+      {
+        size_t k      = 1;
+        size_t result = 0;
+
+        while (k <= current_size)
+        {
+          prefetch(k);
+
+          const bool go_right = compare(pkeys[k], key);
+          result = go_right ? result : k;
+          k      = (2 * k) + (go_right ? 1 : 0);
+        }
+
+        return (result == 0) ? current_size : pranks[result];
+      }
+
+      //***********************************************************************
+      /// Returns the rank of the first key that is greater than the key,
+      /// or the number of keys if there is none.
+      //***********************************************************************
+      size_t upper_bound(key_parameter_t key) const
+      {
+        size_t k      = 1;
+        size_t result = 0;
+
+        while (k <= current_size)
+        {
+          prefetch(k);
+
+          const bool go_right = !compare(key, pkeys[k]);
+          result = go_right ? result : k;
+          k      = (2 * k) + (go_right ? 1 : 0);
+        }
+
+        return (result == 0) ? current_size : pranks[result];
+      }
+
+    protected:
+
+      //***********************************************************************
+      /// Constructor.
+      ///\param pkeys_  Storage for MAX_SIZE + 1 keys.
+      ///\param pranks_ Storage for MAX_SIZE + 1 ranks.
+      //***********************************************************************
+      ieytzinger_index(TKey* pkeys_, size_t* pranks_)
+        : pkeys(pkeys_),
+          pranks(pranks_),
+          current_size(0),
+          valid(false)
+      {
+      }
+
+      //***********************************************************************
+      /// Destructor.
+      //***********************************************************************
+      ~ieytzinger_index()
+      {
+        clear();
+      }
+
+    private:
+
+      // The descendants of position k, a few levels down, start at k * PREFETCH_STRIDE and share a cache line.
+      static const size_t PREFETCH_STRIDE = size_t(1) << etl::log2<(sizeof(TKey) < (ETL_CACHE_LINE_SIZE / 2U)) ? (ETL_CACHE_LINE_SIZE / sizeof(TKey)) : 2U>::value;
+
+      //***********************************************************************
+      /// Prefetches the descendants of position k, if there are any.
+      /// A pointer past the end of the keys must not be formed.
+      //***********************************************************************
+      void prefetch(size_t k) const
+      {
+        const size_t descendants = k * PREFETCH_STRIDE;
+
+        if (descendants <= current_size)
+        {
+          ETL_PREFETCH(pkeys + descendants);
+        }
+      }
+
+      // Disable copy construction and assignment.
+      ieytzinger_index(const ieytzinger_index&);
+      ieytzinger_index& operator =(const ieytzinger_index&);
+
+      TKey*       pkeys;
+      size_t*     pranks;
+      size_t      current_size;
+      bool        valid;
+      TKeyCompare compare;
+    };
+
+    //*************************************************************************
+    /// An Eytzinger index with storage for MAX_SIZE keys.
+    //*************************************************************************
+    template <typename TKey, typename TKeyCompare, const size_t MAX_SIZE>
+    class eytzinger_index : public ieytzinger_index<TKey, TKeyCompare>
+    {
+    public:
+
+      //***********************************************************************
+      /// Constructor.
+      //***********************************************************************
+      eytzinger_index()
+        : ieytzinger_index<TKey, TKeyCompare>(reinterpret_cast<TKey*>(&keys_buffer), ranks)
+      {
+      }
+
+      //***********************************************************************
+      /// Gets the index, for passing to the container base class.
+      //***********************************************************************
+      ieytzinger_index<TKey, TKeyCompare>* get()
+      {
+        return this;
+      }
+
+    private:
+
+      typename etl::aligned_storage<sizeof(TKey) * (MAX_SIZE + 1), etl::alignment_of<TKey>::value>::type keys_buffer;
+      size_t ranks[MAX_SIZE + 1];
+    };
+
+    //*************************************************************************
+    /// Specialisation for containers that do not have an index.
+    //*************************************************************************
+    template <typename TKey, typename TKeyCompare>
+    class eytzinger_index<TKey, TKeyCompare, 0>
+    {
+    public:
+
+      //***********************************************************************
+      /// Gets the index, for passing to the container base class.
+      //***********************************************************************
+      ieytzinger_index<TKey, TKeyCompare>* get()
+      {
+        return nullptr;
+      }
+    };
+  }
+}
+
+#endif
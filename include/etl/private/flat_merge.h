@@ -0,0 +1,263 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_FLAT_MERGE_INCLUDED
+#define ETL_FLAT_MERGE_INCLUDED
+
+///\ingroup private
+
+#include <stddef.h>
+
+#include "../platform.h"
+#include "../stl/algorithm.h"
+#include "../stl/iterator.h"
+
+namespace etl
+{
+  namespace private_flat
+  {
+    //*************************************************************************
+    /// Reverses a range.
+    //*************************************************************************
+    template <typename TIterator>
+    void reverse_range(TIterator first, TIterator last)
+    {
+      while ((first != last) && (first != --last))
+      {
+        std::iter_swap(first, last);
+        ++first;
+      }
+    }
+
+    //*************************************************************************
+    /// Merges two adjacent sorted runs.
+    /// Stable: equal elements from the first run stay ahead of those from the second.
+    /// If the shorter run fits in the buffer it is moved there and merged back
+    /// in linear time. Otherwise the runs are split and rotated, and the parts
+    /// merged in turn.
+    //*************************************************************************
+    template <typename TIterator, typename TPointer, typename TCompare>
+    void merge_runs(TIterator first, TIterator middle, TIterator last, TPointer buffer, size_t buffer_size, TCompare compare)
+    {
+      if ((first == middle) || (middle == last) || !compare(*middle, *(middle - 1)))
+      {
+        // Nothing to do, or already in order.
+        return;
+      }
+
+      const size_t length1 = size_t(middle - first);
+      const size_t length2 = size_t(last - middle);
+
+      if ((length1 <= length2) && (length1 <= buffer_size))
+      {
+        // Move the first run out and merge forwards.
+        TPointer  buffer_end = std::copy(first, middle, buffer);
+        TPointer  from1      = buffer;
+        TIterator from2      = middle;
+        TIterator to         = first;
+
+        while ((from1 != buffer_end) && (from2 != last))
+        {
+          if (compare(*from2, *from1))
+          {
+            *to = *from2;
+            ++from2;
+          }
+          else
+          {
+            *to = *from1;
+            ++from1;
+          }
+
+          ++to;
+        }
+
+        std::copy(from1, buffer_end, to);
+        return;
+      }
+
+      if ((length2 < length1) && (length2 <= buffer_size))
+      {
+        // Move the second run out and merge backwards.
+        TPointer  buffer_end = std::copy(middle, last, buffer);
+        TIterator from1      = middle;
+        TPointer  from2      = buffer_end;
+        TIterator to         = last;
+
+        while ((from1 != first) && (from2 != buffer))
+        {
+          if (compare(*(from2 - 1), *(from1 - 1)))
+          {
+            *--to = *--from1;
+          }
+          else
+          {
+            *--to = *--from2;
+          }
+        }
+
+        std::copy_backward(buffer, from2, to);
+        return;
+      }
+
+      if ((last - first) == 2)
+      {
+        std::iter_swap(first, middle);
+        return;
+      }
+
+      // Split the longer run in half and find the matching split of the other.
+      TIterator cut1;
+      TIterator cut2;
+
+      if (length1 > length2)
+      {
+        cut1 = first + (length1 / 2);
+        cut2 = std::lower_bound(middle, last, *cut1, compare);
+      }
+      else
+      {
+        cut2 = middle + (length2 / 2);
+        cut1 = std::upper_bound(first, middle, *cut2, compare);
+      }
+
+      // Rotate [cut1, middle) past [middle, cut2).
+      reverse_range(cut1, middle);
+      reverse_range(middle, cut2);
+      reverse_range(cut1, cut2);
+
+      TIterator new_middle = cut1 + (cut2 - middle);
+
+      merge_runs(first, cut1, new_middle, buffer, buffer_size, compare);
+      merge_runs(new_middle, cut2, last, buffer, buffer_size, compare);
+    }
+
+    //*************************************************************************
+    /// Sorts a range, keeping equal elements in order.
+    /// Short runs are insertion sorted, then merged in runs of doubling width.
+    /// O(N log N) if the buffer holds at least half of the range, as every
+    /// merge is then linear. With a smaller buffer, or none, the longer merges
+    /// split and rotate in place and the sort is O(N log^2 N).
+    //*************************************************************************
+    template <typename TIterator, typename TPointer, typename TCompare>
+    void stable_sort(TIterator first, TIterator last, TPointer buffer, size_t buffer_size, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_type;
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_type;
+
+      static const difference_type RUN_LENGTH = 16;
+
+      const difference_type length = last - first;
+
+      for (difference_type start = 0; start < length; start += RUN_LENGTH)
+      {
+        TIterator run_first = first + start;
+        TIterator run_last  = first + ((length - start) < RUN_LENGTH ? length : start + RUN_LENGTH);
+
+        for (TIterator itr = run_first + 1; itr < run_last; ++itr)
+        {
+          value_type value = *itr;
+          TIterator  hole  = itr;
+
+          while ((hole != run_first) && compare(value, *(hole - 1)))
+          {
+            *hole = *(hole - 1);
+            --hole;
+          }
+
+          *hole = value;
+        }
+      }
+
+      for (difference_type width = RUN_LENGTH; width < length; width *= 2)
+      {
+        for (difference_type start = 0; (start + width) < length; start += (2 * width))
+        {
+          difference_type end = ((length - start) < (2 * width)) ? length : start + (2 * width);
+
+          merge_runs(first + start, first + start + width, first + end, buffer, buffer_size, compare);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Merges the unsorted elements in [middle, last) into the sorted elements
+    /// in [first, middle). Equal elements keep their order, with the new ones
+    /// after the existing ones.
+    /// 'buffer' is scratch space for 'buffer_size' elements, such as the
+    /// spare capacity of the container. See stable_sort for the complexity.
+    //*************************************************************************
+    template <typename TIterator, typename TPointer, typename TCompare>
+    void merge_multi(TIterator first, TIterator middle, TIterator last, TPointer buffer, size_t buffer_size, TCompare compare)
+    {
+      etl::private_flat::stable_sort(middle, last, buffer, buffer_size, compare);
+      etl::private_flat::merge_runs(first, middle, last, buffer, buffer_size, compare);
+    }
+
+    //*************************************************************************
+    /// Merges the unsorted elements in [middle, last) into the sorted, unique
+    /// elements in [first, middle).
+    /// A new element is rejected if its key is already present or appeared
+    /// earlier in the new elements. Rejected elements are moved to the end.
+    /// 'buffer' is scratch space for 'buffer_size' elements, such as the
+    /// spare capacity of the container. See stable_sort for the complexity.
+    ///\return The position of the first rejected element.
+    //*************************************************************************
+    template <typename TIterator, typename TPointer, typename TCompare>
+    TIterator merge_unique(TIterator first, TIterator middle, TIterator last, TPointer buffer, size_t buffer_size, TCompare compare)
+    {
+      etl::private_flat::stable_sort(middle, last, buffer, buffer_size, compare);
+
+      TIterator existing = first;
+      TIterator kept     = middle;
+
+      for (TIterator itr = middle; itr != last; ++itr)
+      {
+        // The new elements are sorted, so the search can carry on from the last position.
+        existing = std::lower_bound(existing, middle, *itr, compare);
+
+        const bool is_present   = (existing != middle) && !compare(*itr, *existing);
+        const bool is_duplicate = (kept != middle) && !compare(*(kept - 1), *itr);
+
+        if (!is_present && !is_duplicate)
+        {
+          std::iter_swap(kept, itr);
+          ++kept;
+        }
+      }
+
+      etl::private_flat::merge_runs(first, middle, kept, buffer, buffer_size, compare);
+
+      return kept;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,480 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_FLOATING_POINT_DIGITS_INCLUDED
+#define ETL_FLOATING_POINT_DIGITS_INCLUDED
+
+///\ingroup private
+
+#include <stdint.h>
+#include <string.h>
+
+#include "../platform.h"
+#include "../stl/limits.h"
+
+namespace etl
+{
+  namespace private_floating_point_digits
+  {
+    //***************************************************************************
+    /// The maximum number of digits generated for a double.
+    //***************************************************************************
+    static const int MAX_DIGITS = 17;
+
+    //***************************************************************************
+    /// A floating point number with a 64 bit significand and a binary exponent.
+    /// value = f * 2^e
+    //***************************************************************************
+    struct diy_fp
+    {
+      diy_fp(uint64_t f_, int e_)
+        : f(f_)
+        , e(e_)
+      {
+      }
+
+      //*************************************************************************
+      /// x - y, where x.e == y.e and x.f >= y.f.
+      //*************************************************************************
+      static diy_fp sub(const diy_fp& x, const diy_fp& y)
+      {
+        return diy_fp(x.f - y.f, x.e);
+      }
+
+      //*************************************************************************
+      /// The upper 64 bits of x * y, rounded.
+      //*************************************************************************
+      static diy_fp mul(const diy_fp& x, const diy_fp& y)
+      {
+        const uint64_t x_lo = x.f & 0xFFFFFFFFU;
+        const uint64_t x_hi = x.f >> 32;
+        const uint64_t y_lo = y.f & 0xFFFFFFFFU;
+        const uint64_t y_hi = y.f >> 32;
+
+        const uint64_t p0 = x_lo * y_lo;
+        const uint64_t p1 = x_lo * y_hi;
+        const uint64_t p2 = x_hi * y_lo;
+        const uint64_t p3 = x_hi * y_hi;
+
+        uint64_t q = (p0 >> 32) + (p1 & 0xFFFFFFFFU) + (p2 & 0xFFFFFFFFU);
+        q += uint64_t(1U) << 31; // Round.
+
+        return diy_fp(p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e + y.e + 64);
+      }
+
+      //*************************************************************************
+      /// Shifts the non-zero significand left until the top bit is set.
+      //*************************************************************************
+      static diy_fp normalize(diy_fp x)
+      {
+        while ((x.f >> 63) == 0U)
+        {
+          x.f <<= 1;
+          --x.e;
+        }
+
+        return x;
+      }
+
+      //*************************************************************************
+      /// Shifts the significand left to give the exponent e.
+      //*************************************************************************
+      static diy_fp normalize_to(const diy_fp& x, int e)
+      {
+        return diy_fp(x.f << (x.e - e), e);
+      }
+
+      uint64_t f;
+      int      e;
+    };
+
+    //***************************************************************************
+    /// The value and the boundaries of the interval that rounds to it.
+    /// All three have the same exponent.
+    //***************************************************************************
+    struct boundaries
+    {
+      boundaries(const diy_fp& w_, const diy_fp& minus_, const diy_fp& plus_)
+        : w(w_)
+        , minus(minus_)
+        , plus(plus_)
+      {
+      }
+
+      diy_fp w;
+      diy_fp minus;
+      diy_fp plus;
+    };
+
+    //***************************************************************************
+    /// The raw bits of a float or double.
+    //***************************************************************************
+    inline uint64_t get_bits(double value)
+    {
+      uint64_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    inline uint64_t get_bits(float value)
+    {
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    //***************************************************************************
+    /// Calculates the boundaries of a finite, positive value.
+    /// The boundaries are half way to the neighbouring values of the same type,
+    /// so a float gets the shortest digits that round trip as a float.
+    //***************************************************************************
+    template <typename T>
+    boundaries compute_boundaries(T value)
+    {
+      const int      PRECISION  = std::numeric_limits<T>::digits; // Including the hidden bit.
+      const int      BIAS       = std::numeric_limits<T>::max_exponent - 1 + (PRECISION - 1);
+      const int      MIN_EXP    = 1 - BIAS;
+      const uint64_t HIDDEN_BIT = uint64_t(1U) << (PRECISION - 1);
+
+      const uint64_t bits = get_bits(value);
+      const uint64_t E    = bits >> (PRECISION - 1);
+      const uint64_t F    = bits & (HIDDEN_BIT - 1U);
+
+      const diy_fp v = (E == 0U) ? diy_fp(F, MIN_EXP) : diy_fp(F + HIDDEN_BIT, int(E) - BIAS);
+
+      // The lower boundary is closer when the value is a power of two.
+      const bool lower_is_closer = (F == 0U) && (E > 1U);
+
+      const diy_fp m_plus  = diy_fp((2U * v.f) + 1U, v.e - 1);
+      const diy_fp m_minus = lower_is_closer ? diy_fp((4U * v.f) - 1U, v.e - 2)
+                                             : diy_fp((2U * v.f) - 1U, v.e - 1);
+
+      if (E != 0U)
+      {
+        // A normal value has its top bit in a known place.
+        const int SHIFT = 64 - PRECISION;
+
+        const diy_fp w(v.f << SHIFT, v.e - SHIFT);
+
+        return boundaries(w,
+                          diy_fp::normalize_to(m_minus, w.e),
+                          diy_fp::normalize_to(m_plus, w.e));
+      }
+      else
+      {
+        const diy_fp w_plus  = diy_fp::normalize(m_plus);
+        const diy_fp w_minus = diy_fp::normalize_to(m_minus, w_plus.e);
+
+        return boundaries(diy_fp::normalize(v), w_minus, w_plus);
+      }
+    }
+
+    //***************************************************************************
+    /// A cached, normalised power of ten.
+    /// 10^k ~= f * 2^e
+    //***************************************************************************
+    struct cached_power
+    {
+      uint64_t f;
+      int      e;
+      int      k;
+    };
+
+    //***************************************************************************
+    /// The normalised powers of ten from 10^-300 to 10^324, in steps of 10^8.
+    //***************************************************************************
+    template <typename TDummy>
+    struct cached_powers
+    {
+      static const int MIN_DECIMAL_EXPONENT = -300;
+      static const int DECIMAL_STEP         = 8;
+
+      static const cached_power table[79];
+    };
+
+    template <typename TDummy>
+    const cached_power cached_powers<TDummy>::table[79] =
+    {
+        { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+        { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+        { 0xBE5691EF416BD60CULL, -1007, -284 },
+        { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+        { 0xD3515C2831559A83ULL,  -954, -268 },
+        { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+        { 0xEA9C227723EE8BCBULL,  -901, -252 },
+        { 0xAECC49914078536DULL,  -874, -244 },
+        { 0x823C12795DB6CE57ULL,  -847, -236 },
+        { 0xC21094364DFB5637ULL,  -821, -228 },
+        { 0x9096EA6F3848984FULL,  -794, -220 },
+        { 0xD77485CB25823AC7ULL,  -768, -212 },
+        { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+        { 0xEF340A98172AACE5ULL,  -715, -196 },
+        { 0xB23867FB2A35B28EULL,  -688, -188 },
+        { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+        { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+        { 0x936B9FCEBB25C996ULL,  -608, -164 },
+        { 0xDBAC6C247D62A584ULL,  -582, -156 },
+        { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+        { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+        { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+        { 0x87625F056C7C4A8BULL,  -475, -124 },
+        { 0xC9BCFF6034C13053ULL,  -449, -116 },
+        { 0x964E858C91BA2655ULL,  -422, -108 },
+        { 0xDFF9772470297EBDULL,  -396, -100 },
+        { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+        { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+        { 0xB94470938FA89BCFULL,  -316,  -76 },
+        { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+        { 0xCDB02555653131B6ULL,  -263,  -60 },
+        { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+        { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+        { 0xAA242499697392D3ULL,  -183,  -36 },
+        { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+        { 0xBCE5086492111AEBULL,  -130,  -20 },
+        { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+        { 0xD1B71758E219652CULL,   -77,   -4 },
+        { 0x9C40000000000000ULL,   -50,    4 },
+        { 0xE8D4A51000000000ULL,   -24,   12 },
+        { 0xAD78EBC5AC620000ULL,     3,   20 },
+        { 0x813F3978F8940984ULL,    30,   28 },
+        { 0xC097CE7BC90715B3ULL,    56,   36 },
+        { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+        { 0xD5D238A4ABE98068ULL,   109,   52 },
+        { 0x9F4F2726179A2245ULL,   136,   60 },
+        { 0xED63A231D4C4FB27ULL,   162,   68 },
+        { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+        { 0x83C7088E1AAB65DBULL,   216,   84 },
+        { 0xC45D1DF942711D9AULL,   242,   92 },
+        { 0x924D692CA61BE758ULL,   269,  100 },
+        { 0xDA01EE641A708DEAULL,   295,  108 },
+        { 0xA26DA3999AEF774AULL,   322,  116 },
+        { 0xF209787BB47D6B85ULL,   348,  124 },
+        { 0xB454E4A179DD1877ULL,   375,  132 },
+        { 0x865B86925B9BC5C2ULL,   402,  140 },
+        { 0xC83553C5C8965D3DULL,   428,  148 },
+        { 0x952AB45CFA97A0B3ULL,   455,  156 },
+        { 0xDE469FBD99A05FE3ULL,   481,  164 },
+        { 0xA59BC234DB398C25ULL,   508,  172 },
+        { 0xF6C69A72A3989F5CULL,   534,  180 },
+        { 0xB7DCBF5354E9BECEULL,   561,  188 },
+        { 0x88FCF317F22241E2ULL,   588,  196 },
+        { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+        { 0x98165AF37B2153DFULL,   641,  212 },
+        { 0xE2A0B5DC971F303AULL,   667,  220 },
+        { 0xA8D9D1535CE3B396ULL,   694,  228 },
+        { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+        { 0xBB764C4CA7A44410ULL,   747,  244 },
+        { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+        { 0xD01FEF10A657842CULL,   800,  260 },
+        { 0x9B10A4E5E9913129ULL,   827,  268 },
+        { 0xE7109BFBA19C0C9DULL,   853,  276 },
+        { 0xAC2820D9623BF429ULL,   880,  284 },
+        { 0x80444B5E7AA7CF85ULL,   907,  292 },
+        { 0xBF21E44003ACDD2DULL,   933,  300 },
+        { 0x8E679C2F5E44FF8FULL,   960,  308 },
+        { 0xD433179D9C8CB841ULL,   986,  316 },
+        { 0x9E19DB92B4E31BA9ULL,  1013,  324 }    };
+
+    //***************************************************************************
+    /// The lowest exponent targeted for the scaled value. The highest is -32,
+    /// so that the integral part of the scaled upper boundary fits in 32 bits.
+    //***************************************************************************
+    static const int ALPHA = -60;
+
+    //***************************************************************************
+    /// Gets the cached power c = 10^-k such that ALPHA <= e + c.e + 64 <= -32.
+    //***************************************************************************
+    inline const cached_power& get_cached_power(int e)
+    {
+      typedef cached_powers<void> powers;
+
+      // k = ceil((ALPHA - e - 1) * log10(2)), with 78913 / 2^18 ~= log10(2).
+      const int f = ALPHA - e - 1;
+      const int k = ((f * 78913) / (1 << 18)) + ((f > 0) ? 1 : 0);
+
+      const int index = (-powers::MIN_DECIMAL_EXPONENT + k + (powers::DECIMAL_STEP - 1)) / powers::DECIMAL_STEP;
+
+      return powers::table[index];
+    }
+
+    //***************************************************************************
+    /// Finds the largest power of ten <= n.
+    ///\return The number of decimal digits in n.
+    //***************************************************************************
+    inline int find_largest_pow10(uint32_t n, uint32_t& pow10)
+    {
+      int digits = 1;
+      pow10 = 1U;
+
+      while ((digits < 10) && (n >= (pow10 * 10U)))
+      {
+        pow10 *= 10U;
+        ++digits;
+      }
+
+      return digits;
+    }
+
+    //***************************************************************************
+    /// Moves the last digit towards the value while it stays inside the
+    /// rounding interval, to give the closest of the shortest representations.
+    //***************************************************************************
+    inline void round_last_digit(char* buffer, int length, uint64_t distance, uint64_t delta, uint64_t rest, uint64_t ten_k)
+    {
+      while ((rest < distance) &&
+             ((delta - rest) >= ten_k) &&
+             (((rest + ten_k) < distance) || ((distance - rest) > (rest + ten_k - distance))))
+      {
+        --buffer[length - 1];
+        rest += ten_k;
+      }
+    }
+
+    //***************************************************************************
+    /// Generates the digits of w, stopping as soon as they identify a value in
+    /// the interval [M-, M+].
+    //***************************************************************************
+    inline void generate_digits(char* buffer, int& length, int& decimal_exponent, const diy_fp& m_minus, const diy_fp& w, const diy_fp& m_plus)
+    {
+      uint64_t delta    = diy_fp::sub(m_plus, m_minus).f;
+      uint64_t distance = diy_fp::sub(m_plus, w).f;
+
+      // Split M+ into an integral part p1 and a fractional part p2.
+      const diy_fp one(uint64_t(1U) << -m_plus.e, m_plus.e);
+
+      uint32_t p1 = uint32_t(m_plus.f >> -one.e);
+      uint64_t p2 = m_plus.f & (one.f - 1U);
+
+      uint32_t pow10;
+      int n = find_largest_pow10(p1, pow10);
+
+      // The integral digits.
+      while (n > 0)
+      {
+        const uint32_t d = p1 / pow10;
+        p1 %= pow10;
+
+        buffer[length++] = char('0' + d);
+        --n;
+
+        const uint64_t rest = (uint64_t(p1) << -one.e) + p2;
+
+        if (rest <= delta)
+        {
+          decimal_exponent += n;
+          round_last_digit(buffer, length, distance, delta, rest, uint64_t(pow10) << -one.e);
+          return;
+        }
+
+        pow10 /= 10U;
+      }
+
+      // The fractional digits.
+      int m = 0;
+
+      while (true)
+      {
+        p2 *= 10U;
+        const uint64_t d = p2 >> -one.e;
+        p2 &= (one.f - 1U);
+
+        buffer[length++] = char('0' + d);
+        ++m;
+
+        delta    *= 10U;
+        distance *= 10U;
+
+        if (p2 <= delta)
+        {
+          break;
+        }
+      }
+
+      decimal_exponent -= m;
+      round_last_digit(buffer, length, distance, delta, p2, one.f);
+    }
+
+    //***************************************************************************
+    /// Generates the shortest decimal digits that convert back to the value.
+    /// Uses the Grisu2 algorithm, which needs no big integer arithmetic.
+    /// value = digits * 10^decimal_exponent
+    ///\param value            A finite value. The sign is ignored.
+    ///\param buffer           Receives the digits. At least MAX_DIGITS long.
+    ///\param length           Receives the number of digits.
+    ///\param decimal_exponent Receives the exponent of the last digit.
+    //***************************************************************************
+    template <typename T>
+    void generate(T value, char* buffer, int& length, int& decimal_exponent)
+    {
+      length           = 0;
+      decimal_exponent = 0;
+
+      if (value < T(0))
+      {
+        value = -value;
+      }
+
+      if (value == T(0))
+      {
+        buffer[length++] = '0';
+        return;
+      }
+
+      const boundaries b = compute_boundaries(value);
+
+      const cached_power& cached = get_cached_power(b.plus.e);
+      const diy_fp c(cached.f, cached.e);
+
+      const diy_fp w       = diy_fp::mul(b.w, c);
+      const diy_fp w_minus = diy_fp::mul(b.minus, c);
+      const diy_fp w_plus  = diy_fp::mul(b.plus, c);
+
+      // Shrink the interval by one unit either side to allow for the error in
+      // the multiplications, so that the result always rounds back correctly.
+      const diy_fp m_minus(w_minus.f + 1U, w_minus.e);
+      const diy_fp m_plus(w_plus.f - 1U, w_plus.e);
+
+      decimal_exponent = -cached.k;
+
+      generate_digits(buffer, length, decimal_exponent, m_minus, w, m_plus);
+    }
+
+    //***************************************************************************
+    /// Long double is formatted as a double.
+    //***************************************************************************
+    inline void generate(long double value, char* buffer, int& length, int& decimal_exponent)
+    {
+      generate(static_cast<double>(value), buffer, length, decimal_exponent);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,423 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_STRING_SEARCH_INCLUDED
+#define ETL_STRING_SEARCH_INCLUDED
+
+///\ingroup private
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../platform.h"
+#include "../stl/algorithm.h"
+#include "../binary.h"
+#include "../nullptr.h"
+
+// Select the vector instructions for the char searches.
+// Define ETL_NO_SIMD to use the scalar searches only.
+#if !defined(ETL_NO_SIMD)
+  #if defined(__AVX2__)
+    #include <immintrin.h>
+    #define ETL_STRING_SEARCH_AVX2
+  #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define ETL_STRING_SEARCH_SSE2
+  #endif
+#endif
+
+namespace etl
+{
+  namespace private_string_search
+  {
+#if defined(ETL_STRING_SEARCH_AVX2)
+    //*************************************************************************
+    /// 32 byte vector operations.
+    //*************************************************************************
+    struct simd
+    {
+      typedef __m256i vector_t;
+
+      static const size_t WIDTH = 32;
+
+      static vector_t load(const char* p)
+      {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      }
+
+      static vector_t broadcast(char c)
+      {
+        return _mm256_set1_epi8(c);
+      }
+
+      static vector_t equal(vector_t a, vector_t b)
+      {
+        return _mm256_cmpeq_epi8(a, b);
+      }
+
+      static vector_t both(vector_t a, vector_t b)
+      {
+        return _mm256_and_si256(a, b);
+      }
+
+      static vector_t either(vector_t a, vector_t b)
+      {
+        return _mm256_or_si256(a, b);
+      }
+
+      static uint32_t mask(vector_t a)
+      {
+        return uint32_t(_mm256_movemask_epi8(a));
+      }
+    };
+#elif defined(ETL_STRING_SEARCH_SSE2)
+    //*************************************************************************
+    /// 16 byte vector operations.
+    //*************************************************************************
+    struct simd
+    {
+      typedef __m128i vector_t;
+
+      static const size_t WIDTH = 16;
+
+      static vector_t load(const char* p)
+      {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      }
+
+      static vector_t broadcast(char c)
+      {
+        return _mm_set1_epi8(c);
+      }
+
+      static vector_t equal(vector_t a, vector_t b)
+      {
+        return _mm_cmpeq_epi8(a, b);
+      }
+
+      static vector_t both(vector_t a, vector_t b)
+      {
+        return _mm_and_si128(a, b);
+      }
+
+      static vector_t either(vector_t a, vector_t b)
+      {
+        return _mm_or_si128(a, b);
+      }
+
+      static uint32_t mask(vector_t a)
+      {
+        return uint32_t(_mm_movemask_epi8(a));
+      }
+    };
+#endif
+
+    //*************************************************************************
+    /// A set of char values, one bit per value.
+    //*************************************************************************
+    class char_set
+    {
+    public:
+
+      char_set(const char* s, size_t n)
+      {
+        memset(bits, 0, sizeof(bits));
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          const unsigned char c = static_cast<unsigned char>(s[i]);
+          bits[c >> 5] |= uint32_t(1) << (c & 31);
+        }
+      }
+
+      bool contains(char value) const
+      {
+        const unsigned char c = static_cast<unsigned char>(value);
+        return (bits[c >> 5] & (uint32_t(1) << (c & 31))) != 0;
+      }
+
+    private:
+
+      uint32_t bits[8];
+    };
+
+    //*************************************************************************
+    /// Finds the first occurrence of the character.
+    ///\return A pointer to the character, or 'last' if not found.
+    //*************************************************************************
+    template <typename T>
+    const T* find_character(const T* first, const T* last, T c)
+    {
+      return std::find(first, last, c);
+    }
+
+    //*************************************************************************
+    /// Finds the first occurrence of the character.
+    /// Uses memchr, which the C library normally vectorises.
+    //*************************************************************************
+    inline const char* find_character(const char* first, const char* last, char c)
+    {
+      const void* p = memchr(first, c, size_t(last - first));
+
+      return (p == nullptr) ? last : static_cast<const char*>(p);
+    }
+
+    //*************************************************************************
+    /// Finds the first occurrence of the sequence of 'n' characters.
+    ///\return A pointer to the start of the sequence, or 'last' if not found.
+    //*************************************************************************
+    template <typename T>
+    const T* find_sequence(const T* first, const T* last, const T* s, size_t n)
+    {
+      return std::search(first, last, s, s + n);
+    }
+
+    //*************************************************************************
+    /// Finds the first occurrence of the sequence of 'n' characters.
+    /// Candidates are filtered by comparing both the first and last characters
+    /// of the sequence, a vector at a time where available, before comparing
+    /// the characters in between.
+    //*************************************************************************
+    inline const char* find_sequence(const char* first, const char* last, const char* s, size_t n)
+    {
+      const size_t length = size_t(last - first);
+
+      if (n == 0)
+      {
+        return first;
+      }
+
+      if (n > length)
+      {
+        return last;
+      }
+
+      if (n == 1)
+      {
+        return find_character(first, last, s[0]);
+      }
+
+      // The positions at which the sequence could start.
+      const size_t candidates = length - n + 1;
+      size_t i = 0;
+
+#if defined(ETL_STRING_SEARCH_AVX2) || defined(ETL_STRING_SEARCH_SSE2)
+      const simd::vector_t first_char = simd::broadcast(s[0]);
+      const simd::vector_t last_char  = simd::broadcast(s[n - 1]);
+
+      while ((i + simd::WIDTH) <= candidates)
+      {
+        const simd::vector_t starts = simd::load(first + i);
+        const simd::vector_t ends   = simd::load(first + i + n - 1);
+
+        uint32_t matches = simd::mask(simd::both(simd::equal(starts, first_char), simd::equal(ends, last_char)));
+
+        while (matches != 0)
+        {
+          const size_t position = i + etl::count_trailing_zeros(matches);
+
+          if (memcmp(first + position + 1, s + 1, n - 2) == 0)
+          {
+            return first + position;
+          }
+
+          // Clear the lowest match.
+          matches &= matches - 1;
+        }
+
+        i += simd::WIDTH;
+      }
+#endif
+
+      while (i < candidates)
+      {
+        const char* p = find_character(first + i, first + candidates, s[0]);
+
+        if (p == (first + candidates))
+        {
+          break;
+        }
+
+        if ((p[n - 1] == s[n - 1]) && (memcmp(p + 1, s + 1, n - 2) == 0))
+        {
+          return p;
+        }
+
+        i = size_t(p - first) + 1;
+      }
+
+      return last;
+    }
+
+    //*************************************************************************
+    /// Finds the first character that matches any of the 'n' characters.
+    ///\return A pointer to the character, or 'last' if not found.
+    //*************************************************************************
+    template <typename T>
+    const T* find_first_of(const T* first, const T* last, const T* s, size_t n)
+    {
+      while (first != last)
+      {
+        for (size_t j = 0; j < n; ++j)
+        {
+          if (*first == s[j])
+          {
+            return first;
+          }
+        }
+
+        ++first;
+      }
+
+      return last;
+    }
+
+    //*************************************************************************
+    /// Finds the first character that matches any of the 'n' characters.
+    /// Small sets are compared a vector at a time, where available. Otherwise
+    /// each character is looked up in a bitmap of the set.
+    //*************************************************************************
+    inline const char* find_first_of(const char* first, const char* last, const char* s, size_t n)
+    {
+      if (n == 0)
+      {
+        return last;
+      }
+
+      if (n == 1)
+      {
+        return find_character(first, last, s[0]);
+      }
+
+#if defined(ETL_STRING_SEARCH_AVX2) || defined(ETL_STRING_SEARCH_SSE2)
+      // Up to this many characters, comparing against each is faster than the bitmap.
+      static const size_t MAX_VECTOR_SET = 8;
+
+      if (n <= MAX_VECTOR_SET)
+      {
+        simd::vector_t set[MAX_VECTOR_SET];
+
+        for (size_t j = 0; j < n; ++j)
+        {
+          set[j] = simd::broadcast(s[j]);
+        }
+
+        while (size_t(last - first) >= simd::WIDTH)
+        {
+          const simd::vector_t text    = simd::load(first);
+          simd::vector_t       matches = simd::equal(text, set[0]);
+
+          for (size_t j = 1; j < n; ++j)
+          {
+            matches = simd::either(matches, simd::equal(text, set[j]));
+          }
+
+          const uint32_t mask = simd::mask(matches);
+
+          if (mask != 0)
+          {
+            return first + etl::count_trailing_zeros(mask);
+          }
+
+          first += simd::WIDTH;
+        }
+      }
+#endif
+
+      const char_set set(s, n);
+
+      while (first != last)
+      {
+        if (set.contains(*first))
+        {
+          return first;
+        }
+
+        ++first;
+      }
+
+      return last;
+    }
+
+    //*************************************************************************
+    /// Finds the last character that matches any of the 'n' characters.
+    ///\return A pointer to the character, or 'last' if not found.
+    //*************************************************************************
+    template <typename T>
+    const T* find_last_of(const T* first, const T* last, const T* s, size_t n)
+    {
+      const T* p = last;
+
+      while (p != first)
+      {
+        --p;
+
+        for (size_t j = 0; j < n; ++j)
+        {
+          if (*p == s[j])
+          {
+            return p;
+          }
+        }
+      }
+
+      return last;
+    }
+
+    //*************************************************************************
+    /// Finds the last character that matches any of the 'n' characters.
+    /// Each character is looked up in a bitmap of the set.
+    //*************************************************************************
+    inline const char* find_last_of(const char* first, const char* last, const char* s, size_t n)
+    {
+      const char_set set(s, n);
+      const char*    p = last;
+
+      while (p != first)
+      {
+        --p;
+
+        if (set.contains(*p))
+        {
+          return p;
+        }
+      }
+
+      return last;
+    }
+  }
+}
+
+#undef ETL_STRING_SEARCH_AVX2
+#undef ETL_STRING_SEARCH_SSE2
+
+#endif
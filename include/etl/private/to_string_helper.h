@@ -42,6 +42,8 @@ SOFTWARE.
 #include "../type_traits.h"
 #include "../container.h"
 
+#include "floating_point_digits.h"
+
 #include "../stl/algorithm.h"
 #include "../stl/iterator.h"
 #include "../stl/limits.h"
@@ -123,6 +125,208 @@ namespace etl
       etl::private_to_string::add_alignment(str, start, format);
     }
 
+    //***************************************************************************
+    /// The decimal digit pairs "00" to "99".
+    //***************************************************************************
+    template <typename TDummy>
+    struct digit_pairs
+    {
+      static const char text[200];
+    };
+
+    template <typename TDummy>
+    const char digit_pairs<TDummy>::text[200] =
+    {
+      '0','0', '0','1', '0','2', '0','3', '0','4', '0','5', '0','6', '0','7', '0','8', '0','9',
+      '1','0', '1','1', '1','2', '1','3', '1','4', '1','5', '1','6', '1','7', '1','8', '1','9',
+      '2','0', '2','1', '2','2', '2','3', '2','4', '2','5', '2','6', '2','7', '2','8', '2','9',
+      '3','0', '3','1', '3','2', '3','3', '3','4', '3','5', '3','6', '3','7', '3','8', '3','9',
+      '4','0', '4','1', '4','2', '4','3', '4','4', '4','5', '4','6', '4','7', '4','8', '4','9',
+      '5','0', '5','1', '5','2', '5','3', '5','4', '5','5', '5','6', '5','7', '5','8', '5','9',
+      '6','0', '6','1', '6','2', '6','3', '6','4', '6','5', '6','6', '6','7', '6','8', '6','9',
+      '7','0', '7','1', '7','2', '7','3', '7','4', '7','5', '7','6', '7','7', '7','8', '7','9',
+      '8','0', '8','1', '8','2', '8','3', '8','4', '8','5', '8','6', '8','7', '8','8', '8','9',
+      '9','0', '9','1', '9','2', '9','3', '9','4', '9','5', '9','6', '9','7', '9','8', '9','9'
+    };
+
+    //***************************************************************************
+    /// Counts the decimal digits in the value.
+    //***************************************************************************
+    template <typename T>
+    uint32_t count_decimal_digits(T value)
+    {
+      uint32_t count = 1;
+
+      // Four digits per division.
+      while (value >= 10000U)
+      {
+        value /= 10000U;
+        count += 4;
+      }
+
+      if (value >= 1000U)
+      {
+        count += 3;
+      }
+      else if (value >= 100U)
+      {
+        count += 2;
+      }
+      else if (value >= 10U)
+      {
+        count += 1;
+      }
+
+      return count;
+    }
+
+    //***************************************************************************
+    /// Counts the hexadecimal digits in the value.
+    //***************************************************************************
+    template <typename T>
+    uint32_t count_hex_digits(T value)
+    {
+      uint32_t count = 1;
+
+      // Four digits per shift.
+      while (value >= 0x10000U)
+      {
+        value >>= 16;
+        count += 4;
+      }
+
+      if (value >= 0x1000U)
+      {
+        count += 3;
+      }
+      else if (value >= 0x100U)
+      {
+        count += 2;
+      }
+      else if (value >= 0x10U)
+      {
+        count += 1;
+      }
+
+      return count;
+    }
+
+    //***************************************************************************
+    /// Writes the decimal digits of the value backwards from 'p'.
+    //***************************************************************************
+    template <typename T, typename TChar>
+    void write_decimal_digits(T value, TChar* p)
+    {
+      const char* const pairs = digit_pairs<void>::text;
+
+      // Two digits per division.
+      while (value >= 100U)
+      {
+        const uint32_t index = uint32_t(value % 100U) * 2U;
+        value /= 100U;
+
+        *--p = TChar(pairs[index + 1]);
+        *--p = TChar(pairs[index]);
+      }
+
+      if (value >= 10U)
+      {
+        const uint32_t index = uint32_t(value) * 2U;
+
+        *--p = TChar(pairs[index + 1]);
+        *--p = TChar(pairs[index]);
+      }
+      else
+      {
+        *--p = TChar('0' + uint32_t(value));
+      }
+    }
+
+    //***************************************************************************
+    /// Writes the hexadecimal digits of the value backwards from 'p'.
+    //***************************************************************************
+    template <typename T, typename TChar>
+    void write_hex_digits(T value, TChar* p, const bool upper_case)
+    {
+      const char* const digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+
+      // Two digits per shift.
+      while (value >= 0x100U)
+      {
+        const uint32_t pair = uint32_t(value) & 0xFFU;
+        value >>= 8;
+
+        *--p = TChar(digits[pair & 0x0FU]);
+        *--p = TChar(digits[pair >> 4]);
+      }
+
+      if (value >= 0x10U)
+      {
+        *--p = TChar(digits[uint32_t(value) & 0x0FU]);
+        *--p = TChar(digits[uint32_t(value) >> 4]);
+      }
+      else
+      {
+        *--p = TChar(digits[uint32_t(value)]);
+      }
+    }
+
+    //***************************************************************************
+    /// Helper function for decimal and hexadecimal integrals.
+    /// Counts the digits first, so that the sign, digits and fill can be written
+    /// directly into place in one pass.
+    ///\return <b>false</b> if the result would not fit in the string, without
+    /// changing it.
+    //***************************************************************************
+    template <typename T, typename TIString>
+    bool add_integral_in_place(T value,
+                               TIString& str,
+                               const etl::basic_format_spec<TIString>& format)
+    {
+      typedef typename TIString::value_type        type;
+      typedef typename etl::make_unsigned<T>::type unsigned_t;
+
+      const bool decimal  = (format.get_base() == 10);
+      const bool negative = etl::is_negative(value);
+
+      // The magnitude, which is correct for the most negative value too.
+      const unsigned_t magnitude = negative ? unsigned_t(unsigned_t(0) - unsigned_t(value)) : unsigned_t(value);
+
+      const uint32_t digits = decimal ? count_decimal_digits(magnitude) : count_hex_digits(magnitude);
+      const uint32_t sign   = (decimal && negative) ? 1U : 0U;
+      const uint32_t length = digits + sign;
+      const uint32_t width  = (format.get_width() > length) ? format.get_width() : length;
+
+      if (width > str.available())
+      {
+        return false;
+      }
+
+      const size_t start = str.size();
+
+      // Pre-fill with the fill character, then write the number over the end
+      // or the start of it.
+      str.resize(start + width, format.get_fill());
+
+      type* p = str.data() + start + (format.is_left() ? 0 : (width - length));
+
+      if (sign != 0)
+      {
+        *p = type('-');
+      }
+
+      if (decimal)
+      {
+        write_decimal_digits(magnitude, p + length);
+      }
+      else
+      {
+        write_hex_digits(magnitude, p + length, format.is_upper_case());
+      }
+
+      return true;
+    }
+
     //***************************************************************************
     /// Helper function for integrals.
     //***************************************************************************
@@ -142,6 +346,15 @@ namespace etl
         str.clear();
       }
 
+      // Decimal and hexadecimal are formatted in place, if they fit.
+      if ((format.get_base() == 10) || (format.get_base() == 16))
+      {
+        if (etl::private_to_string::add_integral_in_place(value, str, format))
+        {
+          return;
+        }
+      }
+
       iterator start = str.end();
 
       if (value == 0)
@@ -195,28 +408,596 @@ namespace etl
     }
 
     //***************************************************************************
-    /// Helper function for floating point integral and fractional.
+    /// Helper function for floating point in fixed notation, using exact
+    /// integer arithmetic on the binary value. Rounds half to even, as printf.
+    /// Handles non-negative values from about 2^-8 up to 2^64, which are split
+    /// into a 64 bit integral part and a fraction of up to 60 bits.
+    /// Values with more than 64 significant bits are not handled.
+    ///\return <b>true</b> if the value was in range and has been added.
+    //***************************************************************************
+    template <typename T, typename TIString>
+    bool add_fixed_exact(const T value,
+                         const int precision,
+                         TIString& str)
+    {
+      typedef typename TIString::value_type type;
+
+      // The mantissa is held in 64 bits, even for a wider long double.
+      const int DIGITS        = (std::numeric_limits<T>::digits < 64) ? std::numeric_limits<T>::digits : 64;
+      const int FRACTION_BITS = 60;
+
+      // value = mantissa * 2^(exponent - DIGITS)
+      int exponent;
+      const T normalised = frexp(value, &exponent);
+
+      const int shift = DIGITS - exponent;
+
+      if ((exponent > 64) || (shift > FRACTION_BITS))
+      {
+        return false;
+      }
+
+      // In range, so the scaled value is less than 2^64.
+      const T        scaled   = ldexp(normalised, DIGITS);
+      const uint64_t mantissa = static_cast<uint64_t>(scaled);
+
+      // More significant bits than fit in 64.
+      if (static_cast<T>(mantissa) != scaled)
+      {
+        return false;
+      }
+
+      uint64_t integral;
+      uint64_t fraction = 0U;
+      uint64_t mask     = 0U;
+
+      if (shift <= 0)
+      {
+        integral = mantissa << -shift;
+      }
+      else
+      {
+        mask     = (uint64_t(1U) << shift) - 1U;
+        integral = mantissa >> shift;
+        fraction = mantissa & mask;
+      }
+
+      // Each digit removes a factor of two from the fraction, so there are
+      // never more than FRACTION_BITS non-zero digits.
+      char digits[FRACTION_BITS];
+      const int length = (fraction == 0U) ? 0 : ((precision < FRACTION_BITS) ? precision : FRACTION_BITS);
+
+      uint64_t last_digit = integral;
+
+      for (int i = 0; i < length; ++i)
+      {
+        fraction *= 10U;
+        last_digit = fraction >> shift;
+        digits[i]  = char('0' + last_digit);
+        fraction &= mask;
+      }
+
+      // Round the remainder, half to even.
+      if (fraction != 0U)
+      {
+        const uint64_t half = uint64_t(1U) << (shift - 1);
+        const bool     odd  = ((last_digit & 1U) != 0U);
+
+        if ((fraction > half) || ((fraction == half) && odd))
+        {
+          int i = length - 1;
+
+          while ((i >= 0) && (digits[i] == '9'))
+          {
+            digits[i] = '0';
+            --i;
+          }
+
+          if (i < 0)
+          {
+            ++integral;
+          }
+          else
+          {
+            ++digits[i];
+          }
+        }
+      }
+
+      type integral_digits[20];
+      const uint32_t integral_length = count_decimal_digits(integral);
+      write_decimal_digits(integral, integral_digits + integral_length);
+
+      str.insert(str.end(), integral_digits, integral_digits + integral_length);
+
+      if (precision > 0)
+      {
+        str.push_back(type('.'));
+
+        for (int i = 0; i < length; ++i)
+        {
+          str.push_back(type(digits[i]));
+        }
+
+        str.insert(str.end(), size_t(precision - length), type('0'));
+      }
+
+      return true;
+    }
+
+    //***************************************************************************
+    /// The number of bits needed to hold the integral part of any value of T,
+    /// or its fraction scaled to an integer and multiplied by ten.
+    /// Limited to the bits needed for a double, to bound the stack used by
+    /// a wider long double.
+    //***************************************************************************
+    template <typename T>
+    struct exact_fixed_bits
+    {
+    private:
+
+      template <typename U>
+      struct bits_for
+      {
+        static const int INTEGRAL_BITS = std::numeric_limits<U>::max_exponent;
+        static const int FRACTION_BITS = (2 * std::numeric_limits<U>::digits) - std::numeric_limits<U>::min_exponent + 4;
+        static const int value         = (INTEGRAL_BITS > FRACTION_BITS) ? INTEGRAL_BITS : FRACTION_BITS;
+      };
+
+    public:
+
+      static const int value = (bits_for<T>::value < bits_for<double>::value) ? bits_for<T>::value : bits_for<double>::value;
+    };
+
+    //***************************************************************************
+    /// A fixed size unsigned integer, for exact fixed notation of values out
+    /// of the range of 64 bit arithmetic.
+    /// The words are stored least significant first.
+    //***************************************************************************
+    template <const size_t WORDS>
+    class exact_fixed_number
+    {
+    public:
+
+      static const size_t BITS = WORDS * 32U;
+
+      // The most groups of nine decimal digits in a value of BITS bits.
+      static const size_t DECIMAL_GROUPS = (BITS / 29U) + 1U;
+
+      //*************************************************************************
+      exact_fixed_number()
+        : used(0U)
+      {
+      }
+
+      //*************************************************************************
+      /// Loads a non-negative integral floating point value of up to BITS bits.
+      //*************************************************************************
+      template <typename T>
+      void assign(T value)
+      {
+        used = 0U;
+
+        while (value != T(0))
+        {
+          const T high = floor(ldexp(value, -32));
+
+          words[used] = static_cast<uint32_t>(value - ldexp(high, 32));
+          ++used;
+          value = high;
+        }
+      }
+
+      //*************************************************************************
+      bool is_zero() const
+      {
+        return used == 0U;
+      }
+
+      //*************************************************************************
+      /// Multiplies by a small factor.
+      //*************************************************************************
+      void multiply(uint32_t factor)
+      {
+        uint32_t carry = 0U;
+
+        for (size_t i = 0U; i < used; ++i)
+        {
+          const uint64_t product = (uint64_t(words[i]) * factor) + carry;
+
+          words[i] = uint32_t(product);
+          carry    = uint32_t(product >> 32);
+        }
+
+        if (carry != 0U)
+        {
+          words[used] = carry;
+          ++used;
+        }
+      }
+
+      //*************************************************************************
+      /// Divides by a small divisor and returns the remainder.
+      //*************************************************************************
+      uint32_t divide(uint32_t divisor)
+      {
+        uint64_t remainder = 0U;
+
+        for (size_t i = used; i-- != 0U;)
+        {
+          const uint64_t dividend = (remainder << 32) | words[i];
+
+          words[i]  = uint32_t(dividend / divisor);
+          remainder = dividend % divisor;
+        }
+
+        trim();
+
+        return uint32_t(remainder);
+      }
+
+      //*************************************************************************
+      /// Removes and returns the bits from 'bit' upwards.
+      /// They must fit in 32 bits.
+      //*************************************************************************
+      uint32_t split(size_t bit)
+      {
+        const size_t index  = bit / 32U;
+        const size_t offset = bit % 32U;
+
+        uint32_t high = 0U;
+
+        if (index < used)
+        {
+          high = words[index] >> offset;
+
+          if ((offset != 0U) && ((index + 1U) < used))
+          {
+            high |= words[index + 1U] << (32U - offset);
+          }
+
+          words[index] &= (uint32_t(1U) << offset) - 1U;
+          used = index + 1U;
+          trim();
+        }
+
+        return high;
+      }
+
+      //*************************************************************************
+      /// Compares the value with 2^(bit - 1).
+      ///\return Less than, equal to or greater than zero.
+      //*************************************************************************
+      int compare_half(size_t bit) const
+      {
+        const size_t   index = (bit - 1U) / 32U;
+        const uint32_t half  = uint32_t(1U) << ((bit - 1U) % 32U);
+
+        if (used != (index + 1U))
+        {
+          return (used > (index + 1U)) ? 1 : -1;
+        }
+
+        if (words[index] != half)
+        {
+          return (words[index] > half) ? 1 : -1;
+        }
+
+        for (size_t i = 0U; i < index; ++i)
+        {
+          if (words[i] != 0U)
+          {
+            return 1;
+          }
+        }
+
+        return 0;
+      }
+
+    private:
+
+      //*************************************************************************
+      /// Removes leading zero words.
+      //*************************************************************************
+      void trim()
+      {
+        while ((used != 0U) && (words[used - 1U] == 0U))
+        {
+          --used;
+        }
+      }
+
+      uint32_t words[WORDS];
+      size_t   used;
+    };
+
+    //***************************************************************************
+    /// Helper function for floating point in fixed notation, for values out of
+    /// the range of add_fixed_exact. Uses exact arithmetic on a fixed size
+    /// integer and rounds half to even, as printf. Handles every float and
+    /// double, and every long double in the range of a double.
+    ///\return <b>true</b> if the value was in range and has been added.
+    //***************************************************************************
+    template <typename T, typename TIString>
+    bool add_fixed_exact_wide(const T value,
+                              const int precision,
+                              TIString& str)
+    {
+      typedef typename TIString::value_type type;
+
+      typedef etl::private_to_string::exact_fixed_number<(etl::private_to_string::exact_fixed_bits<T>::value + 31) / 32> number_t;
+
+      const int DIGITS = std::numeric_limits<T>::digits;
+
+      // value = mantissa * 2^(exponent - DIGITS)
+      int exponent;
+      frexp(value, &exponent);
+
+      // The fraction is held scaled by 2^shift and multiplied by ten for each digit.
+      const int shift = (exponent < DIGITS) ? (DIGITS - exponent) : 0;
+
+      if ((exponent > int(number_t::BITS)) || ((shift + 4) > int(number_t::BITS)))
+      {
+        return false;
+      }
+
+      const T integral = floor(value);
+
+      number_t number;
+
+      // The integral digits in groups of nine, least significant first.
+      uint32_t groups[number_t::DECIMAL_GROUPS];
+      size_t   n_groups = 0U;
+
+      number.assign(integral);
+
+      do
+      {
+        groups[n_groups] = number.divide(1000000000U);
+        ++n_groups;
+      } while (!number.is_zero());
+
+      const size_t start = str.size();
+
+      for (size_t g = n_groups; g-- != 0U;)
+      {
+        // Leading zeros for all but the most significant group.
+        type group_digits[9] = { type('0'), type('0'), type('0'), type('0'), type('0'), type('0'), type('0'), type('0'), type('0') };
+        const uint32_t group_length = (g == (n_groups - 1U)) ? count_decimal_digits(groups[g]) : 9U;
+
+        write_decimal_digits(groups[g], group_digits + 9);
+        str.insert(str.end(), group_digits + 9 - group_length, group_digits + 9);
+      }
+
+      if (precision > 0)
+      {
+        str.push_back(type('.'));
+      }
+
+      // Each digit removes a factor of two from the fraction, so there are
+      // never more than 'shift' non-zero digits.
+      uint32_t last_digit = groups[0];
+      int      length     = 0;
+
+      number.assign(ldexp(value - integral, shift));
+
+      while ((length < precision) && !number.is_zero())
+      {
+        number.multiply(10U);
+        last_digit = number.split(size_t(shift));
+        str.push_back(type('0' + last_digit));
+        ++length;
+      }
+
+      // Round the remainder, half to even.
+      if (!number.is_zero())
+      {
+        const int  half = number.compare_half(size_t(shift));
+        const bool odd  = ((last_digit & 1U) != 0U);
+
+        if ((half > 0) || ((half == 0) && odd))
+        {
+          size_t i = str.size();
+
+          while ((i != start) && ((str[i - 1] == type('9')) || (str[i - 1] == type('.'))))
+          {
+            --i;
+
+            if (str[i] == type('9'))
+            {
+              str[i] = type('0');
+            }
+          }
+
+          if (i == start)
+          {
+            str.insert(str.begin() + start, type('1'));
+          }
+          else
+          {
+            ++str[i - 1];
+          }
+        }
+      }
+
+      if (precision > length)
+      {
+        str.insert(str.end(), size_t(precision - length), type('0'));
+      }
+
+      return true;
+    }
+
+    //***************************************************************************
+    /// Helper function for floating point in fixed notation, for a long double
+    /// out of the range of add_fixed_exact_wide. The shortest digits are
+    /// rounded, half up, to 'precision' decimal places.
+    //***************************************************************************
+    template <typename TIString>
+    void add_fixed(char* digits,
+                   int length,
+                   int exponent,
+                   const int precision,
+                   TIString& str)
+    {
+      typedef typename TIString::value_type type;
+
+      // The number of digits before the decimal point.
+      int point = length + exponent;
+
+      const int kept = point + precision;
+
+      if (kept < length)
+      {
+        const bool round_up = (kept >= 0) && (digits[kept] >= '5');
+
+        length = (kept > 0) ? kept : 0;
+
+        if (round_up)
+        {
+          int i = length - 1;
+
+          while ((i >= 0) && (digits[i] == '9'))
+          {
+            --i;
+          }
+
+          if (i < 0)
+          {
+            // All nines, so carry into a new leading digit.
+            digits[0] = '1';
+            length = 1;
+            ++point;
+          }
+          else
+          {
+            ++digits[i];
+            length = i + 1;
+          }
+        }
+      }
+
+      // The integral part.
+      if (point <= 0)
+      {
+        str.push_back(type('0'));
+      }
+      else
+      {
+        for (int i = 0; i < point; ++i)
+        {
+          str.push_back((i < length) ? type(digits[i]) : type('0'));
+        }
+      }
+
+      // The fractional part.
+      if (precision > 0)
+      {
+        str.push_back(type('.'));
+
+        for (int i = point; i < (point + precision); ++i)
+        {
+          str.push_back(((i >= 0) && (i < length)) ? type(digits[i]) : type('0'));
+        }
+      }
+    }
+
+    //***************************************************************************
+    /// Helper function for floating point in the shortest form.
+    /// Uses fixed notation for values from 1e-6 up to 1e21, otherwise
+    /// scientific notation, e.g. "0.1", "1500", "1.5e+300".
     //***************************************************************************
     template <typename TIString>
-    void add_integral_fractional(const int64_t integral,
-                                 const int64_t fractional,
-                                 TIString& str,
-                                 const etl::basic_format_spec<TIString>& integral_format,
-                                 const etl::basic_format_spec<TIString>& fractional_format)
+    void add_shortest(const char* digits,
+                      const int length,
+                      const int exponent,
+                      TIString& str)
     {
       typedef typename TIString::value_type type;
 
-      etl::private_to_string::add_integral(integral, str, integral_format, true);
+      // The number of digits before the decimal point.
+      const int point = length + exponent;
 
-      if (fractional_format.get_precision() > 0)
+      if ((point >= length) && (point <= 21))
       {
+        // 1500
+        for (int i = 0; i < length; ++i)
+        {
+          str.push_back(type(digits[i]));
+        }
+
+        str.insert(str.end(), size_t(point - length), type('0'));
+      }
+      else if ((point > 0) && (point <= 21))
+      {
+        // 1.5
+        for (int i = 0; i < length; ++i)
+        {
+          if (i == point)
+          {
+            str.push_back(type('.'));
+          }
+
+          str.push_back(type(digits[i]));
+        }
+      }
+      else if ((point > -6) && (point <= 0))
+      {
+        // 0.0015
+        str.push_back(type('0'));
         str.push_back(type('.'));
-        etl::private_to_string::add_integral(fractional, str, fractional_format, true);
+        str.insert(str.end(), size_t(-point), type('0'));
+
+        for (int i = 0; i < length; ++i)
+        {
+          str.push_back(type(digits[i]));
+        }
+      }
+      else
+      {
+        // 1.5e+300
+        str.push_back(type(digits[0]));
+
+        if (length > 1)
+        {
+          str.push_back(type('.'));
+
+          for (int i = 1; i < length; ++i)
+          {
+            str.push_back(type(digits[i]));
+          }
+        }
+
+        int e = point - 1;
+
+        str.push_back(type('e'));
+        str.push_back((e < 0) ? type('-') : type('+'));
+
+        if (e < 0)
+        {
+          e = -e;
+        }
+
+        if (e >= 100)
+        {
+          str.push_back(type('0' + (e / 100)));
+        }
+
+        if (e >= 10)
+        {
+          str.push_back(type('0' + ((e / 10) % 10)));
+        }
+
+        str.push_back(type('0' + (e % 10)));
       }
     }
 
     //***************************************************************************
     /// Helper function for floating point.
+    /// Fixed notation with the format's precision is exact, as printf, for
+    /// every float and double. The shortest form, and fixed notation for a
+    /// long double out of the range of a double, use the shortest digits that
+    /// convert back to the value.
     //***************************************************************************
     template <typename T, typename TIString>
     void add_floating_point(T value,
@@ -240,27 +1021,33 @@ namespace etl
       }
       else
       {
-        // Make sure we format the two halves correctly.
-        uint32_t max_precision = std::numeric_limits<T>::digits10;
-
-        etl::basic_format_spec<TIString> integral_format = format;
-        integral_format.decimal().width(0).precision(format.get_precision() > max_precision ? max_precision : format.get_precision());
-
-        etl::basic_format_spec<TIString> fractional_format = integral_format;
-        fractional_format.width(integral_format.get_precision()).fill(type('0')).right();
-
-        int64_t multiplier = 1;
-
-        for (uint32_t i = 0; i < fractional_format.get_precision(); ++i)
+        if (value < T(0))
         {
-          multiplier *= 10U;
+          str.push_back(type('-'));
+          value = -value;
         }
 
-        T f_integral = (value < T(0.0) ? ceil(value) : floor(value));
-        int64_t integral = static_cast<int64_t>(f_integral);
-        int64_t fractional = static_cast<int64_t>(round((value - f_integral) * multiplier));
+        const int precision = int(format.get_precision());
 
-        etl::private_to_string::add_integral_fractional(integral, fractional, str, integral_format, fractional_format);
+        if (format.is_shortest() ||
+            (!etl::private_to_string::add_fixed_exact(value, precision, str) &&
+             !etl::private_to_string::add_fixed_exact_wide(value, precision, str)))
+        {
+          char digits[etl::private_floating_point_digits::MAX_DIGITS];
+          int  length;
+          int  exponent;
+
+          etl::private_floating_point_digits::generate(value, digits, length, exponent);
+
+          if (format.is_shortest())
+          {
+            etl::private_to_string::add_shortest(digits, length, exponent, str);
+          }
+          else
+          {
+            etl::private_to_string::add_fixed(digits, length, exponent, precision, str);
+          }
+        }
       }
 
       etl::private_to_string::add_alignment(str, start, format);
@@ -0,0 +1,617 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+#define ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "alignment.h"
+#include "parameter_type.h"
+#include "atomic.h"
+#include "memory_model.h"
+#include "integral_limits.h"
+#include "static_assert.h"
+#include "type_traits.h"
+
+#undef ETL_FILE
+#define ETL_FILE "60"
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup queue_mpmc_atomic
+  /// The read and write positions of a queue_mpmc_atomic.
+  /// A position holds the buffer index in its low bits and a 'lap' count,
+  /// which is incremented each time the index wraps, in its high bits.
+  /// Each slot holds a sequence number that says which lap may next write or
+  /// read it, so producers and consumers only contend on the slot and the
+  /// position that they are updating.
+  //***************************************************************************
+  template <const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_mpmc_atomic_base
+  {
+  public:
+
+    /// The type used for determining the size of queue.
+    typedef typename etl::size_type_lookup<MEMORY_MODEL>::type size_type;
+
+    //*************************************************************************
+    /// Is the queue empty?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool empty() const
+    {
+      return read.load(etl::memory_order_acquire) == write.load(etl::memory_order_acquire);
+    }
+
+    //*************************************************************************
+    /// Is the queue full?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool full() const
+    {
+      return size() == MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items in the queue?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type size() const
+    {
+      size_type write_position;
+      size_type read_position;
+
+      // Read a consistent pair of positions.
+      do
+      {
+        write_position = write.load(etl::memory_order_acquire);
+        read_position  = read.load(etl::memory_order_acquire);
+      } while (write.load(etl::memory_order_acquire) != write_position);
+
+      const size_type write_index = write_position & INDEX_MASK;
+      const size_type read_index  = read_position & INDEX_MASK;
+
+      if (write_index > read_index)
+      {
+        return write_index - read_index;
+      }
+      else if (write_index < read_index)
+      {
+        return MAX_SIZE - read_index + write_index;
+      }
+      else
+      {
+        return (write_position == read_position) ? 0 : MAX_SIZE;
+      }
+    }
+
+    //*************************************************************************
+    /// How much free space available in the queue.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type available() const
+    {
+      return MAX_SIZE - size();
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+  protected:
+
+    queue_mpmc_atomic_base(size_type max_size_)
+      : write(0),
+        read(0),
+        MAX_SIZE(max_size_),
+        ONE_LAP(get_one_lap(max_size_)),
+        INDEX_MASK(size_type(get_one_lap(max_size_) - 1))
+    {
+    }
+
+    //*************************************************************************
+    /// Gets the position after 'position'.
+    //*************************************************************************
+    size_type get_next_position(size_type position) const
+    {
+      const size_type index = position & INDEX_MASK;
+
+      if (size_type(index + 1) < MAX_SIZE)
+      {
+        return size_type(position + 1);
+      }
+      else
+      {
+        // Start the next lap.
+        return size_type((position & ~INDEX_MASK) + ONE_LAP);
+      }
+    }
+
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<size_type> write; ///< Where to input new data.
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<size_type> read;  ///< Where to get the oldest data.
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) const size_type MAX_SIZE;     ///< The maximum number of items in the queue.
+    const size_type ONE_LAP;    ///< The position increment for one lap of the buffer.
+    const size_type INDEX_MASK; ///< The index bits of a position.
+
+  private:
+
+    //*************************************************************************
+    /// The smallest power of 2 that is larger than the size.
+    //*************************************************************************
+    static size_type get_one_lap(size_type max_size_)
+    {
+      size_type one_lap = 1;
+
+      while (one_lap <= max_size_)
+      {
+        one_lap <<= 1;
+      }
+
+      return one_lap;
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_MPMC_QUEUE_ATOMIC) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~queue_mpmc_atomic_base()
+    {
+    }
+#else
+  protected:
+    ~queue_mpmc_atomic_base()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc_atomic
+  ///\brief This is the base for all queue_mpmc_atomics that contain a particular type.
+  ///\details Normally a reference to this type will be taken from a derived queue_mpmc_atomic.
+  ///\code
+  /// etl::queue_mpmc_atomic<int, 10> myQueue;
+  /// etl::iqueue_mpmc_atomic<int>& iQueue = myQueue;
+  ///\endcode
+  /// This queue supports concurrent access by multiple producers and multiple
+  /// consumers without locks.
+  /// \tparam T The type of value that the queue_mpmc_atomic holds.
+  //***************************************************************************
+  template <typename T, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class iqueue_mpmc_atomic : public queue_mpmc_atomic_base<MEMORY_MODEL>
+  {
+  private:
+
+    typedef typename etl::parameter_type<T>::type     parameter_t;
+    typedef etl::queue_mpmc_atomic_base<MEMORY_MODEL> base_t;
+    typedef typename etl::make_signed<typename base_t::size_type>::type difference_type;
+
+  public:
+
+    typedef T                          value_type;      ///< The type stored in the queue.
+    typedef T&                         reference;       ///< A reference to the type used in the queue.
+    typedef const T&                   const_reference; ///< A const reference to the type used in the queue.
+    typedef typename base_t::size_type size_type;       ///< The type used for determining the size of the queue.
+
+    //*************************************************************************
+    /// A buffer slot.
+    //*************************************************************************
+    struct slot
+    {
+      etl::atomic<size_type> sequence; ///< The position that may next write, or the position + 1 that may next read.
+      typename etl::aligned_storage<sizeof(T), etl::alignment_of<T>::value>::type value;
+    };
+
+    using base_t::write;
+    using base_t::read;
+    using base_t::MAX_SIZE;
+    using base_t::ONE_LAP;
+    using base_t::INDEX_MASK;
+    using base_t::get_next_position;
+
+    //*************************************************************************
+    /// Push a value to the queue.
+    //*************************************************************************
+    bool push(parameter_t value)
+    {
+      size_type position;
+      slot* p_slot = claim_write(position);
+
+      if (p_slot != 0)
+      {
+        ::new (&p_slot->value) T(value);
+
+        p_slot->sequence.store(size_type(position + 1), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_QUEUE_MPMC_ATOMIC_FORCE_CPP03)
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename ... Args>
+    bool emplace(Args&&... args)
+    {
+      size_type position;
+      slot* p_slot = claim_write(position);
+
+      if (p_slot != 0)
+      {
+        ::new (&p_slot->value) T(std::forward<Args>(args)...);
+
+        p_slot->sequence.store(size_type(position + 1), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#else
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1>
+    bool emplace(const T1& value1)
+    {
+      size_type position;
+      slot* p_slot = claim_write(position);
+
+      if (p_slot != 0)
+      {
+        ::new (&p_slot->value) T(value1);
+
+        p_slot->sequence.store(size_type(position + 1), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    bool emplace(const T1& value1, const T2& value2)
+    {
+      size_type position;
+      slot* p_slot = claim_write(position);
+
+      if (p_slot != 0)
+      {
+        ::new (&p_slot->value) T(value1, value2);
+
+        p_slot->sequence.store(size_type(position + 1), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3)
+    {
+      size_type position;
+      slot* p_slot = claim_write(position);
+
+      if (p_slot != 0)
+      {
+        ::new (&p_slot->value) T(value1, value2, value3);
+
+        p_slot->sequence.store(size_type(position + 1), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      size_type position;
+      slot* p_slot = claim_write(position);
+
+      if (p_slot != 0)
+      {
+        ::new (&p_slot->value) T(value1, value2, value3, value4);
+
+        p_slot->sequence.store(size_type(position + 1), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#endif
+
+    //*************************************************************************
+    /// Pop a value from the queue.
+    //*************************************************************************
+    bool pop(reference value)
+    {
+      size_type position;
+      slot* p_slot = claim_read(position);
+
+      if (p_slot != 0)
+      {
+        T* p_value = reinterpret_cast<T*>(&p_slot->value);
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_QUEUE_MPMC_ATOMIC_FORCE_CPP03)
+        value = std::move(*p_value);
+#else
+        value = *p_value;
+#endif
+        p_value->~T();
+
+        p_slot->sequence.store(size_type(position + ONE_LAP), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is empty.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue and discard.
+    //*************************************************************************
+    bool pop()
+    {
+      size_type position;
+      slot* p_slot = claim_read(position);
+
+      if (p_slot != 0)
+      {
+        reinterpret_cast<T*>(&p_slot->value)->~T();
+
+        p_slot->sequence.store(size_type(position + ONE_LAP), etl::memory_order_release);
+
+        return true;
+      }
+
+      // Queue is empty.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Clear the queue.
+    //*************************************************************************
+    void clear()
+    {
+      while (pop())
+      {
+        // Do nothing.
+      }
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    //*************************************************************************
+    iqueue_mpmc_atomic(slot* p_slots_, size_type max_size_)
+      : base_t(max_size_),
+        p_slots(p_slots_)
+    {
+    }
+
+    //*************************************************************************
+    /// Sets each slot free for the first lap.
+    /// Called from derived classes once the slots have been constructed.
+    //*************************************************************************
+    void initialise()
+    {
+      for (size_type i = 0; i < MAX_SIZE; ++i)
+      {
+        p_slots[i].sequence.store(i, etl::memory_order_relaxed);
+      }
+
+      write.store(0, etl::memory_order_release);
+      read.store(0, etl::memory_order_release);
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Claims the slot at the write position.
+    ///\return The slot, or 0 if the queue is full.
+    //*************************************************************************
+    slot* claim_write(size_type& position)
+    {
+      position = write.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        slot& s = p_slots[position & INDEX_MASK];
+
+        const size_type sequence = s.sequence.load(etl::memory_order_acquire);
+
+        const difference_type difference = difference_type(size_type(sequence - position));
+
+        if (difference == 0)
+        {
+          // The slot is free for this lap.
+          if (write.compare_exchange_weak(position, get_next_position(position), etl::memory_order_relaxed, etl::memory_order_relaxed))
+          {
+            return &s;
+          }
+        }
+        else if (difference < 0)
+        {
+          // The slot is still in use from the last lap.
+          return 0;
+        }
+        else
+        {
+          // Another producer got here first.
+          position = write.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Claims the slot at the read position.
+    ///\return The slot, or 0 if the queue is empty.
+    //*************************************************************************
+    slot* claim_read(size_type& position)
+    {
+      position = read.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        slot& s = p_slots[position & INDEX_MASK];
+
+        const size_type sequence = s.sequence.load(etl::memory_order_acquire);
+
+        const difference_type difference = difference_type(size_type(sequence - size_type(position + 1)));
+
+        if (difference == 0)
+        {
+          // The slot has been written for this lap.
+          if (read.compare_exchange_weak(position, get_next_position(position), etl::memory_order_relaxed, etl::memory_order_relaxed))
+          {
+            return &s;
+          }
+        }
+        else if (difference < 0)
+        {
+          // The slot has not been written yet.
+          return 0;
+        }
+        else
+        {
+          // Another consumer got here first.
+          position = read.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    // Disable copy construction and assignment.
+    iqueue_mpmc_atomic(const iqueue_mpmc_atomic&);
+    iqueue_mpmc_atomic& operator =(const iqueue_mpmc_atomic&);
+
+    slot* p_slots; ///< The internal buffer.
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc_atomic
+  /// A fixed capacity lock free mpmc queue.
+  /// This queue supports concurrent access by multiple producers and multiple
+  /// consumers. A thread that is suspended while claiming a slot must not
+  /// miss a complete cycle of the position counter, so choose a memory model
+  /// that gives plenty of laps for the expected traffic.
+  /// \tparam T            The type this queue should support.
+  /// \tparam SIZE         The maximum capacity of the queue.
+  /// \tparam MEMORY_MODEL The memory model for the queue. Determines the type of the internal counter variables.
+  //***************************************************************************
+  template <typename T, size_t SIZE, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_mpmc_atomic : public etl::iqueue_mpmc_atomic<T, MEMORY_MODEL>
+  {
+  private:
+
+    typedef etl::iqueue_mpmc_atomic<T, MEMORY_MODEL> base_t;
+
+  public:
+
+    typedef typename base_t::size_type size_type;
+
+    // At least two bits of each position must count laps, so that a lap is
+    // less than half the range and the signed distance to a slot's sequence
+    // keeps its sign.
+    ETL_STATIC_ASSERT((SIZE <= (etl::integral_limits<size_type>::max / 4)), "Size too large for memory model");
+
+    static const size_type MAX_SIZE = size_type(SIZE);
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    queue_mpmc_atomic()
+      : base_t(slots, MAX_SIZE)
+    {
+      base_t::initialise();
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~queue_mpmc_atomic()
+    {
+      base_t::clear();
+    }
+
+  private:
+
+    queue_mpmc_atomic(const queue_mpmc_atomic&);
+    queue_mpmc_atomic& operator = (const queue_mpmc_atomic&);
+
+    /// The slots used in the queue.
+    typename base_t::slot slots[MAX_SIZE];
+  };
+}
+
+#undef ETL_FILE
+
+#endif
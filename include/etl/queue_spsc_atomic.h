@@ -40,6 +40,7 @@ SOFTWARE.
 #include "atomic.h"
 #include "memory_model.h"
 #include "integral_limits.h"
+#include "type_traits.h"
 
 #undef ETL_FILE
 #define ETL_FILE "47"
@@ -93,7 +94,7 @@ namespace etl
       }
       else
       {
-        n = RESERVED - read_index + write_index - 1;
+        n = RESERVED - read_index + write_index;
       }
 
       return n;
@@ -128,7 +129,9 @@ namespace etl
 
     queue_spsc_atomic_base(size_type reserved_)
       : write(0),
+        cached_read(0),
         read(0),
+        cached_write(0),
         RESERVED(reserved_)
     {
     }
@@ -148,9 +151,13 @@ namespace etl
       return index;
     }
 
-    etl::atomic<size_type> write; ///< Where to input new data.
-    etl::atomic<size_type> read;  ///< Where to get the oldest data.
-    const size_type RESERVED;     ///< The maximum number of items in the queue.
+    // The producer's and the consumer's data are on separate cache lines, so
+    // that they do not contend. ETL_CACHE_LINE_SIZE may be set in the profile.
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<size_type> write; ///< Where to input new data.
+    size_type cached_read;                                         ///< The producer's copy of 'read'.
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<size_type> read;  ///< Where to get the oldest data.
+    size_type cached_write;                                        ///< The consumer's copy of 'write'.
+    ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) const size_type RESERVED;     ///< The maximum number of items in the queue.
 
   private:
 
@@ -198,6 +205,8 @@ namespace etl
 
     using base_t::write;
     using base_t::read;
+    using base_t::cached_read;
+    using base_t::cached_write;
     using base_t::RESERVED;
     using base_t::get_next_index;
 
@@ -209,7 +218,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (has_space(next_index))
       {
         ::new (&p_buffer[write_index]) T(value);
 
@@ -233,7 +242,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (has_space(next_index))
       {
         ::new (&p_buffer[write_index]) T(std::forward<Args>(args)...);
 
@@ -256,7 +265,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (has_space(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1);
 
@@ -279,7 +288,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (has_space(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2);
 
@@ -302,7 +311,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (has_space(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2, value3);
 
@@ -325,7 +334,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (has_space(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2, value3, value4);
 
@@ -346,7 +355,7 @@ namespace etl
     {
       size_type read_index = read.load(etl::memory_order_relaxed);
 
-      if (read_index == write.load(etl::memory_order_acquire))
+      if (!has_data(read_index))
       {
         // Queue is empty
         return false;
@@ -369,7 +378,7 @@ namespace etl
     {
       size_type read_index = read.load(etl::memory_order_relaxed);
 
-      if (read_index == write.load(etl::memory_order_acquire))
+      if (!has_data(read_index))
       {
         // Queue is empty
         return false;
@@ -384,6 +393,75 @@ namespace etl
       return true;
     }
 
+    //*************************************************************************
+    /// Push a range of values to the queue.
+    /// Pushes as many as there is room for and publishes them all at once.
+    ///\return The number of values pushed.
+    //*************************************************************************
+    template <typename TIterator>
+    typename etl::enable_if<!etl::is_integral<TIterator>::value, size_type>::type
+      push(TIterator range_begin, TIterator range_end)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type count       = 0;
+
+      while (range_begin != range_end)
+      {
+        size_type next_index = get_next_index(write_index, RESERVED);
+
+        if (!has_space(next_index))
+        {
+          break;
+        }
+
+        ::new (&p_buffer[write_index]) T(*range_begin);
+
+        ++range_begin;
+        write_index = next_index;
+        ++count;
+      }
+
+      if (count != 0)
+      {
+        write.store(write_index, etl::memory_order_release);
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Pop up to 'max_count' values from the queue.
+    /// Releases the space for them all at once.
+    ///\return The number of values popped.
+    //*************************************************************************
+    template <typename TIterator>
+    size_type pop(TIterator output, size_type max_count)
+    {
+      size_type read_index = read.load(etl::memory_order_relaxed);
+      size_type count      = 0;
+
+      while ((count != max_count) && has_data(read_index))
+      {
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_QUEUE_ATOMIC_FORCE_CPP03)
+        *output = std::move(p_buffer[read_index]);
+#else
+        *output = p_buffer[read_index];
+#endif
+        p_buffer[read_index].~T();
+
+        ++output;
+        read_index = get_next_index(read_index, RESERVED);
+        ++count;
+      }
+
+      if (count != 0)
+      {
+        read.store(read_index, etl::memory_order_release);
+      }
+
+      return count;
+    }
+
     //*************************************************************************
     /// Clear the queue.
     /// Must be called from thread that pops the queue or when there is no
@@ -410,6 +488,34 @@ namespace etl
 
   private:
 
+    //*************************************************************************
+    /// Can the producer write to the slot before 'next_index'?
+    /// Only loads the consumer's index when the cached copy says full.
+    //*************************************************************************
+    bool has_space(size_type next_index)
+    {
+      if (next_index == cached_read)
+      {
+        cached_read = read.load(etl::memory_order_acquire);
+      }
+
+      return next_index != cached_read;
+    }
+
+    //*************************************************************************
+    /// Can the consumer read from 'read_index'?
+    /// Only loads the producer's index when the cached copy says empty.
+    //*************************************************************************
+    bool has_data(size_type read_index)
+    {
+      if (read_index == cached_write)
+      {
+        cached_write = write.load(etl::memory_order_acquire);
+      }
+
+      return read_index != cached_write;
+    }
+
     // Disable copy construction and assignment.
     iqueue_spsc_atomic(const iqueue_spsc_atomic&);
     iqueue_spsc_atomic& operator =(const iqueue_spsc_atomic&);
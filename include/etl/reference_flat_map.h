@@ -35,6 +35,8 @@ SOFTWARE.
 
 #include "platform.h"
 #include "vector.h"
+#include "private/eytzinger_index.h"
+#include "private/flat_merge.h"
 #include "error_handler.h"
 #include "debug_count.h"
 #include "type_traits.h"
@@ -112,6 +114,7 @@ namespace etl
   protected:
 
     typedef etl::ivector<value_type*> lookup_t;
+    typedef etl::private_flat::ieytzinger_index<TKey, TKeyCompare> index_t;
 
   public:
 
@@ -532,11 +535,7 @@ namespace etl
 #endif
 
       clear();
-
-      while (first != last)
-      {
-        insert(*first++);
-      }
+      insert(first, last);
     }
 
     //*********************************************************************
@@ -564,6 +563,7 @@ namespace etl
 
     //*********************************************************************
     /// Inserts a range of values to the reference_flat_map.
+    /// The values are appended, sorted and merged with the existing elements in one pass.
     /// If asserts or exceptions are enabled, emits flat_map_full if the reference_flat_map does not have enough free space.
     ///\param position The position to insert at.
     ///\param first    The first element to add.
@@ -572,10 +572,32 @@ namespace etl
     template <class TIterator>
     void insert(TIterator first, TIterator last)
     {
+      size_type sorted_size = size();
+
       while (first != last)
       {
-        insert(*first++);
+        if (full())
+        {
+          // Discarding any duplicates may make room.
+          erase(merge_appended(sorted_size), end());
+          sorted_size = size();
+
+          if (full())
+          {
+            // Only a key that is not already present needs a free slot.
+            const bool is_present = (find((*first).first) != end());
+            ETL_ASSERT(is_present, ETL_ERROR(flat_map_full));
+
+            ++first;
+            continue;
+          }
+        }
+
+        append(*first);
+        ++first;
       }
+
+      erase(merge_appended(sorted_size), end());
     }
 
     //*********************************************************************
@@ -593,6 +615,7 @@ namespace etl
       }
       else
       {
+        invalidate_index();
         lookup.erase(i_element.ilookup);
         return 1;
       }
@@ -604,6 +627,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator i_element)
     {
+      invalidate_index();
       lookup.erase(i_element.ilookup);
     }
 
@@ -616,6 +640,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator first, iterator last)
     {
+      invalidate_index();
       lookup.erase(first.ilookup, last.ilookup);
     }
 
@@ -624,6 +649,7 @@ namespace etl
     //*************************************************************************
     void clear()
     {
+      invalidate_index();
       lookup.clear();
     }
 
@@ -692,6 +718,11 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(key_parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(begin(), end(), key, compare);
     }
 
@@ -702,6 +733,11 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(key_parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(cbegin(), cend(), key, compare);
     }
 
@@ -712,6 +748,11 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(key_parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(begin(), end(), key, compare);
     }
 
@@ -722,6 +763,11 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(key_parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(begin(), end(), key, compare);
     }
 
@@ -732,6 +778,11 @@ namespace etl
     //*********************************************************************
     std::pair<iterator, iterator> equal_range(key_parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       iterator i_lower = std::lower_bound(begin(), end(), key, compare);
 
       return std::make_pair(i_lower, std::upper_bound(i_lower, end(), key, compare));
@@ -744,6 +795,11 @@ namespace etl
     //*********************************************************************
     std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       const_iterator i_lower = std::lower_bound(cbegin(), cend(), key, compare);
 
       return std::make_pair(i_lower, std::upper_bound(i_lower, cend(), key, compare));
@@ -803,13 +859,37 @@ namespace etl
       return lookup.available();
     }
 
+    //*********************************************************************
+    /// Builds the lookup index from the current contents.
+    /// Only containers declared with INDEXED_ = true have an index, otherwise does nothing.
+    /// Any insert or erase discards the index, and lookups fall back to the
+    /// binary search until it is rebuilt.
+    //*********************************************************************
+    void rebuild_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->build(lookup.cbegin(), lookup.size(), &key_of);
+      }
+    }
+
+    //*********************************************************************
+    /// Checks whether lookups are using the index.
+    ///\return <b>true</b> if the index is up to date with the contents.
+    //*********************************************************************
+    bool is_index_valid() const
+    {
+      return (pindex != nullptr) && pindex->is_valid();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
     //*********************************************************************
-    ireference_flat_map(lookup_t& lookup_)
-      : lookup(lookup_)
+    ireference_flat_map(lookup_t& lookup_, index_t* pindex_)
+      : lookup(lookup_),
+        pindex(pindex_)
     {
     }
 
@@ -827,6 +907,7 @@ namespace etl
         // At the end.
         ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_map_full));
 
+        invalidate_index();
         lookup.push_back(&value);
         result.first = --end();
         result.second = true;
@@ -841,6 +922,7 @@ namespace etl
         {
           // A new one.
           ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_map_full));
+          invalidate_index();
           lookup.insert(i_element.ilookup, &value);
           result.second = true;
         }
@@ -849,13 +931,73 @@ namespace etl
       return result;
     }
 
+    //*********************************************************************
+    /// Adds an element to the end of the lookup, out of order.
+    /// merge_appended() must be called before the container is used again.
+    ///\param value The value to append.
+    //*********************************************************************
+    void append(reference value)
+    {
+      invalidate_index();
+      lookup.push_back(&value);
+    }
+
+    //*********************************************************************
+    /// Sorts the elements appended since the container held sorted_size
+    /// elements and merges them with the elements before them.
+    /// The spare capacity of the lookup is used as scratch space.
+    /// Appended elements with a key that is already present, or that appeared
+    /// earlier in the appended elements, are moved to the end.
+    ///\param sorted_size The number of elements before the first appended one.
+    ///\return An iterator to the first rejected element, or end() if there are none.
+    //*********************************************************************
+    iterator merge_appended(size_type sorted_size)
+    {
+      return iterator(etl::private_flat::merge_unique(lookup.begin(), lookup.begin() + sorted_size, lookup.end(), lookup.data() + lookup.size(), size_t(lookup.capacity() - lookup.size()), compare_pointers()));
+    }
+
   private:
 
+    //*********************************************************************
+    /// How to compare elements through the lookup.
+    //*********************************************************************
+    class compare_pointers
+    {
+    public:
+
+      bool operator ()(const value_type* lhs, const value_type* rhs) const
+      {
+        return comp(lhs->first, rhs->first);
+      }
+
+      key_compare comp;
+    };
+
+    //*********************************************************************
+    /// Gets the key of an element, for building the index.
+    //*********************************************************************
+    static const key_type& key_of(const value_type* pvalue)
+    {
+      return pvalue->first;
+    }
+
+    //*********************************************************************
+    /// Discards the index before the contents change.
+    //*********************************************************************
+    void invalidate_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->clear();
+      }
+    }
+
     // Disable copy construction and assignment.
     ireference_flat_map(const ireference_flat_map&);
     ireference_flat_map& operator = (const ireference_flat_map&);
 
     lookup_t& lookup;
+    index_t*  pindex;
 
     Compare compare;
 
@@ -907,9 +1049,10 @@ namespace etl
   ///\tparam TValue   The value type.
   ///\tparam TCompare The type to compare keys. Default = std::less<TKey>
   ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam INDEXED_  If true, reserves space for an index that rebuild_index() can build.
   ///\ingroup reference_flat_map
   //***************************************************************************
-  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey> >
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey>, const bool INDEXED_ = false>
   class reference_flat_map : public ireference_flat_map<TKey, TValue, TCompare>
   {
   public:
@@ -920,7 +1063,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     reference_flat_map()
-      : ireference_flat_map<TKey, TValue, TCompare>(lookup)
+      : ireference_flat_map<TKey, TValue, TCompare>(lookup, index.get())
     {
     }
 
@@ -932,7 +1075,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     reference_flat_map(TIterator first, TIterator last)
-      : ireference_flat_map<TKey, TValue, TCompare>(lookup)
+      : ireference_flat_map<TKey, TValue, TCompare>(lookup, index.get())
     {
       ireference_flat_map<TKey, TValue, TCompare>::assign(first, last);
     }
@@ -966,6 +1109,9 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<node_t*, MAX_SIZE> lookup;
+
+    // The optional lookup index.
+    etl::private_flat::eytzinger_index<TKey, TCompare, (INDEXED_ ? MAX_SIZE_ : 0)> index;
   };
 
 }
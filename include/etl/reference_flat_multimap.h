@@ -38,6 +38,8 @@ SOFTWARE.
 #include "error_handler.h"
 #include "debug_count.h"
 #include "vector.h"
+#include "private/eytzinger_index.h"
+#include "private/flat_merge.h"
 
 #undef ETL_FILE
 #define ETL_FILE "31"
@@ -87,6 +89,7 @@ namespace etl
   protected:
 
     typedef etl::ivector<value_type*> lookup_t;
+    typedef etl::private_flat::ieytzinger_index<TKey, TKeyCompare> index_t;
 
   public:
 
@@ -447,11 +450,7 @@ namespace etl
 #endif
 
       clear();
-
-      while (first != last)
-      {
-        insert(*first++);
-      }
+      insert(first, last);
     }
 
     //*********************************************************************
@@ -483,6 +482,7 @@ namespace etl
 
     //*********************************************************************
     /// Inserts a range of values to the reference_flat_multimap.
+    /// The values are appended, sorted and merged with the existing elements in one pass.
     /// If asserts or exceptions are enabled, emits reference_flat_multimap_full if the reference_flat_multimap does not have enough free space.
     ///\param position The position to insert at.
     ///\param first    The first element to add.
@@ -491,10 +491,17 @@ namespace etl
     template <class TIterator>
     void insert(TIterator first, TIterator last)
     {
+      size_type sorted_size = size();
+
       while (first != last)
       {
-        insert(*first++);
+        ETL_ASSERT(!full(), ETL_ERROR(flat_multimap_full));
+
+        append(*first);
+        ++first;
       }
+
+      merge_appended(sorted_size);
     }
 
     //*********************************************************************
@@ -524,6 +531,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator i_element)
     {
+      invalidate_index();
       lookup.erase(i_element.ilookup);
     }
 
@@ -536,6 +544,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator first, iterator last)
     {
+      invalidate_index();
       lookup.erase(first.ilookup, last.ilookup);
     }
 
@@ -544,6 +553,7 @@ namespace etl
     //*************************************************************************
     void clear()
     {
+      invalidate_index();
       lookup.clear();
     }
 
@@ -614,6 +624,11 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(key_parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(begin(), end(), key, compare);
     }
 
@@ -624,6 +639,11 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(key_parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(cbegin(), cend(), key, compare);
     }
 
@@ -634,6 +654,11 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(key_parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(begin(), end(), key, compare);
     }
 
@@ -644,6 +669,11 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(key_parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(begin(), end(), key, compare);
     }
 
@@ -654,6 +684,11 @@ namespace etl
     //*********************************************************************
     std::pair<iterator, iterator> equal_range(key_parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       iterator i_lower = std::lower_bound(begin(), end(), key, compare);
 
       return std::make_pair(i_lower, std::upper_bound(i_lower, end(), key, compare));
@@ -666,6 +701,11 @@ namespace etl
     //*********************************************************************
     std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       const_iterator i_lower = std::lower_bound(cbegin(), cend(), key, compare);
 
       return std::make_pair(i_lower, std::upper_bound(i_lower, cend(), key, compare));
@@ -725,13 +765,37 @@ namespace etl
       return lookup.available();
     }
 
+    //*********************************************************************
+    /// Builds the lookup index from the current contents.
+    /// Only containers declared with INDEXED_ = true have an index, otherwise does nothing.
+    /// Any insert or erase discards the index, and lookups fall back to the
+    /// binary search until it is rebuilt.
+    //*********************************************************************
+    void rebuild_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->build(lookup.cbegin(), lookup.size(), &key_of);
+      }
+    }
+
+    //*********************************************************************
+    /// Checks whether lookups are using the index.
+    ///\return <b>true</b> if the index is up to date with the contents.
+    //*********************************************************************
+    bool is_index_valid() const
+    {
+      return (pindex != nullptr) && pindex->is_valid();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
     //*********************************************************************
-    ireference_flat_multimap(lookup_t& lookup_)
-      : lookup(lookup_)
+    ireference_flat_multimap(lookup_t& lookup_, index_t* pindex_)
+      : lookup(lookup_),
+        pindex(pindex_)
     {
     }
 
@@ -747,6 +811,7 @@ namespace etl
       if (i_element == end())
       {
         // At the end.
+        invalidate_index();
         lookup.push_back(&value);
         result.first = --end();
         result.second = true;
@@ -754,6 +819,7 @@ namespace etl
       else
       {
         // Not at the end.
+        invalidate_index();
         lookup.insert(i_element.ilookup, &value);
         result.first = i_element;
         result.second = true;
@@ -762,13 +828,71 @@ namespace etl
       return result;
     }
 
+    //*********************************************************************
+    /// Adds an element to the end of the lookup, out of order.
+    /// merge_appended() must be called before the container is used again.
+    ///\param value The value to append.
+    //*********************************************************************
+    void append(reference value)
+    {
+      invalidate_index();
+      lookup.push_back(&value);
+    }
+
+    //*********************************************************************
+    /// Sorts the elements appended since the container held sorted_size
+    /// elements and merges them with the elements before them.
+    /// The spare capacity of the lookup is used as scratch space.
+    /// Equal elements keep their order, with the appended ones last.
+    ///\param sorted_size The number of elements before the first appended one.
+    //*********************************************************************
+    void merge_appended(size_type sorted_size)
+    {
+      etl::private_flat::merge_multi(lookup.begin(), lookup.begin() + sorted_size, lookup.end(), lookup.data() + lookup.size(), size_t(lookup.capacity() - lookup.size()), compare_pointers());
+    }
+
   private:
 
+    //*********************************************************************
+    /// How to compare elements through the lookup.
+    //*********************************************************************
+    class compare_pointers
+    {
+    public:
+
+      bool operator ()(const value_type* lhs, const value_type* rhs) const
+      {
+        return comp(lhs->first, rhs->first);
+      }
+
+      key_compare comp;
+    };
+
+    //*********************************************************************
+    /// Gets the key of an element, for building the index.
+    //*********************************************************************
+    static const key_type& key_of(const value_type* pvalue)
+    {
+      return pvalue->first;
+    }
+
+    //*********************************************************************
+    /// Discards the index before the contents change.
+    //*********************************************************************
+    void invalidate_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->clear();
+      }
+    }
+
     // Disable copy construction and assignment.
     ireference_flat_multimap(const ireference_flat_multimap&);
     ireference_flat_multimap& operator = (const ireference_flat_multimap&);
 
     lookup_t&  lookup;
+    index_t*   pindex;
 
     Compare compare;
 
@@ -814,13 +938,14 @@ namespace etl
     return !(lhs == rhs);
   }
 
-  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey> >
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey>, const bool INDEXED_ = false>
   //***************************************************************************
   /// A reference_flat_multimap implementation that uses a fixed size buffer.
   ///\tparam TKey     The key type.
   ///\tparam TValue   The value type.
   ///\tparam TCompare The type to compare keys. Default = std::less<TKey>
   ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam INDEXED_  If true, reserves space for an index that rebuild_index() can build.
   ///\ingroup reference_flat_multimap
   //***************************************************************************
   class reference_flat_multimap : public ireference_flat_multimap<TKey, TValue, TCompare>
@@ -833,7 +958,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     reference_flat_multimap()
-      : ireference_flat_multimap<TKey, TValue, TCompare>(lookup)
+      : ireference_flat_multimap<TKey, TValue, TCompare>(lookup, index.get())
     {
     }
 
@@ -841,7 +966,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     reference_flat_multimap(const reference_flat_multimap& other)
-      : ireference_flat_multimap<TKey, TValue, TCompare>(lookup)
+      : ireference_flat_multimap<TKey, TValue, TCompare>(lookup, index.get())
     {
       ireference_flat_multimap<TKey, TValue, TCompare>::assign(other.cbegin(), other.cend());
     }
@@ -854,7 +979,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     reference_flat_multimap(TIterator first, TIterator last)
-      : ireference_flat_multimap<TKey, TValue, TCompare>(lookup)
+      : ireference_flat_multimap<TKey, TValue, TCompare>(lookup, index.get())
     {
       ireference_flat_multimap<TKey, TValue, TCompare>::assign(first, last);
     }
@@ -873,6 +998,9 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<node_t*, MAX_SIZE> lookup;
+
+    // The optional lookup index.
+    etl::private_flat::eytzinger_index<TKey, TCompare, (INDEXED_ ? MAX_SIZE_ : 0)> index;
   };
 }
 
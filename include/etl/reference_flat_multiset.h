@@ -42,6 +42,8 @@ SOFTWARE.
 
 #include "type_traits.h"
 #include "vector.h"
+#include "private/eytzinger_index.h"
+#include "private/flat_merge.h"
 #include "pool.h"
 #include "error_handler.h"
 #include "exception.h"
@@ -115,6 +117,7 @@ namespace etl
   protected:
 
     typedef etl::ivector<value_type*> lookup_t;
+    typedef etl::private_flat::ieytzinger_index<T, TKeyCompare> index_t;
 
   public:
 
@@ -444,11 +447,7 @@ namespace etl
 #endif
 
       clear();
-
-      while (first != last)
-      {
-        insert(*first++);
-      }
+      insert(first, last);
     }
 
     //*********************************************************************
@@ -467,6 +466,7 @@ namespace etl
       if (i_element == end())
       {
         // At the end. Doesn't exist.
+        invalidate_index();
         lookup.push_back(&value);
         result.first = --end();
         result.second = true;
@@ -474,6 +474,7 @@ namespace etl
       else
       {
         // Not at the end.
+        invalidate_index();
         lookup.insert(i_element.ilookup, &value);
         result.first = i_element;
         result.second = true;
@@ -495,6 +496,7 @@ namespace etl
 
     //*********************************************************************
     /// Inserts a range of values to the reference_flat_multiset.
+    /// The values are appended, sorted and merged with the existing elements in one pass.
     /// If asserts or exceptions are enabled, emits reference_flat_multiset_full if the reference_flat_multiset does not have enough free space.
     ///\param position The position to insert at.
     ///\param first    The first element to add.
@@ -503,10 +505,17 @@ namespace etl
     template <class TIterator>
     void insert(TIterator first, TIterator last)
     {
+      size_type sorted_size = size();
+
       while (first != last)
       {
-        insert(*first++);
+        ETL_ASSERT(!full(), ETL_ERROR(flat_multiset_full));
+
+        append(*first);
+        ++first;
       }
+
+      merge_appended(sorted_size);
     }
 
     //*********************************************************************
@@ -536,6 +545,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator i_element)
     {
+      invalidate_index();
       lookup.erase(i_element.ilookup);
     }
 
@@ -548,6 +558,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator first, iterator last)
     {
+      invalidate_index();
       lookup.erase(first.ilookup, last.ilookup);
     }
 
@@ -556,6 +567,7 @@ namespace etl
     //*************************************************************************
     void clear()
     {
+      invalidate_index();
       lookup.clear();
     }
 
@@ -566,7 +578,7 @@ namespace etl
     //*********************************************************************
     iterator find(parameter_t key)
     {
-      iterator itr = std::lower_bound(begin(), end(), key, compare);
+      iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -590,7 +602,7 @@ namespace etl
     //*********************************************************************
     const_iterator find(parameter_t key) const
     {
-      const_iterator itr = std::lower_bound(begin(), end(), key, compare);
+      const_iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -626,6 +638,11 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(begin(), end(), key, compare);
     }
 
@@ -636,6 +653,11 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(cbegin(), cend(), key, compare);
     }
 
@@ -646,6 +668,11 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(begin(), end(), key, compare);
     }
 
@@ -656,6 +683,11 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(cbegin(), cend(), key, compare);
     }
 
@@ -666,6 +698,11 @@ namespace etl
     //*********************************************************************
     std::pair<iterator, iterator> equal_range(parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       return std::equal_range(begin(), end(), key, compare);
     }
 
@@ -676,7 +713,12 @@ namespace etl
     //*********************************************************************
     std::pair<const_iterator, const_iterator> equal_range(parameter_t key) const
     {
-      return std::equal_range(begin(), end(), key, compare);
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
+      return std::equal_range(cbegin(), cend(), key, compare);
     }
 
     //*************************************************************************
@@ -733,13 +775,37 @@ namespace etl
       return lookup.available();
     }
 
+    //*********************************************************************
+    /// Builds the lookup index from the current contents.
+    /// Only containers declared with INDEXED_ = true have an index, otherwise does nothing.
+    /// Any insert or erase discards the index, and lookups fall back to the
+    /// binary search until it is rebuilt.
+    //*********************************************************************
+    void rebuild_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->build(lookup.cbegin(), lookup.size(), &key_of);
+      }
+    }
+
+    //*********************************************************************
+    /// Checks whether lookups are using the index.
+    ///\return <b>true</b> if the index is up to date with the contents.
+    //*********************************************************************
+    bool is_index_valid() const
+    {
+      return (pindex != nullptr) && pindex->is_valid();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
     //*********************************************************************
-    ireference_flat_multiset(lookup_t& lookup_)
-      : lookup(lookup_)
+    ireference_flat_multiset(lookup_t& lookup_, index_t* pindex_)
+      : lookup(lookup_),
+        pindex(pindex_)
     {
     }
 
@@ -757,6 +823,7 @@ namespace etl
         // At the end.
         ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_multiset_full));
 
+        invalidate_index();
         lookup.push_back(&value);
         result.first = --end();
         result.second = true;
@@ -768,6 +835,7 @@ namespace etl
 
         // A new one.
         ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_multiset_full));
+        invalidate_index();
         lookup.insert(i_element.ilookup, &value);
         result.second = true;
       }
@@ -775,13 +843,71 @@ namespace etl
       return result;
     }
 
+    //*********************************************************************
+    /// Adds an element to the end of the lookup, out of order.
+    /// merge_appended() must be called before the container is used again.
+    ///\param value The value to append.
+    //*********************************************************************
+    void append(reference value)
+    {
+      invalidate_index();
+      lookup.push_back(&value);
+    }
+
+    //*********************************************************************
+    /// Sorts the elements appended since the container held sorted_size
+    /// elements and merges them with the elements before them.
+    /// The spare capacity of the lookup is used as scratch space.
+    /// Equal elements keep their order, with the appended ones last.
+    ///\param sorted_size The number of elements before the first appended one.
+    //*********************************************************************
+    void merge_appended(size_type sorted_size)
+    {
+      etl::private_flat::merge_multi(lookup.begin(), lookup.begin() + sorted_size, lookup.end(), lookup.data() + lookup.size(), size_t(lookup.capacity() - lookup.size()), compare_pointers());
+    }
+
   private:
 
+    //*********************************************************************
+    /// How to compare elements through the lookup.
+    //*********************************************************************
+    class compare_pointers
+    {
+    public:
+
+      bool operator ()(const value_type* lhs, const value_type* rhs) const
+      {
+        return comp(*lhs, *rhs);
+      }
+
+      key_compare comp;
+    };
+
+    //*********************************************************************
+    /// Gets the key of an element, for building the index.
+    //*********************************************************************
+    static const key_type& key_of(const value_type* pvalue)
+    {
+      return *pvalue;
+    }
+
+    //*********************************************************************
+    /// Discards the index before the contents change.
+    //*********************************************************************
+    void invalidate_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->clear();
+      }
+    }
+
     // Disable copy construction.
     ireference_flat_multiset(const ireference_flat_multiset&);
     ireference_flat_multiset& operator =(const ireference_flat_multiset&);
 
     lookup_t& lookup;
+    index_t*  pindex;
 
     TKeyCompare compare;
 
@@ -805,7 +931,7 @@ namespace etl
   /// An reference flat set
   ///\ingroup reference_flat_multiset
   //***************************************************************************
-  template <typename TKey, const size_t MAX_SIZE_, typename TKeyCompare = std::less<TKey> >
+  template <typename TKey, const size_t MAX_SIZE_, typename TKeyCompare = std::less<TKey>, const bool INDEXED_ = false>
   class reference_flat_multiset : public ireference_flat_multiset<TKey, TKeyCompare>
   {
   public:
@@ -816,7 +942,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     reference_flat_multiset()
-      : ireference_flat_multiset<TKey, TKeyCompare>(lookup)
+      : ireference_flat_multiset<TKey, TKeyCompare>(lookup, index.get())
     {
     }
 
@@ -824,7 +950,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     reference_flat_multiset(const reference_flat_multiset& other)
-      : ireference_flat_multiset<TKey, TKeyCompare>(lookup)
+      : ireference_flat_multiset<TKey, TKeyCompare>(lookup, index.get())
     {
       ireference_flat_multiset<TKey, TKeyCompare>::assign(other.cbegin(), other.cend());
     }
@@ -837,7 +963,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     reference_flat_multiset(TIterator first, TIterator last)
-      : ireference_flat_multiset<TKey, TKeyCompare>(lookup)
+      : ireference_flat_multiset<TKey, TKeyCompare>(lookup, index.get())
     {
       ireference_flat_multiset<TKey, TKeyCompare>::assign(first, last);
     }
@@ -856,6 +982,9 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<value_type*, MAX_SIZE> lookup;
+
+    // The optional lookup index.
+    etl::private_flat::eytzinger_index<TKey, TKeyCompare, (INDEXED_ ? MAX_SIZE_ : 0)> index;
   };
 
   //***************************************************************************
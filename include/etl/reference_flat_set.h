@@ -45,6 +45,8 @@ SOFTWARE.
 #include "error_handler.h"
 #include "exception.h"
 #include "vector.h"
+#include "private/eytzinger_index.h"
+#include "private/flat_merge.h"
 
 #undef ETL_FILE
 #define ETL_FILE "32"
@@ -115,6 +117,7 @@ namespace etl
   protected:
 
     typedef etl::ivector<value_type*> lookup_t;
+    typedef etl::private_flat::ieytzinger_index<T, TKeyCompare> index_t;
 
   public:
 
@@ -444,11 +447,7 @@ namespace etl
 #endif
 
       clear();
-
-      while (first != last)
-      {
-        insert(*first++);
-      }
+      insert(first, last);
     }
 
     //*********************************************************************
@@ -476,6 +475,7 @@ namespace etl
 
     //*********************************************************************
     /// Inserts a range of values to the reference_flat_set.
+    /// The values are appended, sorted and merged with the existing elements in one pass.
     /// If asserts or exceptions are enabled, emits reference_flat_set_full if the reference_flat_set does not have enough free space.
     ///\param position The position to insert at.
     ///\param first    The first element to add.
@@ -484,10 +484,32 @@ namespace etl
     template <class TIterator>
     void insert(TIterator first, TIterator last)
     {
+      size_type sorted_size = size();
+
       while (first != last)
       {
-        insert(*first++);
+        if (full())
+        {
+          // Discarding any duplicates may make room.
+          erase(merge_appended(sorted_size), end());
+          sorted_size = size();
+
+          if (full())
+          {
+            // Only a key that is not already present needs a free slot.
+            const bool is_present = (find(*first) != end());
+            ETL_ASSERT(is_present, ETL_ERROR(flat_set_full));
+
+            ++first;
+            continue;
+          }
+        }
+
+        append(*first);
+        ++first;
       }
+
+      erase(merge_appended(sorted_size), end());
     }
 
     //*********************************************************************
@@ -505,6 +527,7 @@ namespace etl
       }
       else
       {
+        invalidate_index();
         lookup.erase(i_element.ilookup);
         return 1;
       }
@@ -516,6 +539,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator i_element)
     {
+      invalidate_index();
       lookup.erase(i_element.ilookup);
     }
 
@@ -528,6 +552,7 @@ namespace etl
     //*********************************************************************
     void erase(iterator first, iterator last)
     {
+      invalidate_index();
       lookup.erase(first.ilookup, last.ilookup);
     }
 
@@ -536,6 +561,7 @@ namespace etl
     //*************************************************************************
     void clear()
     {
+      invalidate_index();
       lookup.clear();
     }
 
@@ -546,7 +572,7 @@ namespace etl
     //*********************************************************************
     iterator find(parameter_t key)
     {
-      iterator itr = std::lower_bound(begin(), end(), key, compare);
+      iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -570,7 +596,7 @@ namespace etl
     //*********************************************************************
     const_iterator find(parameter_t key) const
     {
-      const_iterator itr = std::lower_bound(begin(), end(), key, compare);
+      const_iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -604,6 +630,11 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(begin(), end(), key, compare);
     }
 
@@ -614,6 +645,11 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->lower_bound(key));
+      }
+
       return std::lower_bound(cbegin(), cend(), key, compare);
     }
 
@@ -624,6 +660,11 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return iterator(lookup.begin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(begin(), end(), key, compare);
     }
 
@@ -634,6 +675,11 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(parameter_t key) const
     {
+      if (is_index_valid())
+      {
+        return const_iterator(lookup.cbegin() + pindex->upper_bound(key));
+      }
+
       return std::upper_bound(cbegin(), cend(), key, compare);
     }
 
@@ -644,6 +690,11 @@ namespace etl
     //*********************************************************************
     std::pair<iterator, iterator> equal_range(parameter_t key)
     {
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       return std::equal_range(begin(), end(), key, compare);
     }
 
@@ -654,7 +705,12 @@ namespace etl
     //*********************************************************************
     std::pair<const_iterator, const_iterator> equal_range(parameter_t key) const
     {
-      return std::upper_bound(cbegin(), cend(), key, compare);
+      if (is_index_valid())
+      {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+      }
+
+      return std::equal_range(cbegin(), cend(), key, compare);
     }
 
     //*************************************************************************
@@ -711,13 +767,37 @@ namespace etl
       return lookup.available();
     }
 
+    //*********************************************************************
+    /// Builds the lookup index from the current contents.
+    /// Only containers declared with INDEXED_ = true have an index, otherwise does nothing.
+    /// Any insert or erase discards the index, and lookups fall back to the
+    /// binary search until it is rebuilt.
+    //*********************************************************************
+    void rebuild_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->build(lookup.cbegin(), lookup.size(), &key_of);
+      }
+    }
+
+    //*********************************************************************
+    /// Checks whether lookups are using the index.
+    ///\return <b>true</b> if the index is up to date with the contents.
+    //*********************************************************************
+    bool is_index_valid() const
+    {
+      return (pindex != nullptr) && pindex->is_valid();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
     //*********************************************************************
-    ireference_flat_set(lookup_t& lookup_)
-      : lookup(lookup_)
+    ireference_flat_set(lookup_t& lookup_, index_t* pindex_)
+      : lookup(lookup_),
+        pindex(pindex_)
     {
     }
 
@@ -735,6 +815,7 @@ namespace etl
         // At the end.
         ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_set_full));
 
+        invalidate_index();
         lookup.push_back(&value);
         result.first = --end();
         result.second = true;
@@ -749,6 +830,7 @@ namespace etl
         {
           // A new one.
           ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_set_full));
+          invalidate_index();
           lookup.insert(i_element.ilookup, &value);
           result.second = true;
         }
@@ -757,13 +839,73 @@ namespace etl
       return result;
     }
 
+    //*********************************************************************
+    /// Adds an element to the end of the lookup, out of order.
+    /// merge_appended() must be called before the container is used again.
+    ///\param value The value to append.
+    //*********************************************************************
+    void append(reference value)
+    {
+      invalidate_index();
+      lookup.push_back(&value);
+    }
+
+    //*********************************************************************
+    /// Sorts the elements appended since the container held sorted_size
+    /// elements and merges them with the elements before them.
+    /// The spare capacity of the lookup is used as scratch space.
+    /// Appended elements with a key that is already present, or that appeared
+    /// earlier in the appended elements, are moved to the end.
+    ///\param sorted_size The number of elements before the first appended one.
+    ///\return An iterator to the first rejected element, or end() if there are none.
+    //*********************************************************************
+    iterator merge_appended(size_type sorted_size)
+    {
+      return iterator(etl::private_flat::merge_unique(lookup.begin(), lookup.begin() + sorted_size, lookup.end(), lookup.data() + lookup.size(), size_t(lookup.capacity() - lookup.size()), compare_pointers()));
+    }
+
   private:
 
+    //*********************************************************************
+    /// How to compare elements through the lookup.
+    //*********************************************************************
+    class compare_pointers
+    {
+    public:
+
+      bool operator ()(const value_type* lhs, const value_type* rhs) const
+      {
+        return comp(*lhs, *rhs);
+      }
+
+      key_compare comp;
+    };
+
+    //*********************************************************************
+    /// Gets the key of an element, for building the index.
+    //*********************************************************************
+    static const key_type& key_of(const value_type* pvalue)
+    {
+      return *pvalue;
+    }
+
+    //*********************************************************************
+    /// Discards the index before the contents change.
+    //*********************************************************************
+    void invalidate_index()
+    {
+      if (pindex != nullptr)
+      {
+        pindex->clear();
+      }
+    }
+
     // Disable copy construction.
     ireference_flat_set(const ireference_flat_set&);
     ireference_flat_set& operator =(const ireference_flat_set&);
 
     lookup_t& lookup;
+    index_t*  pindex;
 
     TKeyCompare compare;
 
@@ -787,7 +929,7 @@ namespace etl
   /// An reference flat set
   ///\ingroup reference_flat_set
   //***************************************************************************
-  template <typename TKey, const size_t MAX_SIZE_, typename TKeyCompare = std::less<TKey> >
+  template <typename TKey, const size_t MAX_SIZE_, typename TKeyCompare = std::less<TKey>, const bool INDEXED_ = false>
   class reference_flat_set : public ireference_flat_set<TKey, TKeyCompare>
   {
   public:
@@ -798,7 +940,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     reference_flat_set()
-      : ireference_flat_set<TKey, TKeyCompare>(lookup)
+      : ireference_flat_set<TKey, TKeyCompare>(lookup, index.get())
     {
     }
 
@@ -806,7 +948,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     reference_flat_set(const reference_flat_set& other)
-      : ireference_flat_set<TKey, TKeyCompare>(lookup)
+      : ireference_flat_set<TKey, TKeyCompare>(lookup, index.get())
     {
       ireference_flat_set<TKey, TKeyCompare>::assign(other.cbegin(), other.cend());
     }
@@ -819,7 +961,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     reference_flat_set(TIterator first, TIterator last)
-      : ireference_flat_set<TKey, TKeyCompare>(lookup)
+      : ireference_flat_set<TKey, TKeyCompare>(lookup, index.get())
     {
       ireference_flat_set<TKey, TKeyCompare>::assign(first, last);
     }
@@ -838,6 +980,9 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<value_type*, MAX_SIZE> lookup;
+
+    // The optional lookup index.
+    etl::private_flat::eytzinger_index<TKey, TKeyCompare, (INDEXED_ ? MAX_SIZE_ : 0)> index;
   };
 
   //***************************************************************************
@@ -219,6 +219,65 @@ namespace etl
     }
   };
 
+  //***************************************************************************
+  /// Ready Queue.
+  /// A policy the scheduler can use to decide what to do next.
+  /// Calls the highest priority task that has signalled that it is ready.
+  /// Tasks of equal priority take turns.
+  /// Tasks call task_signal_ready() when they are given work, so idle tasks
+  /// are never polled. Each task is polled once when it is first seen, and
+  /// again after each call to process work.
+  //***************************************************************************
+  template <const size_t N_PRIORITIES = 256U>
+  struct scheduler_policy_ready_queue
+  {
+    scheduler_policy_ready_queue()
+      : n_bound(0U)
+    {
+    }
+
+    bool schedule_tasks(etl::ivector<etl::task*>& task_list)
+    {
+      // Attach any tasks added since the last call.
+      if (task_list.size() != n_bound)
+      {
+        for (size_t index = 0; index < task_list.size(); ++index)
+        {
+          etl::task& task = *(task_list[index]);
+
+          task.set_task_ready_queue(ready_queue);
+
+          if (task.task_request_work() > 0)
+          {
+            ready_queue.push(task);
+          }
+        }
+
+        n_bound = task_list.size();
+      }
+
+      etl::task* ptask = ready_queue.pop();
+
+      if (ptask == nullptr)
+      {
+        return true;
+      }
+
+      ptask->task_process_work();
+
+      // Go to the back of the queue if there is more to do.
+      if (ptask->task_request_work() > 0)
+      {
+        ready_queue.push(*ptask);
+      }
+
+      return false;
+    }
+
+    etl::task_ready_queue<N_PRIORITIES> ready_queue;
+    size_t n_bound;
+  };
+
   //***************************************************************************
   /// Scheduler base.
   //***************************************************************************
@@ -254,7 +313,7 @@ namespace etl
     //*******************************************
     /// Set the running state for the scheduler.
     //*******************************************
-    void set_scheduler_running(bool scheduler_running_)
+    virtual void set_scheduler_running(bool scheduler_running_)
     {
       scheduler_running = scheduler_running_;
     }
@@ -262,7 +321,7 @@ namespace etl
     //*******************************************
     /// Get the running state for the scheduler.
     //*******************************************
-    bool scheduler_is_running() const
+    virtual bool scheduler_is_running() const
     {
       return scheduler_running;
     }
@@ -270,7 +329,7 @@ namespace etl
     //*******************************************
     /// Force the scheduler to exit.
     //*******************************************
-    void exit_scheduler()
+    virtual void exit_scheduler()
     {
       scheduler_exit = true;
     }
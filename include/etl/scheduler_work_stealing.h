@@ -0,0 +1,383 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_SCHEDULER_WORK_STEALING_INCLUDED
+#define ETL_SCHEDULER_WORK_STEALING_INCLUDED
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "platform.h"
+#include "atomic.h"
+#include "vector.h"
+#include "power.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "task.h"
+#include "scheduler.h"
+
+#undef ETL_FILE
+#define ETL_FILE "61"
+
+#if ETL_HAS_ATOMIC
+
+namespace etl
+{
+  //***************************************************************************
+  /// 'Invalid worker' exception.
+  //***************************************************************************
+  class scheduler_invalid_worker_exception : public etl::scheduler_exception
+  {
+  public:
+
+    scheduler_invalid_worker_exception(string_type file_name_, numeric_type line_number_)
+      : etl::scheduler_exception(ETL_ERROR_TEXT("scheduler:invalid worker", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  namespace private_scheduler
+  {
+    //*************************************************************************
+    /// A bounded Chase-Lev work stealing deque of task indexes.
+    /// The owning worker pushes and pops at the bottom; other workers steal
+    /// from the top. SIZE must be a power of two.
+    //*************************************************************************
+    template <const size_t SIZE>
+    class work_stealing_deque
+    {
+    public:
+
+      ETL_STATIC_ASSERT(etl::is_power_of_2<SIZE>::value, "SIZE must be a power of 2");
+
+      enum
+      {
+        EMPTY = -1
+      };
+
+      work_stealing_deque()
+        : top(0U),
+          bottom(0U)
+      {
+      }
+
+      //*******************************************
+      /// Pushes an item at the bottom. Owner only.
+      /// The caller guarantees that there is room.
+      //*******************************************
+      void push(int32_t item)
+      {
+        const uint32_t b = bottom.load(etl::memory_order_relaxed);
+
+        buffer[b & MASK].store(item, etl::memory_order_relaxed);
+        bottom.store(b + 1U, etl::memory_order_release);
+      }
+
+      //*******************************************
+      /// Pops the item at the bottom. Owner only.
+      ///\return The item, or EMPTY.
+      //*******************************************
+      int32_t pop()
+      {
+        const uint32_t b = bottom.load(etl::memory_order_relaxed) - 1U;
+
+        // Reserve the bottom item before looking at the top.
+        bottom.store(b, etl::memory_order_seq_cst);
+
+        uint32_t t = top.load(etl::memory_order_seq_cst);
+
+        int32_t item = EMPTY;
+
+        if (int32_t(b - t) >= 0)
+        {
+          item = buffer[b & MASK].load(etl::memory_order_relaxed);
+
+          if (b == t)
+          {
+            // The last item; race the thieves for it.
+            if (!top.compare_exchange_strong(t, t + 1U, etl::memory_order_seq_cst))
+            {
+              item = EMPTY;
+            }
+
+            bottom.store(b + 1U, etl::memory_order_relaxed);
+          }
+        }
+        else
+        {
+          bottom.store(b + 1U, etl::memory_order_relaxed);
+        }
+
+        return item;
+      }
+
+      //*******************************************
+      /// Steals the item at the top. Any worker.
+      ///\return The item, or EMPTY if there was none or another worker took it.
+      //*******************************************
+      int32_t steal()
+      {
+        uint32_t       t = top.load(etl::memory_order_seq_cst);
+        const uint32_t b = bottom.load(etl::memory_order_seq_cst);
+
+        if (int32_t(b - t) > 0)
+        {
+          const int32_t item = buffer[t & MASK].load(etl::memory_order_relaxed);
+
+          if (top.compare_exchange_strong(t, t + 1U, etl::memory_order_seq_cst))
+          {
+            return item;
+          }
+        }
+
+        return EMPTY;
+      }
+
+    private:
+
+      enum
+      {
+        MASK = SIZE - 1
+      };
+
+      ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<uint32_t> top;
+      ETL_ALIGNAS(ETL_CACHE_LINE_SIZE) etl::atomic<uint32_t> bottom;
+      etl::atomic<int32_t> buffer[SIZE];
+    };
+  }
+
+  //***************************************************************************
+  /// Work stealing scheduler.
+  /// Runs tasks on a fixed pool of up to MAX_WORKERS worker threads.
+  /// The threads are created by the application, and each calls run_worker()
+  /// with a unique id. start() runs worker 0 on the calling thread.
+  ///
+  /// A worker with nothing to do claims every task that has work, runs the
+  /// highest priority one and pushes the rest to its own deque, highest
+  /// priority at the bottom. It pops from its own deque until it is empty,
+  /// while idle workers steal the lowest priority claims from the top.
+  /// A task is only ever processed by one worker at a time.
+  ///
+  /// The idle and watchdog callbacks are called by each worker, so must be
+  /// safe to call from more than one thread.
+  //***************************************************************************
+  template <size_t MAX_TASKS_, size_t MAX_WORKERS_>
+  class scheduler_work_stealing : public etl::ischeduler
+  {
+  public:
+
+    enum
+    {
+      MAX_TASKS   = MAX_TASKS_,
+      MAX_WORKERS = MAX_WORKERS_
+    };
+
+    ETL_STATIC_ASSERT(MAX_WORKERS > 0, "MAX_WORKERS must be greater than zero");
+
+    scheduler_work_stealing()
+      : ischeduler(task_list),
+        running(false),
+        exiting(false)
+    {
+    }
+
+    //*******************************************
+    /// Start the scheduler.
+    /// Sets the scheduler running and runs worker 0 on the calling thread.
+    //*******************************************
+    void start()
+    {
+      running.store(true);
+
+      run_worker(0U);
+    }
+
+    //*******************************************
+    /// Runs a worker until exit_scheduler() is called.
+    /// All tasks must have been added before the first worker starts.
+    /// The worker does no work until start() is called, or while the scheduler
+    /// is not running.
+    //*******************************************
+    void run_worker(size_t worker_id)
+    {
+      ETL_ASSERT(task_list.size() > 0, ETL_ERROR(etl::scheduler_no_tasks_exception));
+      ETL_ASSERT(worker_id < MAX_WORKERS, ETL_ERROR(etl::scheduler_invalid_worker_exception));
+
+      while (!exiting.load(etl::memory_order_relaxed))
+      {
+        if (running.load(etl::memory_order_relaxed))
+        {
+          bool idle = !process_work(worker_id);
+
+          if (p_watchdog_callback)
+          {
+            (*p_watchdog_callback)();
+          }
+
+          if (idle && p_idle_callback)
+          {
+            (*p_idle_callback)();
+          }
+        }
+      }
+    }
+
+    //*******************************************
+    /// Set the running state for the scheduler.
+    //*******************************************
+    void set_scheduler_running(bool scheduler_running_)
+    {
+      running.store(scheduler_running_);
+    }
+
+    //*******************************************
+    /// Get the running state for the scheduler.
+    //*******************************************
+    bool scheduler_is_running() const
+    {
+      return running.load();
+    }
+
+    //*******************************************
+    /// Force all of the workers to exit.
+    //*******************************************
+    void exit_scheduler()
+    {
+      exiting.store(true);
+    }
+
+  private:
+
+    typedef private_scheduler::work_stealing_deque<etl::power_of_2_round_up<MAX_TASKS + 1>::value> deque_t;
+
+    enum
+    {
+      EMPTY = deque_t::EMPTY
+    };
+
+    //*******************************************
+    /// Processes one work item.
+    ///\return <b>true</b> if there was work to do.
+    //*******************************************
+    bool process_work(size_t worker_id)
+    {
+      int32_t index = deques[worker_id].pop();
+
+      if (index == EMPTY)
+      {
+        index = steal_work(worker_id);
+      }
+
+      if (index == EMPTY)
+      {
+        index = claim_ready_tasks(worker_id);
+      }
+
+      if (index == EMPTY)
+      {
+        return false;
+      }
+
+      task_list[index]->task_process_work();
+      claimed[index].store(0U, etl::memory_order_release);
+
+      return true;
+    }
+
+    //*******************************************
+    /// Tries to steal from each of the other workers in turn.
+    //*******************************************
+    int32_t steal_work(size_t worker_id)
+    {
+      for (size_t i = 1U; i < MAX_WORKERS; ++i)
+      {
+        const int32_t index = deques[(worker_id + i) % MAX_WORKERS].steal();
+
+        if (index != EMPTY)
+        {
+          return index;
+        }
+      }
+
+      return EMPTY;
+    }
+
+    //*******************************************
+    /// Claims every unclaimed task that has work.
+    /// Returns the highest priority, and pushes the rest to the worker's deque.
+    //*******************************************
+    int32_t claim_ready_tasks(size_t worker_id)
+    {
+      int32_t highest = EMPTY;
+
+      // The task list is in descending priority order.
+      for (int32_t index = int32_t(task_list.size()) - 1; index >= 0; --index)
+      {
+        uint32_t unclaimed = 0U;
+
+        if ((claimed[index].load(etl::memory_order_relaxed) == 0U) &&
+            claimed[index].compare_exchange_strong(unclaimed, 1U, etl::memory_order_acquire))
+        {
+          if (task_list[index]->task_request_work() > 0)
+          {
+            if (highest != EMPTY)
+            {
+              deques[worker_id].push(highest);
+            }
+
+            highest = index;
+          }
+          else
+          {
+            claimed[index].store(0U, etl::memory_order_release);
+          }
+        }
+      }
+
+      return highest;
+    }
+
+    etl::atomic<bool> running;
+    etl::atomic<bool> exiting;
+
+    etl::atomic<uint32_t> claimed[MAX_TASKS];
+    deque_t               deques[MAX_WORKERS];
+
+    typedef etl::vector<etl::task*, MAX_TASKS> task_list_t;
+    task_list_t task_list;
+  };
+}
+
+#endif
+
+#undef ETL_FILE
+
+#endif
@@ -41,6 +41,8 @@ SOFTWARE.
 #include "hash.h"
 #include "basic_string.h"
 
+#include "private/string_search.h"
+
 #include "algorithm.h"
 
 ///\defgroup array array
@@ -490,26 +492,32 @@ namespace etl
     //*************************************************************************
     size_type find(etl::basic_string_view<T, TTraits> view, size_type position = 0) const
     {
-      if ((size() < view.size()))
+      if (position > size())
       {
         return npos;
       }
 
-      const_iterator iposition = std::search(begin() + position, end(), view.begin(), view.end());
-
-      if (iposition == end())
-      {
-        return npos;
-      }
-      else
+      // An empty sequence is found at the start position, even at the end of the view.
+      if (view.empty())
       {
-        return std::distance(begin(), iposition);
+        return position;
       }
+
+      const_pointer iposition = etl::private_string_search::find_sequence(mbegin + position, mend, view.data(), view.size());
+
+      return (iposition == mend) ? npos : size_type(iposition - mbegin);
     }
 
     size_type find(T c, size_type position = 0) const
     {
-      return find(etl::basic_string_view<T, TTraits>(&c, 1), position);
+      if (position >= size())
+      {
+        return npos;
+      }
+
+      const_pointer iposition = etl::private_string_search::find_character(mbegin + position, mend, c);
+
+      return (iposition == mend) ? npos : size_type(iposition - mbegin);
     }
 
     size_type find(const T* text, size_type position, size_type count) const
@@ -569,25 +577,14 @@ namespace etl
     //*************************************************************************
     size_type find_first_of(etl::basic_string_view<T, TTraits> view, size_type position = 0) const
     {
-      const size_t lengthtext = size();
-
-      if (position < lengthtext)
+      if (position >= size())
       {
-        for (size_t i = position; i < lengthtext; ++i)
-        {
-          const size_t lengthview = view.size();
-
-          for (size_t j = 0; j < lengthview; ++j)
-          {
-            if (mbegin[i] == view[j])
-            {
-              return i;
-            }
-          }
-        }
+        return npos;
       }
 
-      return npos;
+      const_pointer iposition = etl::private_string_search::find_first_of(mbegin + position, mend, view.data(), view.size());
+
+      return (iposition == mend) ? npos : size_type(iposition - mbegin);
     }
 
     size_type find_first_of(T c, size_type position = 0) const
@@ -617,25 +614,10 @@ namespace etl
 
       position = std::min(position, size() - 1);
 
-      const_reverse_iterator it = rbegin() + size() - position - 1;
-
-      while (it != rend())
-      {
-        const size_t viewlength = view.size();
-
-        for (size_t j = 0; j < viewlength; ++j)
-        {
-          if (mbegin[position] == view[j])
-          {
-            return position;
-          }
-        }
-
-        ++it;
-        --position;
-      }
+      const_pointer iend      = mbegin + position + 1;
+      const_pointer iposition = etl::private_string_search::find_last_of(mbegin, iend, view.data(), view.size());
 
-      return npos;
+      return (iposition == iend) ? npos : size_type(iposition - mbegin);
     }
 
     size_type find_last_of(T c, size_type position = npos) const
@@ -32,6 +32,9 @@ SOFTWARE.
 #include <stdint.h>
 
 #include "platform.h"
+#include "nullptr.h"
+#include "binary.h"
+#include "static_assert.h"
 #include "error_handler.h"
 #include "exception.h"
 
@@ -53,8 +56,23 @@ namespace etl
     }
   };
 
+  //***************************************************************************
+  /// 'Invalid priority' exception.
+  //***************************************************************************
+  class task_invalid_priority_exception : public etl::task_exception
+  {
+  public:
+
+    task_invalid_priority_exception(string_type file_name_, numeric_type line_number_)
+      : etl::task_exception(ETL_ERROR_TEXT("task:invalid priority", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
   typedef uint_least8_t task_priority_t;
 
+  class itask_ready_queue;
+
   //***************************************************************************
   /// Scheduler.
   //***************************************************************************
@@ -67,7 +85,10 @@ namespace etl
     //*******************************************
     task(task_priority_t priority)
       : task_running(true),
-        task_priority(priority)
+        task_priority(priority),
+        task_ready_queued(false),
+        p_next_ready(nullptr),
+        p_ready_queue(nullptr)
     {
     }
 
@@ -114,11 +135,194 @@ namespace etl
       return task_priority;
     }
 
+    //*******************************************
+    /// Set the ready queue that the task signals.
+    /// Called by event driven scheduler policies.
+    //*******************************************
+    void set_task_ready_queue(etl::itask_ready_queue& ready_queue)
+    {
+      p_ready_queue = &ready_queue;
+    }
+
+    //*******************************************
+    /// Signal that the task has work to do.
+    /// Does nothing if the scheduler does not use a ready queue.
+    /// Must be called from the scheduler's context, or with the scheduler
+    /// locked out.
+    //*******************************************
+    void task_signal_ready();
+
   private:
 
+    friend class etl::itask_ready_queue;
+
     bool task_running;
     etl::task_priority_t task_priority;
+    bool task_ready_queued;
+    etl::task* p_next_ready;
+    etl::itask_ready_queue* p_ready_queue;
+  };
+
+  //***************************************************************************
+  /// A queue of tasks that have signalled that they are ready.
+  /// Keeps a bitmap of the priorities that have ready tasks, and a circular
+  /// list of the tasks at each priority, so that push and pop are O(1).
+  /// Tasks of the same priority are popped in the order they were pushed.
+  //***************************************************************************
+  class itask_ready_queue
+  {
+  public:
+
+    //*******************************************
+    /// Pushes a task to the back of its priority's list.
+    /// Does nothing if the task is already queued.
+    //*******************************************
+    void push(etl::task& task)
+    {
+      if (task.task_ready_queued)
+      {
+        return;
+      }
+
+      const size_t priority = task.get_task_priority();
+
+      ETL_ASSERT(priority < N_PRIORITIES, ETL_ERROR(etl::task_invalid_priority_exception));
+
+      etl::task*& p_tail = p_tails[priority];
+
+      if (p_tail == nullptr)
+      {
+        task.p_next_ready = &task;
+
+        // Higher priorities are at lower bit positions, so the highest is found with 'count trailing zeros'.
+        p_bitmap[priority >> 5] |= uint32_t(0x80000000UL) >> (priority & 31U);
+        summary                 |= uint32_t(0x80000000UL) >> (priority >> 5);
+      }
+      else
+      {
+        task.p_next_ready    = p_tail->p_next_ready;
+        p_tail->p_next_ready = &task;
+      }
+
+      p_tail = &task;
+      task.task_ready_queued = true;
+    }
+
+    //*******************************************
+    /// Pops the task at the front of the highest priority list.
+    ///\return A pointer to the task, or nullptr if there are none.
+    //*******************************************
+    etl::task* pop()
+    {
+      if (summary == 0U)
+      {
+        return nullptr;
+      }
+
+      const size_t word     = 31U - etl::count_trailing_zeros(summary);
+      const size_t priority = (word << 5) + (31U - etl::count_trailing_zeros(p_bitmap[word]));
+
+      etl::task*& p_tail = p_tails[priority];
+      etl::task*  p_head = p_tail->p_next_ready;
+
+      if (p_head == p_tail)
+      {
+        p_tail = nullptr;
+
+        p_bitmap[word] &= ~(uint32_t(0x80000000UL) >> (priority & 31U));
+
+        if (p_bitmap[word] == 0U)
+        {
+          summary &= ~(uint32_t(0x80000000UL) >> word);
+        }
+      }
+      else
+      {
+        p_tail->p_next_ready = p_head->p_next_ready;
+      }
+
+      p_head->p_next_ready      = nullptr;
+      p_head->task_ready_queued = false;
+
+      return p_head;
+    }
+
+    //*******************************************
+    /// Returns <b>true</b> if no tasks are ready.
+    //*******************************************
+    bool empty() const
+    {
+      return summary == 0U;
+    }
+
+  protected:
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    itask_ready_queue(etl::task** p_tails_, uint32_t* p_bitmap_, size_t n_priorities_)
+      : p_tails(p_tails_),
+        p_bitmap(p_bitmap_),
+        summary(0U),
+        N_PRIORITIES(n_priorities_)
+    {
+      for (size_t i = 0U; i < N_PRIORITIES; ++i)
+      {
+        p_tails[i] = nullptr;
+      }
+
+      for (size_t i = 0U; i < ((N_PRIORITIES + 31U) >> 5); ++i)
+      {
+        p_bitmap[i] = 0U;
+      }
+    }
+
+  private:
+
+    // Disabled.
+    itask_ready_queue(const itask_ready_queue&);
+    itask_ready_queue& operator =(const itask_ready_queue&);
+
+    etl::task** p_tails;  ///< The last task at each priority. Each list is circular.
+    uint32_t*   p_bitmap; ///< One bit per priority.
+    uint32_t    summary;  ///< One bit per bitmap word.
+    const size_t N_PRIORITIES;
   };
+
+  //***************************************************************************
+  /// A ready queue for tasks with priorities less than N_PRIORITIES.
+  //***************************************************************************
+  template <const size_t N_PRIORITIES_ = 256U>
+  class task_ready_queue : public etl::itask_ready_queue
+  {
+  public:
+
+    ETL_STATIC_ASSERT((N_PRIORITIES_ > 0U) && (N_PRIORITIES_ <= 256U), "N_PRIORITIES must be between 1 and 256");
+
+    enum
+    {
+      N_PRIORITIES = N_PRIORITIES_
+    };
+
+    task_ready_queue()
+      : itask_ready_queue(tails, bitmap, N_PRIORITIES)
+    {
+    }
+
+  private:
+
+    etl::task* tails[N_PRIORITIES];
+    uint32_t   bitmap[(N_PRIORITIES + 31U) / 32U];
+  };
+
+  //*******************************************
+  inline void task::task_signal_ready()
+  {
+    if (p_ready_queue != nullptr)
+    {
+      p_ready_queue->push(*this);
+    }
+  }
 }
 
 #undef ETL_FILE
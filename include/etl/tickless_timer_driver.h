@@ -0,0 +1,311 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_TICKLESS_TIMER_DRIVER_INCLUDED
+#define ETL_TICKLESS_TIMER_DRIVER_INCLUDED
+
+#include "platform.h"
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+#include "nullptr.h"
+#include "atomic.h"
+#include "timer.h"
+#include "error_handler.h"
+#include "exception.h"
+
+#undef ETL_FILE
+#define ETL_FILE "63"
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception base for the tickless timer driver.
+  //***************************************************************************
+  class tickless_timer_driver_exception : public etl::exception
+  {
+  public:
+
+    tickless_timer_driver_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// 'Invalid tick period' exception.
+  //***************************************************************************
+  class tickless_timer_driver_invalid_period : public etl::tickless_timer_driver_exception
+  {
+  public:
+
+    tickless_timer_driver_invalid_period(string_type file_name_, numeric_type line_number_)
+      : etl::tickless_timer_driver_exception(ETL_ERROR_TEXT("tickless timer driver:invalid period", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Drives a callback or message timer from the Linux monotonic clock.
+  /// Rather than calling tick() periodically, the driver sleeps on a timerfd
+  /// until the next timer is due, then calls advance_to() with the current
+  /// time, so an idle timer causes no wakeups.
+  /// TTimer is any timer with advance_to(), time(), time_to_next_expiry() and
+  /// is_running(). A disabled timer causes no wakeups, so call wake() after
+  /// enabling it.
+  /// The driver calls these from the thread running run() or run_once(), so
+  /// other threads must not touch the timer directly. Either post commands
+  /// through the callback timer's command queue (post_start(), post_stop()
+  /// etc.), which advance_to() applies on the driver thread, or pass a TTimer
+  /// that serialises every call, including the driver's, with a lock.
+  /// In both cases call wake() afterwards so that the driver recalculates
+  /// its deadline.
+  //***************************************************************************
+  template <typename TTimer>
+  class tickless_timer_driver
+  {
+  public:
+
+    //*******************************************
+    /// Constructor.
+    /// 'tick_period_ns' is the length of one timer tick in nanoseconds.
+    /// The timer's time is counted from construction of the driver.
+    /// A zero 'tick_period_ns' is rejected and leaves the driver invalid.
+    //*******************************************
+    tickless_timer_driver(TTimer& timer_, uint32_t tick_period_ns_)
+      : timer(timer_),
+        tick_period_ns(tick_period_ns_),
+        epoch_ns(clock_ns() - (uint64_t(timer_.time()) * tick_period_ns_)),
+        timer_fd(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC)),
+        wake_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+        running(true)
+    {
+      ETL_ASSERT(tick_period_ns_ != 0U, ETL_ERROR(etl::tickless_timer_driver_invalid_period));
+    }
+
+    //*******************************************
+    /// Destructor.
+    //*******************************************
+    ~tickless_timer_driver()
+    {
+      if (timer_fd >= 0)
+      {
+        close(timer_fd);
+      }
+
+      if (wake_fd >= 0)
+      {
+        close(wake_fd);
+      }
+    }
+
+    //*******************************************
+    /// Returns true if the tick period is not zero and the timerfd and
+    /// eventfd were created.
+    //*******************************************
+    bool is_valid() const
+    {
+      return (tick_period_ns != 0U) && (timer_fd >= 0) && (wake_fd >= 0);
+    }
+
+    //*******************************************
+    /// Processes the timers that are due, then sleeps until the next one
+    /// is due or wake() is called.
+    /// Returns false if the driver is not valid.
+    //*******************************************
+    bool run_once()
+    {
+      if (!is_valid())
+      {
+        return false;
+      }
+
+      const uint64_t now_ticks = (clock_ns() - epoch_ns) / tick_period_ns;
+
+      if (timer.advance_to(uint32_t(now_ticks)))
+      {
+        const uint32_t ticks_to_expiry = timer.time_to_next_expiry();
+
+        if (ticks_to_expiry == uint32_t(etl::timer::state::INACTIVE))
+        {
+          // Sleep until woken.
+          disarm();
+        }
+        else
+        {
+          arm(now_ticks + ticks_to_expiry);
+        }
+      }
+      else if (!timer.is_running())
+      {
+        // Disabled. Sleep until woken.
+        disarm();
+      }
+      else
+      {
+        // Locked by an update. Try again on the next tick.
+        arm(now_ticks + 1U);
+      }
+
+      pollfd fds[2];
+      fds[0].fd      = timer_fd;
+      fds[0].events  = POLLIN;
+      fds[0].revents = 0;
+      fds[1].fd      = wake_fd;
+      fds[1].events  = POLLIN;
+      fds[1].revents = 0;
+
+      if (poll(fds, 2, -1) > 0)
+      {
+        uint64_t value;
+
+        if ((fds[0].revents & POLLIN) != 0)
+        {
+          (void)read(timer_fd, &value, sizeof(value));
+        }
+
+        if ((fds[1].revents & POLLIN) != 0)
+        {
+          (void)read(wake_fd, &value, sizeof(value));
+        }
+      }
+
+      return true;
+    }
+
+    //*******************************************
+    /// Runs the driver until stop() is called.
+    /// Returns at once if stop() was called before run().
+    //*******************************************
+    void run()
+    {
+      while (running.load() && run_once())
+      {
+      }
+    }
+
+    //*******************************************
+    /// Stops run(). May be called from any thread.
+    //*******************************************
+    void stop()
+    {
+      running.store(false);
+      wake();
+    }
+
+    //*******************************************
+    /// Wakes the driver to recalculate its deadline.
+    /// May be called from any thread.
+    //*******************************************
+    void wake()
+    {
+      const uint64_t value = 1U;
+      (void)write(wake_fd, &value, sizeof(value));
+    }
+
+  private:
+
+    // Disabled.
+    tickless_timer_driver(const tickless_timer_driver&);
+    tickless_timer_driver& operator =(const tickless_timer_driver&);
+
+    //*******************************************
+    /// Arms the timerfd for an absolute tick.
+    /// A deadline in the past fires at once.
+    //*******************************************
+    void arm(uint64_t deadline_ticks)
+    {
+      const uint64_t deadline_ns = epoch_ns + (deadline_ticks * tick_period_ns);
+
+      itimerspec spec;
+
+      spec.it_interval.tv_sec  = 0;
+      spec.it_interval.tv_nsec = 0;
+
+      // A zero value would disarm the timer.
+      spec.it_value.tv_sec  = time_t(deadline_ns / 1000000000U);
+      spec.it_value.tv_nsec = long(deadline_ns % 1000000000U);
+
+      if ((spec.it_value.tv_sec == 0) && (spec.it_value.tv_nsec == 0))
+      {
+        spec.it_value.tv_nsec = 1;
+      }
+
+      timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    //*******************************************
+    /// Disarms the timerfd.
+    //*******************************************
+    void disarm()
+    {
+      itimerspec spec;
+
+      spec.it_interval.tv_sec  = 0;
+      spec.it_interval.tv_nsec = 0;
+      spec.it_value.tv_sec     = 0;
+      spec.it_value.tv_nsec    = 0;
+
+      timerfd_settime(timer_fd, 0, &spec, nullptr);
+    }
+
+    //*******************************************
+    /// The monotonic clock in nanoseconds.
+    //*******************************************
+    static uint64_t clock_ns()
+    {
+      timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+
+      return (uint64_t(ts.tv_sec) * 1000000000U) + uint64_t(ts.tv_nsec);
+    }
+
+    TTimer&        timer;
+    const uint64_t tick_period_ns;
+    const uint64_t epoch_ns;
+    const int      timer_fd;
+    const int      wake_fd;
+    etl::atomic<bool> running;
+  };
+}
+
+#endif
+
+#undef ETL_FILE
+
+#endif
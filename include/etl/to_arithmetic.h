@@ -0,0 +1,356 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#ifndef ETL_TO_ARITHMETIC_INCLUDED
+#define ETL_TO_ARITHMETIC_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "type_traits.h"
+#include "enum_type.h"
+#include "radix.h"
+#include "string_view.h"
+#include "private/to_arithmetic_helper.h"
+
+#include "stl/limits.h"
+
+///\defgroup to_arithmetic to_arithmetic
+/// Converts text to integral and floating point values, without locales,
+/// without needing a terminating null and without using the heap.
+///\code
+/// etl::to_arithmetic_result<int> result = etl::to_arithmetic<int>(etl::string_view("-1234"));
+///
+/// if (result.has_value())
+/// {
+///   int value = result.value();
+/// }
+///\endcode
+///\ingroup string
+
+namespace etl
+{
+  //***************************************************************************
+  /// The status of a conversion.
+  ///\ingroup to_arithmetic
+  //***************************************************************************
+  struct to_arithmetic_status
+  {
+    enum enum_type
+    {
+      valid,
+      invalid_radix,
+      invalid_format,
+      signed_to_unsigned,
+      overflow,
+      underflow
+    };
+
+    ETL_DECLARE_ENUM_TYPE(to_arithmetic_status, int)
+    ETL_ENUM_TYPE(valid,              "valid")
+    ETL_ENUM_TYPE(invalid_radix,      "invalid radix")
+    ETL_ENUM_TYPE(invalid_format,     "invalid format")
+    ETL_ENUM_TYPE(signed_to_unsigned, "signed to unsigned")
+    ETL_ENUM_TYPE(overflow,           "overflow")
+    ETL_ENUM_TYPE(underflow,          "underflow")
+    ETL_END_ENUM_TYPE
+  };
+
+  //***************************************************************************
+  /// The result of a conversion.
+  /// On overflow the value is the largest of the type, or infinity for
+  /// floating point. On underflow it is zero. Otherwise it is zero on error.
+  ///\ingroup to_arithmetic
+  //***************************************************************************
+  template <typename TValue>
+  class to_arithmetic_result
+  {
+  public:
+
+    typedef TValue                     value_type;
+    typedef etl::to_arithmetic_status  error_type;
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    to_arithmetic_result(const value_type value__, const error_type status_)
+      : value_(value__)
+      , status(status_)
+    {
+    }
+
+    //*************************************************************************
+    /// Returns <b>true</b> if the conversion was valid.
+    //*************************************************************************
+    bool has_value() const
+    {
+      return status == error_type::valid;
+    }
+
+#if ETL_CPP11_SUPPORTED
+    //*************************************************************************
+    /// Returns <b>true</b> if the conversion was valid.
+    //*************************************************************************
+    explicit operator bool() const
+    {
+      return has_value();
+    }
+#endif
+
+    //*************************************************************************
+    /// Gets the value.
+    //*************************************************************************
+    value_type value() const
+    {
+      return value_;
+    }
+
+    //*************************************************************************
+    /// Gets the status.
+    //*************************************************************************
+    error_type error() const
+    {
+      return status;
+    }
+
+  private:
+
+    value_type value_;
+    error_type status;
+  };
+
+  namespace private_to_arithmetic
+  {
+    //***************************************************************************
+    /// Converts text to an integral value.
+    //***************************************************************************
+    template <typename TValue, typename TChar>
+    etl::to_arithmetic_result<TValue> to_integral(const TChar* p, const TChar* const end, const uint32_t radix)
+    {
+      typedef etl::to_arithmetic_result<TValue>         result_type;
+      typedef typename etl::make_unsigned<TValue>::type unsigned_type;
+
+      if ((radix != 2U) && (radix != 8U) && (radix != 10U) && (radix != 16U))
+      {
+        return result_type(TValue(0), etl::to_arithmetic_status::invalid_radix);
+      }
+
+      bool negative = false;
+
+      if ((p != end) && ((*p == TChar('-')) || (*p == TChar('+'))))
+      {
+        negative = (*p == TChar('-'));
+        ++p;
+      }
+
+      if (negative && !etl::is_signed<TValue>::value)
+      {
+        return result_type(TValue(0), etl::to_arithmetic_status::signed_to_unsigned);
+      }
+
+      // The magnitude of the most negative value is one more than the maximum.
+      const uint64_t maximum = uint64_t(std::numeric_limits<TValue>::max());
+      const uint64_t limit   = negative ? maximum + 1U : maximum;
+
+      uint64_t magnitude;
+
+      switch (etl::private_to_arithmetic::parse_unsigned(p, end, radix, limit, magnitude))
+      {
+        case 1:
+        {
+          return result_type(TValue(0), etl::to_arithmetic_status::invalid_format);
+        }
+
+        case 2:
+        {
+          return result_type(negative ? std::numeric_limits<TValue>::min() : std::numeric_limits<TValue>::max(),
+                             etl::to_arithmetic_status::overflow);
+        }
+
+        default:
+        {
+          break;
+        }
+      }
+
+      const TValue value = negative ? TValue(unsigned_type(0U) - unsigned_type(magnitude)) : TValue(magnitude);
+
+      return result_type(value, etl::to_arithmetic_status::valid);
+    }
+
+    //***************************************************************************
+    /// Converts text to a floating point value.
+    /// Tries the exact fast path, then the Eisel-Lemire algorithm. Only when
+    /// there are more than 19 significant digits, and they matter, is the
+    /// exact decimal value compared with a big integer.
+    //***************************************************************************
+    template <typename TValue, typename TChar>
+    etl::to_arithmetic_result<TValue> to_floating_point(const TChar* p, const TChar* const end)
+    {
+      typedef etl::to_arithmetic_result<TValue>                         result_type;
+      typedef etl::private_to_arithmetic::binary_format<TValue>         format;
+      typedef etl::private_to_arithmetic::adjusted_mantissa             adjusted_mantissa;
+
+      etl::private_to_arithmetic::decimal_number<TChar> number;
+
+      if (!etl::private_to_arithmetic::parse_decimal(p, end, number))
+      {
+        // Infinity or NaN?
+        const bool negative = (p != end) && (*p == TChar('-'));
+
+        if ((p != end) && ((*p == TChar('-')) || (*p == TChar('+'))))
+        {
+          ++p;
+        }
+
+        if (etl::private_to_arithmetic::matches(p, end, "inf") || etl::private_to_arithmetic::matches(p, end, "infinity"))
+        {
+          const TValue infinity = std::numeric_limits<TValue>::infinity();
+
+          return result_type(negative ? -infinity : infinity, etl::to_arithmetic_status::valid);
+        }
+
+        if (etl::private_to_arithmetic::matches(p, end, "nan"))
+        {
+          return result_type(std::numeric_limits<TValue>::quiet_NaN(), etl::to_arithmetic_status::valid);
+        }
+
+        return result_type(TValue(0), etl::to_arithmetic_status::invalid_format);
+      }
+
+      // Exact when both the mantissa and the power of ten are exact.
+      if (!number.too_many_digits &&
+          (number.exponent >= -format::MAX_EXPONENT_FAST_PATH) &&
+          (number.exponent <= format::MAX_EXPONENT_FAST_PATH) &&
+          (number.mantissa <= format::max_mantissa_fast_path()))
+      {
+        TValue value = TValue(number.mantissa);
+
+        if (number.exponent < 0)
+        {
+          value /= format::exact_power_of_ten(int(-number.exponent));
+        }
+        else
+        {
+          value *= format::exact_power_of_ten(int(number.exponent));
+        }
+
+        return result_type(number.negative ? -value : value, etl::to_arithmetic_status::valid);
+      }
+
+      adjusted_mantissa am = etl::private_to_arithmetic::compute_float<TValue>(number.exponent, number.mantissa);
+
+      if (number.too_many_digits)
+      {
+        // The value lies between mantissa and mantissa + 1.
+        const adjusted_mantissa upper = etl::private_to_arithmetic::compute_float<TValue>(number.exponent, number.mantissa + 1U);
+
+        if (am != upper)
+        {
+          am = etl::private_to_arithmetic::compare_with_halfway<TValue>(number, am, upper);
+        }
+      }
+
+      const TValue value = etl::private_to_arithmetic::to_float<TValue>(number.negative, am);
+
+      if (am.power2 == format::INFINITE_POWER)
+      {
+        return result_type(value, etl::to_arithmetic_status::overflow);
+      }
+
+      if ((am.power2 == 0) && (am.mantissa == 0U) && (number.mantissa != 0U))
+      {
+        return result_type(value, etl::to_arithmetic_status::underflow);
+      }
+
+      return result_type(value, etl::to_arithmetic_status::valid);
+    }
+  }
+
+  //***************************************************************************
+  /// Converts text to an integral value.
+  /// [+-]digits, with no prefix or white space. Digits above 9 may be upper
+  /// or lower case. Decimal text is converted eight characters at a time.
+  ///\param view  The text.
+  ///\param radix Binary, octal, decimal or hex.
+  ///\ingroup to_arithmetic
+  //***************************************************************************
+  template <typename TValue, typename TChar, typename TTraits>
+  typename etl::enable_if<etl::is_integral<TValue>::value && !etl::is_same<TValue, bool>::value, etl::to_arithmetic_result<TValue> >::type
+    to_arithmetic(const etl::basic_string_view<TChar, TTraits>& view, const etl::radix radix = etl::radix::decimal)
+  {
+    return etl::private_to_arithmetic::to_integral<TValue>(view.data(), view.data() + view.size(), radix.get_value());
+  }
+
+  //***************************************************************************
+  /// Converts text to an integral value.
+  ///\param text   The text. Does not need to be null terminated.
+  ///\param length The length of the text.
+  ///\param radix  Binary, octal, decimal or hex.
+  ///\ingroup to_arithmetic
+  //***************************************************************************
+  template <typename TValue, typename TChar>
+  typename etl::enable_if<etl::is_integral<TValue>::value && !etl::is_same<TValue, bool>::value, etl::to_arithmetic_result<TValue> >::type
+    to_arithmetic(const TChar* text, const size_t length, const etl::radix radix = etl::radix::decimal)
+  {
+    return etl::private_to_arithmetic::to_integral<TValue>(text, text + length, radix.get_value());
+  }
+
+  //***************************************************************************
+  /// Converts text to a float or double, correctly rounded.
+  /// [+-]digits[.digits][(e|E)[+-]digits], or "inf", "infinity" or "nan"
+  /// in any case. The decimal point is always '.'.
+  ///\param view The text.
+  ///\ingroup to_arithmetic
+  //***************************************************************************
+  template <typename TValue, typename TChar, typename TTraits>
+  typename etl::enable_if<etl::is_same<TValue, float>::value || etl::is_same<TValue, double>::value, etl::to_arithmetic_result<TValue> >::type
+    to_arithmetic(const etl::basic_string_view<TChar, TTraits>& view)
+  {
+    return etl::private_to_arithmetic::to_floating_point<TValue>(view.data(), view.data() + view.size());
+  }
+
+  //***************************************************************************
+  /// Converts text to a float or double, correctly rounded.
+  ///\param text   The text. Does not need to be null terminated.
+  ///\param length The length of the text.
+  ///\ingroup to_arithmetic
+  //***************************************************************************
+  template <typename TValue, typename TChar>
+  typename etl::enable_if<etl::is_same<TValue, float>::value || etl::is_same<TValue, double>::value, etl::to_arithmetic_result<TValue> >::type
+    to_arithmetic(const TChar* text, const size_t length)
+  {
+    return etl::private_to_arithmetic::to_floating_point<TValue>(text, text + length);
+  }
+}
+
+#endif
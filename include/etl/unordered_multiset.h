@@ -51,6 +51,7 @@ SOFTWARE.
 #include "error_handler.h"
 #include "exception.h"
 #include "debug_count.h"
+#include "private/bucket_occupancy.h"
 
 #undef ETL_FILE
 #define ETL_FILE "26"
@@ -140,6 +141,9 @@ namespace etl
 
     typedef typename etl::parameter_type<TKey>::type key_parameter_t;
 
+    /// The number of keys hashed and prefetched together by find_batch.
+    static const size_t FIND_BATCH_SIZE = 16;
+
     typedef etl::forward_link<0> link_t;
 
     // The nodes that store the elements.
@@ -188,7 +192,7 @@ namespace etl
 
       //*********************************
       iterator(const iterator& other)
-        : pbuckets_end(other.pbuckets_end),
+        : pmap(other.pmap),
         pbucket(other.pbucket),
         inode(other.inode)
       {
@@ -202,15 +206,11 @@ namespace etl
         // The end of this node list?
         if (inode == pbucket->end())
         {
-          // Search for the next non-empty bucket.
-          ++pbucket;
-          while ((pbucket != pbuckets_end) && (pbucket->empty()))
-          {
-            ++pbucket;
-          }
+          // Jump to the next non-empty bucket.
+          pbucket = pmap->next_occupied_bucket(pbucket);
 
           // If not past the end, get the first node in the bucket.
-          if (pbucket != pbuckets_end)
+          if (pbucket != pmap->buckets_end())
           {
             inode = pbucket->begin();
           }
@@ -230,7 +230,7 @@ namespace etl
       //*********************************
       iterator operator =(const iterator& other)
       {
-        pbuckets_end = other.pbuckets_end;
+        pmap = other.pmap;
         pbucket = other.pbucket;
         inode = other.inode;
         return *this;
@@ -287,8 +287,8 @@ namespace etl
     private:
 
       //*********************************
-      iterator(bucket_t* pbuckets_end_, bucket_t* pbucket_, local_iterator inode_)
-        : pbuckets_end(pbuckets_end_),
+      iterator(const iunordered_multiset* pmap_, bucket_t* pbucket_, local_iterator inode_)
+        : pmap(pmap_),
           pbucket(pbucket_),
           inode(inode_)
       {
@@ -318,7 +318,7 @@ namespace etl
         return inode;
       }
 
-      bucket_t* pbuckets_end;
+      const iunordered_multiset* pmap;
       bucket_t* pbucket;
       local_iterator inode;
     };
@@ -348,7 +348,7 @@ namespace etl
 
       //*********************************
       const_iterator(const typename iunordered_multiset::iterator& other)
-        : pbuckets_end(other.pbuckets_end),
+        : pmap(other.pmap),
         pbucket(other.pbucket),
         inode(other.inode)
       {
@@ -356,7 +356,7 @@ namespace etl
 
       //*********************************
       const_iterator(const const_iterator& other)
-        : pbuckets_end(other.pbuckets_end),
+        : pmap(other.pmap),
         pbucket(other.pbucket),
         inode(other.inode)
       {
@@ -370,16 +370,11 @@ namespace etl
         // The end of this node list?
         if (inode == pbucket->end())
         {
-          // Search for the next non-empty bucket.
-
-          ++pbucket;
-          while ((pbucket != pbuckets_end) && (pbucket->empty()))
-          {
-            ++pbucket;
-          }
+          // Jump to the next non-empty bucket.
+          pbucket = pmap->next_occupied_bucket(pbucket);
 
           // If not past the end, get the first node in the bucket.
-          if (pbucket != pbuckets_end)
+          if (pbucket != pmap->buckets_end())
           {
             inode = pbucket->begin();
           }
@@ -399,7 +394,7 @@ namespace etl
       //*********************************
       const_iterator operator =(const const_iterator& other)
       {
-        pbuckets_end = other.pbuckets_end;
+        pmap = other.pmap;
         pbucket = other.pbucket;
         inode = other.inode;
         return *this;
@@ -438,8 +433,8 @@ namespace etl
     private:
 
       //*********************************
-      const_iterator(bucket_t* pbuckets_end_, bucket_t* pbucket_, local_iterator inode_)
-        : pbuckets_end(pbuckets_end_),
+      const_iterator(const iunordered_multiset* pmap_, bucket_t* pbucket_, local_iterator inode_)
+        : pmap(pmap_),
           pbucket(pbucket_),
           inode(inode_)
       {
@@ -469,7 +464,7 @@ namespace etl
         return inode;
       }
 
-      bucket_t* pbuckets_end;
+      const iunordered_multiset* pmap;
       bucket_t* pbucket;
       local_iterator inode;
     };
@@ -482,7 +477,7 @@ namespace etl
     //*********************************************************************
     iterator begin()
     {
-      return iterator((pbuckets + number_of_buckets), first, first->begin());
+      return iterator(this, first, first->begin());
     }
 
     //*********************************************************************
@@ -491,7 +486,7 @@ namespace etl
     //*********************************************************************
     const_iterator begin() const
     {
-      return const_iterator((pbuckets + number_of_buckets), first, first->begin());
+      return const_iterator(this, first, first->begin());
     }
 
     //*********************************************************************
@@ -500,7 +495,7 @@ namespace etl
     //*********************************************************************
     const_iterator cbegin() const
     {
-      return const_iterator((pbuckets + number_of_buckets), first, first->begin());
+      return const_iterator(this, first, first->begin());
     }
 
     //*********************************************************************
@@ -536,7 +531,7 @@ namespace etl
     //*********************************************************************
     iterator end()
     {
-      return iterator((pbuckets + number_of_buckets), last, last->end());
+      return iterator(this, buckets_end(), local_iterator());
     }
 
     //*********************************************************************
@@ -545,7 +540,7 @@ namespace etl
     //*********************************************************************
     const_iterator end() const
     {
-      return const_iterator((pbuckets + number_of_buckets), last, last->end());
+      return const_iterator(this, buckets_end(), local_iterator());
     }
 
     //*********************************************************************
@@ -554,7 +549,7 @@ namespace etl
     //*********************************************************************
     const_iterator cend() const
     {
-      return const_iterator((pbuckets + number_of_buckets), last, last->end());
+      return const_iterator(this, buckets_end(), local_iterator());
     }
 
     //*********************************************************************
@@ -590,7 +585,17 @@ namespace etl
     //*********************************************************************
     size_type get_bucket_index(key_parameter_t key) const
     {
-      return key_hash_function(key) % number_of_buckets;
+      return bucket_for_hash(key_hash_function(key));
+    }
+
+    //*********************************************************************
+    /// Returns the bucket index for a precomputed hash.
+    ///\param hash The hash of the key, as returned by hash_function().
+    ///\return The bucket index for the hash.
+    //*********************************************************************
+    size_type bucket_for_hash(size_t hash) const
+    {
+      return hash % number_of_buckets;
     }
 
     //*********************************************************************
@@ -674,9 +679,9 @@ namespace etl
 
         // Just add the pointer to the bucket;
         bucket.insert_after(bucket.before_begin(), node);
-        adjust_first_last_markers_after_insert(&bucket);
+        update_occupancy_after_insert(&bucket);
 
-        result.first = iterator((pbuckets + number_of_buckets), pbucket, pbucket->begin());
+        result.first = iterator(this, pbucket, pbucket->begin());
         result.second = true;
       }
       else
@@ -704,10 +709,10 @@ namespace etl
 
         // Add the node to the end of the bucket;
         bucket.insert_after(inode_previous, node);
-        adjust_first_last_markers_after_insert(&bucket);
+        update_occupancy_after_insert(&bucket);
         ++inode_previous;
 
-        result.first = iterator((pbuckets + number_of_buckets), pbucket, inode_previous);
+        result.first = iterator(this, pbucket, inode_previous);
         result.second = true;
       }
 
@@ -763,7 +768,7 @@ namespace etl
           bucket.erase_after(iprevious);  // Unlink from the bucket.
           icurrent->key.~value_type();    // Destroy the value.
           pnodepool->release(&*icurrent); // Release it back to the pool.
-          adjust_first_last_markers_after_erase(&bucket);
+          update_occupancy_after_erase(&bucket);
           ++n;
           icurrent = iprevious;
           ETL_DECREMENT_DEBUG_COUNT
@@ -786,7 +791,7 @@ namespace etl
     iterator erase(const_iterator ielement)
     {
       // Make a note of the next one.
-      iterator inext((pbuckets + number_of_buckets), ielement.get_bucket_list_iterator(), ielement.get_local_iterator());
+      iterator inext(this, ielement.get_bucket_list_iterator(), ielement.get_local_iterator());
       ++inext;
 
       bucket_t&      bucket = ielement.get_bucket();
@@ -802,7 +807,7 @@ namespace etl
       bucket.erase_after(iprevious);  // Unlink from the bucket.
       icurrent->key.~value_type();    // Destroy the value.
       pnodepool->release(&*icurrent); // Release it back to the pool.
-      adjust_first_last_markers_after_erase(&bucket);
+      update_occupancy_after_erase(&bucket);
       ETL_DECREMENT_DEBUG_COUNT
 
       return inext;
@@ -818,13 +823,19 @@ namespace etl
     iterator erase(const_iterator first_, const_iterator last_)
     {
       // Make a note of the last.
-      iterator result((pbuckets + number_of_buckets), last_.get_bucket_list_iterator(), last_.get_local_iterator());
+      iterator result(this, last_.get_bucket_list_iterator(), last_.get_local_iterator());
+
+      if (first_ == last_)
+      {
+        return result;
+      }
 
       // Get the starting point.
       bucket_t*      pbucket   = first_.get_bucket_list_iterator();
       local_iterator iprevious = pbucket->before_begin();
       local_iterator icurrent  = first_.get_local_iterator();
       local_iterator iend      = last_.get_local_iterator(); // Note: May not be in the same bucket as icurrent.
+      bucket_t*      pend      = last_.get_bucket_list_iterator();
 
                                                        // Find the node previous to the first one.
       while (iprevious->etl_next != &*icurrent)
@@ -832,29 +843,24 @@ namespace etl
         ++iprevious;
       }
 
-      while (icurrent != iend)
+      while ((pbucket != pend) || (icurrent != iend))
       {
-
         local_iterator inext = pbucket->erase_after(iprevious); // Unlink from the bucket.
         icurrent->key.~value_type();    // Destroy the value.
         pnodepool->release(&*icurrent); // Release it back to the pool.
-        adjust_first_last_markers_after_erase(pbucket);
+        update_occupancy_after_erase(pbucket);
         ETL_DECREMENT_DEBUG_COUNT
 
         icurrent = inext;
 
-        // Are we there yet?
-        if (icurrent != iend)
+        // At the end of this bucket?
+        if (icurrent == pbucket->end())
         {
-          // At the end of this bucket?
-          if ((icurrent == pbucket->end()))
-          {
-            // Find the next non-empty one.
-            do
-            {
-              ++pbucket;
-            } while (pbucket->empty());
+          // Jump to the next non-empty one.
+          pbucket = next_occupied_bucket(pbucket);
 
+          if (pbucket != buckets_end())
+          {
             iprevious = pbucket->before_begin();
             icurrent = pbucket->begin();
           }
@@ -905,31 +911,7 @@ namespace etl
     //*********************************************************************
     iterator find(key_parameter_t key)
     {
-      size_t index = get_bucket_index(key);
-
-      bucket_t* pbucket = pbuckets + index;
-      bucket_t& bucket = *pbucket;
-
-      // Is the bucket not empty?
-      if (!bucket.empty())
-      {
-        // Step though the list until we find the end or an equivalent key.
-        local_iterator inode = bucket.begin();
-        local_iterator iend = bucket.end();
-
-        while (inode != iend)
-        {
-          // Do we have this one?
-          if (key_equal_function(key, inode->key))
-          {
-            return iterator((pbuckets + number_of_buckets), pbucket, inode);
-          }
-
-          ++inode;
-        }
-      }
-
-      return end();
+      return find(key, key_hash_function(key));
     }
 
     //*********************************************************************
@@ -939,31 +921,64 @@ namespace etl
     //*********************************************************************
     const_iterator find(key_parameter_t key) const
     {
-      size_t index = get_bucket_index(key);
+      return find(key, key_hash_function(key));
+    }
 
-      bucket_t* pbucket = pbuckets + index;
-      bucket_t& bucket = *pbucket;
+    //*********************************************************************
+    /// Finds an element, using a hash that has already been calculated.
+    ///\param key  The key to search for.
+    ///\param hash The hash of the key, as returned by hash_function().
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    iterator find(key_parameter_t key, size_t hash)
+    {
+      bucket_t*      pbucket = pbuckets + bucket_for_hash(hash);
+      local_iterator inode   = find_in_bucket(*pbucket, key);
 
-      // Is the bucket not empty?
-      if (!bucket.empty())
-      {
-        // Step though the list until we find the end or an equivalent key.
-        local_iterator inode = bucket.begin();
-        local_iterator iend = bucket.end();
+      return (inode == pbucket->end()) ? end() : iterator(this, pbucket, inode);
+    }
 
-        while (inode != iend)
-        {
-          // Do we have this one?
-          if (key_equal_function(key, inode->key))
-          {
-            return iterator((pbuckets + number_of_buckets), pbucket, inode);
-          }
+    //*********************************************************************
+    /// Finds an element, using a hash that has already been calculated.
+    ///\param key  The key to search for.
+    ///\param hash The hash of the key, as returned by hash_function().
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    const_iterator find(key_parameter_t key, size_t hash) const
+    {
+      bucket_t*      pbucket = pbuckets + bucket_for_hash(hash);
+      local_iterator inode   = find_in_bucket(*pbucket, key);
 
-          ++inode;
-        }
-      }
+      return (inode == pbucket->end()) ? end() : const_iterator(this, pbucket, inode);
+    }
 
-      return end();
+    //*********************************************************************
+    /// Finds a batch of elements.
+    /// The keys are processed in blocks of FIND_BATCH_SIZE. All of the keys
+    /// in a block are hashed and their buckets and first nodes prefetched
+    /// before any are compared, so that the cache misses overlap.
+    ///\param keys_begin The first key. Must be at least a forward iterator.
+    ///\param keys_end   One past the last key.
+    ///\param out        Receives an iterator for each key, or end() if not found.
+    ///\return The output iterator after the last result.
+    //*********************************************************************
+    template <typename TKeyIterator, typename TOutputIterator>
+    TOutputIterator find_batch(TKeyIterator keys_begin, TKeyIterator keys_end, TOutputIterator out)
+    {
+      return find_batch_implementation<iterator>(keys_begin, keys_end, out);
+    }
+
+    //*********************************************************************
+    /// Finds a batch of elements.
+    ///\param keys_begin The first key. Must be at least a forward iterator.
+    ///\param keys_end   One past the last key.
+    ///\param out        Receives a const_iterator for each key, or end() if not found.
+    ///\return The output iterator after the last result.
+    //*********************************************************************
+    template <typename TKeyIterator, typename TOutputIterator>
+    TOutputIterator find_batch(TKeyIterator keys_begin, TKeyIterator keys_end, TOutputIterator out) const
+    {
+      return find_batch_implementation<const_iterator>(keys_begin, keys_end, out);
     }
 
     //*********************************************************************
@@ -1105,10 +1120,11 @@ namespace etl
     //*********************************************************************
     /// Constructor.
     //*********************************************************************
-    iunordered_multiset(pool_t& node_pool_, bucket_t* pbuckets_, size_t number_of_buckets_)
+    iunordered_multiset(pool_t& node_pool_, bucket_t* pbuckets_, size_t number_of_buckets_, etl::private_unordered::bucket_occupancy::word_t* poccupancy_)
       : pnodepool(&node_pool_),
         pbuckets(pbuckets_),
-        number_of_buckets(number_of_buckets_)
+        number_of_buckets(number_of_buckets_),
+        occupancy(poccupancy_, number_of_buckets_)
     {
     }
 
@@ -1119,103 +1135,160 @@ namespace etl
     {
       if (!empty())
       {
-        // For each bucket...
-        for (size_t i = 0; i < number_of_buckets; ++i)
+        // For each occupied bucket...
+        size_t i = occupancy.find_next(size_t(first - pbuckets));
+
+        while (i != number_of_buckets)
         {
           bucket_t& bucket = pbuckets[i];
 
-          if (!bucket.empty())
+          // For each item in the bucket...
+          local_iterator it = bucket.begin();
+
+          while (it != bucket.end())
           {
-            // For each item in the bucket...
-            local_iterator it = bucket.begin();
-
-            while (it != bucket.end())
-            {
-              // Destroy the value contents.
-              it->key.~value_type();
-              ++it;
-              ETL_DECREMENT_DEBUG_COUNT
-            }
-
-            // Now it's safe to clear the bucket.
-            bucket.clear();
+            // Destroy the value contents.
+            it->key.~value_type();
+            ++it;
+            ETL_DECREMENT_DEBUG_COUNT
           }
+
+          // Now it's safe to clear the bucket.
+          bucket.clear();
+
+          i = occupancy.find_next(i + 1);
         }
 
         // Now it's safe to clear the entire pool in one go.
         pnodepool->release_all();
       }
 
+      occupancy.reset_all();
+
       first = pbuckets;
-      last = first;
     }
 
   private:
 
     //*********************************************************************
-    /// Adjust the first and last markers according to the new entry.
+    /// Searches a bucket for the key.
+    ///\return The node for the key, or bucket.end() if not found.
     //*********************************************************************
-    void adjust_first_last_markers_after_insert(bucket_t* pbucket)
+    local_iterator find_in_bucket(bucket_t& bucket, key_parameter_t key) const
     {
-      if (size() == 1)
+      local_iterator inode = bucket.begin();
+      local_iterator iend  = bucket.end();
+
+      while ((inode != iend) && !key_equal_function(key, inode->key))
       {
-        first = pbucket;
-        last = pbucket;
+        ++inode;
       }
-      else
+
+      return inode;
+    }
+
+    //*********************************************************************
+    /// Finds a batch of elements, one block of keys at a time.
+    //*********************************************************************
+    template <typename TIterator, typename TKeyIterator, typename TOutputIterator>
+    TOutputIterator find_batch_implementation(TKeyIterator keys_begin, TKeyIterator keys_end, TOutputIterator out) const
+    {
+      bucket_t* pbucket_block[FIND_BATCH_SIZE];
+
+      while (keys_begin != keys_end)
       {
-        if (pbucket < first)
+        // Hash the keys and prefetch their buckets.
+        TKeyIterator ikey = keys_begin;
+        size_t n = 0;
+
+        while ((ikey != keys_end) && (n < FIND_BATCH_SIZE))
         {
-          first = pbucket;
+          pbucket_block[n] = pbuckets + bucket_for_hash(key_hash_function(*ikey));
+          ETL_PREFETCH(pbucket_block[n]);
+          ++ikey;
+          ++n;
         }
-        else if (pbucket > last)
+
+        // Prefetch the first node of each non-empty bucket.
+        for (size_t i = 0; i < n; ++i)
         {
-          last = pbucket;
+          if (!pbucket_block[i]->empty())
+          {
+            ETL_PREFETCH(pbucket_block[i]->begin().operator ->());
+          }
+        }
+
+        // Search the buckets.
+        for (size_t i = 0; i < n; ++i)
+        {
+          bucket_t*      pbucket = pbucket_block[i];
+          local_iterator inode   = find_in_bucket(*pbucket, *keys_begin);
+
+          if (inode == pbucket->end())
+          {
+            *out = TIterator(this, buckets_end(), local_iterator());
+          }
+          else
+          {
+            *out = TIterator(this, pbucket, inode);
+          }
+
+          ++out;
+          ++keys_begin;
         }
       }
+
+      return out;
+    }
+
+    //*********************************************************************
+    /// Returns a pointer to one past the last bucket.
+    //*********************************************************************
+    bucket_t* buckets_end() const
+    {
+      return pbuckets + number_of_buckets;
+    }
+
+    //*********************************************************************
+    /// Returns the next non-empty bucket after pbucket, or buckets_end().
+    //*********************************************************************
+    bucket_t* next_occupied_bucket(const bucket_t* pbucket) const
+    {
+      return pbuckets + occupancy.find_next(size_t(pbucket - pbuckets) + 1);
     }
 
     //*********************************************************************
-    /// Adjust the first and last markers according to the erased entry.
+    /// Update the occupancy and first marker according to the new entry.
     //*********************************************************************
-    void adjust_first_last_markers_after_erase(bucket_t* pbucket)
+    void update_occupancy_after_insert(bucket_t* pbucket)
     {
-      if (empty())
+      occupancy.set(size_t(pbucket - pbuckets));
+
+      if ((size() == 1) || (pbucket < first))
       {
-        first = pbuckets;
-        last = pbuckets;
+        first = pbucket;
       }
-      else
-      {
-        if (pbucket == first)
-        {
-          // We erased the first so, we need to search again from where we erased.
-          while (first->empty())
-          {
-            ++first;
-          }
-        }
-        else if (pbucket == last)
-        {
-          // We erased the last, so we need to search again. Start from the first, go no further than the current last.
-          bucket_t* pbucket = first;
-          bucket_t* pend = last;
+    }
 
-          last = first;
+    //*********************************************************************
+    /// Update the occupancy and first marker according to the erased entry.
+    //*********************************************************************
+    void update_occupancy_after_erase(bucket_t* pbucket)
+    {
+      if (pbucket->empty())
+      {
+        size_t index = size_t(pbucket - pbuckets);
 
-          while (pbucket != pend)
-          {
-            if (!pbucket->empty())
-            {
-              last = pbucket;
-            }
+        occupancy.reset(index);
 
-            ++pbucket;
-          }
+        if (empty())
+        {
+          first = pbuckets;
         }
-        else
+        else if (pbucket == first)
         {
-          // Nothing to do.
+          // We erased the first, so jump to the next non-empty one.
+          first = pbuckets + occupancy.find_next(index + 1);
         }
       }
     }
@@ -1232,9 +1305,11 @@ namespace etl
     /// The number of buckets.
     const size_t number_of_buckets;
 
-    /// The first and last iterators to buckets with values.
+    /// The first bucket with values.
     bucket_t* first;
-    bucket_t* last;
+
+    /// The buckets that hold values.
+    etl::private_unordered::bucket_occupancy occupancy;
 
     /// The function that creates the hashes.
     hasher key_hash_function;
@@ -1307,7 +1382,7 @@ namespace etl
     /// Default constructor.
     //*************************************************************************
     unordered_multiset()
-      : base(node_pool, buckets, MAX_BUCKETS)
+      : base(node_pool, buckets, MAX_BUCKETS, occupancy)
     {
       base::initialise();
     }
@@ -1316,7 +1391,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     unordered_multiset(const unordered_multiset& other)
-      : base(node_pool, buckets, MAX_BUCKETS)
+      : base(node_pool, buckets, MAX_BUCKETS, occupancy)
     {
       base::assign(other.cbegin(), other.cend());
     }
@@ -1329,7 +1404,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     unordered_multiset(TIterator first_, TIterator last_)
-      : base(node_pool, buckets, MAX_BUCKETS)
+      : base(node_pool, buckets, MAX_BUCKETS, occupancy)
     {
       base::assign(first_, last_);
     }
@@ -1363,6 +1438,9 @@ namespace etl
 
     /// The buckets of node lists.
     etl::intrusive_forward_list<typename base::node_t> buckets[MAX_BUCKETS_];
+
+    /// The occupancy bitmap of the buckets.
+    etl::private_unordered::bucket_occupancy::word_t occupancy[etl::private_unordered::bucket_occupancy::words<MAX_BUCKETS_>::value];
   };
 }
 
@@ -213,6 +213,8 @@ void ecl_timer_data_init_default(struct ecl_timer_config* ptimer_data_)
   ptimer_data_->previous  = ECL_TIMER_NO_TIMER;
   ptimer_data_->next      = ECL_TIMER_NO_TIMER;
   ptimer_data_->repeating = ECL_TIMER_REPEATING;
+  ptimer_data_->expiry    = 0;
+  ptimer_data_->slot      = ECL_TIMER_NO_SLOT;
 }
 
 //*******************************************
@@ -234,6 +236,8 @@ void ecl_timer_data_init(struct ecl_timer_config* ptimer_data_,
   ptimer_data_->previous  = ECL_TIMER_NO_TIMER;
   ptimer_data_->next      = ECL_TIMER_NO_TIMER;
   ptimer_data_->repeating = repeating_;
+  ptimer_data_->expiry    = 0;
+  ptimer_data_->slot      = ECL_TIMER_NO_SLOT;
 }
 
 //*******************************************
@@ -547,6 +551,605 @@ ecl_timer_result_t ecl_timer_set_mode(ecl_timer_id_t id_, ecl_timer_mode_t repea
   return ECL_TIMER_FAIL;
 }
 
+//*****************************************************************************
+// Internal timer wheel
+// A timer is placed at the level of the highest four bits in which its
+// expiry time differs from the current time, and moves down a level each
+// time the current time enters its slot.
+// Each slot is a circular, doubly linked list in insertion order.
+//*****************************************************************************
+
+#define ECL_TIMER_WHEEL_SLOT_MASK (ECL_TIMER_WHEEL_SLOTS - 1)
+
+#if defined(ECL_TIMER_CONTEXT_LOCK_TYPE)
+  #define ECL_TIMER_CONTEXT_ACQUIRE(pcontext) ECL_TIMER_CONTEXT_LOCK((pcontext)->lock)
+  #define ECL_TIMER_CONTEXT_RELEASE(pcontext) ECL_TIMER_CONTEXT_UNLOCK((pcontext)->lock)
+#else
+  #define ECL_TIMER_CONTEXT_ACQUIRE(pcontext)
+  #define ECL_TIMER_CONTEXT_RELEASE(pcontext)
+#endif
+
+//*******************************
+static uint32_t ecl_timer_wheel_count_trailing_zeros(uint32_t value)
+{
+  uint32_t count = 0;
+
+  while ((value & 1U) == 0)
+  {
+    value >>= 1;
+    ++count;
+  }
+
+  return count;
+}
+
+//*******************************
+static void ecl_timer_wheel_clear(struct ecl_timer_context* pcontext)
+{
+  int i;
+  for (i = 0; i < (ECL_TIMER_WHEEL_LEVELS * ECL_TIMER_WHEEL_SLOTS); ++i)
+  {
+    pcontext->heads[i] = ECL_TIMER_NO_TIMER;
+  }
+
+  for (i = 0; i < ECL_TIMER_WHEEL_LEVELS; ++i)
+  {
+    pcontext->occupied[i] = 0;
+  }
+
+  pcontext->active_timers = 0;
+}
+
+//*******************************
+// Inserts the timer at its expiry time.
+//*******************************
+static void ecl_timer_wheel_insert(struct ecl_timer_context* pcontext, ecl_timer_id_t id_)
+{
+  struct ecl_timer_config* ptimer = &pcontext->ptimers[id_];
+
+  uint32_t      difference = ptimer->expiry ^ pcontext->time;
+  uint_least8_t level      = 0;
+
+  while ((difference >>= ECL_TIMER_WHEEL_LEVEL_BITS) != 0)
+  {
+    ++level;
+  }
+
+  uint_least8_t index = (uint_least8_t)((level * ECL_TIMER_WHEEL_SLOTS) +
+                                        ((ptimer->expiry >> (level * ECL_TIMER_WHEEL_LEVEL_BITS)) & ECL_TIMER_WHEEL_SLOT_MASK));
+
+  ecl_timer_id_t* phead = &pcontext->heads[index];
+
+  if (*phead == ECL_TIMER_NO_TIMER)
+  {
+    *phead           = id_;
+    ptimer->previous = id_;
+    ptimer->next     = id_;
+
+    pcontext->occupied[level] |= (uint16_t)(1U << (index & ECL_TIMER_WHEEL_SLOT_MASK));
+  }
+  else
+  {
+    // Add at the tail.
+    struct ecl_timer_config* pfirst = &pcontext->ptimers[*phead];
+
+    ptimer->previous = pfirst->previous;
+    ptimer->next     = *phead;
+    pcontext->ptimers[pfirst->previous].next = id_;
+    pfirst->previous                         = id_;
+  }
+
+  ptimer->slot = index;
+
+  // Marks the timer as active.
+  ptimer->delta = 0;
+
+  ++pcontext->active_timers;
+}
+
+//*******************************
+static void ecl_timer_wheel_remove(struct ecl_timer_context* pcontext, ecl_timer_id_t id_)
+{
+  struct ecl_timer_config* ptimer = &pcontext->ptimers[id_];
+
+  uint_least8_t   index = ptimer->slot;
+  ecl_timer_id_t* phead = &pcontext->heads[index];
+
+  if (ptimer->next == id_)
+  {
+    // The only timer in the slot.
+    *phead = ECL_TIMER_NO_TIMER;
+
+    pcontext->occupied[index / ECL_TIMER_WHEEL_SLOTS] &= (uint16_t)~(1U << (index & ECL_TIMER_WHEEL_SLOT_MASK));
+  }
+  else
+  {
+    pcontext->ptimers[ptimer->previous].next = ptimer->next;
+    pcontext->ptimers[ptimer->next].previous = ptimer->previous;
+
+    if (*phead == id_)
+    {
+      *phead = ptimer->next;
+    }
+  }
+
+  ptimer->previous = ECL_TIMER_NO_TIMER;
+  ptimer->next     = ECL_TIMER_NO_TIMER;
+  ptimer->slot     = ECL_TIMER_NO_SLOT;
+  ptimer->delta    = ECL_TIMER_INACTIVE;
+
+  --pcontext->active_timers;
+}
+
+//*******************************
+// The number of ticks until the current time next enters an occupied slot
+// at any level, or UINT32_MAX if there are no timers.
+//*******************************
+static uint32_t ecl_timer_wheel_ticks_to_next_slot(const struct ecl_timer_context* pcontext)
+{
+  uint64_t ticks = UINT32_MAX;
+
+  int level;
+  for (level = 0; level < ECL_TIMER_WHEEL_LEVELS; ++level)
+  {
+    uint32_t occupied = pcontext->occupied[level];
+
+    if (occupied != 0)
+    {
+      uint32_t shift    = (uint32_t)(level * ECL_TIMER_WHEEL_LEVEL_BITS);
+      uint32_t position = (pcontext->time >> shift) & ECL_TIMER_WHEEL_SLOT_MASK;
+
+      // Rotate so that the slot after the current one is bit 0.
+      uint32_t rotated = ((occupied >> (position + 1U)) | (occupied << (ECL_TIMER_WHEEL_SLOT_MASK - position))) & 0xFFFFU;
+
+      uint64_t slots       = (uint64_t)ecl_timer_wheel_count_trailing_zeros(rotated) + 1U;
+      uint64_t offset      = pcontext->time & (((uint64_t)1U << shift) - 1U);
+      uint64_t level_ticks = (slots << shift) - offset;
+
+      if (level_ticks < ticks)
+      {
+        ticks = level_ticks;
+      }
+    }
+  }
+
+  return (uint32_t)ticks;
+}
+
+//*******************************
+// The number of ticks until the earliest expiry time, or ECL_TIMER_INACTIVE.
+// A timer whose expiry has wrapped past zero may sit in a nearer slot, or a
+// lower level, than an earlier one, so every occupied slot is searched.
+//*******************************
+static uint32_t ecl_timer_wheel_ticks_to_next_expiry(const struct ecl_timer_context* pcontext)
+{
+  uint32_t ticks = ECL_TIMER_INACTIVE;
+  int      level;
+
+  for (level = 0; level < ECL_TIMER_WHEEL_LEVELS; ++level)
+  {
+    uint32_t slots = pcontext->occupied[level];
+
+    while (slots != 0)
+    {
+      uint32_t       index = (level * ECL_TIMER_WHEEL_SLOTS) + ecl_timer_wheel_count_trailing_zeros(slots);
+      ecl_timer_id_t id    = pcontext->heads[index];
+
+      // Clear the lowest set bit.
+      slots &= (slots - 1U);
+
+      do
+      {
+        const struct ecl_timer_config* ptimer = &pcontext->ptimers[id];
+
+        if ((uint32_t)(ptimer->expiry - pcontext->time) < ticks)
+        {
+          ticks = ptimer->expiry - pcontext->time;
+        }
+
+        id = ptimer->next;
+      } while (id != pcontext->heads[index]);
+    }
+  }
+
+  return ticks;
+}
+
+//*******************************
+// Reinserts the timers in a slot relative to the current time.
+//*******************************
+static void ecl_timer_wheel_cascade(struct ecl_timer_context* pcontext, uint_least8_t index)
+{
+  ecl_timer_id_t id = pcontext->heads[index];
+
+  while (id != ECL_TIMER_NO_TIMER)
+  {
+    ecl_timer_wheel_remove(pcontext, id);
+    ecl_timer_wheel_insert(pcontext, id);
+    id = pcontext->heads[index];
+  }
+}
+
+//*******************************
+// Advances the current time.
+// 'count' must not be more than ecl_timer_wheel_ticks_to_next_slot().
+// Timers in higher level slots that the current time enters are moved down.
+//*******************************
+static void ecl_timer_wheel_advance(struct ecl_timer_context* pcontext, uint32_t count)
+{
+  pcontext->time += count;
+
+  if ((count != 0) && (pcontext->active_timers != 0))
+  {
+    int level;
+    for (level = 1; level < ECL_TIMER_WHEEL_LEVELS; ++level)
+    {
+      uint32_t shift = (uint32_t)(level * ECL_TIMER_WHEEL_LEVEL_BITS);
+
+      if ((pcontext->time & (((uint32_t)1U << shift) - 1U)) != 0)
+      {
+        break;
+      }
 
+      ecl_timer_wheel_cascade(pcontext, (uint_least8_t)((level * ECL_TIMER_WHEEL_SLOTS) + ((pcontext->time >> shift) & ECL_TIMER_WHEEL_SLOT_MASK)));
+    }
+  }
+}
 
+//*******************************
+// Calls the timers that expire at the current time.
+// Called with the context locked. The lock is released around each callback.
+//*******************************
+static void ecl_timer_wheel_process_due(struct ecl_timer_context* pcontext)
+{
+  ecl_timer_id_t id;
+
+  while ((id = pcontext->heads[pcontext->time & ECL_TIMER_WHEEL_SLOT_MASK]) != ECL_TIMER_NO_TIMER)
+  {
+    struct ecl_timer_config* ptimer = &pcontext->ptimers[id];
 
+    ecl_timer_wheel_remove(pcontext, id);
+
+    if (ptimer->expiry != pcontext->time)
+    {
+      // Placed before a wrap of the time. Not due yet.
+      ecl_timer_wheel_insert(pcontext, id);
+      continue;
+    }
+
+    if (ptimer->repeating)
+    {
+      // Reinsert the timer.
+      ptimer->expiry = pcontext->time + ptimer->period;
+      ecl_timer_wheel_insert(pcontext, id);
+    }
+
+    if (ptimer->pcallback != 0)
+    {
+      void (*pcallback)() = ptimer->pcallback;
+
+      // Call the C callback.
+      ECL_TIMER_CONTEXT_RELEASE(pcontext);
+      (pcallback)();
+      ECL_TIMER_CONTEXT_ACQUIRE(pcontext);
+    }
+  }
+}
+
+//*******************************
+static ecl_timer_result_t ecl_timer_wheel_stop(struct ecl_timer_context* pcontext, ecl_timer_id_t id_)
+{
+  ecl_timer_result_t result = ECL_TIMER_FAIL;
+
+  // Valid timer id?
+  if ((id_ != ECL_TIMER_NO_TIMER) && (id_ < pcontext->max_timers))
+  {
+    struct ecl_timer_config* ptimer = &pcontext->ptimers[id_];
+
+    // Registered timer?
+    if (ptimer->id != ECL_TIMER_NO_TIMER)
+    {
+      if (ptimer->slot != ECL_TIMER_NO_SLOT)
+      {
+        ecl_timer_wheel_remove(pcontext, id_);
+      }
+
+      result = ECL_TIMER_PASS;
+    }
+  }
+
+  return result;
+}
+
+//*****************************************************************************
+// Timer Context
+//*****************************************************************************
+
+//*******************************************
+/// Initialises a timer context.
+//*******************************************
+void ecl_timer_context_init(struct ecl_timer_context* pcontext_, struct ecl_timer_config* ptimers_, uint_least8_t max_timers_)
+{
+  assert(pcontext_ != 0);
+  assert(ptimers_ != 0);
+  assert(max_timers_ < ECL_TIMER_NO_TIMER);
+
+  pcontext_->ptimers           = ptimers_;
+  pcontext_->max_timers        = max_timers_;
+  pcontext_->enabled           = 0;
+  pcontext_->registered_timers = 0;
+  pcontext_->time              = 0;
+
+#if defined(ECL_TIMER_CONTEXT_LOCK_TYPE)
+  ECL_TIMER_CONTEXT_LOCK_INIT(pcontext_->lock);
+#endif
+
+  int i;
+  for (i = 0; i < max_timers_; ++i)
+  {
+    ecl_timer_data_init_default(&pcontext_->ptimers[i]);
+  }
+
+  ecl_timer_wheel_clear(pcontext_);
+}
+
+//*******************************************
+/// Register a timer.
+//*******************************************
+ecl_timer_id_t ecl_timer_context_register(struct ecl_timer_context* pcontext_,
+                                          void                      (*pcallback_)(),
+                                          ecl_timer_time_t          period_,
+                                          ecl_timer_mode_t          repeating_)
+{
+  assert(pcontext_ != 0);
+  assert(pcallback_ != 0);
+
+  ecl_timer_id_t id = ECL_TIMER_NO_TIMER;
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+
+  int is_space = (pcontext_->registered_timers < pcontext_->max_timers);
+
+  if (is_space)
+  {
+    // Search for the free space.
+    uint_least8_t i;
+    for (i = 0; i < pcontext_->max_timers; ++i)
+    {
+      struct ecl_timer_config* ptimer = &pcontext_->ptimers[i];
+
+      if (ptimer->id == ECL_TIMER_NO_TIMER)
+      {
+        // Create in-place.
+        ecl_timer_data_init(ptimer, i, pcallback_, period_, repeating_);
+        ++pcontext_->registered_timers;
+        id = i;
+        break;
+      }
+    }
+  }
+
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+  return id;
+}
+
+//*******************************************
+/// Unregister a timer.
+//*******************************************
+ecl_timer_result_t ecl_timer_context_unregister(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_)
+{
+  assert(pcontext_ != 0);
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+
+  ecl_timer_result_t result = ecl_timer_wheel_stop(pcontext_, id_);
+
+  if (result == ECL_TIMER_PASS)
+  {
+    // Reset in-place.
+    ecl_timer_data_init_default(&pcontext_->ptimers[id_]);
+    --pcontext_->registered_timers;
+  }
+
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+  return result;
+}
+
+//*******************************************
+/// Enable/disable the timer context.
+//*******************************************
+void ecl_timer_context_enable(struct ecl_timer_context* pcontext_, ecl_timer_enable_t state_)
+{
+  assert(pcontext_ != 0);
+  assert((state_ == ECL_TIMER_ENABLED) || (state_ == ECL_TIMER_DISABLED));
+
+  pcontext_->enabled = state_;
+}
+
+//*******************************************
+/// Get the enable/disable state.
+//*******************************************
+ecl_timer_result_t ecl_timer_context_is_running(struct ecl_timer_context* pcontext_)
+{
+  assert(pcontext_ != 0);
+
+  return pcontext_->enabled;
+}
+
+//*******************************************
+/// Clears the timer context of data.
+//*******************************************
+void ecl_timer_context_clear(struct ecl_timer_context* pcontext_)
+{
+  assert(pcontext_ != 0);
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+
+  ecl_timer_wheel_clear(pcontext_);
+
+  int i;
+  for (i = 0; i < pcontext_->max_timers; ++i)
+  {
+    ecl_timer_data_init_default(&pcontext_->ptimers[i]);
+  }
+
+  pcontext_->registered_timers = 0;
+
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+}
+
+//*******************************************
+// Called by the timer service to indicate the
+// amount of time that has elapsed since the last successful call to 'tick'.
+// Returns true if the tick was processed, false if not.
+//*******************************************
+ecl_timer_result_t ecl_timer_context_tick(struct ecl_timer_context* pcontext_, uint32_t count)
+{
+  assert(pcontext_ != 0);
+
+  if (pcontext_->enabled)
+  {
+    ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+
+    // Timers started with no delay since the last tick.
+    ecl_timer_wheel_process_due(pcontext_);
+
+    // Step from one occupied slot to the next.
+    while ((count != 0) && (pcontext_->active_timers != 0))
+    {
+      uint32_t step = ecl_timer_wheel_ticks_to_next_slot(pcontext_);
+
+      if (step > count)
+      {
+        step = count;
+      }
+
+      ecl_timer_wheel_advance(pcontext_, step);
+      count -= step;
+
+      ecl_timer_wheel_process_due(pcontext_);
+    }
+
+    // Nothing left to expire.
+    ecl_timer_wheel_advance(pcontext_, count);
+
+    ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+    return ECL_TIMER_PASS;
+  }
+
+  return ECL_TIMER_FAIL;
+}
+
+//*******************************************
+/// The number of ticks until the next timer expires,
+/// or ECL_TIMER_INACTIVE if there are no active timers.
+//*******************************************
+ecl_timer_time_t ecl_timer_context_time_to_next_expiry(struct ecl_timer_context* pcontext_)
+{
+  assert(pcontext_ != 0);
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+  ecl_timer_time_t ticks = ecl_timer_wheel_ticks_to_next_expiry(pcontext_);
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+  return ticks;
+}
+
+//*******************************************
+/// Starts a timer
+//*******************************************
+ecl_timer_result_t ecl_timer_context_start(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_, ecl_timer_start_t immediate_)
+{
+  assert(pcontext_ != 0);
+
+  ecl_timer_result_t result = ECL_TIMER_FAIL;
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+
+  // Valid timer id?
+  if ((id_ != ECL_TIMER_NO_TIMER) && (id_ < pcontext_->max_timers))
+  {
+    struct ecl_timer_config* ptimer = &pcontext_->ptimers[id_];
+
+    // Registered timer?
+    if (ptimer->id != ECL_TIMER_NO_TIMER)
+    {
+      // Has a valid period.
+      if (ptimer->period != ECL_TIMER_INACTIVE)
+      {
+        if (ptimer->slot != ECL_TIMER_NO_SLOT)
+        {
+          ecl_timer_wheel_remove(pcontext_, id_);
+        }
+
+        ptimer->expiry = pcontext_->time + (immediate_ ? 0 : ptimer->period);
+        ecl_timer_wheel_insert(pcontext_, id_);
+
+        result = ECL_TIMER_PASS;
+      }
+    }
+  }
+
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+  return result;
+}
+
+//*******************************************
+/// Stops a timer
+//*******************************************
+ecl_timer_result_t ecl_timer_context_stop(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_)
+{
+  assert(pcontext_ != 0);
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+  ecl_timer_result_t result = ecl_timer_wheel_stop(pcontext_, id_);
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+  return result;
+}
+
+//*******************************************
+/// Sets a timer's period.
+//*******************************************
+ecl_timer_result_t ecl_timer_context_set_period(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_, ecl_timer_time_t period_)
+{
+  assert(pcontext_ != 0);
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+
+  ecl_timer_result_t result = ecl_timer_wheel_stop(pcontext_, id_);
+
+  if (result == ECL_TIMER_PASS)
+  {
+    pcontext_->ptimers[id_].period = period_;
+  }
+
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+  return result;
+}
+
+//*******************************************
+/// Sets a timer's mode.
+//*******************************************
+ecl_timer_result_t ecl_timer_context_set_mode(struct ecl_timer_context* pcontext_, ecl_timer_id_t id_, ecl_timer_mode_t repeating_)
+{
+  assert(pcontext_ != 0);
+
+  ECL_TIMER_CONTEXT_ACQUIRE(pcontext_);
+
+  ecl_timer_result_t result = ecl_timer_wheel_stop(pcontext_, id_);
+
+  if (result == ECL_TIMER_PASS)
+  {
+    pcontext_->ptimers[id_].repeating = repeating_;
+  }
+
+  ECL_TIMER_CONTEXT_RELEASE(pcontext_);
+
+  return result;
+}
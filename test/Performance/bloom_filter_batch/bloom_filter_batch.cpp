@@ -0,0 +1,113 @@
+// bloom_filter_batch.cpp : Compares bloom_filter with blocked_bloom_filter exists and exists_batch.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include bloom_filter_batch.cpp
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <random>
+
+#include "etl/bloom_filter.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+// Independent 64 bit mixes of the key.
+template <const uint64_t SEED>
+struct mix_hash
+{
+  typedef uint64_t argument_type;
+
+  size_t operator ()(argument_type key) const
+  {
+    key ^= SEED;
+    key = (key ^ (key >> 33)) * 0xFF51AFD7ED558CCDULL;
+    key = (key ^ (key >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+    return size_t(key ^ (key >> 33));
+  }
+};
+
+const size_t WIDTH      = 1U << 26; // 8MB of flags, well outside of the cache.
+const size_t KEYS       = 4000000;
+const size_t QUERIES    = 8000000;
+const size_t BURSTSIZE  = 64;
+
+typedef etl::bloom_filter<WIDTH, mix_hash<1>, mix_hash<2>, mix_hash<3> > Bloom;
+typedef etl::blocked_bloom_filter<WIDTH, mix_hash<4> >                   BlockedBloom;
+
+Bloom        bloom;
+BlockedBloom blocked_bloom;
+
+int main()
+{
+  std::mt19937_64 random(1);
+
+  for (size_t i = 0; i < KEYS; ++i)
+  {
+    uint64_t key = random();
+    bloom.add(key);
+    blocked_bloom.add(key);
+  }
+
+  std::vector<uint64_t> queries;
+
+  for (size_t i = 0; i < QUERIES; ++i)
+  {
+    queries.push_back(random());
+  }
+
+  size_t found = 0;
+  uint64_t time;
+
+  StartTimer();
+
+  for (size_t i = 0; i < QUERIES; ++i)
+  {
+    found += bloom.exists(queries[i]) ? 1 : 0;
+  }
+
+  time = StopTimer();
+  std::cout << "bloom_filter::exists               Time = " << time / 1000 << "ms  False positives = " << found << "\n";
+
+  found = 0;
+  StartTimer();
+
+  for (size_t i = 0; i < QUERIES; ++i)
+  {
+    found += blocked_bloom.exists(queries[i]) ? 1 : 0;
+  }
+
+  time = StopTimer();
+  std::cout << "blocked_bloom_filter::exists       Time = " << time / 1000 << "ms  False positives = " << found << "\n";
+
+  bool results[BURSTSIZE];
+  found = 0;
+  StartTimer();
+
+  for (size_t i = 0; i < QUERIES; i += BURSTSIZE)
+  {
+    blocked_bloom.exists_batch(queries.begin() + i, queries.begin() + i + BURSTSIZE, results);
+
+    for (size_t j = 0; j < BURSTSIZE; ++j)
+    {
+      found += results[j] ? 1 : 0;
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "blocked_bloom_filter::exists_batch Time = " << time / 1000 << "ms  False positives = " << found << "\n";
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+// callback_timer_wheel.cpp : Compares etl::callback_timer_wheel with the
+// delta list etl::callback_timer as the number of active timers grows.
+// Every tick, a quarter of the timers are restarted.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -DETL_CALLBACK_TIMER_USE_ATOMIC_LOCK -I../.. -I../../../include callback_timer_wheel.cpp
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#include "etl/callback_timer.h"
+#include "etl/callback_timer_wheel.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const uint32_t TICKS = 100000;
+
+uint32_t expiries;
+
+void Callback()
+{
+  ++expiries;
+}
+
+//*********************************
+// Runs 'n_timers' repeating timers for TICKS ticks.
+// Returns the number of expiries.
+template <typename TController>
+uint32_t Run(TController& controller, int n_timers)
+{
+  uint32_t seed = 1;
+
+  controller.clear();
+
+  for (int i = 0; i < n_timers; ++i)
+  {
+    seed = (seed * 1103515245U) + 12345U;
+
+    etl::timer::id::type id = controller.register_timer(Callback, 10U + ((seed >> 8) % 1000U), etl::timer::mode::REPEATING);
+    controller.start(id);
+  }
+
+  controller.enable(true);
+  expiries = 0;
+
+  for (uint32_t tick = 0; tick < TICKS; ++tick)
+  {
+    for (int i = 0; i < (n_timers / 4); ++i)
+    {
+      seed = (seed * 1103515245U) + 12345U;
+      controller.start(etl::timer::id::type((seed >> 8) % n_timers));
+    }
+
+    controller.tick(1);
+  }
+
+  return expiries;
+}
+
+int main()
+{
+  static etl::callback_timer<250>       list_controller;
+  static etl::callback_timer_wheel<250> wheel_controller;
+
+  const int counts[] = { 16, 64, 128, 250 };
+
+  for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i)
+  {
+    uint64_t time;
+
+    StartTimer();
+    const uint32_t list_expiries = Run(list_controller, counts[i]);
+    time = StopTimer();
+    std::cout << counts[i] << " timers, callback_timer       Time = " << time / 1000 << "ms\n";
+
+    StartTimer();
+    const uint32_t wheel_expiries = Run(wheel_controller, counts[i]);
+    time = StopTimer();
+    std::cout << counts[i] << " timers, callback_timer_wheel Time = " << time / 1000 << "ms\n";
+
+    if (list_expiries != wheel_expiries)
+    {
+      std::cout << "Expiries FAILED\n";
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+// deque_block.cpp : Compares filling and draining an etl::deque of bytes in blocks,
+// one item at a time and with the bulk push_back and pop_front.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include deque_block.cpp
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#include "etl/deque.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t BLOCK          = 700;
+const size_t TESTITERATIONS = 200000;
+
+uint8_t input[BLOCK];
+uint8_t output[BLOCK];
+
+//*********************************
+template <typename TDeque>
+uint32_t PerItem(TDeque& data)
+{
+  uint32_t checksum = 0;
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < BLOCK; ++j)
+    {
+      data.push_back(input[j]);
+    }
+
+    for (size_t j = 0; j < BLOCK; ++j)
+    {
+      output[j] = data.front();
+      data.pop_front();
+    }
+
+    checksum += output[i % BLOCK];
+  }
+
+  return checksum;
+}
+
+//*********************************
+template <typename TDeque>
+uint32_t Bulk(TDeque& data)
+{
+  uint32_t checksum = 0;
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    data.push_back(input, input + BLOCK);
+    data.pop_front(BLOCK, output);
+
+    checksum += output[i % BLOCK];
+  }
+
+  return checksum;
+}
+
+int main()
+{
+  for (size_t i = 0; i < BLOCK; ++i)
+  {
+    input[i] = uint8_t(i * 7);
+  }
+
+  // A buffer of 4097 bytes wraps with a comparison, one of 4096 with a mask.
+  etl::deque<uint8_t, 4096> compare_wrap;
+  etl::deque<uint8_t, 4095> mask_wrap;
+
+  uint32_t checksum = 0;
+  uint64_t time;
+
+  StartTimer();
+  checksum += PerItem(compare_wrap);
+  time = StopTimer();
+  std::cout << "Per item, compare wrap Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+  checksum += PerItem(mask_wrap);
+  time = StopTimer();
+  std::cout << "Per item, mask wrap    Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+  checksum += Bulk(compare_wrap);
+  time = StopTimer();
+  std::cout << "Bulk,     compare wrap Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+  checksum += Bulk(mask_wrap);
+  time = StopTimer();
+  std::cout << "Bulk,     mask wrap    Time = " << time / 1000 << "ms\n";
+
+  std::cout << "Checksum " << checksum << "\n";
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+// flat_map_index.cpp : Compares flat_map lookups through the pointer lookup table with lookups through the index.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include flat_map_index.cpp
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "etl/flat_map.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t TESTSIZE       = 1000000;
+const size_t TESTITERATIONS = 8;
+
+typedef etl::flat_map<uint32_t, uint32_t, TESTSIZE, std::less<uint32_t>, true> Etlmap;
+
+Etlmap etlmap;
+
+uint64_t Lookup(const std::vector<uint32_t>& keys)
+{
+  uint64_t checksum = 0;
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < keys.size(); ++j)
+    {
+      checksum += etlmap.lower_bound(keys[j])->second;
+    }
+  }
+
+  return checksum;
+}
+
+int main()
+{
+  std::vector<uint32_t> keys;
+
+  // Insert in order, so that filling the map is linear.
+  for (uint32_t j = 0; j < TESTSIZE; ++j)
+  {
+    etlmap.insert(std::make_pair(j * 2, j));
+    keys.push_back(j * 2);
+  }
+
+  // Look the keys up in a random order, so that most of them are not in the cache.
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+
+  uint64_t checksum;
+  uint64_t time;
+
+  StartTimer();
+  checksum = Lookup(keys);
+  time = StopTimer();
+  std::cout << "Binary search Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+  etlmap.rebuild_index();
+  time = StopTimer();
+  std::cout << "rebuild_index Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+  checksum -= Lookup(keys);
+  time = StopTimer();
+  std::cout << "Index search  Time = " << time / 1000 << "ms\n";
+
+  // Both searches find the same values, so the checksum must return to zero.
+  return (checksum == 0) ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+// format_to.cpp : Compares etl::format_to with chained etl::to_string calls and snprintf.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++14 -DPROFILE_GCC_GENERIC -I../.. -I../../../include format_to.cpp
+
+#include <chrono>
+#include <iostream>
+#include <stdio.h>
+
+#include "etl/format.h"
+#include "etl/to_string.h"
+#include "etl/cstring.h"
+#include "etl/format_spec.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const int TESTITERATIONS = 2000000;
+
+int main()
+{
+  etl::string<64> text;
+  size_t   checksum = 0;
+  uint64_t time;
+
+  StartTimer();
+
+  for (int i = 0; i < TESTITERATIONS; ++i)
+  {
+    text.clear();
+    etl::format_to(text, ETL_FORMAT_STRING("{} {:08x} {:.3f}"), i, unsigned(i) * 2654435761U, i * 0.001);
+    checksum += text.size();
+  }
+
+  time = StopTimer();
+  std::cout << "format_to Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (int i = 0; i < TESTITERATIONS; ++i)
+  {
+    text.clear();
+    etl::to_string(i, text, etl::format_spec(), true);
+    text.push_back(' ');
+    etl::to_string(unsigned(i) * 2654435761U, text, etl::format_spec().hex().width(8).fill('0'), true);
+    text.push_back(' ');
+    etl::to_string(i * 0.001, text, etl::format_spec().precision(3), true);
+    checksum -= text.size();
+  }
+
+  time = StopTimer();
+  std::cout << "to_string Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (int i = 0; i < TESTITERATIONS; ++i)
+  {
+    char buffer[64];
+    checksum += size_t(snprintf(buffer, sizeof(buffer), "%d %08x %.3f", i, unsigned(i) * 2654435761U, i * 0.001));
+  }
+
+  time = StopTimer();
+  std::cout << "snprintf  Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (int i = 0; i < TESTITERATIONS; ++i)
+  {
+    char buffer[64];
+    checksum -= size_t(snprintf(buffer, sizeof(buffer), "%d %08x %.3f", i, unsigned(i) * 2654435761U, i * 0.001));
+  }
+
+  time = StopTimer();
+
+  // Both etl versions and both snprintf runs give the same total length.
+  std::cout << (checksum == 0 ? "Checksum OK\n" : "Checksum FAILED\n");
+
+  return 0;
+}
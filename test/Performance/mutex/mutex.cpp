@@ -0,0 +1,127 @@
+// mutex.cpp : Compares the etl::mutex implementations as the number of
+// threads contending for one short critical section grows.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -DETL_MUTEX_STATISTICS -I../.. -I../../../include mutex.cpp -lpthread
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+
+#include "etl/mutex.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const int ITERATIONS = 1000000;
+
+//*********************************
+// Runs 'n_threads' threads incrementing a shared counter under the lock.
+// Returns the final count.
+template <typename TMutex>
+int64_t Run(TMutex& mutex, int n_threads)
+{
+  std::atomic<bool> start(false);
+  int64_t           count = 0;
+  std::vector<std::thread> threads;
+
+  const int per_thread = ITERATIONS / n_threads;
+
+  for (int t = 0; t < n_threads; ++t)
+  {
+    threads.push_back(std::thread([&mutex, &start, &count, per_thread]()
+    {
+      while (!start.load());
+
+      for (int i = 0; i < per_thread; ++i)
+      {
+        mutex.lock();
+        ++count;
+        mutex.unlock();
+      }
+    }));
+  }
+
+  start.store(true);
+
+  for (size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+
+  return count;
+}
+
+//*********************************
+template <typename TMutex>
+void Report(const char* name, int n_threads)
+{
+  static TMutex mutex;
+
+  StartTimer();
+  const int64_t count = Run(mutex, n_threads);
+  const uint64_t time = StopTimer();
+
+  std::cout << n_threads << " threads, " << name << " Time = " << time / 1000 << "ms";
+
+#if defined(ETL_MUTEX_STATISTICS)
+  std::cout << ", spins = " << mutex.get_statistics().spins
+            << ", parks = " << mutex.get_statistics().parks;
+  mutex.clear_statistics();
+#endif
+
+  std::cout << std::endl;
+
+  if (count != (ITERATIONS / n_threads) * n_threads)
+  {
+    std::cout << "Count FAILED\n";
+  }
+}
+
+//*********************************
+// A std::mutex with the same interface as the statistics enabled mutexes.
+struct std_mutex
+{
+  void lock()   { mutex.lock(); }
+  void unlock() { mutex.unlock(); }
+
+#if defined(ETL_MUTEX_STATISTICS)
+  etl::mutex_statistics get_statistics() const { return etl::mutex_statistics(); }
+  void clear_statistics() {}
+#endif
+
+  std::mutex mutex;
+};
+
+int main()
+{
+  // The spin and ticket locks are not intended for more threads than cores.
+  // A preempted ticket holder stalls every waiter behind it.
+  const int max_threads = int(std::thread::hardware_concurrency());
+
+  for (int threads = 1; threads <= max_threads; threads *= 2)
+  {
+    Report<std_mutex>       ("std::mutex       ", threads);
+    Report<etl::spin_mutex> ("etl::spin_mutex  ", threads);
+    Report<etl::ticket_mutex>("etl::ticket_mutex", threads);
+#if defined(__linux__)
+    Report<etl::futex_mutex>("etl::futex_mutex ", threads);
+#endif
+  }
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+// queue_mpmc.cpp : Compares etl::queue_mpmc_atomic with etl::queue_mpmc_mutex
+// as the number of producer and consumer threads grows.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include queue_mpmc.cpp -lpthread
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+
+#include "etl/queue_mpmc_atomic.h"
+#include "etl/queue_mpmc_mutex.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const int ITEMS = 2000000;
+
+//*********************************
+// Runs 'producers' threads pushing and the same number popping.
+// Returns the sum of the popped values.
+template <typename TQueue>
+int64_t Run(TQueue& queue, int producers)
+{
+  std::atomic<bool>    start(false);
+  std::atomic<int64_t> total(0);
+  std::vector<std::thread> threads;
+
+  const int per_thread = ITEMS / producers;
+
+  for (int t = 0; t < producers; ++t)
+  {
+    threads.push_back(std::thread([&queue, &start, per_thread]()
+    {
+      while (!start.load());
+
+      for (int i = 0; i < per_thread; ++i)
+      {
+        while (!queue.push(i))
+        {
+          std::this_thread::yield();
+        }
+      }
+    }));
+
+    threads.push_back(std::thread([&queue, &start, &total, per_thread]()
+    {
+      int64_t sum = 0;
+
+      while (!start.load());
+
+      for (int i = 0; i < per_thread; ++i)
+      {
+        int value;
+
+        while (!queue.pop(value))
+        {
+          std::this_thread::yield();
+        }
+
+        sum += value;
+      }
+
+      total += sum;
+    }));
+  }
+
+  start.store(true);
+
+  for (size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+
+  return total.load();
+}
+
+int main()
+{
+  static etl::queue_mpmc_atomic<int, 1024> atomic_queue;
+  static etl::queue_mpmc_mutex<int, 1024>  mutex_queue;
+
+  for (int threads = 2; threads <= 16; threads *= 2)
+  {
+    const int producers = threads / 2;
+    uint64_t  time;
+
+    StartTimer();
+    const int64_t atomic_sum = Run(atomic_queue, producers);
+    time = StopTimer();
+    std::cout << threads << " threads, queue_mpmc_atomic Time = " << time / 1000 << "ms\n";
+
+    StartTimer();
+    const int64_t mutex_sum = Run(mutex_queue, producers);
+    time = StopTimer();
+    std::cout << threads << " threads, queue_mpmc_mutex  Time = " << time / 1000 << "ms\n";
+
+    if (atomic_sum != mutex_sum)
+    {
+      std::cout << "Checksum FAILED\n";
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,143 @@
+// queue_spsc_atomic.cpp : Measures etl::queue_spsc_atomic throughput between a
+// producer and a consumer thread, one item at a time and in batches.
+// Pin the threads to separate cores for representative figures.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include queue_spsc_atomic.cpp -lpthread
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <stdint.h>
+
+#include "etl/queue_spsc_atomic.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const uint32_t ITEMS = 20000000;
+const uint32_t BATCH = 32;
+
+etl::queue_spsc_atomic<uint32_t, 1024> queue;
+
+//*********************************
+uint64_t PerItem()
+{
+  std::thread producer([]()
+  {
+    for (uint32_t i = 0; i < ITEMS; ++i)
+    {
+      while (!queue.push(i))
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t sum = 0;
+  uint32_t count = 0;
+
+  while (count < ITEMS)
+  {
+    uint32_t value;
+
+    if (queue.pop(value))
+    {
+      sum += value;
+      ++count;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+
+  return sum;
+}
+
+//*********************************
+uint64_t Batched()
+{
+  std::thread producer([]()
+  {
+    uint32_t input[BATCH];
+    uint32_t next = 0;
+
+    while (next < ITEMS)
+    {
+      uint32_t n = 0;
+
+      while ((n < BATCH) && ((next + n) < ITEMS))
+      {
+        input[n] = next + n;
+        ++n;
+      }
+
+      uint32_t pushed = queue.push(input, input + n);
+
+      if (pushed == 0)
+      {
+        std::this_thread::yield();
+      }
+
+      next += pushed;
+    }
+  });
+
+  uint64_t sum = 0;
+  uint32_t count = 0;
+  uint32_t output[BATCH];
+
+  while (count < ITEMS)
+  {
+    uint32_t n = queue.pop(output, BATCH);
+
+    if (n == 0)
+    {
+      std::this_thread::yield();
+    }
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += output[i];
+    }
+
+    count += n;
+  }
+
+  producer.join();
+
+  return sum;
+}
+
+int main()
+{
+  uint64_t time;
+
+  StartTimer();
+  const uint64_t sum1 = PerItem();
+  time = StopTimer();
+  std::cout << "Per item Time = " << time / 1000 << "ms, " << (ITEMS / (time ? time : 1)) << "M items/s\n";
+
+  StartTimer();
+  const uint64_t sum2 = Batched();
+  time = StopTimer();
+  std::cout << "Batched  Time = " << time / 1000 << "ms, " << (ITEMS / (time ? time : 1)) << "M items/s\n";
+
+  std::cout << ((sum1 == sum2) ? "Checksum OK\n" : "Checksum FAILED\n");
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+// scheduler_ready_queue.cpp : Compares the polling scheduler policies with
+// the event driven ready queue policy when few of many tasks have work.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include scheduler_ready_queue.cpp
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+
+#include "etl/scheduler.h"
+#include "etl/function.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t   N_TASKS    = 256;
+const uint32_t WORK_ITEMS = 1000000;
+
+class Task;
+
+Task*    tasks[N_TASKS];
+uint32_t remaining;
+uint32_t seed;
+
+//*********************************
+// Each work item hands the next one to a pseudo random task, so only one
+// task has work at a time.
+class Task : public etl::task
+{
+public:
+
+  Task(etl::task_priority_t priority)
+    : task(priority),
+      work(0)
+  {
+  }
+
+  uint32_t task_request_work() const
+  {
+    return work;
+  }
+
+  void task_process_work()
+  {
+    --work;
+
+    if (--remaining != 0)
+    {
+      seed = (seed * 1103515245U) + 12345U;
+
+      Task& next = *tasks[(seed >> 16) % N_TASKS];
+      ++next.work;
+      next.task_signal_ready();
+    }
+  }
+
+  uint32_t work;
+};
+
+//*********************************
+template <typename TScheduler>
+void Run(const char* name)
+{
+  static TScheduler scheduler;
+
+  struct Exit
+  {
+    void Idle()
+    {
+      scheduler.exit_scheduler();
+    }
+  } exit;
+
+  etl::function<Exit, void> idle_callback(exit, &Exit::Idle);
+
+  for (size_t i = 0; i < N_TASKS; ++i)
+  {
+    tasks[i] = new Task(etl::task_priority_t(i));
+    scheduler.add_task(*tasks[i]);
+  }
+
+  remaining = WORK_ITEMS;
+  seed      = 1;
+  tasks[0]->work = 1;
+
+  scheduler.set_idle_callback(idle_callback);
+
+  StartTimer();
+  scheduler.start();
+  const uint64_t time = StopTimer();
+
+  std::cout << name << " Time = " << time / 1000 << "ms\n";
+
+  if (remaining != 0)
+  {
+    std::cout << "Work FAILED\n";
+  }
+
+  for (size_t i = 0; i < N_TASKS; ++i)
+  {
+    delete tasks[i];
+  }
+}
+
+int main()
+{
+  Run<etl::scheduler<etl::scheduler_policy_highest_priority, N_TASKS> >      ("highest_priority ");
+  Run<etl::scheduler<etl::scheduler_policy_sequencial_single, N_TASKS> >     ("sequencial_single");
+  Run<etl::scheduler<etl::scheduler_policy_ready_queue<N_TASKS>, N_TASKS> >  ("ready_queue      ");
+
+  return 0;
+}
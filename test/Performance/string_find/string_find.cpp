@@ -0,0 +1,108 @@
+// string_find.cpp : Times etl::string find and find_first_of against the generic algorithms.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include string_find.cpp
+// Add -mavx2 to use the 32 byte vector searches, or -DETL_NO_SIMD for the scalar searches.
+
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <random>
+
+#include "etl/cstring.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t LINES          = 1000;
+const size_t TESTITERATIONS = 2000;
+
+etl::string<256> lines[LINES];
+
+int main()
+{
+  std::mt19937 random(1);
+  const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789 :.-";
+
+  // Log like lines, with the searched for text near the end.
+  for (size_t i = 0; i < LINES; ++i)
+  {
+    while (lines[i].size() < 230)
+    {
+      lines[i].push_back(alphabet[random() % (sizeof(alphabet) - 1)]);
+    }
+
+    lines[i].append("ERROR=1;");
+  }
+
+  const char needle[] = "ERROR=";
+  const char set[]    = "=;|";
+  size_t checksum = 0;
+  uint64_t time;
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < LINES; ++j)
+    {
+      checksum += std::search(lines[j].begin(), lines[j].end(), needle, needle + 6) - lines[j].begin();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "std::search         Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < LINES; ++j)
+    {
+      checksum -= lines[j].find(needle);
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "find                Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < LINES; ++j)
+    {
+      checksum += std::find_first_of(lines[j].begin(), lines[j].end(), set, set + 3) - lines[j].begin();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "std::find_first_of  Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < LINES; ++j)
+    {
+      checksum -= lines[j].find_first_of(set);
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "find_first_of       Time = " << time / 1000 << "ms\n";
+
+  // Both pairs of loops find the same positions, so the checksum must return to zero.
+  return (checksum == 0) ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// to_arithmetic.cpp : Compares etl::to_arithmetic with strtoll and strtod.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include to_arithmetic.cpp
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "etl/to_arithmetic.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t VALUES         = 10000;
+const size_t TESTITERATIONS = 200;
+
+int main()
+{
+  std::mt19937_64 random(1);
+  std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+  std::vector<std::string> integers;
+  std::vector<std::string> doubles;
+
+  for (size_t i = 0; i < VALUES; ++i)
+  {
+    char buffer[40];
+
+    snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(random() >> (random() % 64)));
+    integers.push_back(buffer);
+
+    snprintf(buffer, sizeof(buffer), "%.*g", int(random() % 17) + 1, mantissa(random) * ((i % 3 == 0) ? 0.001 : ((i % 3 == 1) ? 1.0 : 100000.0)));
+    doubles.push_back(buffer);
+  }
+
+  int64_t  checksum   = 0;
+  double   etl_sum    = 0.0;
+  double   strtod_sum = 0.0;
+  uint64_t time;
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      checksum += etl::to_arithmetic<int64_t>(integers[j].data(), integers[j].size()).value();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "to_arithmetic<int64_t> Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      checksum -= strtoll(integers[j].c_str(), 0, 10);
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "strtoll                Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      etl_sum += etl::to_arithmetic<double>(doubles[j].data(), doubles[j].size()).value();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "to_arithmetic<double>  Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      strtod_sum += strtod(doubles[j].c_str(), 0);
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "strtod                 Time = " << time / 1000 << "ms\n";
+
+  // Both conversions give the same values, so the checksum returns to zero and the sums match.
+  return ((checksum == 0) && (etl_sum == strtod_sum)) ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// to_string_float.cpp : Times floating point formatting with etl::to_string.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include to_string_float.cpp
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <stdio.h>
+
+#include "etl/to_string.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t VALUES         = 10000;
+const size_t TESTITERATIONS = 200;
+
+int main()
+{
+  std::mt19937_64 random(1);
+  std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+  std::vector<double> values;
+
+  // Metric-like values, from a thousandth to a million.
+  for (size_t i = 0; i < VALUES; ++i)
+  {
+    values.push_back(mantissa(random) * ((i % 3 == 0) ? 0.001 : ((i % 3 == 1) ? 1.0 : 100000.0)));
+  }
+
+  etl::string<40> str;
+  size_t checksum = 0;
+  uint64_t time;
+
+  const etl::format_spec fixed = etl::format_spec().precision(6);
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      etl::to_string(values[j], str, fixed);
+      checksum += str.size();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "precision 6 Time = " << time / 1000 << "ms\n";
+
+  const etl::format_spec shortest = etl::format_spec().shortest(true);
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      etl::to_string(values[j], str, shortest);
+      checksum += str.size();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "shortest    Time = " << time / 1000 << "ms\n";
+
+  char buffer[40];
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      checksum += snprintf(buffer, sizeof(buffer), "%.6f", values[j]);
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "snprintf %f Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      checksum += snprintf(buffer, sizeof(buffer), "%.17g", values[j]);
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "snprintf %g Time = " << time / 1000 << "ms\n";
+
+  return (checksum != 0) ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// to_string_integral.cpp : Times decimal and hexadecimal integral formatting with etl::to_string.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include to_string_integral.cpp
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <stdio.h>
+
+#include "etl/to_string.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t VALUES         = 10000;
+const size_t TESTITERATIONS = 500;
+
+int main()
+{
+  std::mt19937_64 random(1);
+  std::vector<int64_t> values;
+
+  // A spread of magnitudes, as in telemetry.
+  for (size_t i = 0; i < VALUES; ++i)
+  {
+    values.push_back(int64_t(random() >> (random() % 64)) * ((i % 2) ? 1 : -1));
+  }
+
+  etl::string<32> str;
+  size_t checksum = 0;
+  uint64_t time;
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      etl::to_string(values[j], str);
+      checksum += str.size();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "decimal          Time = " << time / 1000 << "ms\n";
+
+  const etl::format_spec padded = etl::format_spec().width(24).fill('0');
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      etl::to_string(values[j], str, padded);
+      checksum += str.size();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "decimal width 24 Time = " << time / 1000 << "ms\n";
+
+  const etl::format_spec hex = etl::format_spec().hex();
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      etl::to_string(uint64_t(values[j]), str, hex);
+      checksum += str.size();
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "hex              Time = " << time / 1000 << "ms\n";
+
+  char buffer[32];
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < VALUES; ++j)
+    {
+      checksum += snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(values[j]));
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "snprintf         Time = " << time / 1000 << "ms\n";
+
+  return (checksum != 0) ? 0 : 1;
+}
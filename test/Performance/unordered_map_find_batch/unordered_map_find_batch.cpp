@@ -0,0 +1,98 @@
+// unordered_map_find_batch.cpp : Compares find_batch with a loop of single find calls.
+//
+// Build from this directory with, for example:
+//   g++ -O2 -std=c++11 -DPROFILE_GCC_GENERIC -I../.. -I../../../include unordered_map_find_batch.cpp
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "etl/unordered_map.h"
+
+std::chrono::high_resolution_clock::time_point begin;
+
+void StartTimer()
+{
+  begin = std::chrono::high_resolution_clock::now();
+}
+
+uint64_t StopTimer()
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+const size_t TESTSIZE       = 1000000;
+const size_t BURSTSIZE      = 64;
+const size_t TESTITERATIONS = 16;
+
+typedef etl::unordered_map<uint32_t, uint32_t, TESTSIZE> Etlmap;
+
+Etlmap etlmap;
+
+int main()
+{
+  std::vector<uint32_t> keys;
+
+  for (uint32_t j = 0; j < TESTSIZE; ++j)
+  {
+    etlmap.insert(std::make_pair(j, j));
+    keys.push_back(j);
+  }
+
+  // Look the keys up in a random order, so that most buckets and nodes are not in the cache.
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+
+  Etlmap::iterator results[BURSTSIZE];
+  uint64_t checksum = 0;
+  uint64_t time;
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < TESTSIZE; j += BURSTSIZE)
+    {
+      size_t n = std::min(BURSTSIZE, TESTSIZE - j);
+
+      for (size_t k = 0; k < n; ++k)
+      {
+        results[k] = etlmap.find(keys[j + k]);
+      }
+
+      for (size_t k = 0; k < n; ++k)
+      {
+        checksum += results[k]->second;
+      }
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "find       Time = " << time / 1000 << "ms\n";
+
+  StartTimer();
+
+  for (size_t i = 0; i < TESTITERATIONS; ++i)
+  {
+    for (size_t j = 0; j < TESTSIZE; j += BURSTSIZE)
+    {
+      size_t n = std::min(BURSTSIZE, TESTSIZE - j);
+
+      etlmap.find_batch(keys.begin() + j, keys.begin() + j + n, results);
+
+      for (size_t k = 0; k < n; ++k)
+      {
+        checksum -= results[k]->second;
+      }
+    }
+  }
+
+  time = StopTimer();
+  std::cout << "find_batch Time = " << time / 1000 << "ms\n";
+
+  // Both loops visit the same values, so the checksum must return to zero.
+  return (checksum == 0) ? 0 : 1;
+}
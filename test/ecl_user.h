@@ -39,10 +39,20 @@ extern uint32_t timer_semaphore;
   #define ECL_TIMER_DISABLE_PROCESSING InterlockedIncrement((volatile long*)&timer_semaphore)
   #define ECL_TIMER_ENABLE_PROCESSING  InterlockedDecrement((volatile long*)&timer_semaphore)
   #define ECL_TIMER_PROCESSING_ENABLED (InterlockedAdd((volatile long*)&timer_semaphore, 0) == 0)
+
+  #define ECL_TIMER_CONTEXT_LOCK_TYPE       volatile long
+  #define ECL_TIMER_CONTEXT_LOCK_INIT(lock) ((lock) = 0)
+  #define ECL_TIMER_CONTEXT_LOCK(lock)      while (InterlockedExchange(&(lock), 1) != 0) {}
+  #define ECL_TIMER_CONTEXT_UNLOCK(lock)    InterlockedExchange(&(lock), 0)
 #else
   #define ECL_TIMER_DISABLE_PROCESSING __sync_fetch_and_add(&timer_semaphore, 1)
   #define ECL_TIMER_ENABLE_PROCESSING  __sync_fetch_and_sub(&timer_semaphore, 1)
   #define ECL_TIMER_PROCESSING_ENABLED (__sync_fetch_and_add(&timer_semaphore, 0) == 0)
+
+  #define ECL_TIMER_CONTEXT_LOCK_TYPE       volatile int
+  #define ECL_TIMER_CONTEXT_LOCK_INIT(lock) ((lock) = 0)
+  #define ECL_TIMER_CONTEXT_LOCK(lock)      while (__sync_lock_test_and_set(&(lock), 1) != 0) {}
+  #define ECL_TIMER_CONTEXT_UNLOCK(lock)    __sync_lock_release(&(lock))
 #endif
 
 #endif
@@ -44,12 +44,20 @@ SOFTWARE.
 #define ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK
 
 #define ETL_POLYMORPHIC_BITSET
+#define ETL_POLYMORPHIC_BTREE
+#define ETL_POLYMORPHIC_BTREE_MAP
+#define ETL_POLYMORPHIC_BTREE_MULTIMAP
+#define ETL_POLYMORPHIC_BTREE_SET
+#define ETL_POLYMORPHIC_BTREE_MULTISET
 #define ETL_POLYMORPHIC_DEQUE
 #define ETL_POLYMORPHIC_FLAT_MAP
 #define ETL_POLYMORPHIC_FLAT_MULTIMAP
 #define ETL_POLYMORPHIC_FLAT_SET
 #define ETL_POLYMORPHIC_FLAT_MULTISET
+#define ETL_POLYMORPHIC_FLAT_UNORDERED_MAP
+#define ETL_POLYMORPHIC_FLAT_UNORDERED_SET
 #define ETL_POLYMORPHIC_FORWARD_LIST
+#define ETL_POLYMORPHIC_INDEXED_PRIORITY_QUEUE
 #define ETL_POLYMORPHIC_LIST
 #define ETL_POLYMORPHIC_MAP
 #define ETL_POLYMORPHIC_MULTIMAP
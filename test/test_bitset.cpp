@@ -774,6 +774,89 @@ namespace
       CHECK_EQUAL(4U, data.find_next(true,  1));
     }
 
+    //*************************************************************************
+    TEST(test_find_next_across_elements)
+    {
+      const size_t N = 200;
+
+      etl::bitset<N> data;
+      std::bitset<N> compare;
+
+      size_t positions[] = { 3, 63, 64, 65, 127, 128, 150, 199 };
+
+      for (size_t i = 0; i < (sizeof(positions) / sizeof(positions[0])); ++i)
+      {
+        data.set(positions[i]);
+        compare.set(positions[i]);
+      }
+
+      for (size_t start = 0; start <= N; ++start)
+      {
+        size_t expected_set   = etl::ibitset::npos;
+        size_t expected_clear = etl::ibitset::npos;
+
+        for (size_t i = start; i < N; ++i)
+        {
+          if (compare.test(i) && (expected_set == etl::ibitset::npos))
+          {
+            expected_set = i;
+          }
+
+          if (!compare.test(i) && (expected_clear == etl::ibitset::npos))
+          {
+            expected_clear = i;
+          }
+        }
+
+        CHECK_EQUAL(expected_set,   data.find_next(true,  start));
+        CHECK_EQUAL(expected_clear, data.find_next(false, start));
+      }
+
+      // No clear bits must be found in the unused part of the last element.
+      data.set();
+      CHECK_EQUAL(etl::ibitset::npos, data.find_first(false));
+      CHECK_EQUAL(N, data.count());
+    }
+
+    //*************************************************************************
+    struct collect_positions
+    {
+      collect_positions()
+        : count(0)
+      {
+      }
+
+      void operator()(size_t position)
+      {
+        positions[count++] = position;
+      }
+
+      size_t positions[16];
+      size_t count;
+    };
+
+    TEST(test_for_each_set_bit)
+    {
+      etl::bitset<200> data;
+
+      size_t expected[] = { 0, 7, 8, 63, 64, 100, 191, 192, 199 };
+      const size_t n = sizeof(expected) / sizeof(expected[0]);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        data.set(expected[i]);
+      }
+
+      collect_positions result = data.for_each_set_bit(collect_positions());
+
+      CHECK_EQUAL(n, result.count);
+      CHECK_ARRAY_EQUAL(expected, result.positions, n);
+
+      data.reset();
+      result = data.for_each_set_bit(collect_positions());
+      CHECK_EQUAL(0U, result.count);
+    }
+
 
     //*************************************************************************
     TEST(test_swap)
@@ -70,6 +70,26 @@ struct hash3_t
   }
 };
 
+struct hash64_t
+{
+  typedef const char* argument_type;
+
+  uint64_t operator ()(argument_type text) const
+  {
+    return etl::fnv_1a_64(text, text + etl::char_traits<char>::length(text));
+  }
+};
+
+struct int_hash_t
+{
+  typedef uint32_t argument_type;
+
+  size_t operator ()(argument_type value) const
+  {
+    return etl::fnv_1a_32(reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value) + sizeof(value));
+  }
+};
+
 std::vector<const char*> exist_text     = { "The", "rain", "in", "Spain", "falls", "mainly", "on", "the", "plain" };
 std::vector<const char*> not_exist_text = { "My", "hovercraft", "is", "full", "of", "eels" };
 
@@ -260,6 +280,117 @@ namespace
 
       CHECK(!any_exist);
     }
+
+    //*************************************************************************
+    TEST(test_blocked_bloom_filter)
+    {
+      etl::blocked_bloom_filter<1024, hash64_t> bloom;
+
+      CHECK_EQUAL(1024U, bloom.width());
+      CHECK_EQUAL(0U, bloom.count());
+
+      bloom.add(exist_text[0]);
+
+      // One bit in each word of one block.
+      CHECK_EQUAL(size_t(ETL_CACHE_LINE_SIZE / 8), bloom.count());
+
+      for (size_t i = 1; i < exist_text.size(); ++i)
+      {
+        bloom.add(exist_text[i]);
+      }
+
+      // Check for false negatives.
+      bool all_exist = true;
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        all_exist = all_exist && bloom.exists(exist_text[i]);
+      }
+
+      CHECK(all_exist);
+
+      // Check for false positives. There should be none for this set.
+      bool any_exist = false;
+
+      for (size_t i = 0; i < not_exist_text.size(); ++i)
+      {
+        any_exist = any_exist || bloom.exists(not_exist_text[i]);
+      }
+
+      CHECK(!any_exist);
+
+      size_t usage = bloom.usage();
+      CHECK(usage > 0);
+      CHECK(usage < 100);
+
+      bloom.clear();
+      CHECK_EQUAL(0U, bloom.count());
+      CHECK(!bloom.exists(exist_text[0]));
+    }
+
+    //*************************************************************************
+    TEST(test_blocked_bloom_filter_width)
+    {
+      CHECK_EQUAL(512U,  (etl::blocked_bloom_filter<1,    hash64_t>::WIDTH));
+      CHECK_EQUAL(512U,  (etl::blocked_bloom_filter<512,  hash64_t>::WIDTH));
+      CHECK_EQUAL(1024U, (etl::blocked_bloom_filter<513,  hash64_t>::WIDTH));
+      CHECK_EQUAL(4096U, (etl::blocked_bloom_filter<4000, hash64_t>::WIDTH));
+    }
+
+    //*************************************************************************
+    TEST(test_blocked_bloom_filter_block_is_cache_line)
+    {
+      typedef etl::blocked_bloom_filter<1, hash64_t> Bloom;
+
+      CHECK_EQUAL(size_t(ETL_CACHE_LINE_SIZE * 8), size_t(Bloom::WIDTH));
+      CHECK_EQUAL(size_t(ETL_CACHE_LINE_SIZE), sizeof(Bloom));
+    }
+
+    //*************************************************************************
+    TEST(test_blocked_bloom_filter_exists_batch)
+    {
+      // A 32 bit hash, which must still be spread over all of the blocks.
+      etl::blocked_bloom_filter<65536, int_hash_t> bloom;
+
+      std::vector<uint32_t> keys;
+
+      for (uint32_t i = 0; i < 2000; ++i)
+      {
+        keys.push_back(i * 3);
+      }
+
+      for (uint32_t i = 0; i < 2000; i += 2)
+      {
+        bloom.add(keys[i]);
+      }
+
+      std::vector<bool> results(keys.size());
+      std::vector<bool>::iterator end = bloom.exists_batch(keys.begin(), keys.end(), results.begin());
+
+      CHECK(end == results.end());
+
+      size_t false_positives = 0;
+
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        CHECK_EQUAL(bloom.exists(keys[i]), bool(results[i]));
+
+        if ((i % 2) == 0)
+        {
+          CHECK(results[i]);
+        }
+        else if (results[i])
+        {
+          ++false_positives;
+        }
+      }
+
+      // 1000 keys in 128 blocks gives about a 0.1% false positive rate.
+      CHECK(false_positives < 20);
+
+      // The keys must be spread over the blocks.
+      CHECK(bloom.usage() > 5);
+    }
   };
 }
 
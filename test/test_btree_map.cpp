@@ -0,0 +1,424 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <map>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "etl/btree_map.h"
+
+namespace
+{
+  // Large enough for several levels of nodes.
+  static const size_t SIZE = 2000;
+
+  typedef etl::btree_map<int, int, SIZE>  Data;
+  typedef etl::ibtree_map<int, int>       IData;
+  typedef std::map<int, int>              Compare_Data;
+
+  typedef etl::btree_map<std::string, int, 10, std::greater<std::string> > DataString;
+  typedef std::map<std::string, int, std::greater<std::string> >            Compare_DataString;
+
+  //*************************************************************************
+  template <typename T1, typename T2>
+  bool Check_Equal(const T1& lhs, const T2& rhs)
+  {
+    return (lhs.size() == rhs.size()) &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin()) &&
+           std::equal(lhs.rbegin(), lhs.rend(), rhs.rbegin());
+  }
+
+  //*************************************************************************
+  // A simple repeatable sequence of pseudo random numbers.
+  struct Random
+  {
+    Random()
+      : value(12345)
+    {
+    }
+
+    int operator()(int range)
+    {
+      value = (value * 1103515245U) + 12345U;
+      return int((value >> 16) % unsigned(range));
+    }
+
+    unsigned value;
+  };
+
+  SUITE(test_btree_map)
+  {
+    //*************************************************************************
+    struct SetupFixture
+    {
+      std::vector<std::pair<int, int> > initial_data;
+
+      SetupFixture()
+      {
+        Random random;
+
+        Compare_Data unique;
+
+        while (unique.size() < SIZE)
+        {
+          int key = random(10 * int(SIZE));
+          unique[key] = key * 2;
+        }
+
+        initial_data.assign(unique.begin(), unique.end());
+        std::reverse(initial_data.begin(), initial_data.end());
+        std::swap(initial_data.front(), initial_data[SIZE / 2]);
+      }
+    };
+
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      Data data;
+
+      CHECK_EQUAL(0U, data.size());
+      CHECK(data.empty());
+      CHECK(!data.full());
+      CHECK_EQUAL(SIZE, data.max_size());
+      CHECK_EQUAL(SIZE, data.capacity());
+      CHECK_EQUAL(SIZE, data.available());
+      CHECK(data.begin() == data.end());
+      CHECK(data.rbegin() == data.rend());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_constructor_range)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.full());
+      CHECK_EQUAL(0U, data.available());
+      CHECK(Check_Equal(data, compare_data));
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    TEST(test_constructor_initializer_list)
+    {
+      Compare_Data compare_data = { { 3, 30 }, { 1, 10 }, { 2, 20 } };
+      Data data = { { 3, 30 }, { 1, 10 }, { 2, 20 } };
+
+      CHECK(Check_Equal(data, compare_data));
+    }
+#endif
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_copy_constructor_and_assignment)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      Data copy(data);
+
+      CHECK(Check_Equal(copy, data));
+
+      Data other;
+      other[1] = 1;
+      other = data;
+
+      CHECK(Check_Equal(other, data));
+
+      IData& iother = other;
+      iother = iother;
+
+      CHECK(Check_Equal(other, data));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_index_and_at)
+    {
+      Compare_Data compare_data;
+      Data data;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        data[initial_data[i].first]         = initial_data[i].second;
+        compare_data[initial_data[i].first] = initial_data[i].second;
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+
+      const Data& cdata = data;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        CHECK_EQUAL(initial_data[i].second, data.at(initial_data[i].first));
+        CHECK_EQUAL(initial_data[i].second, cdata.at(initial_data[i].first));
+      }
+
+      CHECK_THROW(data.at(-1), etl::btree_out_of_bounds);
+      CHECK_THROW(cdata.at(-1), etl::btree_out_of_bounds);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert)
+    {
+      Compare_Data compare_data;
+      Data data;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        std::pair<Data::iterator, bool> result = data.insert(initial_data[i]);
+        compare_data.insert(initial_data[i]);
+
+        CHECK(result.second);
+        CHECK_EQUAL(initial_data[i].first, result.first->first);
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+
+      // Duplicates are not inserted, even when full.
+      std::pair<Data::iterator, bool> result = data.insert(std::make_pair(initial_data[0].first, -1));
+
+      CHECK(!result.second);
+      CHECK_EQUAL(initial_data[0].second, result.first->second);
+      CHECK(Check_Equal(data, compare_data));
+
+      CHECK_THROW(data.insert(std::make_pair(-1, -1)), etl::btree_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_hint_and_range)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data;
+
+      data.insert(initial_data.begin(), initial_data.begin() + 10);
+      data.insert(data.cbegin(), initial_data[10]);
+      data.insert(initial_data.begin() + 11, initial_data.end());
+
+      CHECK(Check_Equal(data, compare_data));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_find_and_count)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      const Data& cdata = data;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        Data::iterator       itr  = data.find(initial_data[i].first);
+        Data::const_iterator citr = cdata.find(initial_data[i].first);
+
+        CHECK(itr != data.end());
+        CHECK(citr != cdata.end());
+        CHECK_EQUAL(initial_data[i].second, itr->second);
+        CHECK_EQUAL(initial_data[i].second, citr->second);
+        CHECK_EQUAL(1U, data.count(initial_data[i].first));
+      }
+
+      CHECK(data.find(-1) == data.end());
+      CHECK(cdata.find(10 * int(SIZE)) == cdata.end());
+      CHECK_EQUAL(0U, data.count(-1));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_bounds)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+      const Data& cdata = data;
+
+      for (int key = -1; key <= (10 * int(SIZE)); ++key)
+      {
+        Compare_Data::iterator lower = compare_data.lower_bound(key);
+        Compare_Data::iterator upper = compare_data.upper_bound(key);
+
+        CHECK_EQUAL(std::distance(compare_data.begin(), lower), std::distance(data.begin(), data.lower_bound(key)));
+        CHECK_EQUAL(std::distance(compare_data.begin(), upper), std::distance(data.begin(), data.upper_bound(key)));
+        CHECK_EQUAL(std::distance(compare_data.begin(), lower), std::distance(cdata.begin(), cdata.lower_bound(key)));
+        CHECK_EQUAL(std::distance(compare_data.begin(), upper), std::distance(cdata.begin(), cdata.upper_bound(key)));
+
+        std::pair<Data::iterator, Data::iterator> range = data.equal_range(key);
+
+        CHECK(range.first  == data.lower_bound(key));
+        CHECK(range.second == data.upper_bound(key));
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_key)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      for (size_t i = 0; i < initial_data.size(); i += 2)
+      {
+        CHECK_EQUAL(compare_data.erase(initial_data[i].first), data.erase(initial_data[i].first));
+      }
+
+      CHECK_EQUAL(0U, data.erase(-1));
+      CHECK(Check_Equal(data, compare_data));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_while_iterating)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      Data::iterator         itr         = data.begin();
+      Compare_Data::iterator compare_itr = compare_data.begin();
+
+      while (itr != data.end())
+      {
+        if ((itr->first % 3) != 0)
+        {
+          itr         = data.erase(itr);
+          compare_itr = compare_data.erase(compare_itr);
+        }
+        else
+        {
+          ++itr;
+          ++compare_itr;
+        }
+
+        CHECK_EQUAL(compare_itr == compare_data.end(), itr == data.end());
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_range)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      Compare_Data::iterator compare_first = compare_data.begin();
+      Compare_Data::iterator compare_last  = compare_data.begin();
+      std::advance(compare_first, 100);
+      std::advance(compare_last, 1500);
+
+      Data::iterator first = data.begin();
+      Data::iterator last  = data.begin();
+      std::advance(first, 100);
+      std::advance(last, 1500);
+
+      Compare_Data::iterator compare_next = compare_data.erase(compare_first, compare_last);
+      Data::iterator next = data.erase(first, last);
+
+      CHECK_EQUAL(compare_next->first, next->first);
+      CHECK(Check_Equal(data, compare_data));
+
+      data.erase(data.begin(), data.end());
+
+      CHECK(data.empty());
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_clear)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      data.clear();
+
+      CHECK_EQUAL(0U, data.size());
+      CHECK(data.begin() == data.end());
+
+      // The nodes are all available again.
+      data.assign(initial_data.begin(), initial_data.end());
+
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST(test_random_insert_erase)
+    {
+      Random random;
+      Compare_Data compare_data;
+      Data data;
+
+      for (int i = 0; i < 50000; ++i)
+      {
+        int key = random(3 * int(SIZE));
+
+        if ((random(3) != 0) && !data.full())
+        {
+          data[key] = i;
+          compare_data[key] = i;
+        }
+        else
+        {
+          CHECK_EQUAL(compare_data.erase(key), data.erase(key));
+        }
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+    }
+
+    //*************************************************************************
+    TEST(test_compare_function)
+    {
+      Compare_DataString compare_data;
+      DataString data;
+
+      const char* keys[] = { "D", "A", "C", "E", "B" };
+
+      for (int i = 0; i < 5; ++i)
+      {
+        data[keys[i]] = i;
+        compare_data[keys[i]] = i;
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+      CHECK(data.key_comp()("B", "A"));
+      CHECK(data.value_comp()(*data.find("B"), *data.find("A")));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_relational_operators)
+    {
+      Data data1(initial_data.begin(), initial_data.end());
+      Data data2(initial_data.begin(), initial_data.end());
+
+      CHECK(data1 == data2);
+      CHECK(!(data1 != data2));
+      CHECK(data1 <= data2);
+      CHECK(data1 >= data2);
+
+      data2.begin()->second += 1;
+
+      CHECK(data1 != data2);
+      CHECK(data1 < data2);
+      CHECK(data2 > data1);
+      CHECK(!(data1 >= data2));
+    }
+  };
+}
@@ -0,0 +1,178 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "etl/btree_multiset.h"
+
+namespace
+{
+  static const size_t SIZE = 2000;
+
+  typedef etl::btree_multiset<int, SIZE> Data;
+  typedef etl::ibtree_multiset<int>      IData;
+  typedef std::multiset<int>             Compare_Data;
+
+  //*************************************************************************
+  template <typename T1, typename T2>
+  bool Check_Equal(const T1& lhs, const T2& rhs)
+  {
+    return (lhs.size() == rhs.size()) &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin()) &&
+           std::equal(lhs.rbegin(), lhs.rend(), rhs.rbegin());
+  }
+
+  //*************************************************************************
+  // A simple repeatable sequence of pseudo random numbers.
+  struct Random
+  {
+    Random()
+      : value(4242)
+    {
+    }
+
+    int operator()(int range)
+    {
+      value = (value * 1103515245U) + 12345U;
+      return int((value >> 16) % unsigned(range));
+    }
+
+    unsigned value;
+  };
+
+  SUITE(test_btree_multiset)
+  {
+    //*************************************************************************
+    struct SetupFixture
+    {
+      std::vector<int> initial_data;
+
+      SetupFixture()
+      {
+        Random random;
+
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+          initial_data.push_back(random(40));
+        }
+      }
+    };
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert)
+    {
+      Compare_Data compare_data;
+      Data data;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        CHECK_EQUAL(initial_data[i], *data.insert(initial_data[i]));
+        compare_data.insert(initial_data[i]);
+      }
+
+      CHECK(data.full());
+      CHECK(Check_Equal(data, compare_data));
+      CHECK_THROW(data.insert(0), etl::btree_full);
+
+      Data copy(data);
+      CHECK(copy == data);
+
+      Data other;
+      IData& iother = other;
+      iother = data;
+      CHECK(other == data);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_equal_range_and_count)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      for (int key = -1; key <= 41; ++key)
+      {
+        CHECK_EQUAL(compare_data.count(key), data.count(key));
+        CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(data.begin(), data.equal_range(key).first));
+        CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(data.begin(), data.equal_range(key).second));
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      for (int key = 0; key < 40; key += 3)
+      {
+        CHECK_EQUAL(compare_data.erase(key), data.erase(key));
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+
+      data.erase(data.lower_bound(10), data.upper_bound(20));
+      compare_data.erase(compare_data.lower_bound(10), compare_data.upper_bound(20));
+
+      CHECK(Check_Equal(data, compare_data));
+
+      data.erase(data.begin(), data.end());
+      CHECK(data.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_random_insert_erase)
+    {
+      Random random;
+      Compare_Data compare_data;
+      Data data;
+
+      for (int i = 0; i < 50000; ++i)
+      {
+        int key = random(200);
+
+        if ((random(4) != 0) && !data.full())
+        {
+          data.insert(key);
+          compare_data.insert(key);
+        }
+        else if (data.find(key) != data.end())
+        {
+          data.erase(data.find(key));
+          compare_data.erase(compare_data.find(key));
+        }
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+    }
+  };
+}
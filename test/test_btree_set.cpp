@@ -0,0 +1,261 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "etl/btree_set.h"
+
+namespace
+{
+  static const size_t SIZE = 2000;
+
+  typedef etl::btree_set<int, SIZE>  Data;
+  typedef etl::ibtree_set<int>       IData;
+  typedef std::set<int>              Compare_Data;
+
+  //*************************************************************************
+  template <typename T1, typename T2>
+  bool Check_Equal(const T1& lhs, const T2& rhs)
+  {
+    return (lhs.size() == rhs.size()) &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin()) &&
+           std::equal(lhs.rbegin(), lhs.rend(), rhs.rbegin());
+  }
+
+  //*************************************************************************
+  // A simple repeatable sequence of pseudo random numbers.
+  struct Random
+  {
+    Random()
+      : value(54321)
+    {
+    }
+
+    int operator()(int range)
+    {
+      value = (value * 1103515245U) + 12345U;
+      return int((value >> 16) % unsigned(range));
+    }
+
+    unsigned value;
+  };
+
+  SUITE(test_btree_set)
+  {
+    //*************************************************************************
+    struct SetupFixture
+    {
+      std::vector<int> initial_data;
+
+      SetupFixture()
+      {
+        Random random;
+
+        Compare_Data unique;
+
+        while (unique.size() < SIZE)
+        {
+          unique.insert(random(10 * int(SIZE)));
+        }
+
+        initial_data.assign(unique.begin(), unique.end());
+        std::reverse(initial_data.begin(), initial_data.end());
+      }
+    };
+
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      Data data;
+
+      CHECK_EQUAL(0U, data.size());
+      CHECK(data.empty());
+      CHECK_EQUAL(SIZE, data.max_size());
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_constructor_range_and_copy)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.full());
+      CHECK(Check_Equal(data, compare_data));
+
+      Data copy(data);
+      CHECK(copy == data);
+
+      Data other;
+      IData& iother = other;
+      iother = data;
+      CHECK(Check_Equal(other, compare_data));
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    TEST(test_constructor_initializer_list)
+    {
+      Compare_Data compare_data = { 3, 1, 2, 1 };
+      Data data = { 3, 1, 2, 1 };
+
+      CHECK(Check_Equal(data, compare_data));
+    }
+#endif
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert)
+    {
+      Data data;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        std::pair<Data::iterator, bool> result = data.insert(initial_data[i]);
+
+        CHECK(result.second);
+        CHECK_EQUAL(initial_data[i], *result.first);
+      }
+
+      std::pair<Data::iterator, bool> result = data.insert(initial_data[0]);
+      CHECK(!result.second);
+      CHECK_EQUAL(initial_data[0], *result.first);
+
+      CHECK_THROW(data.insert(-1), etl::btree_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_find_and_bounds)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+      const Data& cdata = data;
+
+      for (int key = -1; key <= (10 * int(SIZE)); ++key)
+      {
+        CHECK_EQUAL(compare_data.count(key), data.count(key));
+        CHECK_EQUAL(compare_data.find(key) == compare_data.end(), cdata.find(key) == cdata.end());
+        CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(data.begin(), data.lower_bound(key)));
+        CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(cdata.begin(), cdata.upper_bound(key)));
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(initial_data.begin(), initial_data.end());
+
+      // By key.
+      for (size_t i = 0; i < initial_data.size(); i += 3)
+      {
+        CHECK_EQUAL(compare_data.erase(initial_data[i]), data.erase(initial_data[i]));
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+
+      // By iterator.
+      Data::iterator         itr         = data.begin();
+      Compare_Data::iterator compare_itr = compare_data.begin();
+
+      while (itr != data.end())
+      {
+        if ((*itr % 2) == 0)
+        {
+          itr = data.erase(itr);
+          compare_data.erase(compare_itr++);
+        }
+        else
+        {
+          ++itr;
+          ++compare_itr;
+        }
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+
+      // By range.
+      Data::iterator last = data.begin();
+      std::advance(last, data.size() / 2);
+      data.erase(data.cbegin(), last);
+
+      Compare_Data::iterator compare_last = compare_data.begin();
+      std::advance(compare_last, compare_data.size() / 2);
+      compare_data.erase(compare_data.begin(), compare_last);
+
+      CHECK(Check_Equal(data, compare_data));
+
+      data.clear();
+      CHECK(data.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_random_insert_erase)
+    {
+      Random random;
+      Compare_Data compare_data;
+      Data data;
+
+      for (int i = 0; i < 50000; ++i)
+      {
+        int key = random(3 * int(SIZE));
+
+        if ((random(3) != 0) && !data.full())
+        {
+          CHECK_EQUAL(compare_data.insert(key).second, data.insert(key).second);
+        }
+        else
+        {
+          CHECK_EQUAL(compare_data.erase(key), data.erase(key));
+        }
+      }
+
+      CHECK(Check_Equal(data, compare_data));
+    }
+
+    //*************************************************************************
+    TEST(test_compare_function)
+    {
+      etl::btree_set<std::string, 10, std::greater<std::string> > data;
+      std::set<std::string, std::greater<std::string> > compare_data;
+
+      const char* keys[] = { "D", "A", "C", "E", "B" };
+
+      data.insert(keys, keys + 5);
+      compare_data.insert(keys, keys + 5);
+
+      CHECK(Check_Equal(data, compare_data));
+      CHECK(data.value_comp()("B", "A"));
+    }
+  };
+}
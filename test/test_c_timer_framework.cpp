@@ -42,6 +42,7 @@ extern "C"
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <atomic>
 
 #if defined(ETL_COMPILER_MICROSOFT)
 #include <Windows.h>
@@ -627,6 +628,288 @@ namespace
       CHECK_ARRAY_EQUAL(compare1.data(), callback_list1.data(), compare1.size());
     }
 
+    //=========================================================================
+    TEST(ecl_timer_context_independent_contexts)
+    {
+      struct ecl_timer_config timers1[NTIMERS];
+      struct ecl_timer_config timers2[NTIMERS];
+      struct ecl_timer_context context1;
+      struct ecl_timer_context context2;
+
+      ecl_timer_context_init(&context1, timers1, NTIMERS);
+      ecl_timer_context_init(&context2, timers2, NTIMERS);
+
+      ecl_timer_id_t id1 = ecl_timer_context_register(&context1, callback1, 37, ECL_TIMER_SINGLE_SHOT);
+      ecl_timer_id_t id2 = ecl_timer_context_register(&context1, callback2, 23, ECL_TIMER_REPEATING);
+      ecl_timer_id_t id3 = ecl_timer_context_register(&context2, callback3, 11, ECL_TIMER_REPEATING);
+
+      CHECK(id1 != ECL_TIMER_NO_TIMER);
+      CHECK(id2 != ECL_TIMER_NO_TIMER);
+      CHECK(id3 != ECL_TIMER_NO_TIMER);
+
+      callback_list1.clear();
+      callback_list2.clear();
+      callback_list3.clear();
+
+      CHECK_EQUAL(ECL_TIMER_INACTIVE, ecl_timer_context_time_to_next_expiry(&context1));
+
+      ecl_timer_context_start(&context1, id1, ECL_TIMER_START_DELAYED);
+      ecl_timer_context_start(&context1, id2, ECL_TIMER_START_DELAYED);
+      ecl_timer_context_start(&context2, id3, ECL_TIMER_START_IMMEDIATE);
+
+      CHECK(ecl_timer_is_active(&timers1[id1]));
+      CHECK_EQUAL(23U, ecl_timer_context_time_to_next_expiry(&context1));
+
+      // Not enabled.
+      CHECK(!ecl_timer_context_tick(&context2, 1));
+
+      ecl_timer_context_enable(&context1, ECL_TIMER_ENABLED);
+      ecl_timer_context_enable(&context2, ECL_TIMER_ENABLED);
+
+      ticks = 0;
+
+      while (ticks <= 100U)
+      {
+        // Steps of 1 and 7.
+        const uint32_t step = ((ticks % 2U) == 0U) ? 1U : 7U;
+
+        ticks += step;
+        ecl_timer_context_tick(&context1, step);
+        ecl_timer_context_tick(&context2, step);
+
+        if (ticks == 49U)
+        {
+          ecl_timer_context_stop(&context2, id3);
+        }
+      }
+
+      std::vector<uint64_t> compare1 = { 40 };
+      std::vector<uint64_t> compare2 = { 24, 48, 72, 96 };
+      std::vector<uint64_t> compare3 = { 1, 16, 24, 33, 48 };
+
+      CHECK_EQUAL(compare1.size(), callback_list1.size());
+      CHECK_EQUAL(compare2.size(), callback_list2.size());
+      CHECK_EQUAL(compare3.size(), callback_list3.size());
+      CHECK_ARRAY_EQUAL(compare1.data(), callback_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), callback_list2.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), callback_list3.data(), compare3.size());
+
+      CHECK(!ecl_timer_is_active(&timers1[id1]));
+      CHECK(ecl_timer_context_unregister(&context1, id2));
+      CHECK(!ecl_timer_context_start(&context1, id2, ECL_TIMER_START_DELAYED));
+      CHECK_EQUAL(ECL_TIMER_INACTIVE, ecl_timer_context_time_to_next_expiry(&context1));
+    }
+
+    //=========================================================================
+    TEST(ecl_timer_context_next_expiry_wraps)
+    {
+      struct ecl_timer_config  timers[NTIMERS];
+      struct ecl_timer_context context;
+
+      ecl_timer_context_init(&context, timers, NTIMERS);
+
+      ecl_timer_id_t id1 = ecl_timer_context_register(&context, callback1, 0xFFFFFFF0U, ECL_TIMER_SINGLE_SHOT);
+      ecl_timer_id_t id2 = ecl_timer_context_register(&context, callback2, 0x200U,      ECL_TIMER_SINGLE_SHOT);
+
+      ecl_timer_context_enable(&context, ECL_TIMER_ENABLED);
+      ecl_timer_context_tick(&context, 0x50U);
+
+      // The expiry of id1 wraps to 0x40, a lower level of the wheel than id2.
+      ecl_timer_context_start(&context, id1, ECL_TIMER_START_DELAYED);
+      ecl_timer_context_start(&context, id2, ECL_TIMER_START_DELAYED);
+
+      CHECK_EQUAL(0x200U, ecl_timer_context_time_to_next_expiry(&context));
+
+      ecl_timer_context_stop(&context, id2);
+      CHECK_EQUAL(0xFFFFFFF0U, ecl_timer_context_time_to_next_expiry(&context));
+    }
+
+    //=========================================================================
+    TEST(ecl_timer_context_next_expiry_wraps_same_level)
+    {
+      struct ecl_timer_config  timers[NTIMERS];
+      struct ecl_timer_context context;
+
+      ecl_timer_context_init(&context, timers, NTIMERS);
+
+      ecl_timer_id_t id1 = ecl_timer_context_register(&context, callback1, 0xFFFFFEECU, ECL_TIMER_SINGLE_SHOT);
+      ecl_timer_id_t id2 = ecl_timer_context_register(&context, callback2, 0x661EU,     ECL_TIMER_REPEATING);
+
+      ecl_timer_context_enable(&context, ECL_TIMER_ENABLED);
+
+      ecl_timer_context_tick(&context, 0xF4D481D0U);
+      ecl_timer_context_start(&context, id1, ECL_TIMER_START_DELAYED);
+
+      // The expiry of id1 wraps to 0xF4D480BC, in a nearer level 3 slot than
+      // the expiry of id2 at 0xF4D5CE3C.
+      ecl_timer_context_tick(&context, 0xF4D5681EU - 0xF4D481D0U);
+      ecl_timer_context_start(&context, id2, ECL_TIMER_START_DELAYED);
+
+      CHECK_EQUAL(0x661EU, ecl_timer_context_time_to_next_expiry(&context));
+
+      ecl_timer_context_stop(&context, id2);
+      CHECK_EQUAL(0xF4D480BCU - 0xF4D5681EU, ecl_timer_context_time_to_next_expiry(&context));
+    }
+
+    //=========================================================================
+    struct ecl_timer_context  shared_context;
+    struct ecl_timer_config   shared_timers[NTIMERS];
+
+    void callback_starts_timer()
+    {
+      callback_list3.push_back(ticks);
+
+      // The context is not locked during a callback.
+      ecl_timer_context_start(&shared_context, 1, ECL_TIMER_START_DELAYED);
+      ecl_timer_context_set_period(&shared_context, 2, 5);
+      ecl_timer_context_start(&shared_context, 2, ECL_TIMER_START_DELAYED);
+    }
+
+    TEST(ecl_timer_context_timer_starts_timer)
+    {
+      ecl_timer_context_init(&shared_context, shared_timers, NTIMERS);
+
+      ecl_timer_id_t id1 = ecl_timer_context_register(&shared_context, callback_starts_timer, 10, ECL_TIMER_SINGLE_SHOT);
+      ecl_timer_id_t id2 = ecl_timer_context_register(&shared_context, callback1,             20, ECL_TIMER_SINGLE_SHOT);
+      ecl_timer_id_t id3 = ecl_timer_context_register(&shared_context, callback2,             30, ECL_TIMER_SINGLE_SHOT);
+
+      CHECK_EQUAL(1, id2);
+      CHECK_EQUAL(2, id3);
+
+      callback_list1.clear();
+      callback_list2.clear();
+      callback_list3.clear();
+
+      ecl_timer_context_start(&shared_context, id1, ECL_TIMER_START_DELAYED);
+      ecl_timer_context_enable(&shared_context, ECL_TIMER_ENABLED);
+
+      ticks = 0;
+
+      while (ticks < 40U)
+      {
+        ticks += 1;
+        ecl_timer_context_tick(&shared_context, 1);
+      }
+
+      std::vector<uint64_t> compare1 = { 30 };
+      std::vector<uint64_t> compare2 = { 15 };
+      std::vector<uint64_t> compare3 = { 10 };
+
+      CHECK_EQUAL(compare1.size(), callback_list1.size());
+      CHECK_EQUAL(compare2.size(), callback_list2.size());
+      CHECK_EQUAL(compare3.size(), callback_list3.size());
+      CHECK_ARRAY_EQUAL(compare1.data(), callback_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), callback_list2.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), callback_list3.data(), compare3.size());
+    }
+
+    //=========================================================================
+    TEST(ecl_timer_context_compare_with_list)
+    {
+      // The same timers and steps through the static list and a context.
+      const uint32_t periods[NTIMERS] = { 3, 250, 4099 };
+      const uint32_t steps[]          = { 1, 2, 17, 255, 1, 4096, 3, 100, 70000, 1, 5 };
+      const size_t   N_STEPS          = sizeof(steps) / sizeof(steps[0]);
+
+      std::vector<uint64_t> list_results[NTIMERS];
+
+      void (*callbacks[NTIMERS])() = { callback1, callback2, callback3 };
+
+      ecl_timer_init(timers, NTIMERS);
+      callback_list1.clear();
+      callback_list2.clear();
+      callback_list3.clear();
+
+      for (int i = 0; i < NTIMERS; ++i)
+      {
+        ecl_timer_start(ecl_timer_register(callbacks[i], periods[i], ECL_TIMER_REPEATING), ECL_TIMER_START_DELAYED);
+      }
+
+      ecl_timer_enable(ECL_TIMER_ENABLED);
+
+      ticks = 0;
+
+      for (size_t i = 0; i < (N_STEPS * 20); ++i)
+      {
+        ticks += steps[i % N_STEPS];
+        ecl_timer_tick(steps[i % N_STEPS]);
+      }
+
+      list_results[0] = callback_list1;
+      list_results[1] = callback_list2;
+      list_results[2] = callback_list3;
+
+      struct ecl_timer_context context;
+      ecl_timer_context_init(&context, shared_timers, NTIMERS);
+      callback_list1.clear();
+      callback_list2.clear();
+      callback_list3.clear();
+
+      for (int i = 0; i < NTIMERS; ++i)
+      {
+        ecl_timer_context_start(&context, ecl_timer_context_register(&context, callbacks[i], periods[i], ECL_TIMER_REPEATING), ECL_TIMER_START_DELAYED);
+      }
+
+      ecl_timer_context_enable(&context, ECL_TIMER_ENABLED);
+
+      ticks = 0;
+
+      for (size_t i = 0; i < (N_STEPS * 20); ++i)
+      {
+        ticks += steps[i % N_STEPS];
+        ecl_timer_context_tick(&context, steps[i % N_STEPS]);
+      }
+
+      CHECK(list_results[0].size() > 1000U);
+      CHECK(list_results[2].size() > 10U);
+      CHECK(list_results[0] == callback_list1);
+      CHECK(list_results[1] == callback_list2);
+      CHECK(list_results[2] == callback_list3);
+    }
+
+    //=========================================================================
+    TEST(ecl_timer_context_start_stop_from_another_thread)
+    {
+      struct ecl_timer_context context;
+      struct ecl_timer_config  context_timers[NTIMERS];
+
+      ecl_timer_context_init(&context, context_timers, NTIMERS);
+
+      ecl_timer_id_t id1 = ecl_timer_context_register(&context, callback1, 1, ECL_TIMER_REPEATING);
+      ecl_timer_id_t id2 = ecl_timer_context_register(&context, callback2, 3, ECL_TIMER_SINGLE_SHOT);
+
+      callback_list1.clear();
+      callback_list2.clear();
+
+      ecl_timer_context_enable(&context, ECL_TIMER_ENABLED);
+
+      std::atomic<bool> running(true);
+
+      std::thread ticker([&]()
+      {
+        while (running.load())
+        {
+          ecl_timer_context_tick(&context, 1);
+          std::this_thread::yield();
+        }
+      });
+
+      for (int i = 0; i < 10000; ++i)
+      {
+        ecl_timer_context_start(&context, id1, ECL_TIMER_START_DELAYED);
+        ecl_timer_context_start(&context, id2, ECL_TIMER_START_IMMEDIATE);
+        std::this_thread::yield();
+        ecl_timer_context_stop(&context, id1);
+        ecl_timer_context_set_period(&context, id2, uint32_t(i % 7) + 1U);
+      }
+
+      running = false;
+      ticker.join();
+
+      CHECK_EQUAL(ECL_TIMER_INACTIVE, ecl_timer_context_time_to_next_expiry(&context));
+      CHECK_EQUAL(0U, context.active_timers);
+    }
+
     //=========================================================================
 #if REALTIME_TEST
 
@@ -646,6 +646,241 @@ namespace
       CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
     }
 
+    //=========================================================================
+    TEST(callback_timer_tickless)
+    {
+      etl::callback_timer<2> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(free_callback1, 23, etl::timer::mode::REPEATING);
+      etl::timer::id::type id2 = timer_controller.register_timer(free_callback2, 37, etl::timer::mode::SINGLE_SHOT);
+
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.enable(true);
+
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), timer_controller.time_to_next_expiry());
+
+      ticks = 10;
+      CHECK(timer_controller.advance_to(uint32_t(ticks)));
+      CHECK_EQUAL(10U, timer_controller.time());
+
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      CHECK_EQUAL(23U, timer_controller.time_to_next_expiry());
+
+      ticks = 33;
+      CHECK(timer_controller.advance_to(uint32_t(ticks)));
+      CHECK_EQUAL(14U, timer_controller.time_to_next_expiry());
+
+      // All of the expiries due by 'now' in one call.
+      ticks = 100;
+      CHECK(timer_controller.advance_to(uint32_t(ticks)));
+      CHECK_EQUAL(102U - 100U, timer_controller.time_to_next_expiry());
+      CHECK_EQUAL(100U, timer_controller.time());
+
+      std::vector<uint64_t> compare1 = { 33, 100, 100 };
+      std::vector<uint64_t> compare2 = { 100 };
+
+      CHECK_EQUAL(compare1.size(), free_tick_list1.size());
+      CHECK_EQUAL(compare2.size(), free_tick_list2.size());
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list2.data(), compare2.size());
+
+      // Periodic ticks and tickless calls may be mixed.
+      timer_controller.tick(2);
+      CHECK_EQUAL(102U, timer_controller.time());
+      CHECK_EQUAL(4U, free_tick_list1.size());
+      CHECK_EQUAL(23U, timer_controller.time_to_next_expiry());
+
+      timer_controller.stop(id1);
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), timer_controller.time_to_next_expiry());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_posted_commands)
+    {
+      etl::callback_timer<2, 4> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(free_callback1, 10, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id2 = timer_controller.register_timer(free_callback2, 20, etl::timer::mode::REPEATING);
+
+      free_tick_list1.clear();
+      free_tick_list2.clear();
+
+      timer_controller.enable(true);
+
+      ticks = 0;
+
+      // Applied by the next tick. The period is counted from that tick.
+      CHECK(timer_controller.post_start(id1));
+      CHECK(timer_controller.post_start(id2, etl::timer::start::IMMEDIATE));
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), timer_controller.time_to_next_expiry());
+
+      ticks = 5;
+      timer_controller.tick(5);
+      CHECK_EQUAL(1U, free_tick_list2.size());
+      CHECK_EQUAL(10U, timer_controller.time_to_next_expiry());
+
+      // A stop is applied before the expiries of the same tick.
+      // id1 expires during this step.
+      ticks = 24;
+      timer_controller.tick(19);
+      CHECK(timer_controller.post_stop(id2));
+      ticks = 25;
+      timer_controller.tick(1);
+
+      // Re-arm with a new period.
+      CHECK(timer_controller.post_rearm(id2, 7));
+      ticks = 30;
+      timer_controller.tick(5);
+      CHECK_EQUAL(7U, timer_controller.time_to_next_expiry());
+
+      while (ticks < 45)
+      {
+        ++ticks;
+        timer_controller.tick(1);
+      }
+
+      // Changing the period or mode stops the timer.
+      CHECK(timer_controller.post_set_period(id2, 3));
+      CHECK(timer_controller.post_set_mode(id1, etl::timer::mode::REPEATING));
+      ++ticks;
+      timer_controller.tick(1);
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), timer_controller.time_to_next_expiry());
+
+      std::vector<uint64_t> compare1 = { 24 };
+      std::vector<uint64_t> compare2 = { 5, 37, 44 };
+
+      CHECK_EQUAL(compare1.size(), free_tick_list1.size());
+      CHECK_EQUAL(compare2.size(), free_tick_list2.size());
+      CHECK_ARRAY_EQUAL(compare1.data(), free_tick_list1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), free_tick_list2.data(), compare2.size());
+    }
+
+    //=========================================================================
+    TEST(callback_timer_posted_commands_not_processed)
+    {
+      etl::callback_timer<2, 2> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(free_callback1, 10, etl::timer::mode::SINGLE_SHOT);
+
+      // Queue full.
+      CHECK(timer_controller.post_start(id1));
+      CHECK(timer_controller.post_stop(id1));
+      CHECK(!timer_controller.post_start(id1));
+
+      // Invalid id.
+      CHECK(!timer_controller.post_stop(etl::timer::id::NO_TIMER));
+
+      // Held while disabled.
+      timer_controller.tick(1);
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), timer_controller.time_to_next_expiry());
+
+      // Discarded by clear.
+      timer_controller.clear();
+      id1 = timer_controller.register_timer(free_callback1, 10, etl::timer::mode::SINGLE_SHOT);
+      CHECK(timer_controller.post_start(id1));
+      timer_controller.clear();
+      id1 = timer_controller.register_timer(free_callback1, 10, etl::timer::mode::SINGLE_SHOT);
+      timer_controller.enable(true);
+      timer_controller.tick(1);
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), timer_controller.time_to_next_expiry());
+
+      // No command queue.
+      etl::callback_timer<2> no_queue_controller;
+      etl::timer::id::type id2 = no_queue_controller.register_timer(free_callback1, 10, etl::timer::mode::SINGLE_SHOT);
+      CHECK(!no_queue_controller.post_start(id2));
+    }
+
+    //=========================================================================
+    etl::callback_timer<4, 16> posting_controller;
+    etl::atomic<uint32_t> posting_count;
+
+    void posting_callback()
+    {
+      ++posting_count;
+    }
+
+    TEST(callback_timer_posted_commands_threads)
+    {
+      const int N_THREADS = 3;
+      const int N_POSTS   = 10000;
+
+      posting_controller.clear();
+      posting_count = 0;
+
+      etl::timer::id::type ids[N_THREADS];
+
+      for (int i = 0; i < N_THREADS; ++i)
+      {
+        ids[i] = posting_controller.register_timer(posting_callback, 1, etl::timer::mode::SINGLE_SHOT);
+      }
+
+      posting_controller.enable(true);
+
+      etl::atomic<bool> posting(true);
+      uint32_t          posted[N_THREADS] = { 0 };
+
+      std::thread ticker([&]()
+      {
+        while (posting.load() || (posting_controller.time_to_next_expiry() != etl::timer::state::INACTIVE))
+        {
+          posting_controller.tick(1);
+          std::this_thread::yield();
+        }
+
+        // Drain the last of the commands.
+        posting_controller.tick(1);
+        posting_controller.tick(1);
+      });
+
+      std::vector<std::thread> producers;
+
+      for (int i = 0; i < N_THREADS; ++i)
+      {
+        producers.push_back(std::thread([&, i]()
+        {
+          for (int j = 0; j < N_POSTS; ++j)
+          {
+            // Each posted start is followed by the timer's expiry or a posted stop.
+            if ((j % 2) == 0)
+            {
+              if (posting_controller.post_start(ids[i]))
+              {
+                ++posted[i];
+              }
+            }
+            else
+            {
+              posting_controller.post_stop(ids[i]);
+            }
+
+            std::this_thread::yield();
+          }
+        }));
+      }
+
+      for (size_t i = 0; i < producers.size(); ++i)
+      {
+        producers[i].join();
+      }
+
+      posting = false;
+      ticker.join();
+
+      uint32_t total_posted = 0;
+
+      for (int i = 0; i < N_THREADS; ++i)
+      {
+        total_posted += posted[i];
+      }
+
+      CHECK(posting_count.load() <= total_posted);
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), posting_controller.time_to_next_expiry());
+    }
+
     //=========================================================================
 #if REALTIME_TEST
 
@@ -1840,5 +1840,192 @@ namespace
       CHECK(data2.empty());
       CHECK_EQUAL(ACTUAL_SIZE, data3.size());
     }
+
+    //*************************************************************************
+    TEST(test_power_of_two_buffer)
+    {
+      // A buffer of 16 elements wraps with a mask.
+      etl::deque<int, 15> data;
+      std::deque<int>     compare;
+
+      int value = 0;
+
+      for (int cycle = 0; cycle < 50; ++cycle)
+      {
+        for (int i = 0; i < (cycle % 7) + 3; ++i)
+        {
+          if (!data.full())
+          {
+            if ((i % 2) == 0)
+            {
+              data.push_back(value);
+              compare.push_back(value);
+            }
+            else
+            {
+              data.push_front(value);
+              compare.push_front(value);
+            }
+
+            ++value;
+          }
+        }
+
+        for (int i = 0; i < (cycle % 5) + 2; ++i)
+        {
+          if (!data.empty())
+          {
+            if ((i % 2) == 0)
+            {
+              data.pop_front();
+              compare.pop_front();
+            }
+            else
+            {
+              data.pop_back();
+              compare.pop_back();
+            }
+          }
+        }
+
+        CHECK_EQUAL(compare.size(), data.size());
+        CHECK(std::equal(compare.begin(), compare.end(), data.begin()));
+        CHECK(std::equal(compare.rbegin(), compare.rend(), data.rbegin()));
+        CHECK_EQUAL(std::distance(compare.begin(), compare.end()), std::distance(data.begin(), data.end()));
+
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+          CHECK_EQUAL(compare[i], data[i]);
+          CHECK_EQUAL(compare[i], *(data.end() - (data.size() - i)));
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_push_back_range_pop_front_n)
+    {
+      etl::deque<int, 15> data;
+      std::deque<int>     compare;
+
+      int input[12];
+      int output[12];
+      int value = 0;
+
+      for (int cycle = 0; cycle < 40; ++cycle)
+      {
+        const size_t n_in = std::min(size_t(cycle % 12) + 1, data.available());
+
+        for (size_t i = 0; i < n_in; ++i)
+        {
+          input[i] = value++;
+          compare.push_back(input[i]);
+        }
+
+        data.push_back(input, input + n_in);
+
+        CHECK_EQUAL(compare.size(), data.size());
+        CHECK(std::equal(compare.begin(), compare.end(), data.begin()));
+
+        const size_t n_out = std::min(size_t((cycle * 5) % 12), data.size());
+
+        int* end = data.pop_front(n_out, output);
+
+        CHECK_EQUAL(n_out, size_t(end - output));
+        CHECK(std::equal(output, end, compare.begin()));
+
+        compare.erase(compare.begin(), compare.begin() + n_out);
+
+        CHECK_EQUAL(compare.size(), data.size());
+        CHECK(std::equal(compare.begin(), compare.end(), data.begin()));
+      }
+
+      CHECK_THROW(data.push_back(input, input + data.available() + 1), etl::deque_full);
+      CHECK_THROW(data.pop_front(data.size() + 1, output), etl::deque_empty);
+    }
+
+    //*************************************************************************
+    TEST(test_push_back_range_pop_front_n_empty)
+    {
+      etl::deque<int, 15> data;
+
+      const int* input  = nullptr;
+      int*       output = nullptr;
+
+      data.push_back(input, input);
+      CHECK(data.empty());
+
+      CHECK(data.pop_front(0, output) == nullptr);
+      CHECK(data.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_push_back_range_pop_front_n_non_trivial)
+    {
+      DataNDC data;
+      std::vector<NDC> input;
+      std::vector<NDC> output;
+
+      for (int i = 0; i < 10; ++i)
+      {
+        input.push_back(NDC(std::to_string(i)));
+      }
+
+      // Move the front part way through the buffer, so that the items wrap.
+      data.push_back(input.begin(), input.end());
+      data.pop_front(8, std::back_inserter(output));
+      data.push_back(input.begin(), input.end());
+
+      CHECK_EQUAL(12U, data.size());
+      CHECK(std::equal(input.begin(), input.begin() + 8, output.begin()));
+
+      output.clear();
+      data.pop_front(12, std::back_inserter(output));
+
+      CHECK(data.empty());
+      CHECK(std::equal(input.begin() + 8, input.end(), output.begin()));
+      CHECK(std::equal(input.begin(), input.end(), output.begin() + 2));
+    }
+
+    //*************************************************************************
+    TEST(test_array_one_array_two)
+    {
+      DataInt data;
+      const DataInt& cdata = data;
+
+      CHECK_EQUAL(0U, data.array_one().size());
+      CHECK_EQUAL(0U, data.array_two().size());
+
+      for (int i = 0; i < 10; ++i)
+      {
+        data.push_back(i);
+      }
+
+      CHECK_EQUAL(10U, data.array_one().size());
+      CHECK_EQUAL(0U,  data.array_two().size());
+      CHECK(std::equal(data.begin(), data.end(), data.array_one().begin()));
+
+      // Wrap around the end of the buffer.
+      for (int i = 0; i < 8; ++i)
+      {
+        data.pop_front();
+      }
+
+      for (int i = 10; i < 20; ++i)
+      {
+        data.push_back(i);
+      }
+
+      etl::array_view<const int> one = cdata.array_one();
+      etl::array_view<const int> two = cdata.array_two();
+
+      CHECK_EQUAL(data.size(), one.size() + two.size());
+      CHECK(two.size() != 0U);
+      CHECK(std::equal(one.begin(), one.end(), data.begin()));
+      CHECK(std::equal(two.begin(), two.end(), data.begin() + one.size()));
+
+      // Writable spans.
+      data.array_two()[0] = 99;
+      CHECK_EQUAL(99, data[one.size()]);
+    }
   };
 }
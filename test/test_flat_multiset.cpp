@@ -973,5 +973,93 @@ namespace
       CHECK_EQUAL(compare_data.count(N3), data.count(N3));
       CHECK_EQUAL(compare_data.count(N4), data.count(N4));
     }
+
+    //*************************************************************************
+    TEST(test_rebuild_index)
+    {
+      typedef etl::flat_multiset<int, SIZE, std::less<int>, true> Indexed;
+
+      // Every size, so that every shape of index tree is searched.
+      for (size_t n = 0; n <= SIZE; ++n)
+      {
+        std::multiset<int> compare_data;
+        Indexed data;
+
+        for (int i = 0; i < int(n); ++i)
+        {
+          data.insert(i / 2);
+          compare_data.insert(i / 2);
+        }
+
+        CHECK(!data.is_index_valid());
+        data.rebuild_index();
+        CHECK(data.is_index_valid());
+
+        const Indexed& cdata = data;
+
+        for (int key = -1; key <= int(n); ++key)
+        {
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(data.begin(), data.lower_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(data.begin(), data.upper_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(cdata.begin(), cdata.lower_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(cdata.begin(), cdata.upper_bound(key)));
+          CHECK_EQUAL(compare_data.count(key), data.count(key));
+          CHECK_EQUAL(compare_data.find(key) == compare_data.end(), data.find(key) == data.end());
+          CHECK(data.equal_range(key).second == data.upper_bound(key));
+        }
+
+        // Any change discards the index.
+        if (n != 0)
+        {
+          data.erase(data.begin());
+          compare_data.erase(compare_data.begin());
+          CHECK(!data.is_index_valid());
+          CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+          data.rebuild_index();
+          CHECK(data.is_index_valid());
+          CHECK(data.find(*compare_data.begin()) == data.begin());
+        }
+
+        data.clear();
+        CHECK(!data.is_index_valid());
+      }
+
+      // A container without an index ignores rebuild_index.
+      etl::flat_multiset<int, SIZE> plain;
+      plain.rebuild_index();
+      CHECK(!plain.is_index_valid());
+    }
+
+    //*************************************************************************
+    TEST(test_insert_range_merges_with_existing)
+    {
+      // Unsorted, with keys that repeat and keys that are already present.
+      std::vector<int> values;
+
+      for (int i = 0; i < 8; ++i)
+      {
+        values.push_back((i * 5) % 4);
+      }
+
+      int existing[] = { 2, 1 };
+
+      etl::flat_multiset<int, SIZE> data;
+      std::multiset<int> compare_data;
+
+      data.insert(existing[0]);
+      data.insert(existing[1]);
+      compare_data.insert(existing[0]);
+      compare_data.insert(existing[1]);
+
+      // Equal keys follow the existing elements.
+      data.insert(values.begin(), values.end());
+      compare_data.insert(values.begin(), values.end());
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+      CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+      CHECK_THROW(data.insert(values.begin(), values.begin() + 1), etl::flat_multiset_full);
+    }
   };
 }
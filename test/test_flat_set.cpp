@@ -907,5 +907,122 @@ namespace
 
       CHECK(initial1 != different);
     }
+
+    //*************************************************************************
+    TEST(test_rebuild_index)
+    {
+      typedef etl::flat_set<int, SIZE, std::less<int>, true> Indexed;
+
+      // Every size, so that every shape of index tree is searched.
+      for (size_t n = 0; n <= SIZE; ++n)
+      {
+        std::set<int> compare_data;
+        Indexed data;
+
+        for (int i = 0; i < int(n); ++i)
+        {
+          data.insert(i);
+          compare_data.insert(i);
+        }
+
+        CHECK(!data.is_index_valid());
+        data.rebuild_index();
+        CHECK(data.is_index_valid());
+
+        const Indexed& cdata = data;
+
+        for (int key = -1; key <= int(n); ++key)
+        {
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(data.begin(), data.lower_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(data.begin(), data.upper_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(cdata.begin(), cdata.lower_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(cdata.begin(), cdata.upper_bound(key)));
+          CHECK_EQUAL(compare_data.count(key), data.count(key));
+          CHECK_EQUAL(compare_data.find(key) == compare_data.end(), data.find(key) == data.end());
+          CHECK(data.equal_range(key).second == data.upper_bound(key));
+        }
+
+        // Any change discards the index.
+        if (n != 0)
+        {
+          data.erase(data.begin());
+          compare_data.erase(compare_data.begin());
+          CHECK(!data.is_index_valid());
+          CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+          data.rebuild_index();
+          CHECK(data.is_index_valid());
+          CHECK(data.find(*compare_data.begin()) == data.begin());
+        }
+
+        data.clear();
+        CHECK(!data.is_index_valid());
+      }
+
+      // A container without an index ignores rebuild_index.
+      etl::flat_set<int, SIZE> plain;
+      plain.rebuild_index();
+      CHECK(!plain.is_index_valid());
+    }
+
+    //*************************************************************************
+    TEST(test_insert_range_merges_with_existing)
+    {
+      // Unsorted, with keys that repeat and keys that are already present.
+      // There are more values than free space, but few enough distinct keys.
+      std::vector<int> values;
+
+      for (int i = 0; i < 20; ++i)
+      {
+        values.push_back((i * 7) % 9);
+      }
+
+      int existing[] = { 2, 5 };
+
+      etl::flat_set<int, SIZE> data;
+      std::set<int> compare_data;
+
+      data.insert(existing[0]);
+      data.insert(existing[1]);
+      compare_data.insert(existing[0]);
+      compare_data.insert(existing[1]);
+
+      data.insert(values.begin(), values.end());
+      compare_data.insert(values.begin(), values.end());
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+      CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+      // Not enough room for the new keys.
+      std::vector<int> more;
+
+      for (int i = 0; i < 2; ++i)
+      {
+        more.push_back(i + 20);
+      }
+
+      CHECK_THROW(data.insert(more.begin(), more.end()), etl::flat_set_full);
+    }
+
+    //*************************************************************************
+    TEST(test_insert_range_existing_keys_when_full)
+    {
+      etl::flat_set<int, SIZE> data;
+
+      for (int i = 0; i < int(SIZE); ++i)
+      {
+        data.insert(i);
+      }
+
+      // Keys that are already present need no room.
+      std::vector<int> existing = { 1, int(SIZE) - 1, 1 };
+
+      CHECK_NO_THROW(data.insert(existing.begin(), existing.end()));
+      CHECK_EQUAL(SIZE, data.size());
+
+      std::vector<int> more = { 1, int(SIZE) };
+
+      CHECK_THROW(data.insert(more.begin(), more.end()), etl::flat_set_full);
+    }
   };
 }
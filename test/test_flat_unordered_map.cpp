@@ -0,0 +1,547 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <map>
+#include <set>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <numeric>
+
+#include "data.h"
+
+#include "etl/flat_unordered_map.h"
+
+namespace
+{
+  //*************************************************************************
+  struct simple_hash
+  {
+    size_t operator ()(const std::string& text) const
+    {
+      return std::accumulate(text.begin(), text.end(), 0);
+    }
+  };
+
+  //*************************************************************************
+  // Sends every key to the last of 16 slots, so that every run wraps around.
+  // The hash is mixed before it is masked, and 29 mixes to a value ending in 0xF.
+  struct bad_hash
+  {
+    size_t operator ()(int) const
+    {
+      return 29U;
+    }
+  };
+
+  SUITE(test_flat_unordered_map)
+  {
+    static const size_t SIZE = 10;
+
+    typedef TestDataDC<std::string>  DC;
+    typedef TestDataNDC<std::string> NDC;
+
+    typedef std::pair<std::string, DC>  ElementDC;
+    typedef std::pair<std::string, NDC> ElementNDC;
+
+    typedef etl::flat_unordered_map<std::string, DC,  SIZE, simple_hash> DataDC;
+    typedef etl::flat_unordered_map<std::string, NDC, SIZE, simple_hash> DataNDC;
+    typedef etl::iflat_unordered_map<std::string, NDC, simple_hash> IDataNDC;
+
+    typedef etl::flat_unordered_map<int, int, 12, bad_hash> DataCollide;
+
+    NDC N0 = NDC("A");
+    NDC N1 = NDC("B");
+    NDC N2 = NDC("C");
+    NDC N3 = NDC("D");
+    NDC N4 = NDC("E");
+    NDC N5 = NDC("F");
+    NDC N6 = NDC("G");
+    NDC N7 = NDC("H");
+    NDC N8 = NDC("I");
+    NDC N9 = NDC("J");
+    NDC N10 = NDC("K");
+
+    DC M0 = DC("A");
+    DC M1 = DC("B");
+    DC M2 = DC("C");
+    DC M3 = DC("D");
+    DC M4 = DC("E");
+    DC M5 = DC("F");
+    DC M6 = DC("G");
+    DC M7 = DC("H");
+    DC M8 = DC("I");
+    DC M9 = DC("J");
+
+    const char* K0  = "FF"; // 0
+    const char* K1  = "FG"; // 1
+    const char* K2  = "FH"; // 2
+    const char* K3  = "FI"; // 3
+    const char* K4  = "FJ"; // 4
+    const char* K5  = "FK"; // 5
+    const char* K6  = "FL"; // 6
+    const char* K7  = "FM"; // 7
+    const char* K8  = "FN"; // 8
+    const char* K9  = "FO"; // 9
+    const char* K10 = "FP"; // 0
+    const char* K11 = "FQ"; // 1
+
+    std::string K[] = { K0, K1, K2, K3, K4, K5, K6, K7, K8, K9, K10, K11 };
+
+    std::vector<ElementDC> initial_data_dc;
+
+    std::vector<ElementNDC> initial_data;
+    std::vector<ElementNDC> excess_data;
+
+    //*************************************************************************
+    struct SetupFixture
+    {
+      SetupFixture()
+      {
+        ElementNDC n[] =
+        {
+          ElementNDC(K0, N0), ElementNDC(K1, N1), ElementNDC(K2, N2), ElementNDC(K3, N3), ElementNDC(K4, N4),
+          ElementNDC(K5, N5), ElementNDC(K6, N6), ElementNDC(K7, N7), ElementNDC(K8, N8), ElementNDC(K9, N9)
+        };
+
+        ElementNDC n2[] =
+        {
+          ElementNDC(K0, N0), ElementNDC(K1, N1), ElementNDC(K2, N2), ElementNDC(K3, N3), ElementNDC(K4, N4),
+          ElementNDC(K5, N5), ElementNDC(K6, N6), ElementNDC(K7, N7), ElementNDC(K8, N8), ElementNDC(K9, N9),
+          ElementNDC(K10, N10)
+        };
+
+        ElementDC n4[] =
+        {
+          ElementDC(K0, M0), ElementDC(K1, M1), ElementDC(K2, M2), ElementDC(K3, M3), ElementDC(K4, M4),
+          ElementDC(K5, M5), ElementDC(K6, M6), ElementDC(K7, M7), ElementDC(K8, M8), ElementDC(K9, M9)
+        };
+
+        initial_data.assign(std::begin(n), std::end(n));
+        excess_data.assign(std::begin(n2), std::end(n2));
+        initial_data_dc.assign(std::begin(n4), std::end(n4));
+      }
+    };
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_default_constructor)
+    {
+      DataDC data;
+
+      CHECK_EQUAL(data.size(), size_t(0));
+      CHECK(data.empty());
+      CHECK_EQUAL(data.max_size(), SIZE);
+      CHECK_EQUAL(size_t(16), data.bucket_count());
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_constructor_range)
+    {
+      DataDC data(initial_data_dc.begin(), initial_data_dc.end());
+
+      CHECK(data.size() == SIZE);
+      CHECK(!data.empty());
+      CHECK(data.full());
+      CHECK_EQUAL(SIZE, size_t(std::distance(data.begin(), data.end())));
+    }
+
+    //*************************************************************************
+    TEST(test_destruct_via_iflat_unordered_map)
+    {
+      int current_count = NDC::get_instance_count();
+
+      DataNDC* pdata = new DataNDC(initial_data.begin(), initial_data.end());
+
+      IDataNDC* pidata = pdata;
+      delete pidata;
+
+      CHECK_EQUAL(current_count, NDC::get_instance_count());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_assignment)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      DataNDC other_data;
+
+      other_data = data;
+
+      CHECK(data == other_data);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_assignment_interface)
+    {
+      DataNDC data1(initial_data.begin(), initial_data.end());
+      DataNDC data2;
+
+      IDataNDC& idata1 = data1;
+      IDataNDC& idata2 = data2;
+
+      idata2 = idata1;
+
+      CHECK(data1 == data2);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_index_read_write)
+    {
+      DataDC data(initial_data_dc.begin(), initial_data_dc.end());
+
+      CHECK_EQUAL(M0, data[K0]);
+      CHECK_EQUAL(M9, data[K9]);
+
+      data[K0] = M9;
+      data[K9] = M0;
+
+      CHECK_EQUAL(M9, data[K0]);
+      CHECK_EQUAL(M0, data[K9]);
+      CHECK_EQUAL(SIZE, data.size());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_index_inserts)
+    {
+      DataDC data;
+
+      data[K0] = M0;
+      data[K10] = M1; // Same home slot.
+
+      CHECK_EQUAL(2U, data.size());
+      CHECK_EQUAL(M0, data[K0]);
+      CHECK_EQUAL(M1, data[K10]);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_at)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      const DataNDC& cdata = data;
+
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        CHECK_EQUAL(initial_data[i].second, data.at(K[i]));
+        CHECK_EQUAL(initial_data[i].second, cdata.at(K[i]));
+      }
+
+      CHECK_THROW(data.at(K10), etl::flat_unordered_map_out_of_range);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_value)
+    {
+      DataNDC data;
+
+      CHECK(data.insert(DataNDC::value_type(K0,  N0)).second);  // Inserted
+      CHECK(data.insert(DataNDC::value_type(K2,  N2)).second);  // Inserted
+      CHECK(data.insert(DataNDC::value_type(K1,  N1)).second);  // Inserted
+      CHECK(data.insert(DataNDC::value_type(K11, N1)).second);  // Duplicate hash. Inserted
+      CHECK(!data.insert(DataNDC::value_type(K1, N3)).second);  // Duplicate key.  Not inserted
+
+      CHECK_EQUAL(4U, data.size());
+
+      CHECK(data.find(K0)->second == N0);
+      CHECK(data.find(K1)->second == N1);
+      CHECK(data.find(K2)->second == N2);
+      CHECK(data.find(K11)->second == N1);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_range_excess)
+    {
+      DataNDC data;
+
+      CHECK_THROW(data.insert(excess_data.begin(), excess_data.end()), etl::flat_unordered_map_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_emplace)
+    {
+      DataNDC data;
+
+      std::pair<DataNDC::iterator, bool> result = data.emplace(K0, "A");
+      CHECK(result.second);
+      CHECK_EQUAL(N0, result.first->second);
+
+      result = data.emplace(K0, "B");
+      CHECK(!result.second);
+      CHECK_EQUAL(N0, result.first->second);
+
+      result = data.emplace(DataNDC::value_type(K10, N10));
+      CHECK(result.second);
+      CHECK_EQUAL(N10, data.at(K10));
+      CHECK_EQUAL(2U, data.size());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_key)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK_EQUAL(1U, data.erase(K5));
+      CHECK_EQUAL(0U, data.erase(K5));
+      CHECK_EQUAL(SIZE - 1, data.size());
+      CHECK(data.find(K5) == data.end());
+
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        if (i != 5)
+        {
+          CHECK(data.find(K[i]) != data.end());
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_single_iterator)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      DataNDC::iterator idata = data.find(K3);
+      idata = data.erase(idata);
+
+      CHECK_EQUAL(SIZE - 1, data.size());
+      CHECK(data.find(K3) == data.end());
+      CHECK_EQUAL(SIZE - 1, size_t(std::distance(data.begin(), data.end())));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_range)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      DataNDC::iterator first = data.begin();
+      std::advance(first, 2);
+      DataNDC::iterator last = first;
+      std::advance(last, 4);
+
+      std::vector<std::string> erased;
+      for (DataNDC::iterator itr = first; itr != last; ++itr)
+      {
+        erased.push_back(itr->first);
+      }
+
+      data.erase(first, last);
+
+      CHECK_EQUAL(SIZE - 4, data.size());
+
+      for (size_t i = 0; i < erased.size(); ++i)
+      {
+        CHECK(data.find(erased[i]) == data.end());
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_all_while_iterating)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      int current_count = NDC::get_instance_count();
+
+      DataNDC::iterator itr = data.begin();
+      size_t count = 0;
+
+      while (itr != data.end())
+      {
+        itr = data.erase(itr);
+        ++count;
+      }
+
+      CHECK_EQUAL(SIZE, count);
+      CHECK(data.empty());
+      CHECK_EQUAL(current_count - int(SIZE), NDC::get_instance_count());
+    }
+
+    //*************************************************************************
+    TEST(test_wrapped_runs)
+    {
+      DataCollide data;
+
+      for (int i = 0; i < 12; ++i)
+      {
+        data[i] = i * 10;
+      }
+
+      CHECK(data.full());
+
+      // Every element is in one run that wraps from the last slot.
+      int sum = 0;
+      for (DataCollide::const_iterator itr = data.cbegin(); itr != data.cend(); ++itr)
+      {
+        sum += itr->first;
+      }
+
+      CHECK_EQUAL(66, sum);
+
+      // Erase every odd key while iterating.
+      DataCollide::iterator itr = data.begin();
+      size_t visited = 0;
+
+      while (itr != data.end())
+      {
+        ++visited;
+
+        if ((itr->first % 2) != 0)
+        {
+          itr = data.erase(itr);
+        }
+        else
+        {
+          ++itr;
+        }
+      }
+
+      CHECK_EQUAL(12U, visited);
+      CHECK_EQUAL(6U, data.size());
+
+      for (int i = 0; i < 12; ++i)
+      {
+        CHECK_EQUAL(((i % 2) == 0) ? 1U : 0U, data.count(i));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_strided_keys_spread_over_slots)
+    {
+      typedef etl::flat_unordered_map<int, int, 100> Data;
+
+      Data data;
+
+      // etl::hash is the identity for int, so these keys share their low bits.
+      for (int i = 0; i < 100; ++i)
+      {
+        data[i * int(data.max_bucket_count())] = i;
+      }
+
+      std::set<size_t> homes;
+
+      for (Data::const_iterator itr = data.begin(); itr != data.end(); ++itr)
+      {
+        homes.insert(data.get_bucket_index(itr->first));
+      }
+
+      CHECK(homes.size() > 50U);
+
+      for (int i = 0; i < 100; ++i)
+      {
+        CHECK_EQUAL(i, data[i * int(data.max_bucket_count())]);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_against_std_map)
+    {
+      typedef etl::flat_unordered_map<int, int, 100> Data;
+
+      Data data;
+      std::map<int, int> compare;
+
+      unsigned int seed = 1;
+
+      for (int i = 0; i < 10000; ++i)
+      {
+        seed = (seed * 1103515245U) + 12345U;
+        int key = int((seed >> 16) % 150U);
+
+        if (((seed >> 8) & 1U) && !data.full())
+        {
+          data[key] = i;
+          compare[key] = i;
+        }
+        else
+        {
+          CHECK_EQUAL(compare.erase(key), data.erase(key));
+        }
+      }
+
+      CHECK_EQUAL(compare.size(), data.size());
+      CHECK_EQUAL(compare.size(), size_t(std::distance(data.begin(), data.end())));
+
+      for (std::map<int, int>::const_iterator itr = compare.begin(); itr != compare.end(); ++itr)
+      {
+        Data::iterator idata = data.find(itr->first);
+        CHECK(idata != data.end());
+        CHECK_EQUAL(itr->second, idata->second);
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_clear)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      data.clear();
+
+      CHECK_EQUAL(data.size(), size_t(0));
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_count)
+    {
+      const DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK_EQUAL(1U, data.count(K0));
+      CHECK_EQUAL(0U, data.count(K10));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_equal_range)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      std::pair<DataNDC::iterator, DataNDC::iterator> result = data.equal_range(K2);
+      CHECK(result.first == data.find(K2));
+      CHECK_EQUAL(1, std::distance(result.first, result.second));
+
+      result = data.equal_range(K10);
+      CHECK(result.first == data.end());
+      CHECK(result.second == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_equal)
+    {
+      std::vector<ElementNDC> reversed(initial_data.rbegin(), initial_data.rend());
+
+      const DataNDC initial1(initial_data.begin(), initial_data.end());
+      const DataNDC initial2(reversed.begin(), reversed.end());
+
+      CHECK(initial1 == initial2);
+
+      DataNDC different(initial_data.begin(), initial_data.end());
+      different.at(K0) = N5;
+
+      CHECK(initial1 != different);
+    }
+  };
+}
@@ -0,0 +1,304 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "data.h"
+
+#include "etl/flat_unordered_set.h"
+#include "etl/checksum.h"
+
+namespace
+{
+  SUITE(test_flat_unordered_set)
+  {
+    static const size_t SIZE = 10;
+
+    typedef TestDataNDC<std::string> NDC;
+
+    struct simple_hash
+    {
+      size_t operator ()(const NDC& value) const
+      {
+        return etl::checksum<size_t>(value.value.begin(), value.value.end());
+      }
+    };
+
+    typedef etl::flat_unordered_set<NDC, SIZE, simple_hash> DataNDC;
+    typedef etl::iflat_unordered_set<NDC, simple_hash> IDataNDC;
+
+    NDC N0  = NDC("FF");
+    NDC N1  = NDC("FG");
+    NDC N2  = NDC("FH");
+    NDC N3  = NDC("FI");
+    NDC N4  = NDC("FJ");
+    NDC N5  = NDC("FK");
+    NDC N6  = NDC("FL");
+    NDC N7  = NDC("FM");
+    NDC N8  = NDC("FN");
+    NDC N9  = NDC("FO");
+    NDC N10 = NDC("FP");
+    NDC N11 = NDC("FQ");
+
+    std::vector<NDC> initial_data;
+    std::vector<NDC> excess_data;
+
+    //*************************************************************************
+    struct SetupFixture
+    {
+      SetupFixture()
+      {
+        NDC n[] =
+        {
+          N0, N1, N2, N3, N4, N5, N6, N7, N8, N9
+        };
+
+        NDC n2[] =
+        {
+          N0, N1, N2, N3, N4, N5, N6, N7, N8, N9, N10
+        };
+
+        initial_data.assign(std::begin(n), std::end(n));
+        excess_data.assign(std::begin(n2), std::end(n2));
+      }
+    };
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_default_constructor)
+    {
+      DataNDC data;
+
+      CHECK_EQUAL(data.size(), size_t(0));
+      CHECK(data.empty());
+      CHECK_EQUAL(data.max_size(), SIZE);
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_constructor_range)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.size() == SIZE);
+      CHECK(data.full());
+      CHECK_EQUAL(SIZE, size_t(std::distance(data.begin(), data.end())));
+    }
+
+    //*************************************************************************
+    TEST(test_destruct_via_iflat_unordered_set)
+    {
+      int current_count = NDC::get_instance_count();
+
+      DataNDC* pdata = new DataNDC(initial_data.begin(), initial_data.end());
+
+      IDataNDC* pidata = pdata;
+      delete pidata;
+
+      CHECK_EQUAL(current_count, NDC::get_instance_count());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_assignment_interface)
+    {
+      DataNDC data1(initial_data.begin(), initial_data.end());
+      DataNDC data2;
+
+      IDataNDC& idata1 = data1;
+      IDataNDC& idata2 = data2;
+
+      idata2 = idata1;
+
+      CHECK(data1 == data2);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_value)
+    {
+      DataNDC data;
+
+      CHECK(data.insert(N0).second);
+      CHECK(data.insert(N2).second);
+      CHECK(data.insert(N1).second);
+      CHECK(!data.insert(N1).second);
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK(*data.find(N0) == N0);
+      CHECK(*data.find(N1) == N1);
+      CHECK(*data.find(N2) == N2);
+      CHECK(data.find(N3) == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_range_excess)
+    {
+      DataNDC data;
+
+      CHECK_THROW(data.insert(excess_data.begin(), excess_data.end()), etl::flat_unordered_set_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_emplace)
+    {
+      DataNDC data;
+
+      CHECK(data.emplace("FF").second);
+      CHECK(!data.emplace(N0).second);
+      CHECK(data.emplace("FG", 1).second);
+
+      CHECK_EQUAL(2U, data.size());
+      CHECK_EQUAL(1U, data.count(N1));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK_EQUAL(1U, data.erase(N5));
+      CHECK_EQUAL(0U, data.erase(N5));
+
+      DataNDC::iterator itr = data.find(N7);
+      data.erase(itr);
+
+      CHECK_EQUAL(SIZE - 2, data.size());
+      CHECK_EQUAL(0U, data.count(N7));
+      CHECK_EQUAL(1U, data.count(N8));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_all_while_iterating)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      DataNDC::iterator itr = data.begin();
+      size_t count = 0;
+
+      while (itr != data.end())
+      {
+        itr = data.erase(itr);
+        ++count;
+      }
+
+      CHECK_EQUAL(SIZE, count);
+      CHECK(data.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_against_std_set)
+    {
+      typedef etl::flat_unordered_set<int, 50> Data;
+
+      Data data;
+      std::set<int> compare;
+
+      unsigned int seed = 7;
+
+      for (int i = 0; i < 10000; ++i)
+      {
+        seed = (seed * 1103515245U) + 12345U;
+        int key = int((seed >> 16) % 80U);
+
+        if (((seed >> 8) & 1U) && !data.full())
+        {
+          CHECK_EQUAL(compare.insert(key).second, data.insert(key).second);
+        }
+        else
+        {
+          CHECK_EQUAL(compare.erase(key), data.erase(key));
+        }
+      }
+
+      CHECK_EQUAL(compare.size(), data.size());
+
+      std::set<int> contents(data.begin(), data.end());
+      CHECK(contents == compare);
+    }
+
+    //*************************************************************************
+    TEST(test_strided_keys_spread_over_slots)
+    {
+      typedef etl::flat_unordered_set<int, 50> Data;
+
+      Data data;
+
+      // etl::hash is the identity for int, so these keys share their low bits.
+      for (int i = 0; i < 50; ++i)
+      {
+        data.insert(i * int(data.max_bucket_count()));
+      }
+
+      std::set<size_t> homes;
+
+      for (Data::const_iterator itr = data.begin(); itr != data.end(); ++itr)
+      {
+        homes.insert(data.get_bucket_index(*itr));
+      }
+
+      CHECK(homes.size() > 25U);
+
+      for (int i = 0; i < 50; ++i)
+      {
+        CHECK_EQUAL(1U, data.count(i * int(data.max_bucket_count())));
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_clear)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      data.clear();
+
+      CHECK_EQUAL(data.size(), size_t(0));
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_equal)
+    {
+      std::vector<NDC> reversed(initial_data.rbegin(), initial_data.rend());
+
+      const DataNDC initial1(initial_data.begin(), initial_data.end());
+      const DataNDC initial2(reversed.begin(), reversed.end());
+
+      CHECK(initial1 == initial2);
+
+      DataNDC different(initial_data.begin(), initial_data.end());
+      different.erase(N0);
+      different.insert(N11);
+
+      CHECK(initial1 != different);
+    }
+  };
+}
@@ -0,0 +1,294 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include <ostream>
+#include <stdio.h>
+
+#include "etl/format.h"
+#include "etl/cstring.h"
+#include "etl/wstring.h"
+#include "etl/string_view.h"
+
+namespace
+{
+  std::ostream& operator << (std::ostream& os, const etl::istring& str)
+  {
+    for (auto c : str)
+    {
+      os << c;
+    }
+
+    return os;
+  }
+
+  typedef etl::string<64> String;
+
+  SUITE(test_format)
+  {
+    //*************************************************************************
+    TEST(test_literal_text)
+    {
+      String str;
+
+      CHECK_EQUAL(String("Hello World"), etl::format_to(str, "Hello World"));
+
+      str.clear();
+      CHECK_EQUAL(String("{}{x}"), etl::format_to(str, "{{}}{{x}}"));
+
+      str.clear();
+      CHECK_EQUAL(String(""), etl::format_to(str, ""));
+    }
+
+    //*************************************************************************
+    TEST(test_appends)
+    {
+      String str("Value=");
+
+      etl::format_to(str, "{}", 42);
+
+      CHECK_EQUAL(String("Value=42"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_default_formats)
+    {
+      String str;
+      String text("text");
+      etl::string_view view("view");
+
+      etl::format_to(str, "{} {} {} {} {} {} {} {} {}", 42, -17, 255U, int64_t(-1234567890123LL), true, 'c', "chars", text, view);
+
+      CHECK_EQUAL(String("42 -17 255 -1234567890123 true c chars text view"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_integral_limits)
+    {
+      String str;
+
+      etl::format_to(str, "{} {} {} {}", INT32_MIN, UINT32_MAX, INT64_MIN, UINT64_MAX);
+
+      CHECK_EQUAL(String("-2147483648 4294967295 -9223372036854775808 18446744073709551615"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_integral_bases)
+    {
+      String str;
+
+      etl::format_to(str, "{:x} {:X} {:o} {:b} {:d}", 0xABCDU, 0xABCDU, 8, 5, 10);
+      CHECK_EQUAL(String("abcd ABCD 10 101 10"), str);
+
+      str.clear();
+      etl::format_to(str, "{:#x} {:#X} {:#o} {:#o} {:#b}", 255, 255, 8, 0, 5);
+      CHECK_EQUAL(String("0xff 0XFF 010 0 0b101"), str);
+
+      str.clear();
+      etl::format_to(str, "{:x} {:#x}", -255, -255);
+      CHECK_EQUAL(String("-ff -0xff"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_integral_sign)
+    {
+      String str;
+
+      etl::format_to(str, "{:+} {:+} {: } {: } {:-}", 1, -1, 1, -1, 1);
+
+      CHECK_EQUAL(String("+1 -1  1 -1 1"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_width_and_alignment)
+    {
+      String str;
+
+      etl::format_to(str, "[{:5}][{:<5}][{:^5}][{:>5}]", 42, 42, 42, 42);
+      CHECK_EQUAL(String("[   42][42   ][ 42  ][   42]"), str);
+
+      str.clear();
+      etl::format_to(str, "[{:5}][{:<5}][{:^6}][{:>5}]", "ab", "ab", "ab", "ab");
+      CHECK_EQUAL(String("[ab   ][ab   ][  ab  ][   ab]"), str);
+
+      str.clear();
+      etl::format_to(str, "[{:*^7}][{:->4}][{:_<6}]", "abc", 'x', true);
+      CHECK_EQUAL(String("[**abc**][---x][true__]"), str);
+
+      str.clear();
+      etl::format_to(str, "[{:2}]", 12345);
+      CHECK_EQUAL(String("[12345]"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_zero_padding)
+    {
+      String str;
+
+      etl::format_to(str, "{:08x} {:05} {:+05} {:#010x} {:06.2f}", 0xBEEFU, -42, 42, 255, -1.5);
+
+      CHECK_EQUAL(String("0000beef -0042 +0042 0x000000ff -01.50"), str);
+
+      // An alignment overrides zero padding.
+      str.clear();
+      etl::format_to(str, "{:<05}", 42);
+
+      CHECK_EQUAL(String("42   "), str);
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point)
+    {
+      String str;
+
+      etl::format_to(str, "{:.3f} {:.0f} {:f} {:.2f} {:+.1f}", 3.14159, 2.5, 1.0, -0.005, 0.25);
+      CHECK_EQUAL(String("3.142 2 1.000000 -0.01 +0.2"), str);
+
+      str.clear();
+      etl::format_to(str, "{} {} {} {}", 0.1, 1.5f, -2.0, 1e30);
+      CHECK_EQUAL(String("0.1 1.5 -2 1e+30"), str);
+
+      str.clear();
+      etl::format_to(str, "[{:>8.2f}][{:<8}][{:^9.1f}]", 3.14159, 0.5, 2.25);
+      CHECK_EQUAL(String("[    3.14][0.5     ][   2.2   ]"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_against_printf)
+    {
+      const double values[] = { 0.0, 1.0, 0.1, 123.456, -98765.4321, 1.0 / 3.0, 2.675, 1e-5 };
+
+      for (size_t i = 0U; i < sizeof(values) / sizeof(values[0]); ++i)
+      {
+        String str;
+        char   expected[64];
+
+        etl::format_to(str, "{:12.4f}|{:.7f}", values[i], values[i]);
+        snprintf(expected, sizeof(expected), "%12.4f|%.7f", values[i], values[i]);
+
+        CHECK_EQUAL(String(expected), str);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_more_arguments_than_fields)
+    {
+      String str;
+
+      etl::format_to(str, "{} and", 1, 2, 3);
+
+      CHECK_EQUAL(String("1 and"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_truncation)
+    {
+      etl::string<10> str;
+
+      etl::format_to(str, "{} {:08x} {}", 12345, 0xABCDU, "overflow");
+
+      CHECK_EQUAL(10U, str.size());
+      CHECK(str.truncated());
+      CHECK(str == etl::string<10>("12345 0000"));
+
+      // Padding is truncated too.
+      etl::string<4> small;
+
+      etl::format_to(small, "{:>10}", 1);
+
+      CHECK_EQUAL(4U, small.size());
+      CHECK(small.truncated());
+    }
+
+    //*************************************************************************
+    TEST(test_invalid_format)
+    {
+      String str;
+
+      CHECK_THROW(etl::format_to(str, "{} {}", 1), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "{", 1), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "}", 1), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "{0}", 1), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "{:.2}", 1), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "{:x}", 1.0), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "{:+}", "text"), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "{:05}", true), etl::format_invalid);
+      CHECK_THROW(etl::format_to(str, "{:d}", 'c'), etl::format_invalid);
+    }
+
+    //*************************************************************************
+    TEST(test_format_string_check)
+    {
+      typedef etl::private_format::category category;
+
+      const category kinds[] = { etl::private_format::integral_argument,
+                                 etl::private_format::floating_point_argument,
+                                 etl::private_format::string_argument };
+
+      CHECK(etl::private_format::is_valid_format("{} {:.2f} {:>8}", kinds, 3U));
+      CHECK(etl::private_format::is_valid_format("{{}} {:#010x}", kinds, 3U));
+      CHECK(!etl::private_format::is_valid_format("{} {} {} {}", kinds, 3U));
+      CHECK(!etl::private_format::is_valid_format("{:.2f}", kinds, 3U));
+      CHECK(!etl::private_format::is_valid_format("{} {:x}", kinds, 3U));
+      CHECK(!etl::private_format::is_valid_format("{} }", kinds, 3U));
+
+#if ETL_CPP14_SUPPORTED
+      static_assert(etl::private_format::is_valid_format("{} {:.3f} {}", etl::private_format::argument_categories<char, int, double, const char*>::values, 3U), "Should be valid");
+      static_assert(!etl::private_format::is_valid_format("{:x}", etl::private_format::argument_categories<char, double>::values, 1U), "Should be invalid");
+#endif
+    }
+
+    //*************************************************************************
+    TEST(test_checked_format_string)
+    {
+      String str;
+
+      etl::format_to(str, ETL_FORMAT_STRING("{} {:08x} {:.3f}"), 42, 255U, 3.14159);
+
+      CHECK_EQUAL(String("42 000000ff 3.142"), str);
+    }
+
+    //*************************************************************************
+    TEST(test_wide_string)
+    {
+      etl::wstring<40> str;
+      etl::wstring<10> text(L"text");
+
+      etl::format_to(str, L"{} {:#x} {:.2f} {:>6} {} {}", -7, 255, 2.5, L"ab", text, L'c');
+
+      CHECK(str == etl::wstring<40>(L"-7 0xff 2.50     ab text c"));
+
+      str.clear();
+      etl::format_to(str, ETL_FORMAT_STRING(L"{:^5}"), true);
+
+      CHECK(str == etl::wstring<40>(L"true "));
+    }
+  };
+}
@@ -0,0 +1,459 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include <queue>
+#include <vector>
+#include <functional>
+
+#include "etl/indexed_priority_queue.h"
+
+namespace
+{
+  //***************************************************************************
+  // Counts the number of live instances.
+  //***************************************************************************
+  struct Counted
+  {
+    Counted(int value_)
+      : value(value_)
+    {
+      ++instances;
+    }
+
+    Counted(const Counted& other)
+      : value(other.value)
+    {
+      ++instances;
+    }
+
+    ~Counted()
+    {
+      --instances;
+    }
+
+    Counted& operator = (const Counted& other)
+    {
+      value = other.value;
+      return *this;
+    }
+
+    int value;
+
+    static int instances;
+  };
+
+  int Counted::instances = 0;
+
+  bool operator < (const Counted& lhs, const Counted& rhs)
+  {
+    return lhs.value < rhs.value;
+  }
+
+  SUITE(test_indexed_priority_queue)
+  {
+    static const size_t SIZE = 8;
+
+    typedef etl::indexed_priority_queue<int, SIZE> Queue;
+    typedef etl::iindexed_priority_queue<int>      IQueue;
+
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      Queue queue;
+
+      CHECK(queue.empty());
+      CHECK(!queue.full());
+      CHECK_EQUAL(0U, queue.size());
+      CHECK_EQUAL(SIZE, queue.max_size());
+      CHECK_EQUAL(SIZE, queue.available());
+    }
+
+    //*************************************************************************
+    TEST(test_push_pop_order)
+    {
+      int data[] = { 5, 1, 7, 3, 8, 2, 6, 4 };
+
+      Queue queue;
+      std::priority_queue<int> compare_queue;
+
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        queue.push(data[i]);
+        compare_queue.push(data[i]);
+        CHECK_EQUAL(compare_queue.top(), queue.top());
+      }
+
+      CHECK(queue.full());
+
+      while (!compare_queue.empty())
+      {
+        CHECK_EQUAL(compare_queue.top(), queue.top());
+        compare_queue.pop();
+        queue.pop();
+      }
+
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_pop_into)
+    {
+      Queue queue;
+
+      queue.push(2);
+      queue.push(3);
+      queue.push(1);
+
+      int value;
+
+      queue.pop_into(value);
+      CHECK_EQUAL(3, value);
+      queue.pop_into(value);
+      CHECK_EQUAL(2, value);
+      queue.pop_into(value);
+      CHECK_EQUAL(1, value);
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_handles_are_stable)
+    {
+      Queue queue;
+      Queue::handle_type handles[SIZE];
+
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        handles[i] = queue.push(int(i * 10));
+      }
+
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        CHECK(queue.contains(handles[i]));
+        CHECK_EQUAL(int(i * 10), queue.get(handles[i]));
+      }
+
+      CHECK_EQUAL(handles[SIZE - 1], queue.top_handle());
+
+      queue.pop();
+      CHECK(!queue.contains(handles[SIZE - 1]));
+
+      for (size_t i = 0; i < (SIZE - 1); ++i)
+      {
+        CHECK(queue.contains(handles[i]));
+        CHECK_EQUAL(int(i * 10), queue.get(handles[i]));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_update_increase_and_decrease)
+    {
+      Queue queue;
+
+      Queue::handle_type h1 = queue.push(1);
+      Queue::handle_type h2 = queue.push(2);
+      Queue::handle_type h3 = queue.push(3);
+      queue.push(4);
+
+      queue.update(h1, 10);
+      CHECK_EQUAL(h1, queue.top_handle());
+      CHECK_EQUAL(10, queue.top());
+
+      queue.update(h1, 0);
+      CHECK_EQUAL(4, queue.top());
+
+      queue.update(h2, 5);
+      CHECK_EQUAL(h2, queue.top_handle());
+
+      queue.update(h3, 3);
+      CHECK_EQUAL(3, queue.get(h3));
+
+      int expected[] = { 5, 4, 3, 0 };
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        CHECK_EQUAL(expected[i], queue.top());
+        queue.pop();
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_erase)
+    {
+      Queue queue;
+
+      Queue::handle_type h1 = queue.push(1);
+      Queue::handle_type h5 = queue.push(5);
+      Queue::handle_type h3 = queue.push(3);
+      queue.push(4);
+      queue.push(2);
+
+      queue.erase(h3);
+      CHECK(!queue.contains(h3));
+      CHECK_EQUAL(4U, queue.size());
+
+      queue.erase(h5);
+      CHECK_EQUAL(4, queue.top());
+
+      queue.erase(h1);
+
+      CHECK_EQUAL(4, queue.top());
+      queue.pop();
+      CHECK_EQUAL(2, queue.top());
+      queue.pop();
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_erased_handle_is_reused)
+    {
+      Queue queue;
+
+      queue.push(1);
+      Queue::handle_type h = queue.push(2);
+      queue.push(3);
+
+      queue.erase(h);
+
+      CHECK_EQUAL(h, queue.push(4));
+      CHECK_EQUAL(4, queue.get(h));
+    }
+
+    //*************************************************************************
+    TEST(test_push_excess)
+    {
+      Queue queue;
+
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        queue.push(int(i));
+      }
+
+      CHECK_THROW(queue.push(0), etl::indexed_priority_queue_full);
+    }
+
+    //*************************************************************************
+    TEST(test_invalid_handle)
+    {
+      Queue queue;
+
+      Queue::handle_type h = queue.push(1);
+      queue.pop();
+
+      CHECK(!queue.contains(h));
+      CHECK(!queue.contains(SIZE));
+      CHECK_THROW(queue.update(h, 2), etl::indexed_priority_queue_invalid_handle);
+      CHECK_THROW(queue.erase(h), etl::indexed_priority_queue_invalid_handle);
+      CHECK_THROW(queue.get(SIZE), etl::indexed_priority_queue_invalid_handle);
+    }
+
+    //*************************************************************************
+    TEST(test_compare_greater)
+    {
+      etl::indexed_priority_queue<int, SIZE, std::greater<int> > queue;
+
+      Queue::handle_type h = queue.push(5);
+      queue.push(3);
+      queue.push(7);
+
+      CHECK_EQUAL(3, queue.top());
+
+      // Decrease-key, as used by Dijkstra's algorithm.
+      queue.update(h, 1);
+      CHECK_EQUAL(h, queue.top_handle());
+      CHECK_EQUAL(1, queue.top());
+    }
+
+    //*************************************************************************
+    TEST(test_copy_constructor_preserves_handles)
+    {
+      Queue queue1;
+
+      Queue::handle_type h1 = queue1.push(1);
+      Queue::handle_type h2 = queue1.push(2);
+      Queue::handle_type h3 = queue1.push(3);
+      queue1.erase(h2);
+
+      Queue queue2(queue1);
+
+      CHECK_EQUAL(queue1.size(), queue2.size());
+      CHECK(!queue2.contains(h2));
+      CHECK_EQUAL(1, queue2.get(h1));
+      CHECK_EQUAL(3, queue2.get(h3));
+
+      queue2.update(h1, 4);
+      CHECK_EQUAL(h1, queue2.top_handle());
+      CHECK_EQUAL(h3, queue1.top_handle());
+    }
+
+    //*************************************************************************
+    TEST(test_assignment_interface)
+    {
+      Queue queue1;
+      etl::indexed_priority_queue<int, SIZE * 2> queue2;
+
+      Queue::handle_type h1 = queue1.push(1);
+      Queue::handle_type h2 = queue1.push(2);
+
+      queue2.push(10);
+      queue2.push(20);
+      queue2.push(30);
+
+      IQueue& iqueue1 = queue1;
+      IQueue& iqueue2 = queue2;
+
+      iqueue2 = iqueue1;
+
+      CHECK_EQUAL(2U, queue2.size());
+      CHECK_EQUAL(1, queue2.get(h1));
+      CHECK_EQUAL(2, queue2.get(h2));
+
+      // The extra slots are usable.
+      for (size_t i = 0; i < ((SIZE * 2) - 2); ++i)
+      {
+        queue2.push(int(i));
+      }
+
+      CHECK(queue2.full());
+
+      // Too many handles to fit.
+      CHECK_THROW(iqueue1 = iqueue2, etl::indexed_priority_queue_full);
+    }
+
+    //*************************************************************************
+    TEST(test_clear_destroys_values)
+    {
+      Counted::instances = 0;
+
+      {
+        etl::indexed_priority_queue<Counted, SIZE> queue;
+
+        queue.push(Counted(1));
+        etl::indexed_priority_queue<Counted, SIZE>::handle_type h = queue.push(Counted(2));
+        queue.push(Counted(3));
+        CHECK_EQUAL(3, Counted::instances);
+
+        queue.erase(h);
+        CHECK_EQUAL(2, Counted::instances);
+
+        queue.clear();
+        CHECK_EQUAL(0, Counted::instances);
+        CHECK(queue.empty());
+
+        queue.push(Counted(4));
+        queue.push(Counted(5));
+        CHECK_EQUAL(5, queue.top().value);
+      }
+
+      CHECK_EQUAL(0, Counted::instances);
+    }
+
+    //*************************************************************************
+    template <size_t ARITY>
+    void check_random_operations()
+    {
+      const size_t LARGE = 100;
+
+      etl::indexed_priority_queue<int, LARGE, std::less<int>, ARITY> queue;
+      typedef typename etl::indexed_priority_queue<int, LARGE, std::less<int>, ARITY>::handle_type handle_type;
+
+      // Reference model: the value of each live handle.
+      std::vector<int> values(LARGE, 0);
+      std::vector<bool> live(LARGE, false);
+
+      unsigned seed = 12345;
+
+      for (size_t step = 0; step < 5000; ++step)
+      {
+        seed = (seed * 1103515245U) + 12345U;
+        const unsigned r   = (seed >> 8);
+        const int      key = int(r % 1000);
+
+        if (!queue.full() && ((r % 3) == 0 || queue.empty()))
+        {
+          handle_type h = queue.push(key);
+          CHECK(!live[h]);
+          live[h]   = true;
+          values[h] = key;
+        }
+        else
+        {
+          handle_type h = handle_type((r / 7) % LARGE);
+
+          if (live[h])
+          {
+            if ((r % 3) == 1)
+            {
+              queue.update(h, key);
+              values[h] = key;
+            }
+            else
+            {
+              queue.erase(h);
+              live[h] = false;
+            }
+          }
+          else
+          {
+            handle_type top = queue.top_handle();
+            queue.pop();
+            live[top] = false;
+          }
+        }
+
+        // The top must hold the largest live value.
+        if (!queue.empty())
+        {
+          int largest = -1;
+
+          for (size_t i = 0; i < LARGE; ++i)
+          {
+            CHECK_EQUAL(live[i], queue.contains(i));
+
+            if (live[i] && (values[i] > largest))
+            {
+              largest = values[i];
+            }
+          }
+
+          CHECK_EQUAL(largest, queue.top());
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_random_operations)
+    {
+      check_random_operations<2>();
+      check_random_operations<4>();
+      check_random_operations<8>();
+    }
+  };
+}
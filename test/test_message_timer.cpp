@@ -594,6 +594,204 @@ namespace
       CHECK_ARRAY_EQUAL(compare1.data(), router1.message1.data(), compare1.size());
     }
 
+    //=========================================================================
+    TEST(message_timer_tickless)
+    {
+      etl::message_timer<2> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(message1, router1, 23, etl::timer::mode::REPEATING);
+      etl::timer::id::type id2 = timer_controller.register_timer(message2, router1, 37, etl::timer::mode::SINGLE_SHOT);
+
+      router1.clear();
+
+      timer_controller.enable(true);
+
+      CHECK_EQUAL(uint32_t(etl::timer::state::INACTIVE), timer_controller.time_to_next_expiry());
+
+      ticks = 10;
+      CHECK(timer_controller.advance_to(uint32_t(ticks)));
+      CHECK_EQUAL(10U, timer_controller.time());
+
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+
+      CHECK_EQUAL(23U, timer_controller.time_to_next_expiry());
+
+      ticks = 33;
+      CHECK(timer_controller.advance_to(uint32_t(ticks)));
+      CHECK_EQUAL(14U, timer_controller.time_to_next_expiry());
+
+      // All of the expiries due by 'now' in one call.
+      ticks = 100;
+      CHECK(timer_controller.advance_to(uint32_t(ticks)));
+      CHECK_EQUAL(2U, timer_controller.time_to_next_expiry());
+
+      std::vector<uint64_t> compare1 = { 33, 100, 100 };
+      std::vector<uint64_t> compare2 = { 100 };
+
+      CHECK_EQUAL(compare1.size(), router1.message1.size());
+      CHECK_EQUAL(compare2.size(), router1.message2.size());
+      CHECK_ARRAY_EQUAL(compare1.data(), router1.message1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), router1.message2.data(), compare2.size());
+    }
+
+    //=========================================================================
+    TEST(message_timer_slack)
+    {
+      etl::message_timer<4> timer_controller;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(message1, router1, 37, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id2 = timer_controller.register_timer(message2, router1, 33, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id3 = timer_controller.register_timer(message3, router1, 10, etl::timer::mode::REPEATING);
+      etl::timer::id::type id4 = timer_controller.register_timer(message3, router1, 38, etl::timer::mode::SINGLE_SHOT);
+
+      CHECK(!timer_controller.set_slack(etl::timer::id::NO_TIMER, 7));
+
+      // Rounded up to a multiple of 8.
+      CHECK(timer_controller.set_slack(id1, 7));
+      CHECK(timer_controller.set_slack(id2, 10));
+
+      // Rounded up to a multiple of 4.
+      CHECK(timer_controller.set_slack(id3, 5));
+
+      router1.clear();
+
+      timer_controller.enable(true);
+
+      ticks = 1;
+      timer_controller.tick(1);
+
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+      timer_controller.start(id3);
+      timer_controller.start(id4);
+
+      CHECK_EQUAL(11U, timer_controller.time_to_next_expiry());
+
+      while (ticks < 60U)
+      {
+        ++ticks;
+        timer_controller.tick(1);
+      }
+
+      // Both expire at 40. The timer with no slack is not moved.
+      std::vector<uint64_t> compare1 = { 40 };
+      std::vector<uint64_t> compare2 = { 40 };
+      std::vector<uint64_t> compare3 = { 12, 24, 36, 39, 48, 60 };
+
+      CHECK_EQUAL(compare1.size(), router1.message1.size());
+      CHECK_EQUAL(compare2.size(), router1.message2.size());
+      CHECK_EQUAL(compare3.size(), router1.message3.size());
+      CHECK_ARRAY_EQUAL(compare1.data(), router1.message1.data(), compare1.size());
+      CHECK_ARRAY_EQUAL(compare2.data(), router1.message2.data(), compare2.size());
+      CHECK_ARRAY_EQUAL(compare3.data(), router1.message3.data(), compare3.size());
+    }
+
+    //=========================================================================
+    class BatchHandler : public etl::imessage_timer_batch_handler
+    {
+    public:
+
+      struct Batch
+      {
+        etl::imessage_router*    p_router;
+        etl::message_router_id_t destination;
+        std::vector<etl::message_id_t> ids;
+      };
+
+      void receive(etl::imessage_router&    router,
+                   etl::message_router_id_t destination_router_id,
+                   const etl::imessage* const* messages,
+                   size_t                   count)
+      {
+        Batch batch;
+        batch.p_router    = &router;
+        batch.destination = destination_router_id;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          batch.ids.push_back(messages[i]->message_id);
+        }
+
+        batches.push_back(batch);
+      }
+
+      std::vector<Batch> batches;
+    };
+
+    TEST(message_timer_batched)
+    {
+      etl::message_timer<4, 8> timer_controller;
+      BatchHandler handler;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(message1, router1, 10, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id2 = timer_controller.register_timer(message2, bus1,    10, etl::timer::mode::SINGLE_SHOT, ROUTER1);
+      etl::timer::id::type id3 = timer_controller.register_timer(message3, router1, 12, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id4 = timer_controller.register_timer(message2, router1,  5, etl::timer::mode::REPEATING);
+
+      CHECK(timer_controller.set_batch_handler(handler));
+
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+      timer_controller.start(id3);
+      timer_controller.start(id4);
+
+      timer_controller.enable(true);
+
+      // One call for each router and destination.
+      timer_controller.tick(12);
+
+      CHECK_EQUAL(2U, handler.batches.size());
+
+      CHECK(handler.batches[0].p_router == &router1);
+      CHECK_EQUAL(etl::imessage_router::ALL_MESSAGE_ROUTERS, handler.batches[0].destination);
+      std::vector<etl::message_id_t> compare1 = { MESSAGE2, MESSAGE2, MESSAGE1, MESSAGE3 };
+      CHECK_EQUAL(compare1.size(), handler.batches[0].ids.size());
+      CHECK_ARRAY_EQUAL(compare1.data(), handler.batches[0].ids.data(), compare1.size());
+
+      CHECK(handler.batches[1].p_router == &bus1);
+      CHECK_EQUAL(ROUTER1, handler.batches[1].destination);
+      CHECK_EQUAL(1U, handler.batches[1].ids.size());
+      CHECK_EQUAL(MESSAGE2, handler.batches[1].ids[0]);
+
+      // Back to delivery one message at a time.
+      timer_controller.clear_batch_handler();
+      router1.clear();
+      ticks = 15;
+      timer_controller.tick(3);
+      CHECK_EQUAL(1U, router1.message2.size());
+      CHECK_EQUAL(2U, handler.batches.size());
+    }
+
+    //=========================================================================
+    TEST(message_timer_batched_overflow)
+    {
+      etl::message_timer<3, 2> timer_controller;
+      BatchHandler handler;
+
+      etl::timer::id::type id1 = timer_controller.register_timer(message1, router1, 10, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id2 = timer_controller.register_timer(message2, router1, 10, etl::timer::mode::SINGLE_SHOT);
+      etl::timer::id::type id3 = timer_controller.register_timer(message3, router1, 10, etl::timer::mode::SINGLE_SHOT);
+
+      CHECK(timer_controller.set_batch_handler(handler));
+
+      timer_controller.start(id1);
+      timer_controller.start(id2);
+      timer_controller.start(id3);
+
+      timer_controller.enable(true);
+      timer_controller.tick(10);
+
+      // Delivered as the batch fills.
+      CHECK_EQUAL(2U, handler.batches.size());
+      CHECK_EQUAL(2U, handler.batches[0].ids.size());
+      CHECK_EQUAL(1U, handler.batches[1].ids.size());
+
+      // No batch storage.
+      etl::message_timer<3> unbatched_controller;
+      CHECK(!unbatched_controller.set_batch_handler(handler));
+    }
+
     //=========================================================================
 #if REALTIME_TEST
 
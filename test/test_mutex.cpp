@@ -0,0 +1,205 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <chrono>
+#include <vector>
+
+#define ETL_MUTEX_STATISTICS
+
+#include "etl/mutex.h"
+
+namespace
+{
+  const int N_THREADS    = 4;
+  const int N_INCREMENTS = 20000;
+
+  //***************************************************************************
+  template <typename TMutex>
+  void check_lock_unlock()
+  {
+    TMutex mutex;
+
+    mutex.lock();
+    CHECK(!mutex.try_lock());
+    mutex.unlock();
+
+    CHECK(mutex.try_lock());
+    CHECK(!mutex.try_lock());
+    mutex.unlock();
+
+    CHECK_EQUAL(2U, mutex.get_statistics().acquisitions);
+    CHECK_EQUAL(0U, mutex.get_statistics().spins);
+    CHECK_EQUAL(0U, mutex.get_statistics().parks);
+
+    mutex.clear_statistics();
+    CHECK_EQUAL(0U, mutex.get_statistics().acquisitions);
+  }
+
+  //***************************************************************************
+  template <typename TMutex>
+  void check_threads()
+  {
+    TMutex mutex;
+    int    count = 0;
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < N_THREADS; ++t)
+    {
+      threads.push_back(std::thread([&mutex, &count]()
+      {
+        for (int i = 0; i < N_INCREMENTS; ++i)
+        {
+          if ((i % 2) == 0)
+          {
+            mutex.lock();
+          }
+          else
+          {
+            while (!mutex.try_lock())
+            {
+              std::this_thread::yield();
+            }
+          }
+
+          ++count;
+          mutex.unlock();
+        }
+      }));
+    }
+
+    for (size_t t = 0; t < threads.size(); ++t)
+    {
+      threads[t].join();
+    }
+
+    CHECK_EQUAL(N_THREADS * N_INCREMENTS, count);
+    CHECK_EQUAL(uint32_t(N_THREADS * N_INCREMENTS), mutex.get_statistics().acquisitions);
+  }
+
+  SUITE(test_mutex)
+  {
+    //*************************************************************************
+    TEST(test_spin_backoff)
+    {
+      etl::spin_backoff backoff;
+
+      CHECK_EQUAL(0U, backoff.count());
+      backoff.pause();
+      backoff.pause();
+      CHECK_EQUAL(2U, backoff.count());
+    }
+
+    //*************************************************************************
+    TEST(test_spin_mutex_lock_unlock)
+    {
+      check_lock_unlock<etl::spin_mutex>();
+    }
+
+    //*************************************************************************
+    TEST(test_spin_mutex_threads)
+    {
+      check_threads<etl::spin_mutex>();
+    }
+
+    //*************************************************************************
+    TEST(test_ticket_mutex_lock_unlock)
+    {
+      check_lock_unlock<etl::ticket_mutex>();
+    }
+
+    //*************************************************************************
+    TEST(test_ticket_mutex_threads)
+    {
+      check_threads<etl::ticket_mutex>();
+    }
+
+    //*************************************************************************
+    TEST(test_ticket_mutex_try_lock_with_waiter)
+    {
+      etl::ticket_mutex mutex;
+
+      mutex.lock();
+
+      std::thread waiter([&mutex]()
+      {
+        mutex.lock();
+        mutex.unlock();
+      });
+
+      // Once the waiter has taken a ticket, try_lock must not jump the queue.
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      mutex.unlock();
+      waiter.join();
+
+      CHECK(mutex.try_lock());
+      mutex.unlock();
+    }
+
+#if defined(__linux__) && defined(ETL_COMPILER_GCC)
+    //*************************************************************************
+    TEST(test_futex_mutex_lock_unlock)
+    {
+      check_lock_unlock<etl::futex_mutex>();
+    }
+
+    //*************************************************************************
+    TEST(test_futex_mutex_threads)
+    {
+      check_threads<etl::futex_mutex>();
+    }
+
+    //*************************************************************************
+    TEST(test_futex_mutex_parks)
+    {
+      etl::futex_mutex mutex;
+
+      mutex.lock();
+
+      std::thread waiter([&mutex]()
+      {
+        mutex.lock();
+        mutex.unlock();
+      });
+
+      // Hold the lock long enough for the waiter to exhaust its spin and sleep.
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      mutex.unlock();
+      waiter.join();
+
+      CHECK_EQUAL(2U, mutex.get_statistics().acquisitions);
+      CHECK(mutex.get_statistics().parks >= 1U);
+      CHECK_EQUAL(uint32_t(ETL_MUTEX_FUTEX_SPIN_LIMIT), mutex.get_statistics().spins);
+    }
+#endif
+  };
+}
@@ -64,6 +64,52 @@ namespace
     return os;
   }
 
+  //***************************************************************************
+  // Counts the copies made of it.
+  //***************************************************************************
+  struct Counted
+  {
+    Counted(int value_)
+      : value(value_)
+    {
+    }
+
+    Counted(const Counted& other)
+      : value(other.value)
+    {
+      ++copies;
+    }
+
+    Counted(Counted&& other)
+      : value(other.value)
+    {
+    }
+
+    Counted& operator =(const Counted& other)
+    {
+      value = other.value;
+      ++copies;
+      return *this;
+    }
+
+    Counted& operator =(Counted&& other)
+    {
+      value = other.value;
+      return *this;
+    }
+
+    int value;
+
+    static int copies;
+  };
+
+  int Counted::copies = 0;
+
+  bool operator < (const Counted& lhs, const Counted& rhs)
+  {
+    return (lhs.value < rhs.value);
+  }
+
   SUITE(test_priority_queue)
   {
     static const size_t SIZE = 4;
@@ -517,5 +563,81 @@ namespace
       CHECK_EQUAL(compare_priority_queue.size(), ipriority_queue.size());
       CHECK_EQUAL(compare_priority_queue.top(), ipriority_queue.top());
     }
+
+    //*************************************************************************
+    TEST(test_arity_4_and_8)
+    {
+      const size_t LARGE = 200;
+
+      etl::priority_queue<int, LARGE, etl::vector<int, LARGE>, std::less<int>, 4> priority_queue4;
+      etl::priority_queue<int, LARGE, etl::vector<int, LARGE>, std::less<int>, 8> priority_queue8;
+      std::priority_queue<int> compare_priority_queue;
+
+      for (size_t i = 0; i < LARGE; ++i)
+      {
+        int value = int((i * 7919) % 241);
+        priority_queue4.push(value);
+        priority_queue8.push(value);
+        compare_priority_queue.push(value);
+      }
+
+      while (!compare_priority_queue.empty())
+      {
+        CHECK_EQUAL(compare_priority_queue.top(), priority_queue4.top());
+        CHECK_EQUAL(compare_priority_queue.top(), priority_queue8.top());
+        compare_priority_queue.pop();
+        priority_queue4.pop();
+        priority_queue8.pop();
+      }
+
+      CHECK(priority_queue4.empty());
+      CHECK(priority_queue8.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_arity_4_assign_range)
+    {
+      int data[] = { 5, 1, 9, 3, 7, 2, 8, 6, 4, 0, 11, 10 };
+
+      etl::priority_queue<int, SIZE * 4, etl::vector<int, SIZE * 4>, std::greater<int>, 4> priority_queue;
+      priority_queue.assign(std::begin(data), std::end(data));
+
+      std::priority_queue<int, std::vector<int>, std::greater<int> > compare_priority_queue(std::begin(data), std::end(data));
+
+      CHECK_EQUAL(compare_priority_queue.size(), priority_queue.size());
+
+      while (!compare_priority_queue.empty())
+      {
+        CHECK_EQUAL(compare_priority_queue.top(), priority_queue.top());
+        compare_priority_queue.pop();
+        priority_queue.pop();
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_sift_moves_values)
+    {
+      const size_t LARGE = 50;
+
+      etl::priority_queue<Counted, LARGE, etl::vector<Counted, LARGE>, std::less<Counted>, 4> priority_queue;
+
+      Counted::copies = 0;
+
+      for (size_t i = 0; i < LARGE; ++i)
+      {
+        priority_queue.emplace(int((i * 7919) % 241));
+      }
+
+      int previous = priority_queue.top().value;
+
+      while (!priority_queue.empty())
+      {
+        CHECK(priority_queue.top().value <= previous);
+        previous = priority_queue.top().value;
+        priority_queue.pop();
+      }
+
+      CHECK_EQUAL(0, Counted::copies);
+    }
   };
 }
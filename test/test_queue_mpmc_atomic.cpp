@@ -0,0 +1,564 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+#include "etl/queue_mpmc_atomic.h"
+
+namespace
+{
+  struct Data
+  {
+    Data(int a_, int b_ = 2, int c_ = 3, int d_ = 4)
+      : a(a_),
+        b(b_),
+        c(c_),
+        d(d_)
+    {
+    }
+
+    Data()
+      : a(0),
+        b(0),
+        c(0),
+        d(0)
+    {
+    }
+
+    int a;
+    int b;
+    int c;
+    int d;
+  };
+
+  bool operator ==(const Data& lhs, const Data& rhs)
+  {
+    return (lhs.a == rhs.a) && (lhs.b == rhs.b) && (lhs.c == rhs.c) && (lhs.d == rhs.d);
+  }
+
+  struct Counted
+  {
+    Counted()
+    {
+      ++count;
+    }
+
+    Counted(const Counted&)
+    {
+      ++count;
+    }
+
+    ~Counted()
+    {
+      --count;
+    }
+
+    static int count;
+  };
+
+  int Counted::count = 0;
+
+  //***************************************************************************
+  // Blocks in the copy that is made while a slot is claimed, when asked to.
+  //***************************************************************************
+  struct Stalling
+  {
+    Stalling()
+    {
+    }
+
+    Stalling(const Stalling&)
+    {
+      wait();
+    }
+
+    Stalling& operator =(const Stalling&)
+    {
+      wait();
+      return *this;
+    }
+
+    static void wait()
+    {
+      if (stall_next.exchange(false))
+      {
+        stalled = true;
+
+        while (stall.load())
+        {
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    static std::atomic<bool> stall_next;
+    static std::atomic<bool> stall;
+    static std::atomic<bool> stalled;
+  };
+
+  std::atomic<bool> Stalling::stall_next(false);
+  std::atomic<bool> Stalling::stall(false);
+  std::atomic<bool> Stalling::stalled(false);
+
+  typedef etl::queue_mpmc_atomic<int, 4, etl::memory_model::MEMORY_MODEL_SMALL> QueueIntSmall;
+
+  SUITE(test_queue_mpmc_atomic)
+  {
+    //*************************************************************************
+    TEST(test_constructor)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      CHECK_EQUAL(4U, queue.max_size());
+      CHECK_EQUAL(4U, queue.capacity());
+      CHECK_EQUAL(0U, queue.size());
+      CHECK_EQUAL(4U, queue.available());
+    }
+
+    //*************************************************************************
+    TEST(test_size_push_pop)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      CHECK_EQUAL(0U, queue.size());
+
+      queue.push(1);
+      CHECK_EQUAL(1U, queue.size());
+      CHECK_EQUAL(3U, queue.available());
+
+      queue.push(2);
+      CHECK_EQUAL(2U, queue.size());
+      CHECK_EQUAL(2U, queue.available());
+
+      queue.push(3);
+      CHECK_EQUAL(3U, queue.size());
+      CHECK_EQUAL(1U, queue.available());
+
+      queue.push(4);
+      CHECK_EQUAL(4U, queue.size());
+      CHECK_EQUAL(0U, queue.available());
+
+      CHECK(!queue.push(5));
+      CHECK(!queue.push(5));
+
+      int i;
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(1, i);
+      CHECK_EQUAL(3U, queue.size());
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(2, i);
+      CHECK_EQUAL(2U, queue.size());
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(3, i);
+      CHECK_EQUAL(1U, queue.size());
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(4, i);
+      CHECK_EQUAL(0U, queue.size());
+
+      CHECK(!queue.pop(i));
+      CHECK(!queue.pop(i));
+    }
+
+    //*************************************************************************
+    TEST(test_multiple_emplace)
+    {
+      etl::queue_mpmc_atomic<Data, 4> queue;
+
+      queue.emplace(1);
+      queue.emplace(1, 2);
+      queue.emplace(1, 2, 3);
+      queue.emplace(1, 2, 3, 4);
+
+      CHECK_EQUAL(4U, queue.size());
+
+      Data popped;
+
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+    }
+
+    //*************************************************************************
+    TEST(test_size_push_pop_iqueue)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      etl::iqueue_mpmc_atomic<int>& iqueue = queue;
+
+      CHECK(iqueue.push(1));
+      CHECK(iqueue.push(2));
+      CHECK(iqueue.push(3));
+      CHECK(iqueue.push(4));
+      CHECK_EQUAL(4U, iqueue.size());
+
+      CHECK(!iqueue.push(5));
+
+      int i;
+
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(1, i);
+      CHECK(iqueue.pop());
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(3, i);
+      CHECK_EQUAL(1U, iqueue.size());
+
+      CHECK(iqueue.pop());
+      CHECK(!iqueue.pop());
+      CHECK(!iqueue.pop(i));
+    }
+
+    //*************************************************************************
+    TEST(test_clear)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      queue.push(1);
+      queue.push(2);
+      queue.clear();
+      CHECK_EQUAL(0U, queue.size());
+
+      // Do it again to check that clear() didn't screw up the internals.
+      queue.push(1);
+      queue.push(2);
+      CHECK_EQUAL(2U, queue.size());
+      queue.clear();
+      CHECK_EQUAL(0U, queue.size());
+    }
+
+    //*************************************************************************
+    TEST(test_empty_full)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+      CHECK(queue.empty());
+      CHECK(!queue.full());
+
+      queue.push(1);
+      CHECK(!queue.empty());
+      CHECK(!queue.full());
+
+      queue.push(2);
+      queue.push(3);
+      queue.push(4);
+      CHECK(!queue.empty());
+      CHECK(queue.full());
+
+      queue.clear();
+      CHECK(queue.empty());
+      CHECK(!queue.full());
+    }
+
+    //*************************************************************************
+    TEST(test_destruction)
+    {
+      Counted::count = 0;
+
+      {
+        etl::queue_mpmc_atomic<Counted, 4> queue;
+
+        queue.push(Counted());
+        queue.push(Counted());
+        queue.push(Counted());
+        CHECK_EQUAL(3, Counted::count);
+
+        CHECK(queue.pop());
+        CHECK_EQUAL(2, Counted::count);
+      }
+
+      // The destructor clears the queue.
+      CHECK_EQUAL(0, Counted::count);
+    }
+
+    //*************************************************************************
+    TEST(test_wrap_small_memory_model)
+    {
+      // The positions of the small model wrap every few laps.
+      QueueIntSmall queue;
+
+      int next_push = 0;
+      int next_pop  = 0;
+
+      for (int cycle = 0; cycle < 1000; ++cycle)
+      {
+        const int n_push = (cycle % 4) + 1;
+
+        for (int i = 0; i < n_push; ++i)
+        {
+          if (queue.push(next_push))
+          {
+            ++next_push;
+          }
+        }
+
+        CHECK_EQUAL(size_t(next_push - next_pop), size_t(queue.size()));
+
+        const int n_pop = (cycle % 3) + 1;
+
+        for (int i = 0; i < n_pop; ++i)
+        {
+          int value;
+
+          if (queue.pop(value))
+          {
+            CHECK_EQUAL(next_pop, value);
+            ++next_pop;
+          }
+        }
+
+        CHECK_EQUAL(size_t(next_push - next_pop), size_t(queue.size()));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_wrap_small_memory_model_largest_size)
+    {
+      // The largest size for the small model. One lap is 64, a quarter of the range.
+      etl::queue_mpmc_atomic<int, 63, etl::memory_model::MEMORY_MODEL_SMALL> queue;
+
+      int next_push = 0;
+      int next_pop  = 0;
+
+      for (int cycle = 0; cycle < 100; ++cycle)
+      {
+        const int n_push = (cycle % 70) + 1;
+
+        for (int i = 0; i < n_push; ++i)
+        {
+          if (queue.push(next_push))
+          {
+            ++next_push;
+          }
+          else
+          {
+            CHECK_EQUAL(63U, size_t(queue.size()));
+          }
+        }
+
+        CHECK_EQUAL(size_t(next_push - next_pop), size_t(queue.size()));
+
+        const int n_pop = (cycle % 50) + 1;
+
+        for (int i = 0; i < n_pop; ++i)
+        {
+          int value;
+
+          if (queue.pop(value))
+          {
+            CHECK_EQUAL(next_pop, value);
+            ++next_pop;
+          }
+          else
+          {
+            CHECK(queue.empty());
+          }
+        }
+
+        CHECK_EQUAL(size_t(next_push - next_pop), size_t(queue.size()));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_multiple_producers_multiple_consumers)
+    {
+      const int THREADS = 4;
+      const int LENGTH  = 100000;
+
+      etl::queue_mpmc_atomic<int, 16> queue;
+
+      std::vector<std::vector<int>> popped(THREADS);
+      std::atomic<bool> start(false);
+      std::vector<std::thread> threads;
+
+      for (int t = 0; t < THREADS; ++t)
+      {
+        // Producer.
+        threads.push_back(std::thread([&queue, &start, t, LENGTH]()
+        {
+          while (!start.load());
+
+          for (int value = t * LENGTH; value < ((t + 1) * LENGTH); ++value)
+          {
+            while (!queue.push(value))
+            {
+              std::this_thread::yield();
+            }
+          }
+        }));
+
+        // Consumer.
+        threads.push_back(std::thread([&queue, &start, &popped, t, LENGTH]()
+        {
+          std::vector<int>& output = popped[t];
+          output.reserve(LENGTH);
+
+          while (!start.load());
+
+          while (output.size() < size_t(LENGTH))
+          {
+            int value;
+
+            if (queue.pop(value))
+            {
+              output.push_back(value);
+            }
+            else
+            {
+              std::this_thread::yield();
+            }
+          }
+        }));
+      }
+
+      start.store(true);
+
+      for (size_t i = 0; i < threads.size(); ++i)
+      {
+        threads[i].join();
+      }
+
+      CHECK(queue.empty());
+
+      // Each consumer sees each producer's values in order.
+      for (int t = 0; t < THREADS; ++t)
+      {
+        std::vector<int> last(THREADS, -1);
+
+        for (size_t i = 0; i < popped[t].size(); ++i)
+        {
+          const int value    = popped[t][i];
+          const int producer = value / LENGTH;
+
+          CHECK(value > last[producer]);
+          last[producer] = value;
+        }
+      }
+
+      // Every value is popped exactly once.
+      std::vector<int> all;
+
+      for (int t = 0; t < THREADS; ++t)
+      {
+        all.insert(all.end(), popped[t].begin(), popped[t].end());
+      }
+
+      std::sort(all.begin(), all.end());
+
+      CHECK_EQUAL(size_t(THREADS * LENGTH), all.size());
+
+      bool in_sequence = true;
+
+      for (size_t i = 0; i < all.size(); ++i)
+      {
+        in_sequence = in_sequence && (all[i] == int(i));
+      }
+
+      CHECK(in_sequence);
+    }
+
+    //*************************************************************************
+    TEST(test_push_full_while_last_lap_push_in_progress)
+    {
+      etl::queue_mpmc_atomic<Stalling, 1> queue;
+
+      Stalling::stall      = true;
+      Stalling::stall_next = true;
+      Stalling::stalled    = false;
+
+      // Claims the slot and stalls before it is marked as written.
+      std::thread producer([&queue]()
+      {
+        queue.push(Stalling());
+      });
+
+      while (!Stalling::stalled.load())
+      {
+        std::this_thread::yield();
+      }
+
+      // Neither call waits for the stalled producer.
+      Stalling value;
+      CHECK(!queue.pop(value));
+      CHECK(!queue.push(value));
+
+      Stalling::stall = false;
+      producer.join();
+
+      CHECK(queue.pop(value));
+      CHECK(queue.push(value));
+    }
+
+    //*************************************************************************
+    TEST(test_pop_empty_while_last_lap_pop_in_progress)
+    {
+      etl::queue_mpmc_atomic<Stalling, 1> queue;
+
+      CHECK(queue.push(Stalling()));
+
+      Stalling::stall      = true;
+      Stalling::stall_next = true;
+      Stalling::stalled    = false;
+
+      // Claims the slot and stalls before it is marked as read.
+      std::thread consumer([&queue]()
+      {
+        Stalling value;
+        queue.pop(value);
+      });
+
+      while (!Stalling::stalled.load())
+      {
+        std::this_thread::yield();
+      }
+
+      // Neither call waits for the stalled consumer.
+      Stalling value;
+      CHECK(!queue.pop(value));
+      CHECK(!queue.push(value));
+
+      Stalling::stall = false;
+      consumer.join();
+
+      CHECK(queue.push(value));
+      CHECK(queue.pop(value));
+    }
+  };
+}
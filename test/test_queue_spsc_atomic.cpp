@@ -299,6 +299,151 @@ namespace
       CHECK(queue.full());
     }
 
+    //*************************************************************************
+    TEST(test_push_range_pop_n)
+    {
+      etl::queue_spsc_atomic<int, 6> queue;
+
+      const int input[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+      int output[8] = { 0 };
+
+      // Only as many as there is room for are pushed.
+      CHECK_EQUAL(4U, queue.push(input, input + 4));
+      CHECK_EQUAL(2U, queue.push(input + 4, input + 8));
+      CHECK_EQUAL(0U, queue.push(input, input + 8));
+      CHECK_EQUAL(6U, queue.size());
+      CHECK(queue.full());
+
+      // Only as many as are available are popped.
+      CHECK_EQUAL(3U, queue.pop(output, 3));
+      CHECK_EQUAL(1, output[0]);
+      CHECK_EQUAL(2, output[1]);
+      CHECK_EQUAL(3, output[2]);
+
+      // Wrap around the end of the buffer.
+      CHECK_EQUAL(2U, queue.push(input + 6, input + 8));
+      CHECK_EQUAL(1U, queue.push(input, input + 1));
+      CHECK_EQUAL(6U, queue.size());
+
+      CHECK_EQUAL(6U, queue.pop(output, 8));
+      CHECK_EQUAL(4, output[0]);
+      CHECK_EQUAL(5, output[1]);
+      CHECK_EQUAL(6, output[2]);
+      CHECK_EQUAL(7, output[3]);
+      CHECK_EQUAL(8, output[4]);
+      CHECK_EQUAL(1, output[5]);
+
+      CHECK_EQUAL(0U, queue.pop(output, 8));
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_push_pop_cycles)
+    {
+      // The cached indexes must be refreshed as each side wraps.
+      etl::queue_spsc_atomic<int, 5> queue;
+
+      int next_push = 0;
+      int next_pop  = 0;
+
+      for (int cycle = 0; cycle < 100; ++cycle)
+      {
+        for (int i = 0; i < (cycle % 4) + 1; ++i)
+        {
+          if (queue.push(next_push))
+          {
+            ++next_push;
+          }
+        }
+
+        int value;
+
+        for (int i = 0; i < (cycle % 3) + 1; ++i)
+        {
+          if (queue.pop(value))
+          {
+            CHECK_EQUAL(next_pop, value);
+            ++next_pop;
+          }
+        }
+
+        CHECK_EQUAL(size_t(next_push - next_pop), queue.size());
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_producer_consumer_threads)
+    {
+      const int LENGTH = 200000;
+
+      etl::queue_spsc_atomic<int, 64> queue;
+
+      std::vector<int> popped;
+      popped.reserve(LENGTH);
+
+      std::thread producer([&queue, LENGTH]()
+      {
+        int input[16];
+        int value = 0;
+
+        while (value < LENGTH)
+        {
+          int n = 0;
+
+          while ((n < 16) && ((value + n) < LENGTH))
+          {
+            input[n] = value + n;
+            ++n;
+          }
+
+          // Single and bulk pushes.
+          if ((value % 3) == 0)
+          {
+            if (queue.push(input[0]))
+            {
+              ++value;
+            }
+          }
+          else
+          {
+            value += int(queue.push(input, input + n));
+          }
+        }
+      });
+
+      int output[16];
+
+      while (popped.size() < size_t(LENGTH))
+      {
+        if ((popped.size() % 2) == 0)
+        {
+          int value;
+
+          if (queue.pop(value))
+          {
+            popped.push_back(value);
+          }
+        }
+        else
+        {
+          size_t n = queue.pop(output, 16);
+          popped.insert(popped.end(), output, output + n);
+        }
+      }
+
+      producer.join();
+
+      bool in_sequence = true;
+
+      for (size_t i = 0; i < popped.size(); ++i)
+      {
+        in_sequence = in_sequence && (popped[i] == int(i));
+      }
+
+      CHECK(in_sequence);
+      CHECK(queue.empty());
+    }
+
     //=========================================================================
 #if REALTIME_TEST && defined(ETL_COMPILER_MICROSOFT)
     #if defined(ETL_TARGET_OS_WINDOWS) // Only Windows priority is currently supported
@@ -789,5 +789,133 @@ namespace
 
       CHECK(initial1 != different);
     }
+
+    //*************************************************************************
+    TEST(test_rebuild_index)
+    {
+      typedef etl::reference_flat_map<int, int, SIZE, std::less<int>, true> Indexed;
+
+      // Every size, so that every shape of index tree is searched.
+      for (size_t n = 0; n <= SIZE; ++n)
+      {
+        std::vector<std::pair<const int, int> > values;
+
+        for (int i = 0; i < int(n); ++i)
+        {
+          values.push_back(std::make_pair(i, i));
+        }
+
+        std::map<int, int> compare_data;
+        Indexed data;
+
+        for (int i = 0; i < int(n); ++i)
+        {
+          data.insert(values[i]);
+          compare_data.insert(values[i]);
+        }
+
+        CHECK(!data.is_index_valid());
+        data.rebuild_index();
+        CHECK(data.is_index_valid());
+
+        const Indexed& cdata = data;
+
+        for (int key = -1; key <= int(n); ++key)
+        {
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(data.begin(), data.lower_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(data.begin(), data.upper_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.lower_bound(key)), std::distance(cdata.begin(), cdata.lower_bound(key)));
+          CHECK_EQUAL(std::distance(compare_data.begin(), compare_data.upper_bound(key)), std::distance(cdata.begin(), cdata.upper_bound(key)));
+          CHECK_EQUAL(compare_data.count(key), data.count(key));
+          CHECK_EQUAL(compare_data.find(key) == compare_data.end(), data.find(key) == data.end());
+          CHECK(data.equal_range(key).second == data.upper_bound(key));
+        }
+
+        // Any change discards the index.
+        if (n != 0)
+        {
+          data.erase(data.begin());
+          compare_data.erase(compare_data.begin());
+          CHECK(!data.is_index_valid());
+          CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+          data.rebuild_index();
+          CHECK(data.is_index_valid());
+          CHECK(data.find(compare_data.begin()->first) == data.begin());
+        }
+
+        data.clear();
+        CHECK(!data.is_index_valid());
+      }
+
+      // A container without an index ignores rebuild_index.
+      etl::reference_flat_map<int, int, SIZE> plain;
+      plain.rebuild_index();
+      CHECK(!plain.is_index_valid());
+    }
+
+    //*************************************************************************
+    TEST(test_insert_range_merges_with_existing)
+    {
+      // Unsorted, with keys that repeat and keys that are already present.
+      // There are more values than free space, but few enough distinct keys.
+      std::vector<std::pair<const int, int>> values;
+
+      for (int i = 0; i < 20; ++i)
+      {
+        values.push_back(std::pair<const int, int>((i * 7) % 9, i));
+      }
+
+      std::pair<const int, int> existing[] = { std::pair<const int, int>(2, 100), std::pair<const int, int>(5, 100) };
+
+      etl::reference_flat_map<int, int, SIZE> data;
+      std::map<int, int> compare_data;
+
+      data.insert(existing[0]);
+      data.insert(existing[1]);
+      compare_data.insert(existing[0]);
+      compare_data.insert(existing[1]);
+
+      data.insert(values.begin(), values.end());
+      compare_data.insert(values.begin(), values.end());
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+      CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+      // Not enough room for the new keys.
+      std::vector<std::pair<const int, int>> more;
+
+      for (int i = 0; i < 2; ++i)
+      {
+        more.push_back(std::pair<const int, int>(i + 20, i));
+      }
+
+      CHECK_THROW(data.insert(more.begin(), more.end()), etl::flat_map_full);
+    }
+
+    //*************************************************************************
+    TEST(test_insert_range_existing_keys_when_full)
+    {
+      std::vector<std::pair<const int, int>> values;
+
+      for (int i = 0; i < int(SIZE); ++i)
+      {
+        values.push_back(std::pair<const int, int>(i, i));
+      }
+
+      etl::reference_flat_map<int, int, SIZE> data(values.begin(), values.end());
+
+      // Keys that are already present need no room.
+      std::vector<std::pair<const int, int>> existing = { std::pair<const int, int>(1, 9), std::pair<const int, int>(int(SIZE) - 1, 9), std::pair<const int, int>(1, 9) };
+
+      CHECK_NO_THROW(data.insert(existing.begin(), existing.end()));
+      CHECK_EQUAL(SIZE, data.size());
+      CHECK_EQUAL(1, data.find(1)->second);
+      CHECK_EQUAL(int(SIZE) - 1, data.find(int(SIZE) - 1)->second);
+
+      std::vector<std::pair<const int, int>> more = { std::pair<const int, int>(1, 9), std::pair<const int, int>(int(SIZE), 9) };
+
+      CHECK_THROW(data.insert(more.begin(), more.end()), etl::flat_map_full);
+    }
   };
 }
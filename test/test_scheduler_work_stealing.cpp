@@ -0,0 +1,292 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <string>
+
+#include "etl/scheduler_work_stealing.h"
+#include "etl/function.h"
+
+namespace
+{
+  //***************************************************************************
+  // A task with a fixed amount of work, that checks it is never processed by
+  // two workers at once.
+  //***************************************************************************
+  class Task : public etl::task
+  {
+  public:
+
+    Task(etl::task_priority_t priority, uint32_t work_, std::vector<int>* p_order_ = nullptr)
+      : task(priority),
+        work(work_),
+        processed(0U),
+        in_progress(false),
+        overlapped(false),
+        p_order(p_order_)
+    {
+    }
+
+    uint32_t task_request_work() const
+    {
+      return work - processed;
+    }
+
+    void task_process_work()
+    {
+      if (in_progress.exchange(true))
+      {
+        overlapped = true;
+      }
+
+      if (p_order != nullptr)
+      {
+        p_order->push_back(get_task_priority());
+      }
+
+      ++processed;
+      in_progress.store(false);
+    }
+
+    uint32_t work;
+    uint32_t processed;
+    std::atomic<bool> in_progress;
+    bool overlapped;
+    std::vector<int>* p_order;
+  };
+
+  //***************************************************************************
+  // Exits the scheduler when all of the work is done.
+  //***************************************************************************
+  struct Common
+  {
+    Common(etl::ischeduler& scheduler_, std::atomic<uint32_t>& remaining_)
+      : idle_callback(*this, &Common::IdleCallback),
+        watchdog_callback(*this, &Common::WatchdogCallback),
+        scheduler(scheduler_),
+        remaining(remaining_),
+        watchdog_count(0U)
+    {
+    }
+
+    void IdleCallback()
+    {
+      if (remaining.load() == 0U)
+      {
+        scheduler.exit_scheduler();
+      }
+    }
+
+    void WatchdogCallback()
+    {
+      ++watchdog_count;
+    }
+
+    etl::function<Common, void> idle_callback;
+    etl::function<Common, void> watchdog_callback;
+    etl::ischeduler&        scheduler;
+    std::atomic<uint32_t>&  remaining;
+    std::atomic<uint32_t>   watchdog_count;
+  };
+
+  SUITE(test_scheduler_work_stealing)
+  {
+    //=========================================================================
+    TEST(test_single_worker_priority_order)
+    {
+      typedef etl::scheduler_work_stealing<3, 1> Scheduler;
+
+      std::vector<int> order;
+
+      Task task1(1, 2, &order);
+      Task task2(2, 2, &order);
+      Task task3(3, 1, &order);
+
+      etl::task* task_list[] = { &task1, &task3, &task2 };
+
+      Scheduler scheduler;
+      std::atomic<uint32_t> remaining(0U);
+      Common common(scheduler, remaining);
+
+      scheduler.set_idle_callback(common.idle_callback);
+      scheduler.set_watchdog_callback(common.watchdog_callback);
+      scheduler.add_task_list(task_list, 3);
+      scheduler.start(); // Returns when the idle callback is called.
+
+      std::vector<int> expected = { 3, 2, 1, 2, 1 };
+
+      CHECK(expected == order);
+      CHECK(common.watchdog_count.load() > 0U);
+      CHECK(scheduler.scheduler_is_running());
+    }
+
+    //=========================================================================
+    TEST(test_invalid_worker)
+    {
+      typedef etl::scheduler_work_stealing<1, 2> Scheduler;
+
+      Task task1(1, 1);
+      Scheduler scheduler;
+      scheduler.add_task(task1);
+
+      CHECK_THROW(scheduler.run_worker(2), etl::scheduler_invalid_worker_exception);
+    }
+
+    //=========================================================================
+    TEST(test_late_worker_does_not_resume_scheduler)
+    {
+      typedef etl::scheduler_work_stealing<1, 2> Scheduler;
+
+      Task task1(1, 1);
+      Scheduler scheduler;
+      scheduler.add_task(task1);
+
+      scheduler.set_scheduler_running(false);
+      scheduler.exit_scheduler();
+
+      scheduler.run_worker(1);
+
+      CHECK(!scheduler.scheduler_is_running());
+    }
+
+    //=========================================================================
+    TEST(test_no_tasks)
+    {
+      etl::scheduler_work_stealing<1, 1> scheduler;
+
+      CHECK_THROW(scheduler.start(), etl::scheduler_no_tasks_exception);
+    }
+
+    //=========================================================================
+    TEST(test_deque_pop_and_steal)
+    {
+      etl::private_scheduler::work_stealing_deque<4> deque;
+
+      CHECK_EQUAL(int(deque.EMPTY), deque.pop());
+      CHECK_EQUAL(int(deque.EMPTY), deque.steal());
+
+      deque.push(1);
+      deque.push(2);
+      deque.push(3);
+
+      CHECK_EQUAL(1, deque.steal());
+      CHECK_EQUAL(3, deque.pop());
+      CHECK_EQUAL(2, deque.pop());
+      CHECK_EQUAL(int(deque.EMPTY), deque.pop());
+
+      // Wrap around the buffer.
+      for (int i = 0; i < 10; ++i)
+      {
+        deque.push(i);
+        deque.push(i + 100);
+        CHECK_EQUAL(i, deque.steal());
+        CHECK_EQUAL(i + 100, deque.pop());
+      }
+
+      CHECK_EQUAL(int(deque.EMPTY), deque.steal());
+    }
+
+    //=========================================================================
+    TEST(test_multiple_workers)
+    {
+      const size_t N_TASKS   = 8;
+      const size_t N_WORKERS = 4;
+      const uint32_t WORK    = 5000;
+
+      typedef etl::scheduler_work_stealing<N_TASKS, N_WORKERS> Scheduler;
+
+      //*************************************
+      // Counts down the outstanding work.
+      class CountingTask : public Task
+      {
+      public:
+
+        CountingTask(etl::task_priority_t priority, uint32_t work_, std::atomic<uint32_t>& remaining_)
+          : Task(priority, work_),
+            remaining(remaining_)
+        {
+        }
+
+        void task_process_work()
+        {
+          Task::task_process_work();
+          --remaining;
+        }
+
+        std::atomic<uint32_t>& remaining;
+      };
+
+      std::atomic<uint32_t> remaining(uint32_t(N_TASKS * WORK));
+
+      std::vector<CountingTask*> tasks;
+
+      Scheduler scheduler;
+      Common common(scheduler, remaining);
+
+      for (size_t i = 0; i < N_TASKS; ++i)
+      {
+        tasks.push_back(new CountingTask(etl::task_priority_t(i % 3), WORK, remaining));
+        scheduler.add_task(*tasks.back());
+      }
+
+      scheduler.set_idle_callback(common.idle_callback);
+      scheduler.set_watchdog_callback(common.watchdog_callback);
+
+      std::vector<std::thread> workers;
+
+      for (size_t i = 1; i < N_WORKERS; ++i)
+      {
+        workers.push_back(std::thread([&scheduler, i]()
+        {
+          scheduler.run_worker(i);
+        }));
+      }
+
+      scheduler.start();
+
+      for (size_t i = 0; i < workers.size(); ++i)
+      {
+        workers[i].join();
+      }
+
+      CHECK_EQUAL(0U, remaining.load());
+
+      for (size_t i = 0; i < N_TASKS; ++i)
+      {
+        CHECK_EQUAL(WORK, tasks[i]->processed);
+        CHECK(!tasks[i]->overlapped);
+        delete tasks[i];
+      }
+    }
+  };
+}
@@ -3750,5 +3750,50 @@ namespace
       // Check there no non-zero values in the remainder of the string.
       CHECK(std::find_if(pb, pe, [](Text::value_type x) { return x != 0; }) == pe);
     }
+
+    //*************************************************************************
+    TEST(test_find_against_std_long_strings)
+    {
+      // Long enough to use the vector searches, with a small alphabet so that
+      // there are many partial matches.
+      etl::string<256> text;
+      std::string      compare_text;
+
+      uint32_t seed = 1;
+
+      for (size_t i = 0; i < 200; ++i)
+      {
+        seed = (seed * 1103515245U) + 12345U;
+        char c = char('a' + ((seed >> 16) % 4));
+        text.push_back(c);
+        compare_text.push_back(c);
+      }
+
+      const char* needles[] = { "a", "ab", "abc", "dcba", "abcdabcd", "aaaaa", "ddddddddd", "x", "ax", "" };
+      const char* sets[]    = { "x", "d", "cd", "xyz", "bcd", "xyzd", "xyzwvuts", "xyzwvutsd", "xyzwvutsrqponmlkjihgfd", "" };
+
+      for (size_t n = 0; n < (sizeof(needles) / sizeof(needles[0])); ++n)
+      {
+        for (size_t position = 0; position <= text.size(); ++position)
+        {
+          CHECK_EQUAL(compare_text.find(needles[n], position), text.find(needles[n], position));
+        }
+      }
+
+      for (size_t n = 0; n < (sizeof(sets) / sizeof(sets[0])); ++n)
+      {
+        for (size_t position = 0; position <= text.size(); ++position)
+        {
+          CHECK_EQUAL(compare_text.find_first_of(sets[n], position), text.find_first_of(sets[n], position));
+          CHECK_EQUAL(compare_text.find_last_of(sets[n], position), text.find_last_of(sets[n], position));
+        }
+      }
+
+      for (size_t position = 0; position <= text.size(); ++position)
+      {
+        CHECK_EQUAL(compare_text.find('d', position), text.find('d', position));
+        CHECK_EQUAL(compare_text.find('x', position), text.find('x', position));
+      }
+    }
   };
 }
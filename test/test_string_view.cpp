@@ -881,5 +881,46 @@ namespace
       CHECK_EQUAL(etl::hash<U16Text>()(u16text), etl::hash<U16View>()(u16view));
       CHECK_EQUAL(etl::hash<U32Text>()(u32text), etl::hash<U32View>()(u32view));
     }
+
+    //*************************************************************************
+    TEST(test_find_against_std_long_views)
+    {
+      std::string compare_text;
+
+      uint32_t seed = 1;
+
+      for (size_t i = 0; i < 200; ++i)
+      {
+        seed = (seed * 1103515245U) + 12345U;
+        compare_text.push_back(char('a' + ((seed >> 16) % 4)));
+      }
+
+      etl::string_view view(compare_text.data(), compare_text.size());
+
+      const char* needles[] = { "a", "ab", "abc", "dcba", "abcdabcd", "ddddddddd", "ax" };
+      const char* sets[]    = { "x", "d", "cd", "xyzd", "xyzwvutsd", "xyzwvutsrqponmlkjihgfd" };
+
+      for (size_t n = 0; n < (sizeof(needles) / sizeof(needles[0])); ++n)
+      {
+        for (size_t position = 0; position < compare_text.size(); ++position)
+        {
+          CHECK_EQUAL(compare_text.find(needles[n], position), view.find(needles[n], position));
+        }
+      }
+
+      for (size_t n = 0; n < (sizeof(sets) / sizeof(sets[0])); ++n)
+      {
+        for (size_t position = 0; position < compare_text.size(); ++position)
+        {
+          CHECK_EQUAL(compare_text.find_first_of(sets[n], position), view.find_first_of(sets[n], position));
+          CHECK_EQUAL(compare_text.find_last_of(sets[n], position), view.find_last_of(sets[n], position));
+        }
+      }
+
+      for (size_t position = 0; position < compare_text.size(); ++position)
+      {
+        CHECK_EQUAL(compare_text.find('d', position), view.find('d', position));
+      }
+    }
   };
 }
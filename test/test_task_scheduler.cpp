@@ -125,6 +125,7 @@ public:
     if (workIndex == addAtIndex)
     {
       pTaskToAddTo->work.push_back(workToAdd);
+      pTaskToAddTo->task_signal_ready();
     }
   }
 
@@ -155,6 +156,27 @@ typedef etl::scheduler<etl::scheduler_policy_sequencial_single,   sizeof(etl::ar
 typedef etl::scheduler<etl::scheduler_policy_sequencial_multiple, sizeof(etl::array_size(taskList))> SchedulerSequencialMultiple;
 typedef etl::scheduler<etl::scheduler_policy_highest_priority,    sizeof(etl::array_size(taskList))> SchedulerHighestPriority;
 typedef etl::scheduler<etl::scheduler_policy_most_work,           sizeof(etl::array_size(taskList))> SchedulerMostWork;
+typedef etl::scheduler<etl::scheduler_policy_ready_queue<4>,      sizeof(etl::array_size(taskList))> SchedulerReadyQueue;
+
+//*****************************************************************************
+class IdleTask : public etl::task
+{
+public:
+
+  IdleTask(etl::task_priority_t priority_)
+    : task(priority_)
+  {
+  }
+
+  uint32_t task_request_work() const
+  {
+    return 0;
+  }
+
+  void task_process_work()
+  {
+  }
+};
 
 namespace
 {
@@ -259,5 +281,96 @@ namespace
       CHECK(expected == common.workList);
       CHECK(common.watchdog_called);
     }
+
+    //=========================================================================
+    TEST(test_scheduler_ready_queue)
+    {
+      SchedulerReadyQueue s;
+
+      task1.Reset();
+      task2.Reset();
+      task3.Reset();
+
+      task2.WorkToAdd(2, "T3W3", task3);
+
+      common.Clear();
+      common.pScheduler = &s;
+
+      s.set_idle_callback(common.idle_callback);
+      s.set_watchdog_callback(common.watchdog_callback);
+      s.add_task_list(taskList, etl::size(taskList));
+      s.start(); // If 'start' returns then the idle callback was sucessfully called.
+
+      WorkList_t expected = { "T3W1", "T3W2", "T2W1", "T2W2", "T3W3", "T2W3", "T2W4", "T1W1", "T1W2", "T1W3" };
+
+      CHECK(expected == common.workList);
+      CHECK(common.watchdog_called);
+    }
+
+    //=========================================================================
+    TEST(test_task_ready_queue)
+    {
+      etl::task_ready_queue<256> queue;
+
+      IdleTask taskA(0);
+      IdleTask taskB(200);
+      IdleTask taskC(31);
+      IdleTask taskD(32);
+      IdleTask taskE(200);
+      IdleTask taskF(255);
+
+      CHECK(queue.empty());
+      CHECK(queue.pop() == nullptr);
+
+      queue.push(taskA);
+      queue.push(taskB);
+      queue.push(taskC);
+      queue.push(taskD);
+      queue.push(taskE);
+      queue.push(taskB); // Already queued.
+      queue.push(taskF);
+
+      CHECK(!queue.empty());
+      CHECK(queue.pop() == &taskF);
+      CHECK(queue.pop() == &taskB);
+      CHECK(queue.pop() == &taskE);
+      CHECK(queue.pop() == &taskD);
+
+      queue.push(taskB);
+
+      CHECK(queue.pop() == &taskB);
+      CHECK(queue.pop() == &taskC);
+      CHECK(queue.pop() == &taskA);
+      CHECK(queue.pop() == nullptr);
+      CHECK(queue.empty());
+    }
+
+    //=========================================================================
+    TEST(test_task_ready_queue_invalid_priority)
+    {
+      etl::task_ready_queue<4> queue;
+
+      IdleTask task(4);
+
+      CHECK_THROW(queue.push(task), etl::task_invalid_priority_exception);
+    }
+
+    //=========================================================================
+    TEST(test_task_signal_ready)
+    {
+      etl::task_ready_queue<4> queue;
+
+      IdleTask task(1);
+
+      task.task_signal_ready(); // Not attached to a queue.
+      CHECK(queue.empty());
+
+      task.set_task_ready_queue(queue);
+      task.task_signal_ready();
+      task.task_signal_ready();
+
+      CHECK(queue.pop() == &task);
+      CHECK(queue.empty());
+    }
   };
 }
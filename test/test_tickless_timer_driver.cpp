@@ -0,0 +1,259 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include "etl/tickless_timer_driver.h"
+#include "etl/callback_timer_wheel.h"
+#include "etl/callback_timer.h"
+#include "etl/function.h"
+
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+
+#if defined(__linux__)
+
+namespace
+{
+  std::atomic<int> repeating_count;
+  std::atomic<int> single_shot_count;
+
+  void repeating_callback()
+  {
+    ++repeating_count;
+  }
+
+  void single_shot_callback()
+  {
+    ++single_shot_count;
+  }
+
+  //***************************************************************************
+  // Serialises access to the timer and counts the driver's wakeups.
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : wakeups(0)
+    {
+    }
+
+    bool advance_to(uint32_t now)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++wakeups;
+      return controller.advance_to(now);
+    }
+
+    uint32_t time() const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return controller.time();
+    }
+
+    uint32_t time_to_next_expiry() const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return controller.time_to_next_expiry();
+    }
+
+    bool is_running() const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return controller.is_running();
+    }
+
+    etl::callback_timer_wheel<2> controller;
+    mutable std::mutex mutex;
+    std::atomic<int> wakeups;
+  };
+
+  const uint32_t TICK_NS = 1000000; // 1ms
+
+  SUITE(test_tickless_timer_driver)
+  {
+    //=========================================================================
+    TEST(test_expiries)
+    {
+      Timer timer;
+
+      etl::timer::id::type id1 = timer.controller.register_timer(repeating_callback,   5,  etl::timer::mode::REPEATING);
+      etl::timer::id::type id2 = timer.controller.register_timer(single_shot_callback, 20, etl::timer::mode::SINGLE_SHOT);
+
+      repeating_count   = 0;
+      single_shot_count = 0;
+
+      timer.controller.enable(true);
+      timer.controller.start(id1);
+      timer.controller.start(id2);
+
+      etl::tickless_timer_driver<Timer> driver(timer, TICK_NS);
+      CHECK(driver.is_valid());
+
+      std::thread thread([&driver]() { driver.run(); });
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(52));
+
+      driver.stop();
+      thread.join();
+
+      CHECK_EQUAL(1, single_shot_count.load());
+      CHECK(repeating_count.load() >= 5);
+      CHECK(repeating_count.load() <= 11);
+
+      // About one wakeup per expiry.
+      CHECK(timer.wakeups.load() <= 2 * (repeating_count.load() + single_shot_count.load()) + 2);
+    }
+
+    //=========================================================================
+    TEST(test_idle_and_wake)
+    {
+      Timer timer;
+
+      etl::timer::id::type id1 = timer.controller.register_timer(single_shot_callback, 10, etl::timer::mode::SINGLE_SHOT);
+
+      single_shot_count = 0;
+
+      timer.controller.enable(true);
+
+      etl::tickless_timer_driver<Timer> driver(timer, TICK_NS);
+
+      std::thread thread([&driver]() { driver.run(); });
+
+      // No active timers, so no wakeups.
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+      CHECK_EQUAL(1, timer.wakeups.load());
+
+      {
+        std::lock_guard<std::mutex> lock(timer.mutex);
+        timer.controller.start(id1);
+      }
+
+      driver.wake();
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+      driver.stop();
+      thread.join();
+
+      CHECK_EQUAL(1, single_shot_count.load());
+    }
+
+    //=========================================================================
+    TEST(test_disabled_timer_is_idle)
+    {
+      Timer timer;
+
+      etl::timer::id::type id1 = timer.controller.register_timer(single_shot_callback, 10, etl::timer::mode::SINGLE_SHOT);
+
+      single_shot_count = 0;
+
+      timer.controller.start(id1);
+
+      etl::tickless_timer_driver<Timer> driver(timer, TICK_NS);
+
+      std::thread thread([&driver]() { driver.run(); });
+
+      // Disabled, so no wakeups.
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+      CHECK_EQUAL(1, timer.wakeups.load());
+
+      {
+        std::lock_guard<std::mutex> lock(timer.mutex);
+        timer.controller.enable(true);
+      }
+
+      driver.wake();
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+      driver.stop();
+      thread.join();
+
+      CHECK_EQUAL(1, single_shot_count.load());
+    }
+
+    //=========================================================================
+    TEST(test_posted_commands)
+    {
+      // No lock. Commands from this thread go through the command queue.
+      etl::callback_timer<2, 4> controller;
+
+      etl::timer::id::type id1 = controller.register_timer(single_shot_callback, 10, etl::timer::mode::SINGLE_SHOT);
+
+      single_shot_count = 0;
+
+      controller.enable(true);
+
+      etl::tickless_timer_driver<etl::callback_timer<2, 4> > driver(controller, TICK_NS);
+
+      std::thread thread([&driver]() { driver.run(); });
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+      CHECK(controller.post_start(id1));
+      driver.wake();
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+      driver.stop();
+      thread.join();
+
+      CHECK_EQUAL(1, single_shot_count.load());
+    }
+
+    //=========================================================================
+    TEST(test_stop_before_run)
+    {
+      Timer timer;
+
+      etl::tickless_timer_driver<Timer> driver(timer, TICK_NS);
+
+      driver.stop();
+
+      // Returns at once rather than losing the stop.
+      std::thread thread([&driver]() { driver.run(); });
+      thread.join();
+
+      CHECK_EQUAL(0, timer.wakeups.load());
+    }
+
+    //=========================================================================
+    TEST(test_zero_tick_period)
+    {
+      Timer timer;
+
+      CHECK_THROW(etl::tickless_timer_driver<Timer> driver(timer, 0U), etl::tickless_timer_driver_invalid_period);
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,249 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2019 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+#include "UnitTest++.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "etl/to_arithmetic.h"
+#include "etl/to_string.h"
+#include "etl/cstring.h"
+#include "etl/format_spec.h"
+
+namespace
+{
+  typedef etl::to_arithmetic_status Status;
+
+  SUITE(test_to_arithmetic)
+  {
+    //*************************************************************************
+    TEST(test_integral_decimal)
+    {
+      CHECK_EQUAL(0,    etl::to_arithmetic<int>(etl::string_view("0")).value());
+      CHECK_EQUAL(1234, etl::to_arithmetic<int>(etl::string_view("1234")).value());
+      CHECK_EQUAL(1234, etl::to_arithmetic<int>(etl::string_view("+1234")).value());
+      CHECK_EQUAL(-1234, etl::to_arithmetic<int>(etl::string_view("-1234")).value());
+
+      CHECK_EQUAL(int8_t(127),   etl::to_arithmetic<int8_t>(etl::string_view("127")).value());
+      CHECK_EQUAL(int8_t(-128),  etl::to_arithmetic<int8_t>(etl::string_view("-128")).value());
+      CHECK_EQUAL(uint8_t(255),  etl::to_arithmetic<uint8_t>(etl::string_view("255")).value());
+      CHECK_EQUAL(int16_t(-32768), etl::to_arithmetic<int16_t>(etl::string_view("-32768")).value());
+      CHECK_EQUAL(uint32_t(4294967295UL), etl::to_arithmetic<uint32_t>(etl::string_view("4294967295")).value());
+
+      CHECK(etl::to_arithmetic<int64_t>(etl::string_view("-9223372036854775808")).value() == (-9223372036854775807LL - 1));
+      CHECK(etl::to_arithmetic<int64_t>(etl::string_view("9223372036854775807")).value() == 9223372036854775807LL);
+      CHECK(etl::to_arithmetic<uint64_t>(etl::string_view("18446744073709551615")).value() == 18446744073709551615ULL);
+
+      // Eight digits at a time, with leading zeros and a tail.
+      CHECK(etl::to_arithmetic<uint64_t>(etl::string_view("0000000012345678901234567")).value() == 12345678901234567ULL);
+
+      etl::to_arithmetic_result<int> result = etl::to_arithmetic<int>(etl::string_view("42"));
+      CHECK(result.has_value());
+      CHECK(bool(result));
+      CHECK_EQUAL(int(Status::valid), int(result.error()));
+    }
+
+    //*************************************************************************
+    TEST(test_integral_radix)
+    {
+      CHECK_EQUAL(5,      etl::to_arithmetic<int>(etl::string_view("101"), etl::radix::binary).value());
+      CHECK_EQUAL(-8,     etl::to_arithmetic<int>(etl::string_view("-10"), etl::radix::octal).value());
+      CHECK_EQUAL(0xABCD, etl::to_arithmetic<int>(etl::string_view("AbCd"), etl::radix::hex).value());
+      CHECK(etl::to_arithmetic<uint64_t>(etl::string_view("FFFFFFFFFFFFFFFF"), etl::radix::hex).value() == 0xFFFFFFFFFFFFFFFFULL);
+
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("102"), etl::radix::binary).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("18"), etl::radix::octal).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("1G"), etl::radix::hex).error()));
+      CHECK_EQUAL(int(Status::invalid_radix),  int(etl::to_arithmetic<int>(etl::string_view("1"), etl::radix::undefined).error()));
+    }
+
+    //*************************************************************************
+    TEST(test_integral_errors)
+    {
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("-")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view(" 12")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("12 ")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("0x10")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::string_view("1234567a")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int64_t>(etl::string_view("12345678a")).error()));
+
+      CHECK_EQUAL(int(Status::signed_to_unsigned), int(etl::to_arithmetic<unsigned>(etl::string_view("-1")).error()));
+
+      etl::to_arithmetic_result<int8_t> result = etl::to_arithmetic<int8_t>(etl::string_view("128"));
+      CHECK(!result.has_value());
+      CHECK_EQUAL(int(Status::overflow), int(result.error()));
+      CHECK_EQUAL(127, int(result.value()));
+
+      result = etl::to_arithmetic<int8_t>(etl::string_view("-129"));
+      CHECK_EQUAL(int(Status::overflow), int(result.error()));
+      CHECK_EQUAL(-128, int(result.value()));
+
+      CHECK_EQUAL(int(Status::overflow), int(etl::to_arithmetic<uint64_t>(etl::string_view("18446744073709551616")).error()));
+      CHECK_EQUAL(int(Status::overflow), int(etl::to_arithmetic<uint64_t>(etl::string_view("100000000000000000000000")).error()));
+      CHECK_EQUAL(int(Status::overflow), int(etl::to_arithmetic<uint8_t>(etl::string_view("100000000")).error()));
+    }
+
+    //*************************************************************************
+    TEST(test_integral_not_null_terminated)
+    {
+      const char text[] = { '1', '2', '3', '4' };
+
+      CHECK_EQUAL(12,   etl::to_arithmetic<int>(text, 2).value());
+      CHECK_EQUAL(1234, etl::to_arithmetic<int>(etl::string_view(text, 4)).value());
+    }
+
+    //*************************************************************************
+    TEST(test_integral_wide)
+    {
+      CHECK_EQUAL(-1234,  etl::to_arithmetic<int>(etl::wstring_view(L"-1234")).value());
+      CHECK_EQUAL(0xBEEF, etl::to_arithmetic<int>(etl::u16string_view(u"beef"), etl::radix::hex).value());
+      CHECK(etl::to_arithmetic<uint64_t>(etl::u32string_view(U"12345678901234567890")).value() == 12345678901234567890ULL);
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<int>(etl::u32string_view(U"12x")).error()));
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point)
+    {
+      CHECK_EQUAL(0.0,     etl::to_arithmetic<double>(etl::string_view("0")).value());
+      CHECK_EQUAL(1.5,     etl::to_arithmetic<double>(etl::string_view("1.5")).value());
+      CHECK_EQUAL(-0.1,    etl::to_arithmetic<double>(etl::string_view("-.1")).value());
+      CHECK_EQUAL(100.0,   etl::to_arithmetic<double>(etl::string_view("100.")).value());
+      CHECK_EQUAL(1.25e-5, etl::to_arithmetic<double>(etl::string_view("1.25E-5")).value());
+      CHECK_EQUAL(1e23,    etl::to_arithmetic<double>(etl::string_view("1e23")).value());
+      CHECK_EQUAL(1e23,    etl::to_arithmetic<double>(etl::string_view("+1e+23")).value());
+
+      CHECK_EQUAL(1.7976931348623157e308,  etl::to_arithmetic<double>(etl::string_view("1.7976931348623157e308")).value());
+      CHECK_EQUAL(2.2250738585072014e-308, etl::to_arithmetic<double>(etl::string_view("2.2250738585072014e-308")).value());
+      CHECK_EQUAL(4.9406564584124654e-324, etl::to_arithmetic<double>(etl::string_view("4.9e-324")).value());
+
+      CHECK_EQUAL(0.1f,           etl::to_arithmetic<float>(etl::string_view("0.1")).value());
+      CHECK_EQUAL(3.4028235e38f,  etl::to_arithmetic<float>(etl::string_view("3.4028235e38")).value());
+      CHECK_EQUAL(1.17549435e-38f, etl::to_arithmetic<float>(etl::string_view("1.17549435e-38")).value());
+
+      double negative_zero = etl::to_arithmetic<double>(etl::string_view("-0.0")).value();
+      CHECK_EQUAL(0.0, negative_zero);
+      CHECK(signbit(negative_zero));
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_many_digits)
+    {
+      // 2^53 + 1 is half way between two doubles, so rounds to even.
+      CHECK_EQUAL(9007199254740992.0, etl::to_arithmetic<double>(etl::string_view("9007199254740993")).value());
+
+      // A digit far past the nineteenth decides the rounding.
+      CHECK_EQUAL(9007199254740994.0, etl::to_arithmetic<double>(etl::string_view("9007199254740993.0000000000000000000001")).value());
+      CHECK_EQUAL(9007199254740992.0, etl::to_arithmetic<double>(etl::string_view("9007199254740992.9999999999999999999999")).value());
+
+      CHECK_EQUAL(0.1, etl::to_arithmetic<double>(etl::string_view("0.1000000000000000000000000000000000000000000000000000001")).value());
+      CHECK_EQUAL(123456789012345678901234567890.0, etl::to_arithmetic<double>(etl::string_view("123456789012345678901234567890")).value());
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_special)
+    {
+      CHECK(isinf(etl::to_arithmetic<double>(etl::string_view("inf")).value()));
+      CHECK(isinf(etl::to_arithmetic<double>(etl::string_view("-Infinity")).value()));
+      CHECK(etl::to_arithmetic<double>(etl::string_view("-Infinity")).value() < 0.0);
+      CHECK(isnan(etl::to_arithmetic<float>(etl::string_view("NaN")).value()));
+
+      etl::to_arithmetic_result<double> result = etl::to_arithmetic<double>(etl::string_view("1e309"));
+      CHECK_EQUAL(int(Status::overflow), int(result.error()));
+      CHECK(isinf(result.value()));
+
+      result = etl::to_arithmetic<double>(etl::string_view("1e-400"));
+      CHECK_EQUAL(int(Status::underflow), int(result.error()));
+      CHECK_EQUAL(0.0, result.value());
+
+      CHECK_EQUAL(int(Status::overflow), int(etl::to_arithmetic<float>(etl::string_view("1e39")).error()));
+      CHECK_EQUAL(int(Status::valid),    int(etl::to_arithmetic<double>(etl::string_view("0e-400")).error()));
+
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<double>(etl::string_view("")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<double>(etl::string_view(".")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<double>(etl::string_view("e5")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<double>(etl::string_view("1e")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<double>(etl::string_view("1.5x")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<double>(etl::string_view("1,5")).error()));
+      CHECK_EQUAL(int(Status::invalid_format), int(etl::to_arithmetic<double>(etl::string_view("infinite")).error()));
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_wide)
+    {
+      CHECK_EQUAL(-2.5e-3, etl::to_arithmetic<double>(etl::wstring_view(L"-2.5e-3")).value());
+      CHECK_EQUAL(0.3f,    etl::to_arithmetic<float>(etl::u16string_view(u"0.3")).value());
+      CHECK_EQUAL(1e100,   etl::to_arithmetic<double>(etl::u32string_view(U"1e100")).value());
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_against_strtod)
+    {
+      uint64_t bits = 0x0123456789ABCDEFULL;
+
+      for (int i = 0; i < 10000; ++i)
+      {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+
+        if ((value != value) || (value - value != 0.0))
+        {
+          continue; // NaN or infinity.
+        }
+
+        char text[40];
+        const int length = snprintf(text, sizeof(text), "%.*e", int(bits % 20), value);
+
+        CHECK_EQUAL(strtod(text, 0), etl::to_arithmetic<double>(text, size_t(length)).value());
+        CHECK_EQUAL(strtof(text, 0), etl::to_arithmetic<float>(text, size_t(length)).value());
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_round_trip_with_to_string)
+    {
+      etl::string<40> str;
+
+      const double values[] = { 0.1, 1.0 / 3.0, 6.02214076e23, 5e-324, 1.7976931348623157e308, 123456.789 };
+
+      for (size_t i = 0; i < (sizeof(values) / sizeof(values[0])); ++i)
+      {
+        etl::to_string(values[i], str, etl::format_spec().shortest(true));
+
+        CHECK_EQUAL(values[i], etl::to_arithmetic<double>(etl::string_view(str)).value());
+      }
+    }
+  };
+}
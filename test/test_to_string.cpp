@@ -31,6 +31,8 @@ SOFTWARE.
 #include <ostream>
 #include <sstream>
 #include <iomanip>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "etl/to_string.h"
 #include "etl/cstring.h"
@@ -394,6 +396,201 @@ namespace
       to_string(&cvi, str, Format().hex().width(10).left().fill(STR('0')), true);
       CHECK_EQUAL(compare, str);
     }
+
+    //*************************************************************************
+    TEST(test_decimal_and_hex_against_ostream)
+    {
+      etl::string<40> str;
+
+      int64_t values[] = { 0, 1, -1, 9, 10, 99, 100, 999, 1000, 9999, 10000, 12345678, -987654321,
+                           int64_t(4294967295ll), int64_t(-9223372036854775807ll - 1), int64_t(9223372036854775807ll) };
+
+      for (size_t i = 0; i < (sizeof(values) / sizeof(values[0])); ++i)
+      {
+        std::ostringstream oss;
+        oss << std::setw(24) << std::setfill('*') << std::right << values[i];
+        std::string compare(STR("Value "));
+        compare.append(oss.str());
+
+        str.assign(STR("Value "));
+        etl::to_string(values[i], str, Format().decimal().width(24).fill(STR('*')).right(), true);
+        CHECK_EQUAL(etl::string<40>(compare.begin(), compare.end()), str);
+
+        oss.str(STR(""));
+        oss << std::setw(24) << std::setfill('*') << std::left << values[i];
+        compare = oss.str();
+
+        etl::to_string(values[i], str, Format().decimal().width(24).fill(STR('*')).left());
+        CHECK_EQUAL(etl::string<40>(compare.begin(), compare.end()), str);
+
+        uint64_t uvalue = uint64_t(values[i]);
+
+        oss.str(STR(""));
+        oss << std::hex << std::nouppercase << uvalue;
+        compare = oss.str();
+
+        etl::to_string(uvalue, str, Format().hex().upper_case(false));
+        CHECK_EQUAL(etl::string<40>(compare.begin(), compare.end()), str);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_decimal_truncated)
+    {
+      etl::string<4> str;
+
+      etl::to_string(123456, str);
+      CHECK(str.truncated());
+      CHECK_EQUAL(4U, str.size());
+
+      etl::to_string(12, str, Format().width(6).fill(STR('0')));
+      CHECK(str.truncated());
+      CHECK_EQUAL(4U, str.size());
+
+      etl::to_string(1234, str);
+      CHECK_EQUAL(etl::string<4>(STR("1234")), str);
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_fixed_against_printf)
+    {
+      etl::string<400> str;
+
+      double values[] = { 0.0, 1.0, -1.0, 0.1, 0.7, 1.4, 3.14159265358979, -2.718281828459045,
+                          123456.789, 0.000123, 9.99999, 99.996, 1.0e15, 12345678901234567.0,
+                          0.5, 1.5, 2.5, 0.125, 2.675, 1.0e-30,
+                          0.0006355, 0.0032795, 0.000155, 1.95e-05, 1.0e300, 5e-324,
+                          1.7976931348623157e308, 2.2250738585072014e-308 };
+
+      for (size_t i = 0; i < (sizeof(values) / sizeof(values[0])); ++i)
+      {
+        for (uint32_t precision = 0; precision < 10; ++precision)
+        {
+          char compare[400];
+          snprintf(compare, sizeof(compare), "%.*f", int(precision), values[i]);
+
+          etl::to_string(values[i], str, Format().precision(precision));
+          CHECK_EQUAL(etl::string<400>(STR(compare)), str);
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_fixed_small_values)
+    {
+      etl::string<60> str;
+
+      // Rounded exactly rather than from the shortest digits.
+      CHECK_EQUAL(etl::string<60>(STR("0.000635")), etl::to_string(0.0006355, str, Format().precision(6)));
+      CHECK_EQUAL(etl::string<60>(STR("0.003279")), etl::to_string(0.0032795, str, Format().precision(6)));
+      CHECK_EQUAL(etl::string<60>(STR("0.00015")),  etl::to_string(0.000155,  str, Format().precision(5)));
+      CHECK_EQUAL(etl::string<60>(STR("0.000019")), etl::to_string(1.95e-05,  str, Format().precision(6)));
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_fixed_float_and_long_double_against_printf)
+    {
+      etl::string<100> str;
+
+      float       float_values[]       = { 0.0006355f, 0.1f, 3.0f, 1.0e-20f, 3.4028235e38f };
+      long double long_double_values[] = { 0.0006355L, 0.0032795L, 0.1L, 3.0L, 2.675L, 1.0e-20L };
+
+      for (uint32_t precision = 0; precision < 12; ++precision)
+      {
+        char compare[100];
+
+        for (size_t i = 0; i < (sizeof(float_values) / sizeof(float_values[0])); ++i)
+        {
+          snprintf(compare, sizeof(compare), "%.*f", int(precision), double(float_values[i]));
+
+          etl::to_string(float_values[i], str, Format().precision(precision));
+          CHECK_EQUAL(etl::string<100>(STR(compare)), str);
+        }
+
+        for (size_t i = 0; i < (sizeof(long_double_values) / sizeof(long_double_values[0])); ++i)
+        {
+          snprintf(compare, sizeof(compare), "%.*Lf", int(precision), long_double_values[i]);
+
+          etl::to_string(long_double_values[i], str, Format().precision(precision));
+          CHECK_EQUAL(etl::string<100>(STR(compare)), str);
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_fixed_large_exponent)
+    {
+      etl::string<60> str;
+
+      // Too large for the integral part to be held in an int64_t.
+      CHECK_EQUAL(etl::string<60>(STR("100000000000000000000.00")), etl::to_string(1.0e20, str, Format().precision(2)));
+      // The exact binary value, as printf.
+      CHECK_EQUAL(etl::string<60>(STR("-123399999999999999385685458944")), etl::to_string(-1.234e29, str));
+
+      // Rounds up into a new leading digit.
+      CHECK_EQUAL(etl::string<60>(STR("  1000.0")), etl::to_string(999.96, str, Format().precision(1).width(8)));
+      CHECK_EQUAL(etl::string<60>(STR("0.001")), etl::to_string(0.00096, str, Format().precision(3)));
+      CHECK_EQUAL(etl::string<60>(STR("0.000")), etl::to_string(0.00004, str, Format().precision(3)));
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_shortest)
+    {
+      etl::string<40> str;
+
+      CHECK_EQUAL(etl::string<40>(STR("0")),                       etl::to_string(0.0, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("0.1")),                     etl::to_string(0.1, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("-1.5")),                    etl::to_string(-1.5, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("1500")),                    etl::to_string(1500.0, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("0.000001")),                etl::to_string(0.000001, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("1.5e-7")),                  etl::to_string(1.5e-7, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("100000000000000000000")),   etl::to_string(1.0e20, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("1e+21")),                   etl::to_string(1.0e21, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("1.7976931348623157e+308")), etl::to_string(1.7976931348623157e308, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("5e-324")),                  etl::to_string(5e-324, str, Format().shortest(true)));
+
+      // A float gets the shortest digits for a float.
+      CHECK_EQUAL(etl::string<40>(STR("0.1")),                     etl::to_string(0.1f, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::string<40>(STR("3.4028235e+38")),           etl::to_string(3.4028235e38f, str, Format().shortest(true)));
+
+      // Width and fill still apply.
+      CHECK_EQUAL(etl::string<40>(STR("****0.25")),                etl::to_string(0.25, str, Format().shortest(true).width(8).fill(STR('*'))));
+
+      str.assign(STR("Value "));
+      CHECK_EQUAL(etl::string<40>(STR("Value 0.25****")),          etl::to_string(0.25, str, Format().shortest(true).width(8).fill(STR('*')).left(), true));
+    }
+
+    //*************************************************************************
+    TEST(test_floating_point_shortest_round_trip)
+    {
+      etl::string<40> str;
+
+      uint64_t bits = 0x0123456789ABCDEFULL;
+
+      for (int i = 0; i < 10000; ++i)
+      {
+        // A simple xorshift sequence of bit patterns.
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+
+        if ((value != value) || (value - value != 0.0))
+        {
+          continue; // NaN or infinity.
+        }
+
+        etl::to_string(value, str, Format().shortest(true));
+
+        std::string text(str.begin(), str.end());
+        CHECK_EQUAL(value, strtod(text.c_str(), 0));
+
+        // Never more than 17 significant digits.
+        CHECK(str.size() <= 25U);
+      }
+    }
   };
 }
 
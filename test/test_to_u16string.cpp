@@ -281,6 +281,17 @@ namespace
       CHECK_EQUAL(etl::u16string<20>(STR("Result 12.345678 ")), etl::to_string(12.345678, str, Format().precision(6).width(10).left(), true));
     }
 
+    //*************************************************************************
+    TEST(test_floating_point_shortest)
+    {
+      etl::u16string<30> str;
+
+      CHECK_EQUAL(etl::u16string<30>(STR("0.1")),                     etl::to_string(0.1, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::u16string<30>(STR("-1.5e-7")),                 etl::to_string(-1.5e-7, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::u16string<30>(STR("1.7976931348623157e+308")), etl::to_string(1.7976931348623157e308, str, Format().shortest(true)));
+      CHECK_EQUAL(etl::u16string<30>(STR("****0.25")),                etl::to_string(0.25f, str, Format().shortest(true).width(8).fill(STR('*'))));
+    }
+
     //*************************************************************************
     TEST(test_bool_no_append)
     {
@@ -719,5 +719,121 @@ namespace
       CHECK_EQUAL('c', map[2]);
       CHECK_EQUAL('d', map[3]);
     }
+
+    //*************************************************************************
+    TEST(test_sparse_buckets_iterate_erase_clear)
+    {
+      // Many more buckets than elements, spanning several occupancy words.
+      typedef etl::unordered_map<uint32_t, int, 8, 200> Sparse;
+
+      Sparse data;
+
+      const uint32_t keys[] = { 199, 3, 150, 70, 64, 63 };
+
+      for (size_t i = 0; i < 6; ++i)
+      {
+        data.insert(std::make_pair(keys[i], int(keys[i])));
+      }
+
+      std::vector<uint32_t> visited;
+
+      for (Sparse::const_iterator itr = data.begin(); itr != data.end(); ++itr)
+      {
+        visited.push_back(itr->first);
+        CHECK_EQUAL(int(itr->first), itr->second);
+      }
+
+      std::sort(visited.begin(), visited.end());
+      const uint32_t expected[] = { 3, 63, 64, 70, 150, 199 };
+      CHECK_EQUAL(6U, visited.size());
+      CHECK_ARRAY_EQUAL(expected, visited.data(), 6);
+
+      // Erase the even keys while iterating.
+      Sparse::iterator itr = data.begin();
+
+      while (itr != data.end())
+      {
+        if ((itr->first % 2) == 0)
+        {
+          itr = data.erase(itr);
+        }
+        else
+        {
+          ++itr;
+        }
+      }
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK_EQUAL(3U, size_t(std::distance(data.begin(), data.end())));
+      CHECK(data.find(3)   != data.end());
+      CHECK(data.find(63)  != data.end());
+      CHECK(data.find(199) != data.end());
+
+      // Erase the lowest bucket, then the rest as a range.
+      data.erase(3);
+      CHECK(data.begin()->first == 63 || data.begin()->first == 199);
+      data.erase(data.begin(), data.end());
+      CHECK(data.empty());
+      CHECK(data.begin() == data.end());
+
+      data.insert(std::make_pair(uint32_t(100), 100));
+      data.clear();
+      CHECK(data.empty());
+      CHECK(data.begin() == data.end());
+
+      data.insert(std::make_pair(uint32_t(5), 5));
+      CHECK_EQUAL(5U, data.begin()->first);
+      CHECK_EQUAL(1U, size_t(std::distance(data.begin(), data.end())));
+    }
+
+    //*************************************************************************
+    TEST(test_find_prehashed_and_batch)
+    {
+      typedef etl::unordered_map<uint32_t, int, 40, 16> Data;
+
+      Data data;
+
+      for (uint32_t i = 0; i < 40; ++i)
+      {
+        data.insert(std::make_pair(i * 3, int(i)));
+      }
+
+      const Data& cdata = data;
+
+      // Prehashed lookup.
+      size_t hash = data.hash_function()(27);
+      CHECK_EQUAL(data.get_bucket_index(27), data.bucket_for_hash(hash));
+      CHECK(data.find(27, hash) == data.find(27));
+      CHECK(cdata.find(27, hash) == cdata.find(27));
+      CHECK(data.find(28, data.hash_function()(28)) == data.end());
+
+      // Batch lookup, spanning more than one block, with some missing keys.
+      std::vector<uint32_t> keys;
+
+      for (uint32_t i = 0; i < 50; ++i)
+      {
+        keys.push_back((i * 7) % 130);
+      }
+
+      std::vector<Data::iterator> results;
+      data.find_batch(keys.begin(), keys.end(), std::back_inserter(results));
+
+      std::vector<Data::const_iterator> cresults(keys.size());
+      std::vector<Data::const_iterator>::iterator iend = cdata.find_batch(keys.begin(), keys.end(), cresults.begin());
+
+      CHECK(iend == cresults.end());
+      CHECK_EQUAL(keys.size(), results.size());
+
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        CHECK(results[i] == data.find(keys[i]));
+        CHECK(cresults[i] == cdata.find(keys[i]));
+
+        if (results[i] != data.end())
+        {
+          CHECK_EQUAL(keys[i], results[i]->first);
+        }
+      }
+    }
   };
 }